@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file BlockAdapter.h
+ * @brief Fixed processing quantum behind a variable device block size
+ *
+ * The device decides the callback size (128, 441, 512, ... and sometimes a
+ * different one per callback). Processors with a natural frame size (RNNoise
+ * works in 480-sample frames) then need their own FIFO, and plugins see an
+ * uneven workload. FixedBlockAdapter buffers the stream once, in front of the
+ * whole chain, so the chain always runs on exactly quantum() frames.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace directpipe {
+
+/**
+ * @brief Input/output FIFO pair that runs a callback on fixed-size blocks.
+ *
+ * For a steady device block B and quantum Q the adapter delays the stream by
+ * the smallest amount that never starves the output: Q - gcd(B, Q) frames
+ * (0 when B is a multiple of Q). A callback of an unexpected size can still
+ * find the output short; the gap is filled with silence and the delay grows by
+ * the shortfall, up to Q - 1 frames, where no call pattern can starve it
+ * again. latencyFrames() always reports the delay actually applied.
+ *
+ * Quantum 0 disables the adapter: process() runs the callback in place on the
+ * caller's block.
+ *
+ * prepare() allocates; process() and reset() are RT-safe. Not thread-safe:
+ * call from the audio thread only.
+ */
+class FixedBlockAdapter {
+public:
+    /// Smallest delay that serves a steady `hostBlock` with `quantum` (0 if quantum is 0)
+    static uint32_t minimumLatency(uint32_t quantum, uint32_t hostBlock);
+
+    /**
+     * @brief Allocate the FIFOs and reset.
+     * @param channels  Channels carried through the adapter.
+     * @param quantum   Frames per processing block (0 = disabled).
+     * @param hostBlock Expected device block size; sets the initial delay.
+     * @param maxBlock  Largest block process() will be handed.
+     */
+    void prepare(uint32_t channels, uint32_t quantum, uint32_t hostBlock, uint32_t maxBlock);
+
+    /// Drop buffered audio and return to the initial delay (silence primed)
+    void reset();
+
+    /**
+     * @brief Push `frames` of `io`, run every complete quantum, pop `frames` back into `io`.
+     * @param processQuantum  Called as processQuantum(float* const* data, uint32_t channels,
+     *                        uint32_t frames) with frames == quantum(), in place.
+     */
+    template <typename ProcessQuantum>
+    void process(float* const* io, uint32_t numChannels, uint32_t frames, ProcessQuantum&& processQuantum)
+    {
+        if (quantum_ == 0) {
+            processQuantum(io, numChannels, frames);
+            return;
+        }
+        const uint32_t channels = (std::min)(numChannels, channels_);
+        for (uint32_t offset = 0; offset < frames;) {
+            const uint32_t n = (std::min)(frames - offset, maxBlock_);
+            push(io, channels, offset, n);
+            while (inFill_ >= quantum_) {
+                processQuantum(quantumPtrs_.data(), channels_, quantum_);
+                takeQuantum();
+            }
+            pop(io, channels, offset, n);
+            offset += n;
+        }
+    }
+
+    uint32_t quantum() const { return quantum_; }
+
+    /// Delay through the adapter in frames (grows only after a short output)
+    uint32_t latencyFrames() const { return latency_; }
+
+    /// Calls whose output came up short since prepare()
+    uint64_t underruns() const { return underruns_; }
+
+private:
+    void push(float* const* io, uint32_t channels, uint32_t offset, uint32_t frames);
+    void takeQuantum();
+    void pop(float* const* io, uint32_t channels, uint32_t offset, uint32_t frames);
+
+    std::vector<std::vector<float>> in_;    // per channel, inFill_ frames used
+    std::vector<std::vector<float>> out_;   // per channel, outFill_ frames used
+    std::vector<float*> quantumPtrs_;       // heads of in_, handed to the callback
+    uint32_t channels_ = 0;
+    uint32_t quantum_ = 0;
+    uint32_t maxBlock_ = 0;
+    uint32_t initialLatency_ = 0;
+    uint32_t latency_ = 0;
+    uint32_t inFill_ = 0;
+    uint32_t outFill_ = 0;
+    uint64_t underruns_ = 0;
+};
+
+} // namespace directpipe
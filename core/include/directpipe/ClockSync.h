@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file ClockSync.h
+ * @brief Host-clock helpers for the per-block timestamp side channel
+ *
+ * Producer and consumer stamp audio blocks with steadyClockNs(), a monotonic
+ * clock shared by all processes on the machine. ClockRatioEstimator turns the
+ * producer's (host time, device sample counter) stamps and the consumer's own
+ * progress into sample rates measured against that common clock, and from
+ * them the producer/consumer clock ratio used for drift reporting.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace directpipe {
+
+/// Monotonic host time in nanoseconds (same clock in every process)
+inline uint64_t steadyClockNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Estimates producer and consumer sample rates against the host clock.
+ *
+ * Each side's rate is the slope of its sample counter over a window of 1-10 s
+ * of host time; the window restarts every 10 s so the estimate follows slow
+ * clock drift. Timestamp jitter of ~0.1 ms gives <= 100 ppm error at the
+ * shortest window and ~10 ppm at the longest.
+ *
+ * Not thread-safe: feed and query from one thread (the consumer's RT thread).
+ * No allocation, RT-safe.
+ */
+class ClockRatioEstimator {
+public:
+    /// Shortest window before a rate is reported
+    static constexpr uint64_t kMinWindowNs = 1'000'000'000ULL;
+    /// Window length after which the anchor is moved up to the latest stamp
+    static constexpr uint64_t kMaxWindowNs = 10'000'000'000ULL;
+
+    /// Forget all stamps (e.g. on reconnect)
+    void reset();
+
+    /// Producer block stamp: BlockMeta host_time_ns / sample_counter
+    void addProducerStamp(uint64_t hostTimeNs, uint64_t sampleCounter);
+
+    /// Consumer progress: host time and frames consumed since connect
+    void addConsumerStamp(uint64_t hostTimeNs, uint64_t sampleCounter);
+
+    /// Producer device rate in Hz against the host clock, 0 until known
+    double producerRateHz() const { return producer_.rateHz; }
+
+    /// Consumer rate in Hz against the host clock, 0 until known
+    double consumerRateHz() const { return consumer_.rateHz; }
+
+    /// producerRateHz / consumerRateHz (> 1 = producer clock runs fast), 0 until both known
+    double ratio() const;
+
+private:
+    struct RateTracker {
+        uint64_t anchorNs = 0;
+        uint64_t anchorSamples = 0;
+        uint64_t lastNs = 0;
+        uint64_t lastSamples = 0;
+        bool hasAnchor = false;
+        double rateHz = 0.0;
+
+        void add(uint64_t hostTimeNs, uint64_t samples);
+    };
+
+    RateTracker producer_;
+    RateTracker consumer_;
+};
+
+} // namespace directpipe
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file Concealment.h
+ * @brief Consumer-side packet-loss concealment for short ring underruns
+ *
+ * A producer hiccup of a few milliseconds leaves the consumer without input
+ * for part of a block. Padding that with silence (or a short fade) is an
+ * audible dropout; PacketLossConcealer instead keeps playing a pitch-period
+ * loop of the most recent output, then fades it out if the gap persists.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace directpipe {
+
+/**
+ * @brief Pitch-synchronous waveform repeat over gaps up to kMaxConcealMs.
+ *
+ * Remembers the last 2 x kMaxPeriodMs of output. When a gap starts, the
+ * pitch period is found by normalized autocorrelation (coarse search on a
+ * ~8 kHz decimated mix, refined at full rate), and a whole number of periods
+ * from the end of the history is looped. The loop's tail is crossfaded with
+ * the audio one loop earlier so the wrap is seamless, and the first samples
+ * carry a decaying offset so the splice onto the last real sample is too.
+ * Material that is not periodic enough (correlation below kMinCorrelation)
+ * loops the longest period instead, which sounds less buzzy on noise.
+ *
+ * The loop plays at full level for kFullGainMs, ramps to silence at
+ * kMaxConcealMs, and stays silent after that. When input returns, the first
+ * kRecoveryMs crossfade from the loop (or from silence, after a long gap)
+ * into the real audio.
+ *
+ * prepare() allocates; everything else is RT-safe. Not thread-safe: feed
+ * and query from the consumer's RT thread.
+ */
+class PacketLossConcealer {
+public:
+    static constexpr uint32_t kMaxChannels = 2;
+    /// Shortest pitch period searched (ms) — 400 Hz
+    static constexpr double kMinPeriodMs = 2.5;
+    /// Longest pitch period searched (ms) — ~67 Hz; the history is twice this
+    static constexpr double kMaxPeriodMs = 15.0;
+    /// Loops are at least this long (ms), so short periods repeat as a group
+    static constexpr double kMinLoopMs = 5.0;
+    /// Gap time played at full level (ms)
+    static constexpr double kFullGainMs = 10.0;
+    /// Gap time after which the output is silent (ms)
+    static constexpr double kMaxConcealMs = 20.0;
+    /// Crossfade from the loop back into real audio (ms)
+    static constexpr double kRecoveryMs = 2.5;
+    /// Normalized correlation below which the signal is treated as unvoiced
+    static constexpr float kMinCorrelation = 0.3f;
+
+    /// Allocate the history and loop buffers for `sampleRate` and reset
+    void prepare(double sampleRate, uint32_t channels);
+
+    /// Forget the history and any gap in progress (e.g. on mute)
+    void reset();
+
+    /**
+     * @brief Run one output block through the concealer, in place.
+     * @param channelData  Planar output; channels beyond the prepared count are left alone.
+     * @param validFrames  Frames [0, validFrames) hold real audio; the rest is a gap.
+     * @param totalFrames  Block length. Frames [validFrames, totalFrames) are overwritten.
+     * @return Gap frames filled with audible concealment in this block.
+     */
+    uint32_t process(float* const* channelData, uint32_t numChannels,
+                     uint32_t validFrames, uint32_t totalFrames);
+
+    /// Gap frames filled with audible concealment since prepare()
+    uint64_t concealedFrames() const { return concealedFrames_; }
+
+    /// True while a gap is being concealed (until input returns)
+    bool concealing() const { return inGap_; }
+
+    /// Period the current (or last) gap loops, in frames (0 = nothing to repeat)
+    uint32_t pitchPeriod() const { return period_; }
+
+private:
+    void pushHistory(float* const* channelData, uint32_t channels, uint32_t offset, uint32_t frames);
+    void startGap();
+    uint32_t findPeriod(float& correlation);
+    float gainAt(uint32_t gapFrame) const;
+    float nextSample(uint32_t ch) const;
+    void advance();
+
+    std::vector<float> history_[kMaxChannels];   // historyFrames_, oldest first
+    std::vector<float> loop_[kMaxChannels];      // loopFrames_ used
+    std::vector<float> mono_;                    // channel mix of the history (pitch search)
+    std::vector<float> decimated_;               // mono_ averaged over decimation_ frames
+    uint32_t channels_ = 0;
+    uint32_t historyFrames_ = 0;
+    uint32_t historyFilled_ = 0;   // valid frames at the end of history_
+    uint32_t minLag_ = 0;
+    uint32_t maxLag_ = 0;
+    uint32_t decimation_ = 1;
+    uint32_t minLoopFrames_ = 0;
+    uint32_t fullGainFrames_ = 0;
+    uint32_t maxConcealFrames_ = 0;
+    uint32_t recoveryFrames_ = 0;
+
+    bool inGap_ = false;
+    bool silent_ = false;          // current gap has nothing to repeat
+    uint32_t gapFrame_ = 0;        // frames generated since the gap started
+    uint32_t loopFrames_ = 0;
+    uint32_t loopPos_ = 0;
+    uint32_t spliceFrames_ = 0;    // offset ramp length at the gap start
+    float spliceOffset_[kMaxChannels] = {};
+    uint32_t period_ = 0;
+    uint64_t concealedFrames_ = 0;
+};
+
+} // namespace directpipe
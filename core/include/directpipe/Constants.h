@@ -36,6 +36,13 @@ constexpr const char* SHM_NAME = "Local\\DirectPipeAudio";
 /// Name of the Named Event for data-ready signaling
 constexpr const char* EVENT_NAME = "Local\\DirectPipeDataReady";
 
+/// Name of the stream directory region (StreamRegistry). Lists every stream
+/// published on this machine; the main stream keeps SHM_NAME / EVENT_NAME.
+constexpr const char* REGISTRY_SHM_NAME = "Local\\DirectPipeRegistry";
+
+/// Stream id of the host's main (post-limiter) output
+constexpr const char* MAIN_STREAM_ID = "main";
+
 // ─── Default Audio Parameters ───────────────────────────────────
 /// Default ring buffer size in frames (must be power of 2)
 /// 16384 frames = ~341ms @48kHz — enough headroom for clock drift
@@ -57,6 +64,10 @@ constexpr uint32_t EVENT_TIMEOUT_MS = 500;
 /// Reconnection attempt interval in milliseconds
 constexpr uint32_t RECONNECT_INTERVAL_MS = 1000;
 
+/// A consumer that blocks the producer (buffer full on its cursor) without
+/// calling read() for this long is evicted from the consumer table
+constexpr uint32_t CONSUMER_STALL_TIMEOUT_MS = 250;
+
 // ─── Validation Helpers ─────────────────────────────────────────
 /// Check if a value is a power of 2
 constexpr bool isPowerOfTwo(uint32_t v) {
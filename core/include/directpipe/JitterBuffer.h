@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file JitterBuffer.h
+ * @brief Consumer-side automatic buffer sizing from measured arrival jitter
+ *
+ * A fixed target fill has to cover the worst gap between the host's writes
+ * and our reads (scheduler latency, host block size, bursty devices), which
+ * differs per machine. JitterBufferSizer measures that gap every block and
+ * picks the smallest target fill whose underrun rate stays within a budget.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace directpipe {
+
+/**
+ * @brief Picks a ring target fill from the per-block read deficit.
+ *
+ * Each consumer block reports its deficit: how far the ring level just before
+ * the read sat below its running average, plus the frames the read takes. A
+ * block underruns exactly when its deficit exceeds the target, so the target
+ * is the (1 - budget) quantile of recent deficits, plus one quantum of margin.
+ * Deficits go into a fixed-bin histogram that decays with kWindowSec.
+ *
+ * Asymmetric on purpose: an underrun raises the target at once (at least
+ * x kGrowFactor), a quantile above the target raises it on the next
+ * evaluation, but it only shrinks one quantum per kShrinkIntervalSec after
+ * kShrinkHoldSec without underruns.
+ *
+ * Not thread-safe: feed and query from the consumer's RT thread. No allocation.
+ */
+class JitterBufferSizer {
+public:
+    /// Target granularity and histogram bin width (frames)
+    static constexpr uint32_t kQuantum = 32;
+    /// Histogram range: deficits beyond kBins * kQuantum land in the last bin
+    static constexpr uint32_t kBins = 256;
+    /// Histogram memory (s); older blocks fade out
+    static constexpr double kWindowSec = 30.0;
+    /// How often the quantile is re-evaluated and the histogram decayed (s)
+    static constexpr double kEvaluateIntervalSec = 0.25;
+    /// Minimum target growth on an underrun
+    static constexpr double kGrowFactor = 1.5;
+    /// Underrun-free time before the target may shrink (s)
+    static constexpr double kShrinkHoldSec = 10.0;
+    /// Time between one-quantum shrink steps (s)
+    static constexpr double kShrinkIntervalSec = 2.0;
+
+    struct Config {
+        uint32_t minTarget = 128;        ///< Frames
+        uint32_t maxTarget = 4096;       ///< Frames (the "Safe" preset)
+        uint32_t initialTarget = 512;    ///< Frames, before anything is measured
+        double underrunBudget = 1e-4;    ///< Tolerated fraction of blocks that underrun (1e-4 ~ one a minute at 256/48k)
+    };
+
+    /// Apply `config` and forget all history; the target returns to initialTarget
+    void reset(const Config& config);
+
+    /// Forget history but keep the config (e.g. on reconnect)
+    void reset();
+
+    /// Change the budget without dropping history
+    void setUnderrunBudget(double budget);
+
+    /**
+     * @brief Record one consumer block (underrunning blocks too, before onUnderrun()).
+     * @param deficitFrames Ring frames the level dipped below its average, plus the read size.
+     * @param elapsedSec    Time this block covers (blockFrames / consumer rate).
+     * @return true if the target changed.
+     */
+    bool observe(double deficitFrames, double elapsedSec);
+
+    /**
+     * @brief Record an underrun (a read came up short).
+     * @return true if the target grew — the caller should rebuffer to it.
+     */
+    bool onUnderrun();
+
+    /// Current target fill (frames)
+    uint32_t target() const { return target_; }
+
+    /// Target the histogram alone asks for (frames; 0 until enough blocks seen)
+    uint32_t measuredTarget() const { return measured_; }
+
+    /// Underruns since the last reset
+    uint32_t underruns() const { return underruns_; }
+
+    const Config& config() const { return config_; }
+
+private:
+    void evaluate();
+    uint32_t clampTarget(double frames) const;
+
+    Config config_;
+    float bins_[kBins] = {};
+    double totalWeight_ = 0.0;
+    double sinceEvaluate_ = 0.0;    // s
+    double sinceUnderrun_ = 0.0;    // s
+    double sinceShrink_ = 0.0;      // s
+    uint32_t target_ = 512;
+    uint32_t measured_ = 0;
+    uint32_t underruns_ = 0;
+};
+
+} // namespace directpipe
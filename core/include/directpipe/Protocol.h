@@ -32,26 +32,283 @@
 namespace directpipe {
 
 /// Protocol version — increment when header layout changes
-constexpr uint32_t PROTOCOL_VERSION = 1;
+/// v2: per-consumer cursor table (multi-consumer broadcast), consumer_active removed,
+///     sample_format (0 = float32, so zeroed reserved bytes read as the old layout)
+/// v3: per-block timestamp side channel (block_meta ring) after the cursor table,
+///     per-consumer measured latency (ConsumerSlot::latency_us)
+/// v4: sample_layout (0 = interleaved; planar rings keep one ring per channel)
+/// v5: overrun_policy, oldest_pos and last_block_pos next to write_pos
+///     (overwrite-oldest rings; consumers must check oldest_pos after copying)
+/// v6: per-consumer telemetry table (consumer_stats) after the block_meta ring
+constexpr uint32_t PROTOCOL_VERSION = 6;
 
 /**
- * @brief Shared memory header placed at the start of the mapped region.
+ * @brief Sample encoding of the interleaved PCM in the ring.
  *
- * Layout:
- *   [Header (64-byte aligned fields)] [Ring buffer PCM data]
+ * Float32 is the default and the only format the host used before v2.
+ * The compact formats trade precision for shared-memory bandwidth and
+ * cache footprint (Int16 halves both).
+ */
+enum class SampleFormat : uint32_t {
+    Float32 = 0,  ///< 32-bit IEEE float, [-1, 1]
+    Int16   = 1,  ///< 16-bit signed little-endian, full scale 32767
+    Int24   = 2,  ///< 24-bit signed little-endian, packed in 3 bytes, full scale 8388607
+    Float16 = 3,  ///< IEEE 754 binary16 (half precision)
+};
+
+/**
+ * @brief Arrangement of the PCM channels in the ring.
+ *
+ * Interleaved: one ring of frames [L0 R0 L1 R1 ...].
+ * Planar: one contiguous ring per channel, channel c starting at
+ * c * buffer_frames * bytesPerSample(format) into the PCM area. Both ends of
+ * the IPC hold planar audio (JUCE AudioBuffer), so a planar ring is a straight
+ * per-channel copy on each side. Same total size as interleaved.
+ */
+enum class SampleLayout : uint32_t {
+    Interleaved = 0,
+    Planar      = 1,
+};
+
+/// Check a raw header value before casting it to SampleLayout
+constexpr bool isValidSampleLayout(uint32_t raw) {
+    return raw <= static_cast<uint32_t>(SampleLayout::Planar);
+}
+
+/**
+ * @brief What the producer does when the slowest consumer has not freed
+ * enough space for a block.
  *
- * write_pos and read_pos are on separate cache lines to prevent
- * false sharing between producer and consumer.
+ * DropNewest: the write is cut short and the rest of the block is lost; the
+ * ring keeps the oldest unread audio (v4 behaviour).
+ * OverwriteOldest: the whole block is written and the oldest frames are
+ * recycled. The producer advances oldest_pos before touching them, so a
+ * consumer that falls behind it (lapped) resumes at the newest block.
  */
+enum class OverrunPolicy : uint32_t {
+    DropNewest      = 0,
+    OverwriteOldest = 1,
+};
+
+/// Number of SampleFormat values (for validation and bitmasks)
+constexpr uint32_t SAMPLE_FORMAT_COUNT = 4;
+
+/// Bit for `format` in a ConsumerSlot::accepted_formats mask
+constexpr uint32_t sampleFormatBit(SampleFormat format) {
+    return 1u << static_cast<uint32_t>(format);
+}
+
+/// Mask accepting every SampleFormat
+constexpr uint32_t ALL_SAMPLE_FORMATS = (1u << SAMPLE_FORMAT_COUNT) - 1;
+
+/// Check a raw header value before casting it to SampleFormat
+constexpr bool isValidSampleFormat(uint32_t raw) {
+    return raw < SAMPLE_FORMAT_COUNT;
+}
+
+/// Bytes per sample for a format
+constexpr uint32_t bytesPerSample(SampleFormat format) {
+    return format == SampleFormat::Int16   ? 2u
+         : format == SampleFormat::Int24   ? 3u
+         : format == SampleFormat::Float16 ? 2u
+         : 4u;
+}
+
+/// Maximum number of consumers (Receiver instances) that can read one buffer
+/// concurrently. Each consumer owns one ConsumerSlot in the header.
+constexpr uint32_t MAX_CONSUMERS = 8;
+
+/// ConsumerSlot::owner value while a consumer is initialising its cursor.
+/// The producer ignores slots in this state.
+constexpr uint64_t CONSUMER_SLOT_CLAIMING = ~0ULL;
+
+/// Number of entries in the per-block metadata ring (power of 2).
+/// 64 blocks cover >= 64 ms of audio at the smallest supported buffer size.
+constexpr uint32_t BLOCK_META_CAPACITY = 64;
+
+/// Number of bins in ConsumerStats::fill_histogram (see fillHistogramBin)
+constexpr uint32_t FILL_HISTOGRAM_BINS = 16;
+
+/// Fill-level histogram bin for `frames` buffered: bin 0 is [0, 64), bin b
+/// is [2^(b+5), 2^(b+6)) frames, the last bin is open-ended
+constexpr uint32_t fillHistogramBin(uint32_t frames) {
+    uint32_t bin = 0;
+    for (uint32_t edge = 64; bin < FILL_HISTOGRAM_BINS - 1 && frames >= edge; edge <<= 1)
+        ++bin;
+    return bin;
+}
+
+/// Lowest fill level (frames) that lands in histogram bin `bin`
+constexpr uint32_t fillHistogramBinFloor(uint32_t bin) {
+    return bin == 0 ? 0u : 32u << bin;
+}
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4324) // structure was padded due to alignment specifier
 #endif
+
+/**
+ * @brief Per-consumer read cursor, one cache line each.
+ *
+ * owner == 0 means the slot is free. A consumer claims a slot by CAS'ing
+ * owner 0 -> CONSUMER_SLOT_CLAIMING, initialising read_pos, then publishing
+ * its unique claim token (from DirectPipeHeader::next_consumer_token).
+ * The producer evicts a stalled consumer by CAS'ing its token back to 0;
+ * the consumer notices the token mismatch on its next read and re-claims.
+ */
+struct ConsumerSlot {
+    /// Read position in frames (owning consumer increments)
+    alignas(64) std::atomic<uint64_t> read_pos{0};
+
+    /// 0 = free, CONSUMER_SLOT_CLAIMING = being claimed, otherwise claim token
+    std::atomic<uint64_t> owner{0};
+
+    /// Bumped by the owning consumer on every read() — lets the producer
+    /// tell a stalled consumer from one that simply has nothing to read
+    std::atomic<uint64_t> heartbeat{0};
+
+    /// SampleFormat bitmask the owning consumer can decode, published before
+    /// owner. The producer reads the AND over live slots to pick a format.
+    std::atomic<uint32_t> accepted_formats{0};
+
+    /// End-to-end IPC latency measured by the owning consumer in microseconds
+    /// (producer block timestamp -> consumer read), 0 = not measured yet
+    std::atomic<uint32_t> latency_us{0};
+
+    uint8_t reserved[64 - 3 * sizeof(std::atomic<uint64_t>) - 2 * sizeof(std::atomic<uint32_t>)]{};
+};
+
+/**
+ * @brief Timing metadata for one producer block (side channel to the PCM ring).
+ *
+ * Written by the producer under a per-entry seqlock: seq is odd while the
+ * entry is being rewritten. Every field is atomic so concurrent readers are
+ * well-defined; readers retry when seq changed across their copy.
+ *
+ * host_time_ns uses the system-wide monotonic clock (std::chrono::steady_clock:
+ * CLOCK_MONOTONIC / QueryPerformanceCounter / mach_absolute_time), so producer
+ * and consumer timestamps are directly comparable across processes.
+ */
+struct BlockMeta {
+    /// Seqlock sequence (odd = write in progress)
+    std::atomic<uint32_t> seq{0};
+
+    /// Number of frames of this block that were written to the ring
+    std::atomic<uint32_t> frames{0};
+
+    /// Ring stream position (write_pos) of the block's first frame
+    std::atomic<uint64_t> stream_pos{0};
+
+    /// Monotonic host time of the producer's audio callback for this block (ns)
+    std::atomic<uint64_t> host_time_ns{0};
+
+    /// Producer device sample counter at the block's first frame. Counts every
+    /// frame the device delivered, including frames dropped on overrun.
+    std::atomic<uint64_t> sample_counter{0};
+};
+
+/**
+ * @brief Telemetry published by one consumer, indexed like the cursor table.
+ *
+ * Only the consumer owning the matching ConsumerSlot writes it (relaxed
+ * stores, once per audio block); the producer reads it for display, so a
+ * snapshot may mix fields from two neighbouring blocks. Counters are the
+ * consumer's running totals and never go backwards while it stays attached.
+ * Zeroed when the slot is claimed.
+ */
+struct ConsumerStats {
+    /// Audio blocks the consumer rendered while connected
+    alignas(64) std::atomic<uint64_t> blocks{0};
+
+    /// Output frames the ring could not supply (concealed, faded or silent)
+    std::atomic<uint64_t> frames_padded{0};
+
+    /// Ring frames skipped without being played (stall recovery)
+    std::atomic<uint64_t> frames_skipped{0};
+
+    /// Padded frames covered by audible concealment (waveform repeat)
+    std::atomic<uint64_t> frames_concealed{0};
+
+    /// Blocks whose read came up short
+    std::atomic<uint32_t> underruns{0};
+
+    /// Ring frames buffered for this consumer at the start of its last block
+    std::atomic<uint32_t> fill_frames{0};
+
+    /// Current read ratio (ring frames per output frame) x 1e6, 0 = unknown
+    std::atomic<uint32_t> resample_ratio_micros{0};
+
+    /// Consumer's own processing time per block (ns, smoothed)
+    std::atomic<uint32_t> process_ns{0};
+
+    /// Longest processing time of one block since attach (ns)
+    std::atomic<uint32_t> process_peak_ns{0};
+
+    /// Blocks by fill level at block start (see fillHistogramBin)
+    std::atomic<uint32_t> fill_histogram[FILL_HISTOGRAM_BINS]{};
+
+    uint8_t reserved[128 - 4 * sizeof(std::atomic<uint64_t>) - 5 * sizeof(std::atomic<uint32_t>)
+                     - FILL_HISTOGRAM_BINS * sizeof(std::atomic<uint32_t>)]{};
+};
+
+/// Plain copy of a ConsumerStats entry (plus the slot's latency), as
+/// returned by RingBuffer::readConsumerStats or passed to publishConsumerStats
+struct ConsumerStatsSnapshot {
+    uint32_t slot = 0;               ///< Cursor table index (filled in by the reader)
+    uint32_t latency_us = 0;         ///< ConsumerSlot::latency_us (filled in by the reader)
+    uint64_t blocks = 0;
+    uint64_t frames_padded = 0;
+    uint64_t frames_skipped = 0;
+    uint64_t frames_concealed = 0;
+    uint32_t underruns = 0;
+    uint32_t fill_frames = 0;
+    uint32_t resample_ratio_micros = 0;
+    uint32_t process_ns = 0;
+    uint32_t process_peak_ns = 0;
+    uint32_t fill_histogram[FILL_HISTOGRAM_BINS] = {};
+};
+
+/// Plain copy of a BlockMeta entry, as returned by RingBuffer readers
+struct BlockMetaSnapshot {
+    uint64_t stream_pos = 0;
+    uint64_t host_time_ns = 0;
+    uint64_t sample_counter = 0;
+    uint32_t frames = 0;
+};
+
+/**
+ * @brief Shared memory header placed at the start of the mapped region.
+ *
+ * Layout:
+ *   [Header (64-byte aligned fields)] [Consumer cursor table] [Block metadata ring]
+ *   [Ring buffer PCM data]
+ *
+ * write_pos, read_pos and every consumer cursor are on separate cache lines
+ * to prevent false sharing between the producer and each consumer.
+ */
 struct DirectPipeHeader {
     /// Write position in frames (producer increments)
     alignas(64) std::atomic<uint64_t> write_pos{0};
 
-    /// Read position in frames (consumer increments)
+    /// Oldest stream position whose frames are still intact. The producer
+    /// raises it (then a release fence) before it starts overwriting a frame,
+    /// so it only grows and acts as the overwrite sequence counter: a consumer
+    /// that finds oldest_pos above the start of the region it just copied
+    /// (after an acquire fence) had a torn read and must discard it.
+    std::atomic<uint64_t> oldest_pos{0};
+
+    /// Stream position of the first frame of the newest committed block —
+    /// where a lapped consumer resumes (producer stores before write_pos)
+    std::atomic<uint64_t> last_block_pos{0};
+
+    /// OverrunPolicy value (producer may change it at any time)
+    std::atomic<uint32_t> overrun_policy{0};
+
+    /// Retention tail in frames: the slowest live consumer cursor, published by
+    /// the producer on every write. Frames in [read_pos, write_pos) are still
+    /// readable; a newly attached consumer starts here. When no consumer is
+    /// attached it stays put, so data written in the meantime is retained.
     alignas(64) std::atomic<uint64_t> read_pos{0};
 
     /// Audio sample rate (e.g., 48000)
@@ -66,20 +323,46 @@ struct DirectPipeHeader {
     /// Protocol version for compatibility checking
     uint32_t version{PROTOCOL_VERSION};
 
+    /// Sample encoding of the ring data (SampleFormat value, 0 = Float32)
+    uint32_t sample_format{0};
+
+    /// Channel arrangement of the ring data (SampleLayout value, 0 = Interleaved)
+    uint32_t sample_layout{0};
+
     /// Whether the producer (JUCE host) is actively writing
     std::atomic<bool> producer_active{false};
 
-    /// Whether a consumer (Receiver VST) is currently attached and reading.
-    /// SPSC design: only one consumer is supported. If a second consumer attaches
-    /// while this is true, it should warn the user (data will be corrupted with
-    /// two readers advancing the same read_pos).
-    /// Set to true by RingBuffer::attachAsConsumer(), false by detach().
-    /// PROTOCOL_VERSION remains 1 — old consumers ignore this field (it was in
-    /// the previously unused reserved area of cache line 1).
-    std::atomic<bool> consumer_active{false};
-
-    /// Reserved padding for cache line 1 (keeps sizeof(DirectPipeHeader) == 192)
-    uint8_t reserved[64 - 2 * sizeof(std::atomic<bool>) - 4 * sizeof(uint32_t)]{};
+    /// Reserved padding for cache line 1
+    uint8_t reserved[64 - sizeof(std::atomic<uint64_t>) - sizeof(std::atomic<bool>)
+                     - 6 * sizeof(uint32_t)]{};
+
+    /// Source of unique consumer claim tokens (fetch_add by attaching consumers)
+    alignas(64) std::atomic<uint64_t> next_consumer_token{1};
+
+    /// Data-ready sequence, bumped by the producer on every signal. On Linux this
+    /// is the futex word NamedEvent waits on (see NamedEvent::bindSharedWord).
+    std::atomic<uint32_t> data_seq{0};
+
+    /// Number of consumers currently parked on data_seq. The producer only
+    /// enters the kernel (FUTEX_WAKE) when this is non-zero.
+    std::atomic<uint32_t> consumer_waiting{0};
+
+    /// Reserved padding for cache line 2
+    uint8_t reserved2[64 - sizeof(std::atomic<uint64_t>) - 2 * sizeof(std::atomic<uint32_t>)]{};
+
+    /// Per-consumer read cursors (cache lines 3 .. 3 + MAX_CONSUMERS - 1)
+    ConsumerSlot consumers[MAX_CONSUMERS];
+
+    /// Number of BlockMeta entries ever published; entry n lives at
+    /// block_meta[n & (BLOCK_META_CAPACITY - 1)]. Producer increments.
+    alignas(64) std::atomic<uint64_t> block_meta_head{0};
+
+    /// Per-block timestamp side channel (producer writes, consumers read)
+    alignas(64) BlockMeta block_meta[BLOCK_META_CAPACITY];
+
+    /// Per-consumer telemetry, indexed like `consumers` (consumers write,
+    /// producer reads for display)
+    ConsumerStats consumer_stats[MAX_CONSUMERS];
 };
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -88,6 +371,10 @@ struct DirectPipeHeader {
 // Atomics must be lock-free for cross-process shared memory (no hidden mutexes)
 static_assert(std::atomic<uint64_t>::is_always_lock_free,
               "std::atomic<uint64_t> must be lock-free for IPC");
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "std::atomic<uint32_t> must be lock-free for IPC");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "std::atomic<uint32_t> must be a plain 32-bit word (used as a futex)");
 static_assert(std::atomic<bool>::is_always_lock_free,
               "std::atomic<bool> must be lock-free for IPC");
 
@@ -95,22 +382,96 @@ static_assert(std::atomic<bool>::is_always_lock_free,
 static_assert(alignof(DirectPipeHeader) >= 64,
               "DirectPipeHeader must be at least 64-byte aligned");
 
-// Ensure header size is consistent across compilers (3 x 64-byte cache lines = 192 bytes).
-// Cache line 0: write_pos. Cache line 1: read_pos + config + producer_active + consumer_active.
-// Cache line 2: trailing padding/future use.
-// consumer_active was added in the reserved area of cache line 1 (no size change).
-// PROTOCOL_VERSION stays at 1 — old consumers ignore the new field.
-static_assert(sizeof(DirectPipeHeader) == 192,
+static_assert(sizeof(ConsumerSlot) == 64,
+              "ConsumerSlot must occupy exactly one cache line");
+
+static_assert(sizeof(BlockMeta) == 32,
+              "BlockMeta must be 32 bytes (two entries per cache line)");
+
+static_assert(sizeof(ConsumerStats) == 128,
+              "ConsumerStats must occupy exactly two cache lines");
+
+static_assert((BLOCK_META_CAPACITY & (BLOCK_META_CAPACITY - 1)) == 0,
+              "BLOCK_META_CAPACITY must be a power of 2");
+
+// Ensure header size is consistent across compilers.
+// Cache line 0: write_pos + overwrite bookkeeping (oldest_pos, last_block_pos,
+// overrun_policy — same writer, read together). Cache line 1: read_pos + config + producer_active.
+// Cache line 2: next_consumer_token + data_seq/consumer_waiting (wake word).
+// Cache lines 3-10: consumer cursor table.
+// Cache line 11: block_meta_head. Then the block metadata ring, then the
+// consumer telemetry table (two cache lines per consumer).
+static_assert(sizeof(DirectPipeHeader) == 192 + MAX_CONSUMERS * 64 + 64
+                                          + BLOCK_META_CAPACITY * sizeof(BlockMeta)
+                                          + MAX_CONSUMERS * sizeof(ConsumerStats),
               "DirectPipeHeader size changed — update PROTOCOL_VERSION if layout changed");
 
+// ─── Stream Directory ───────────────────────────────────────────
+
+/// Stream directory layout version (StreamDirectory::version)
+constexpr uint32_t REGISTRY_VERSION = 1;
+
+/// Maximum number of streams listed in the directory
+constexpr uint32_t MAX_STREAMS = 16;
+
+/// Fixed text field sizes in a StreamEntry (including the terminating NUL)
+constexpr size_t STREAM_ID_LEN = 32;
+constexpr size_t STREAM_DESC_LEN = 80;
+constexpr size_t STREAM_NAME_LEN = 64;
+
+/// StreamEntry::state values
+constexpr uint32_t STREAM_ENTRY_FREE = 0;
+constexpr uint32_t STREAM_ENTRY_CLAIMED = 1;  ///< A producer is (re)writing the entry
+constexpr uint32_t STREAM_ENTRY_ACTIVE = 2;
+
+/**
+ * @brief One published stream in the directory.
+ *
+ * A producer claims an entry (CAS state FREE/ACTIVE -> CLAIMED), rewrites it
+ * under the seq seqlock (odd = write in progress) and then marks it ACTIVE.
+ * Text fields are only written while the entry is claimed; readers copy them
+ * and retry when seq changed across the copy.
+ */
+struct alignas(64) StreamEntry {
+    std::atomic<uint32_t> state{STREAM_ENTRY_FREE};
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> channels{0};
+    std::atomic<uint32_t> sample_rate{0};
+
+    char id[STREAM_ID_LEN];                ///< Stable key, e.g. "main", "input"
+    char description[STREAM_DESC_LEN];     ///< Human-readable label for selectors
+    char shm_name[STREAM_NAME_LEN];        ///< Shared memory region of the stream's ring
+    char event_name[STREAM_NAME_LEN];      ///< Data-ready NamedEvent of the stream
+};
+
+/**
+ * @brief Directory of the IPC streams published on this machine
+ * (REGISTRY_SHM_NAME). A zero-filled region is an empty directory; the first
+ * producer to open it stamps `version`.
+ */
+struct StreamDirectory {
+    alignas(64) std::atomic<uint32_t> version{0};
+    uint32_t reserved[15]{};
+
+    StreamEntry streams[MAX_STREAMS];
+};
+
+static_assert(sizeof(StreamEntry) == 256,
+              "StreamEntry must be 256 bytes — update REGISTRY_VERSION if layout changed");
+static_assert(sizeof(StreamDirectory) == 64 + MAX_STREAMS * sizeof(StreamEntry),
+              "StreamDirectory size changed — update REGISTRY_VERSION if layout changed");
+
 /**
  * @brief Calculate the total shared memory size needed.
  * @param buffer_frames Number of frames in the ring buffer (power of 2).
  * @param channels Number of audio channels.
+ * @param format Sample encoding of the ring data.
  * @return Total bytes needed for header + ring buffer data.
  */
-constexpr size_t calculateSharedMemorySize(uint32_t buffer_frames, uint32_t channels) {
-    return sizeof(DirectPipeHeader) + (static_cast<size_t>(buffer_frames) * channels * sizeof(float));
+constexpr size_t calculateSharedMemorySize(uint32_t buffer_frames, uint32_t channels,
+                                           SampleFormat format = SampleFormat::Float32) {
+    return sizeof(DirectPipeHeader)
+         + (static_cast<size_t>(buffer_frames) * channels * bytesPerSample(format));
 }
 
 } // namespace directpipe
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file Resampler.h
+ * @brief Consumer-side sample-rate conversion and clock drift compensation
+ *
+ * The Receiver's DAW may run at a different nominal rate than the host
+ * (44.1 vs 48 vs 96 kHz), and even at the same nominal rate the two audio
+ * clocks drift, so the ring fill level slowly moves. The consumer reads
+ * through one AdaptiveResampler stage whose ratio is the nominal rate ratio
+ * times a drift correction FillLevelController steers (PI loop on the fill
+ * level, bounded to +/-kMaxCorrectionPpm).
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace directpipe {
+
+/**
+ * @brief PI loop from ring fill level to a read ratio (input frames per output frame).
+ *
+ * The fill level is low-pass filtered (the raw value saw-tooths by a producer
+ * block on every write) and the loop is critically damped at
+ * kLoopBandwidthRad, so a typical 100 ppm clock offset moves the fill by only
+ * a few frames before the integrator absorbs it. Anti-windup: the integrator
+ * is clamped to the correction bound.
+ *
+ * Not thread-safe: feed and query from the consumer's RT thread. No allocation.
+ */
+class FillLevelController {
+public:
+    /// Largest correction applied either way (1000 ppm = 1.7 cents, inaudible)
+    static constexpr double kMaxCorrectionPpm = 1000.0;
+    /// Loop natural frequency (rad/s); settles in ~20 s
+    static constexpr double kLoopBandwidthRad = 0.2;
+    /// Fill-level smoothing time constant (s)
+    static constexpr double kFillSmoothingSec = 0.5;
+
+    /// Set the consumer sample rate and reset the loop
+    void prepare(double sampleRate);
+
+    /// Forget the loop state (e.g. on reconnect); ratio returns to 1.0
+    void reset();
+
+    /**
+     * @brief Feed the fill level seen before reading one block.
+     * @param fillFrames   Frames available in the ring.
+     * @param targetFrames Desired fill level.
+     * @param blockFrames  Output frames rendered per call (loop time step).
+     * @return The new read ratio, 1 +/- kMaxCorrectionPpm * 1e-6.
+     */
+    double update(double fillFrames, double targetFrames, uint32_t blockFrames);
+
+    /// Current read ratio (> 1 = reading faster than real time to drain the ring)
+    double ratio() const { return ratio_; }
+
+    /// Current correction in ppm
+    double correctionPpm() const { return (ratio_ - 1.0) * 1e6; }
+
+    /// Low-pass filtered fill level (frames), negative until the first update
+    double smoothedFill() const { return smoothedFill_; }
+
+private:
+    double sampleRate_ = 48000.0;
+    double smoothedFill_ = -1.0;
+    double integral_ = 0.0;   // frame-seconds, clamped so its term stays within the bound
+    double ratio_ = 1.0;
+};
+
+/// Interpolation kernel of AdaptiveResampler (quality / CPU trade-off)
+enum class ResamplerQuality : uint32_t {
+    Cubic  = 0,  ///< 4-point Hermite, no anti-aliasing — drift correction only, lowest CPU
+    Sinc16 = 1,  ///< 16-tap Kaiser-windowed sinc (~60 dB image rejection)
+    Sinc32 = 2,  ///< 32-tap (~80 dB), flat to ~18 kHz at 48 kHz — default
+    Sinc64 = 3,  ///< 64-tap (~100 dB), flat to ~20 kHz
+};
+
+/**
+ * @brief Streaming polyphase resampler with a continuously variable ratio.
+ *
+ * Windowed-sinc kernels are tabulated at kPhases sub-sample offsets and
+ * linearly interpolated between neighbouring phases, so any ratio (fixed
+ * rate conversion times a slowly varying drift correction) is rendered
+ * without rebuilding the table. When downsampling, the kernel is stretched
+ * by the nominal ratio so its cutoff follows the output Nyquist frequency.
+ * ResamplerQuality::Cubic uses 4-point Hermite interpolation instead.
+ *
+ * Works on planar float audio. The caller unpacks new input straight into
+ * inputBuffer(), then process() renders output frames; the last historyFrames()
+ * input frames carry over to the next call, so block boundaries are seamless.
+ *
+ * Typical use per block:
+ *   const uint32_t need = rs.inputFramesFor(outFrames, ratio);
+ *   // ... write `need` frames to rs.inputBuffer(ch) for every channel ...
+ *   rs.process(need, out, outFrames, ratio);
+ *
+ * prepare() allocates. configure() does not allocate but computes the kernel
+ * table (up to ~(kPhases + 1) * 64 * stretch window evaluations) — call it
+ * when the rate pair or quality changes, not per block. The rest is RT-safe.
+ */
+class AdaptiveResampler {
+public:
+    static constexpr uint32_t kMaxChannels = 2;
+    /// Kernel table resolution (sub-sample offsets per input frame)
+    static constexpr uint32_t kPhases = 128;
+    /// Longest kernel at unity stretch (ResamplerQuality::Sinc64)
+    static constexpr uint32_t kMaxBaseTaps = 64;
+
+    /**
+     * @brief Allocate work buffers and the kernel table for the worst case,
+     * then configure(Cubic, 1.0).
+     * @param channels        1 or 2.
+     * @param maxOutputFrames Largest outFrames passed to process().
+     * @param maxRatio        Largest ratio passed to process() (also the
+     *                        largest nominal ratio configure() accepts).
+     */
+    void prepare(uint32_t channels, uint32_t maxOutputFrames, double maxRatio);
+
+    /**
+     * @brief Select the kernel for a nominal input/output rate ratio and reset.
+     * No allocation. `nominalRatio` is clamped to the prepared maxRatio.
+     */
+    void configure(ResamplerQuality quality, double nominalRatio);
+
+    /// Clear history and phase (e.g. on reconnect)
+    void reset();
+
+    ResamplerQuality quality() const { return quality_; }
+
+    /// Kernel length in input frames (4 for Cubic)
+    uint32_t taps() const { return taps_; }
+
+    /// Input frames kept from the previous call (= taps())
+    uint32_t historyFrames() const { return taps_; }
+
+    /// Input frames process() consumes for `outFrames` at `ratio`
+    uint32_t inputFramesFor(uint32_t outFrames, double ratio) const;
+
+    /// Largest output that `inFrames` new input frames can produce at `ratio`
+    uint32_t outputFramesFor(uint32_t inFrames, double ratio) const;
+
+    /// Largest output frame count accepted by process()
+    uint32_t maxOutputFrames() const { return maxOutputFrames_; }
+
+    /// Capacity of inputBuffer() in frames
+    uint32_t maxInputFrames() const { return maxInputFrames_; }
+
+    /// Where the caller writes new input for channel `ch` before process()
+    float* inputBuffer(uint32_t ch) { return work_[ch].data() + taps_; }
+
+    /**
+     * @brief Render `outFrames` output frames from `inFrames` new input frames.
+     * @param inFrames Must equal inputFramesFor(outFrames, ratio).
+     * @param out      `channels` output pointers; a nullptr entry skips that channel.
+     */
+    void process(uint32_t inFrames, float* const* out, uint32_t outFrames, double ratio);
+
+    /// Group delay in input frames (half the kernel plus the history offset)
+    double latencyFrames() const { return static_cast<double>(taps_ / 2 + 1); }
+
+    /**
+     * @brief latencyFrames() after prepare(.., maxRatio) and configure(quality, nominalRatio),
+     * without building a resampler (e.g. to report latency before connecting).
+     */
+    static double latencyFramesFor(ResamplerQuality quality, double nominalRatio, double maxRatio);
+
+private:
+    void processCubic(const float* x, float* dest, uint32_t outFrames, double ratio,
+                      uint32_t lastStart) const;
+    void processSinc(const float* x, float* dest, uint32_t outFrames, double ratio,
+                     uint32_t lastStart) const;
+    /// Kernel length configure() picks (before the maxTaps_ clamp)
+    static uint32_t tapsFor(ResamplerQuality quality, double nominalRatio, double maxStretch);
+
+    std::vector<float> work_[kMaxChannels];   // maxTaps_ history + maxInputFrames_
+    std::vector<float> table_;                // (kPhases + 1) rows of taps_ coefficients
+    ResamplerQuality quality_ = ResamplerQuality::Cubic;
+    uint32_t channels_ = 0;
+    uint32_t maxOutputFrames_ = 0;
+    uint32_t maxInputFrames_ = 0;
+    uint32_t maxTaps_ = 4;
+    double maxStretch_ = 1.0;
+    uint32_t taps_ = 4;
+    double phase_ = 0.0;   // Window start of the next output in work_ (fraction of frame 0), [0, 1)
+};
+
+} // namespace directpipe
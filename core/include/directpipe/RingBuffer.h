@@ -18,16 +18,22 @@
 
 /**
  * @file RingBuffer.h
- * @brief SPSC (Single Producer Single Consumer) lock-free ring buffer
+ * @brief Single-producer, multi-consumer broadcast lock-free ring buffer
  *
  * Designed to be placed directly in shared memory. Uses atomic operations
  * with acquire/release semantics for thread-safe communication between
- * the DirectPipe host (producer) and OBS plugin (consumer).
+ * the DirectPipe host (producer) and up to MAX_CONSUMERS Receiver instances
+ * (consumers). Every consumer owns its own read cursor and sees every frame;
+ * the producer's free space is bounded by the slowest live cursor, unless the
+ * ring is switched to OverrunPolicy::OverwriteOldest (latest wins).
  */
 #pragma once
 
+#include "Constants.h"
 #include "Protocol.h"
+#include "SampleConvert.h"
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -36,6 +42,52 @@ namespace directpipe {
 
 class RingBuffer {
 public:
+    /**
+     * @brief Writable window into the shared ring, split at the wrap point.
+     *
+     * bytes1 holds frames1 frames, bytes2 (the wrapped part at the start of
+     * the ring) holds frames2. bytes2 is nullptr when frames2 == 0.
+     * Samples are encoded in `format`; span1/span2 are the same addresses typed
+     * as float and are only set for SampleFormat::Float32 rings.
+     *
+     * Interleaved layout: bytes1/bytes2 hold interleaved frames, planeStride is 0.
+     * Planar layout: bytes1/bytes2 point at channel 0's samples; channel c's
+     * samples start planeStride * c bytes further (see packPlanes/unpackPlanes).
+     */
+    struct WriteRegion {
+        float* span1 = nullptr;
+        uint32_t frames1 = 0;
+        float* span2 = nullptr;
+        uint32_t frames2 = 0;
+        uint8_t* bytes1 = nullptr;
+        uint8_t* bytes2 = nullptr;
+        SampleFormat format = SampleFormat::Float32;
+        SampleLayout layout = SampleLayout::Interleaved;
+        size_t planeStride = 0;  ///< Bytes between channel planes (Planar only)
+        uint64_t position = 0;   ///< Stream position (write_pos) of the first frame
+
+        uint32_t frames() const { return frames1 + frames2; }
+    };
+
+    /**
+     * @brief Readable window into the shared ring, split at the wrap point.
+     * Same layout rules as WriteRegion.
+     */
+    struct ReadRegion {
+        const float* span1 = nullptr;
+        uint32_t frames1 = 0;
+        const float* span2 = nullptr;
+        uint32_t frames2 = 0;
+        const uint8_t* bytes1 = nullptr;
+        const uint8_t* bytes2 = nullptr;
+        SampleFormat format = SampleFormat::Float32;
+        SampleLayout layout = SampleLayout::Interleaved;
+        size_t planeStride = 0;  ///< Bytes between channel planes (Planar only)
+        uint64_t position = 0;   ///< Stream position of the first frame
+
+        uint32_t frames() const { return frames1 + frames2; }
+    };
+
     RingBuffer() = default;
     ~RingBuffer() = default;
 
@@ -48,43 +100,126 @@ public:
     /**
      * @brief Initialize the ring buffer over a pre-allocated memory region.
      *
-     * The memory region must be at least calculateSharedMemorySize() bytes.
-     * This is called by the producer (host) to set up the shared memory layout.
+     * The memory region must be at least calculateSharedMemorySize() bytes
+     * (for the same format). This is called by the producer (host) to set up
+     * the shared memory layout.
      *
      * @param memory Pointer to the shared memory region.
      * @param capacity_frames Ring buffer size in frames (must be power of 2).
      * @param channels Number of audio channels.
      * @param sample_rate Audio sample rate in Hz.
+     * @param format Sample encoding of the ring data (Float32 by default).
+     * @param layout Channel arrangement (Interleaved by default). Advertised in
+     *               the header; consumers follow it automatically.
      */
-    void initAsProducer(void* memory, uint32_t capacity_frames, uint32_t channels, uint32_t sample_rate);
+    void initAsProducer(void* memory, uint32_t capacity_frames, uint32_t channels, uint32_t sample_rate,
+                        SampleFormat format = SampleFormat::Float32,
+                        SampleLayout layout = SampleLayout::Interleaved);
 
     /**
      * @brief Attach to an existing ring buffer in shared memory.
      *
-     * Called by the consumer (OBS plugin) to connect to an already-initialized buffer.
-     * Sets consumer_active flag in the header. If another consumer is already active,
-     * attachment still succeeds but anotherConsumerWasActive() returns true (caller
-     * should warn the user — SPSC buffer cannot safely support two readers).
+     * Called by the consumer (Receiver plugin) to connect to an already-initialized
+     * buffer. Claims a free slot in the consumer cursor table; the new cursor starts
+     * at the retention tail (header read_pos), or at the live edge (write_pos) on an
+     * overwrite-oldest ring. Fails if all MAX_CONSUMERS slots are
+     * taken — consumerSlotsExhausted() then returns true.
+     *
+     * Format negotiation: the consumer passes the SampleFormat bitmask it can
+     * decode. It is published in the claimed slot so the producer can see what
+     * every attached consumer accepts (getConsumerFormatMask()). If the ring's
+     * format is not in the mask, attach fails and formatRejected() returns true.
      *
      * @param memory Pointer to the shared memory region.
      * @param mappedSizeBytes Mapped size in bytes (0 to skip size checks).
-     * @return true if the buffer is valid and version matches.
+     * @param acceptedFormats sampleFormatBit() mask of decodable formats.
+     * @return true if the buffer is valid, version and format match and a slot was claimed.
      */
-    bool attachAsConsumer(void* memory, size_t mappedSizeBytes = 0);
+    bool attachAsConsumer(void* memory, size_t mappedSizeBytes = 0,
+                          uint32_t acceptedFormats = ALL_SAMPLE_FORMATS);
 
     /**
-     * @brief Returns true if another consumer was already active when we attached.
-     * Use this to display a warning in the Receiver UI.
+     * @brief Returns true if the last attachAsConsumer() failed because every
+     * consumer slot was in use. Use this to display a warning in the Receiver UI.
      */
-    bool anotherConsumerWasActive() const { return anotherConsumerWasActive_; }
+    bool consumerSlotsExhausted() const { return consumerSlotsExhausted_; }
+
+    /**
+     * @brief Returns true if the last attachAsConsumer() failed because the
+     * ring's sample format was not in the consumer's accepted mask.
+     */
+    bool formatRejected() const { return formatRejected_; }
+
+    /**
+     * @brief [Producer] AND of the accepted_formats masks of all live consumers
+     * (ALL_SAMPLE_FORMATS when none is attached) — the formats the producer can
+     * switch to without locking any current consumer out.
+     */
+    uint32_t getConsumerFormatMask() const;
+
+    /**
+     * @brief [Producer] Dither used by write() when quantizing to Int16/Int24.
+     */
+    void setDitherMode(DitherMode mode) { ditherMode_ = mode; }
+
+    /**
+     * @brief [Producer] Choose between dropping new frames and overwriting the
+     * oldest ones when a consumer has not freed enough space (default DropNewest).
+     * Published in the header; takes effect from the next write.
+     */
+    void setOverrunPolicy(OverrunPolicy policy);
+
+    /**
+     * @brief Overrun policy advertised in the header.
+     */
+    OverrunPolicy getOverrunPolicy() const;
+
+    /**
+     * @brief [Producer] Frames recycled by OverwriteOldest before the slowest
+     * live consumer had read them.
+     */
+    uint64_t getOverwrittenFrames() const { return overwrittenFrames_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief [Consumer] Number of times the producer lapped this consumer
+     * (overwrite-oldest) and it resumed at the newest block.
+     */
+    uint32_t getLapCount() const { return lapCount_; }
+
+    /**
+     * @brief Number of consumers currently holding a slot (including this one).
+     */
+    uint32_t getConsumerCount() const;
+
+    /**
+     * @brief [Consumer] Number of times this consumer was evicted by the producer
+     * and re-claimed a slot at the current write position (audio gap).
+     */
+    uint32_t getEvictionCount() const { return evictionCount_; }
+
+    /**
+     * @brief [Producer] Number of stalled consumers evicted by this producer.
+     */
+    uint32_t getEvictedConsumerCount() const { return evictedConsumers_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief [Producer] Set how long a consumer may block the producer without
+     * reading before it is evicted (default CONSUMER_STALL_TIMEOUT_MS).
+     */
+    void setStallTimeoutMs(uint32_t ms) { stallTimeoutMs_ = ms; }
 
     /**
      * @brief Write audio frames into the ring buffer (producer side).
      *
      * Lock-free. Safe to call from the real-time audio thread.
-     * If the buffer is full, frames are dropped (overrun).
+     * Free space is bounded by the slowest live consumer. A consumer that keeps
+     * the buffer full without reading for longer than the stall timeout is
+     * evicted first; otherwise, if the buffer is full, frames are dropped (overrun).
+     * With OverrunPolicy::OverwriteOldest the oldest frames are recycled instead
+     * and up to getCapacity() frames are always written.
      *
-     * @param data Interleaved float PCM samples (frames × channels).
+     * @param data Interleaved float PCM samples (frames × channels), converted
+     *             to the ring's sample format and layout.
      * @param frames Number of frames to write.
      * @return Number of frames actually written.
      */
@@ -93,16 +228,119 @@ public:
     /**
      * @brief Read audio frames from the ring buffer (consumer side).
      *
-     * Lock-free. Returns 0 if no data is available (underrun).
+     * Lock-free. Returns 0 if no data is available (underrun) or if this
+     * object is not attached as a consumer. If the producer evicted this
+     * consumer, a fresh slot is claimed at the current write position and
+     * 0 is returned for this call. If the producer lapped this consumer, it
+     * resumes at the newest block; a copy torn by a concurrent overwrite is
+     * retried once from there.
      *
-     * @param data Output buffer for interleaved float PCM samples.
+     * @param data Output buffer for interleaved float PCM samples (decoded from
+     *             the ring's sample format and layout).
      * @param frames Maximum number of frames to read.
      * @return Number of frames actually read.
      */
     uint32_t read(float* data, uint32_t frames);
 
+    /**
+     * @brief Reserve up to `frames` frames of ring space for in-place writing
+     * (producer side, zero-copy).
+     *
+     * Fill the returned spans with interleaved samples directly in shared
+     * memory, then publish them with commitWrite(). Nothing is visible to
+     * consumers until commit. Same eviction/free-space rules as write().
+     * RT-safe. Only one reservation may be outstanding at a time.
+     *
+     * @return Reserved region (frames() may be less than requested, 0 if full).
+     */
+    WriteRegion beginWrite(uint32_t frames);
+
+    /**
+     * @brief Publish `frames` frames of the last beginWrite() reservation.
+     * Clamped to the reserved size; committing 0 abandons the reservation.
+     */
+    void commitWrite(uint32_t frames);
+
+    /**
+     * @brief Expose up to `frames` readable frames in place (consumer side,
+     * zero-copy).
+     *
+     * The returned spans point into shared memory and stay valid until
+     * commitRead(), unless an overwrite-oldest producer recycles them — check
+     * commitRead()'s result. Same heartbeat/eviction handling as read(). A
+     * cursor that fell behind oldest_pos (lapped) first moves to the newest block.
+     *
+     * @return Readable region (frames() may be less than requested, 0 on underrun).
+     */
+    ReadRegion beginRead(uint32_t frames);
+
+    /**
+     * @brief Release `frames` frames of the last beginRead() region back to the
+     * producer. Clamped to the region size. Committing without reading the
+     * spans is a cheap way to skip frames.
+     *
+     * @return false if an overwrite-oldest producer recycled part of the region
+     *         while it was being read: the copied samples may be torn and must be
+     *         discarded. The cursor is left in place; the next beginRead()
+     *         resumes at the newest block.
+     */
+    bool commitRead(uint32_t frames);
+
+    /**
+     * @brief [Producer] Publish timing metadata for a block in the side channel.
+     *
+     * Call after filling the block's frames and before commitWrite(), so a
+     * consumer that sees the frames also finds their metadata. Lock-free
+     * (per-entry seqlock); the oldest of BLOCK_META_CAPACITY entries is reused.
+     *
+     * @param streamPos Stream position of the block's first frame (WriteRegion::position).
+     * @param frames Frames of the block written to the ring.
+     * @param hostTimeNs Monotonic host time of the block (steadyClockNs()).
+     * @param sampleCounter Device sample counter at the block's first frame.
+     */
+    void publishBlockMeta(uint64_t streamPos, uint32_t frames,
+                          uint64_t hostTimeNs, uint64_t sampleCounter);
+
+    /**
+     * @brief Copy the most recently published block metadata.
+     * @return false if nothing was published yet (or the entry kept changing).
+     */
+    bool latestBlockMeta(BlockMetaSnapshot& out) const;
+
+    /**
+     * @brief Find the metadata of the block containing stream position `streamPos`
+     * (e.g. ReadRegion::position). Searches newest to oldest.
+     * @return false if the block has already been recycled or was never stamped.
+     */
+    bool findBlockMeta(uint64_t streamPos, BlockMetaSnapshot& out) const;
+
+    /**
+     * @brief [Consumer] Publish this consumer's measured end-to-end latency
+     * (microseconds) in its slot so the producer can report it.
+     */
+    void reportLatencyUs(uint32_t latencyUs);
+
+    /**
+     * @brief [Producer] Highest latency_us reported by a live consumer (0 if none).
+     */
+    uint32_t getMaxConsumerLatencyUs() const;
+
+    /**
+     * @brief [Consumer] Publish this consumer's telemetry in its ConsumerStats
+     * entry (slot and latency_us are ignored). Relaxed stores, no syscalls —
+     * meant to be called once per audio block.
+     */
+    void publishConsumerStats(const ConsumerStatsSnapshot& stats);
+
+    /**
+     * @brief [Producer] Copy the telemetry of every live consumer.
+     * @return Number of entries written to `out` (at most maxConsumers).
+     */
+    uint32_t readConsumerStats(ConsumerStatsSnapshot* out, uint32_t maxConsumers) const;
+
     /**
      * @brief Number of frames available for reading.
+     * Consumer: from this consumer's cursor. Producer: from the slowest cursor.
      */
     uint32_t availableRead() const;
 
@@ -112,8 +350,8 @@ public:
     uint32_t availableWrite() const;
 
     /**
-     * @brief Reset read and write positions to zero.
-     * Only safe when both producer and consumer are stopped.
+     * @brief Reset write, tail and all consumer positions to zero.
+     * Only safe when the producer and all consumers are stopped.
      */
     void reset();
 
@@ -132,6 +370,16 @@ public:
      */
     uint32_t getCapacity() const;
 
+    /**
+     * @brief Get the sample encoding of the ring data.
+     */
+    SampleFormat getSampleFormat() const;
+
+    /**
+     * @brief Get the channel arrangement of the ring data.
+     */
+    SampleLayout getSampleLayout() const;
+
     /**
      * @brief Check if the buffer has been initialized.
      */
@@ -140,26 +388,77 @@ public:
     /**
      * @brief Detach from the shared memory region.
      *
-     * Clears consumer_active flag in the header, then resets internal pointers
-     * to nullptr so isValid() returns false. Call this before closing the
+     * Releases this consumer's cursor slot (if still owned), then resets internal
+     * pointers to nullptr so isValid() returns false. Call this before closing the
      * underlying shared memory to prevent dangling pointer dereferences.
      */
     void detach() {
         detached_.store(true, std::memory_order_release);
-        if (header_)
-            header_->consumer_active.store(false, std::memory_order_release);
+        releaseConsumerSlot();
         header_ = nullptr;
         data_ = nullptr;
         mask_ = 0;
-        anotherConsumerWasActive_ = false;
+        frameBytes_ = 0;
+        strideBytes_ = 0;
+        planeStride_ = 0;
     }
 
 private:
+    /// Claim a free cursor slot starting at startPos. Returns false if the table is full.
+    bool claimConsumerSlot(uint64_t startPos);
+    void releaseConsumerSlot();
+
+    /// Slowest live consumer cursor, or the retention tail if none is attached
+    uint64_t slowestCursor(uint64_t write_pos) const;
+
+    /// [Producer] Evict consumers that block a write of `frames` and have not read
+    /// for longer than stallTimeoutMs_
+    void evictStalledConsumers(uint64_t write_pos, uint32_t frames);
+
+    /// Seqlock copy of one metadata entry; false if it was being rewritten
+    bool readBlockMeta(const BlockMeta& entry, BlockMetaSnapshot& out) const;
+
+    /// Producer-local stall bookkeeping per consumer slot (never shared)
+    struct StallTracker {
+        uint64_t owner = 0;
+        uint64_t heartbeat = 0;
+        std::chrono::steady_clock::time_point since{};
+        bool armed = false;
+    };
+
     DirectPipeHeader* header_ = nullptr;
-    float* data_ = nullptr;
+    uint8_t* data_ = nullptr;   // PCM area, encoded in header_->sample_format
     uint32_t mask_ = 0;  // capacity - 1 for power-of-2 modulo
-    bool anotherConsumerWasActive_ = false;  // true if consumer_active was already set on attach
+    uint32_t frameBytes_ = 0;   // channels * bytesPerSample(format)
+    uint32_t strideBytes_ = 0;  // bytes per frame index within a segment (frameBytes_, or one sample if planar)
+    size_t planeStride_ = 0;    // bytes between channel planes (0 = interleaved)
+    SampleFormat format_ = SampleFormat::Float32;
+    SampleLayout layout_ = SampleLayout::Interleaved;
     std::atomic<bool> detached_{false};  // [Any thread] Set before nulling pointers in detach()
+
+    // Consumer side [consumer thread only]
+    int consumerSlot_ = -1;             // index into header_->consumers, -1 = not a consumer
+    uint64_t pendingSlotPos_ = 0;       // slot cursor observed by beginRead (CAS expected value)
+    uint64_t pendingReadPos_ = 0;       // start of the beginRead region (after overrun clamp)
+    uint32_t pendingReadFrames_ = 0;
+    uint64_t consumerToken_ = 0;        // claim token we published in our slot
+    uint64_t heartbeat_ = 0;            // local copy of our slot's heartbeat
+    uint32_t evictionCount_ = 0;
+    uint32_t lapCount_ = 0;
+    uint32_t acceptedFormats_ = ALL_SAMPLE_FORMATS;  // published in our slot on every claim
+    bool consumerSlotsExhausted_ = false;  // true if the last attach found no free slot
+    bool formatRejected_ = false;          // true if the last attach could not decode the format
+
+    // Producer side [producer thread only, except evictedConsumers_/overwrittenFrames_]
+    uint64_t pendingWritePos_ = 0;      // write_pos at beginWrite
+    uint32_t pendingWriteFrames_ = 0;
+    StallTracker stall_[MAX_CONSUMERS];
+    uint32_t stallTimeoutMs_ = CONSUMER_STALL_TIMEOUT_MS;
+    DitherMode ditherMode_ = DitherMode::None;
+    OverrunPolicy overrunPolicy_ = OverrunPolicy::DropNewest;
+    DitherState ditherState_;
+    std::atomic<uint32_t> evictedConsumers_{0};  // [Producer write, Any read]
+    std::atomic<uint64_t> overwrittenFrames_{0}; // [Producer write, Any read]
 };
 
 } // namespace directpipe
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file SampleConvert.h
+ * @brief float <-> SampleFormat conversion kernels for the IPC ring
+ *
+ * Used by the producer to pack float audio into a compact ring format
+ * (int16 / packed int24 / fp16) and by consumers to unpack it again.
+ * All functions are RT-safe: no allocation, no locks, no syscalls.
+ * Int16 mono/stereo paths use SSE2 where available; the rest are scalar
+ * loops the compiler can vectorize.
+ */
+#pragma once
+
+#include "Protocol.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace directpipe {
+
+/// Dither applied when quantizing float to an integer format
+enum class DitherMode : uint32_t {
+    None = 0,  ///< Plain round-to-nearest
+    Tpdf = 1,  ///< Triangular PDF, +/-1 LSB peak (decorrelates quantization error)
+};
+
+/// Per-producer dither noise generator state (xorshift32, never zero)
+struct DitherState {
+    uint32_t rng = 0x9E3779B9u;
+};
+
+/**
+ * @brief Convert `count` contiguous float samples into `format` at `dest`.
+ * Float32 is a plain copy; dither is ignored for Float32 and Float16.
+ */
+void packSamples(SampleFormat format, const float* src, size_t count, void* dest,
+                 DitherMode dither, DitherState& state);
+
+/**
+ * @brief Convert `count` contiguous `format` samples at `src` into float.
+ */
+void unpackSamples(SampleFormat format, const void* src, size_t count, float* dest);
+
+/**
+ * @brief Interleave planar float channels into `format` frames at `dest`.
+ * @param src Array of `channels` (1 or 2) channel pointers.
+ */
+void packInterleaved(SampleFormat format, const float* const* src, uint32_t channels,
+                     uint32_t frames, void* dest, DitherMode dither, DitherState& state);
+
+/**
+ * @brief De-interleave `format` frames at `src` into planar float channels.
+ * @param dest Array of `channels` (1 or 2) channel pointers; a nullptr entry
+ *             skips that channel.
+ */
+void unpackInterleaved(SampleFormat format, const void* src, uint32_t channels,
+                       uint32_t frames, float* const* dest);
+
+/**
+ * @brief Convert planar float channels into per-channel `format` planes.
+ * Channel c is written at `dest + c * planeStride` bytes (planar ring layout).
+ */
+void packPlanes(SampleFormat format, const float* const* src, uint32_t channels,
+                uint32_t frames, void* dest, size_t planeStride,
+                DitherMode dither, DitherState& state);
+
+/**
+ * @brief Convert per-channel `format` planes into planar float channels.
+ * @param dest Array of `channels` channel pointers; a nullptr entry skips that channel.
+ */
+void unpackPlanes(SampleFormat format, const void* src, size_t planeStride,
+                  uint32_t channels, uint32_t frames, float* const* dest);
+
+/**
+ * @brief De-interleave float frames into per-channel `format` planes
+ * (interleaved producer API writing into a planar ring).
+ */
+void packInterleavedToPlanes(SampleFormat format, const float* src, uint32_t channels,
+                             uint32_t frames, void* dest, size_t planeStride,
+                             DitherMode dither, DitherState& state);
+
+/**
+ * @brief Interleave per-channel `format` planes into float frames
+ * (interleaved consumer API reading from a planar ring).
+ */
+void unpackPlanesToInterleaved(SampleFormat format, const void* src, size_t planeStride,
+                               uint32_t channels, uint32_t frames, float* dest);
+
+} // namespace directpipe
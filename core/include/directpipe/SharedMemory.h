@@ -25,6 +25,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 
@@ -34,6 +35,30 @@
 
 namespace directpipe {
 
+/**
+ * @brief Residency options for a shared memory mapping.
+ *
+ * Without them the pages of a fresh mapping are faulted in on first touch,
+ * which is usually the RT audio callback right after initAsProducer().
+ * Requested options are best-effort: SharedMemory::getAppliedOptions()
+ * reports which ones actually took effect.
+ */
+struct SharedMemoryOptions {
+    /// Touch every page at create/open time (producer writes, consumer reads)
+    bool prefault = false;
+
+    /// Pin the mapping in RAM (mlock / VirtualLock). Subject to RLIMIT_MEMLOCK
+    /// on POSIX and the process working-set quota on Windows.
+    bool lock = false;
+
+    /// Back the mapping with huge pages where the OS allows it.
+    /// Linux: MADV_HUGEPAGE (shmem THP; MAP_HUGETLB needs hugetlbfs, which
+    /// shm_open does not use). Windows: SEC_LARGE_PAGES (needs
+    /// SeLockMemoryPrivilege, producer only). macOS: not available.
+    /// Only effective for regions of at least one huge page (2 MB).
+    bool hugePages = false;
+};
+
 /**
  * @brief Windows shared memory region wrapper.
  *
@@ -57,17 +82,32 @@ public:
      * @brief Create a new shared memory region (producer side).
      * @param name The shared memory name (e.g., "Local\\DirectPipeAudio").
      * @param size Size in bytes of the shared memory region.
-     * @return true if creation succeeded.
+     * @param options Residency options (pre-fault, lock, huge pages).
+     * @return true if creation succeeded. Options that could not be applied
+     *         do not fail creation — see getAppliedOptions().
      */
-    bool create(const std::string& name, size_t size);
+    bool create(const std::string& name, size_t size, const SharedMemoryOptions& options = {});
 
     /**
      * @brief Open an existing shared memory region (consumer side).
      * @param name The shared memory name.
      * @param size Expected size in bytes. Use 0 to map the full existing region.
+     * @param options Residency options. Pre-faulting only reads, so the
+     *        producer's data is never touched.
      * @return true if open succeeded.
      */
-    bool open(const std::string& name, size_t size);
+    bool open(const std::string& name, size_t size, const SharedMemoryOptions& options = {});
+
+    /**
+     * @brief Open the region if it exists, otherwise create it zero-filled.
+     *
+     * For regions shared by several producers (the stream directory): the
+     * mapping is never owned, so close() does not unlink it and an existing
+     * region's contents are kept.
+     * @param size Size in bytes; an existing region must be at least this large.
+     * @return true if the region was opened or created.
+     */
+    bool openOrCreate(const std::string& name, size_t size);
 
     /**
      * @brief Close the shared memory region and release resources.
@@ -90,10 +130,19 @@ public:
      */
     bool isOpen() const { return data_ != nullptr; }
 
+    /**
+     * @brief Options that took effect for the current mapping (all false when closed).
+     */
+    const SharedMemoryOptions& getAppliedOptions() const { return applied_; }
+
 private:
+    /// Apply prefault/lock/huge-page advice to the fresh mapping, recording results in applied_
+    void applyOptions(const SharedMemoryOptions& options, bool writable);
+
     void* data_ = nullptr;
     size_t size_ = 0;
     bool isCreator_ = false;  // Only creator (producer) unlinks on close
+    SharedMemoryOptions applied_;
 
 #ifdef _WIN32
     HANDLE mapping_ = nullptr;
@@ -158,6 +207,31 @@ public:
      */
     bool isOpen() const;
 
+    /**
+     * @brief Switch signalling to a wake word that lives in shared memory.
+     *
+     * Linux: signal()/wait() use a futex on @p seq instead of the named
+     * semaphore. signal() bumps @p seq and only issues FUTEX_WAKE when
+     * @p waiters is non-zero, so a write with no parked reader costs no
+     * syscall. Signals coalesce like a Windows auto-reset event instead of
+     * accumulating a semaphore count. Both sides must bind the same words
+     * (DirectPipeHeader::data_seq / consumer_waiting): a bound signal() no
+     * longer posts the semaphore, so a waiter that did not bind never wakes.
+     *
+     * Windows/macOS: no-op, the named event / semaphore stays in use.
+     *
+     * The words must outlive the binding — close() drops it, so close the
+     * event before unmapping the shared memory that holds them.
+     *
+     * @return true if the futex path is now active.
+     */
+    bool bindSharedWord(std::atomic<uint32_t>* seq, std::atomic<uint32_t>* waiters);
+
+    /**
+     * @brief Whether signal()/wait() currently use the shared futex word.
+     */
+    bool isSharedWordBound() const;
+
 private:
 #ifdef _WIN32
     HANDLE event_ = nullptr;
@@ -168,10 +242,15 @@ private:
     std::string name_;
     bool isCreator_ = false;  // Only creator (producer) unlinks on close
 #else
-    // Linux: POSIX named semaphore (sem_open/sem_post/sem_timedwait)
+    // Linux: POSIX named semaphore (sem_open/sem_post/sem_timedwait),
+    // replaced by a futex on a shared-memory word once bindSharedWord() is called
     void* sem_ = nullptr;  // sem_t* (void* to avoid including semaphore.h in header)
     std::string name_;
     bool isCreator_ = false;  // Only creator (producer) unlinks on close
+
+    std::atomic<uint32_t>* futexSeq_ = nullptr;      // DirectPipeHeader::data_seq
+    std::atomic<uint32_t>* futexWaiters_ = nullptr;  // DirectPipeHeader::consumer_waiting
+    uint32_t lastSeenSeq_ = 0;  // Last data_seq value this waiter consumed
 #endif
 };
 
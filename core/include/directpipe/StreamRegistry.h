@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file StreamRegistry.h
+ * @brief Machine-wide directory of published IPC streams
+ *
+ * Each stream is an independent ring (its own shared memory region and
+ * data-ready event). The directory maps a stable stream id ("main",
+ * "input", "post-chain", ...) to those names plus channel count, sample rate
+ * and a description, so consumers can list streams and pick one. The main
+ * stream keeps SHM_NAME / EVENT_NAME, so it is reachable without the
+ * directory.
+ */
+#pragma once
+
+#include "Constants.h"
+#include "Protocol.h"
+#include "SharedMemory.h"
+
+#include <cstdint>
+#include <string>
+
+namespace directpipe {
+
+/// Plain copy of a StreamEntry, as published and returned by StreamRegistry
+struct StreamInfo {
+    char id[STREAM_ID_LEN] = {};
+    char description[STREAM_DESC_LEN] = {};
+    char shmName[STREAM_NAME_LEN] = {};
+    char eventName[STREAM_NAME_LEN] = {};
+    uint32_t channels = 0;
+    uint32_t sampleRate = 0;
+};
+
+/**
+ * @brief Valid stream ids: 1-31 characters of [A-Za-z0-9_-].
+ */
+bool isValidStreamId(const char* id);
+
+/**
+ * @brief Fill id and the shared memory / event names for stream `id`.
+ * The main stream maps to SHM_NAME / EVENT_NAME, others get suffixed names.
+ * @return false if `id` is not a valid stream id.
+ */
+bool makeStreamInfo(const char* id, const char* description, StreamInfo& out);
+
+/**
+ * @brief Reader/writer for the stream directory (REGISTRY_SHM_NAME).
+ *
+ * Producers open it with openForPublishing() (created on first use) and
+ * publish/withdraw their own streams; several producer processes can share
+ * it. Consumers open it with openForReading() and list or look up streams.
+ * The region is never unlinked by close(), so it outlives any one producer;
+ * producers withdraw their entries on shutdown and reuse an entry with the
+ * same id after a crash.
+ *
+ * list()/find() do not allocate and are safe on the RT thread; open and
+ * publish are message-thread operations.
+ */
+class StreamRegistry {
+public:
+    StreamRegistry() = default;
+    ~StreamRegistry() { close(); }
+
+    StreamRegistry(const StreamRegistry&) = delete;
+    StreamRegistry& operator=(const StreamRegistry&) = delete;
+
+    /// Open the directory, creating it if no producer has yet
+    bool openForPublishing(const std::string& name = REGISTRY_SHM_NAME);
+
+    /// Open an existing directory (fails if no producer ever published)
+    bool openForReading(const std::string& name = REGISTRY_SHM_NAME);
+
+    void close();
+    bool isOpen() const { return directory_ != nullptr; }
+
+    /**
+     * @brief Publish or update a stream. An existing entry with the same id
+     * is rewritten in place (sample rate change, producer restart).
+     * @return false if the directory is full, not open or the id is invalid.
+     */
+    bool publish(const StreamInfo& info);
+
+    /**
+     * @brief Remove the stream with this id from the directory.
+     * @return true if an entry was removed.
+     */
+    bool withdraw(const char* id);
+
+    /**
+     * @brief Copy up to maxStreams active entries (directory order) into out.
+     * @return Number of entries copied.
+     */
+    uint32_t list(StreamInfo* out, uint32_t maxStreams) const;
+
+    /**
+     * @brief Look up the stream with this id.
+     */
+    bool find(const char* id, StreamInfo& out) const;
+
+private:
+    bool attach(const std::string& name, bool create);
+    bool readEntry(const StreamEntry& entry, StreamInfo& out) const;
+    void writeEntry(StreamEntry& entry, const StreamInfo& info);
+    int findIndex(const char* id) const;
+
+    SharedMemory memory_;
+    StreamDirectory* directory_ = nullptr;
+};
+
+} // namespace directpipe
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file BlockAdapter.cpp
+ * @brief Fixed processing quantum behind a variable device block size
+ */
+
+#include "directpipe/BlockAdapter.h"
+
+#include <numeric>
+
+namespace directpipe {
+
+uint32_t FixedBlockAdapter::minimumLatency(uint32_t quantum, uint32_t hostBlock)
+{
+    if (quantum == 0)
+        return 0;
+    if (hostBlock == 0)
+        return quantum - 1;   // Unknown block size: the bound that serves any pattern
+    // After k device blocks kB frames are in and at most floor(kB/Q)*Q processed;
+    // the output is short by (kB mod Q) minus the delay, whose largest value
+    // over all k is Q - gcd(B, Q)
+    return quantum - std::gcd(quantum, hostBlock);
+}
+
+void FixedBlockAdapter::prepare(uint32_t channels, uint32_t quantum, uint32_t hostBlock, uint32_t maxBlock)
+{
+    channels_ = channels;
+    quantum_ = channels > 0 ? quantum : 0;
+    maxBlock_ = (std::max)(maxBlock, 1u);
+    initialLatency_ = minimumLatency(quantum_, hostBlock);
+
+    // The delay never exceeds Q - 1, so neither FIFO holds more than that
+    // plus one incoming block
+    const size_t capacity = quantum_ > 0 ? static_cast<size_t>(quantum_) + maxBlock_ : 0;
+    in_.assign(channels_, std::vector<float>(capacity, 0.0f));
+    out_.assign(channels_, std::vector<float>(capacity, 0.0f));
+    quantumPtrs_.resize(channels_);
+    for (uint32_t ch = 0; ch < channels_; ++ch)
+        quantumPtrs_[ch] = in_[ch].data();
+    underruns_ = 0;
+    reset();
+}
+
+void FixedBlockAdapter::reset()
+{
+    inFill_ = 0;
+    outFill_ = initialLatency_;
+    latency_ = initialLatency_;
+    for (uint32_t ch = 0; ch < channels_; ++ch)
+        std::fill(out_[ch].begin(), out_[ch].begin() + outFill_, 0.0f);
+}
+
+void FixedBlockAdapter::push(float* const* io, uint32_t channels, uint32_t offset, uint32_t frames)
+{
+    for (uint32_t ch = 0; ch < channels_; ++ch) {
+        float* dst = in_[ch].data() + inFill_;
+        if (ch < channels && io[ch] != nullptr)
+            std::memcpy(dst, io[ch] + offset, static_cast<size_t>(frames) * sizeof(float));
+        else
+            std::fill(dst, dst + frames, 0.0f);
+    }
+    inFill_ += frames;
+}
+
+void FixedBlockAdapter::takeQuantum()
+{
+    const uint32_t rest = inFill_ - quantum_;
+    for (uint32_t ch = 0; ch < channels_; ++ch) {
+        float* in = in_[ch].data();
+        std::memcpy(out_[ch].data() + outFill_, in, static_cast<size_t>(quantum_) * sizeof(float));
+        if (rest > 0)
+            std::memmove(in, in + quantum_, static_cast<size_t>(rest) * sizeof(float));
+    }
+    inFill_ = rest;
+    outFill_ += quantum_;
+}
+
+void FixedBlockAdapter::pop(float* const* io, uint32_t channels, uint32_t offset, uint32_t frames)
+{
+    // Short output: silence first, so what we do have runs straight on into
+    // the next call; the stream is now `shortfall` frames later for good
+    const uint32_t shortfall = frames > outFill_ ? frames - outFill_ : 0;
+    const uint32_t available = frames - shortfall;
+    if (shortfall > 0) {
+        latency_ += shortfall;
+        ++underruns_;
+    }
+    for (uint32_t ch = 0; ch < channels_; ++ch) {
+        float* out = out_[ch].data();
+        if (ch < channels && io[ch] != nullptr) {
+            float* dst = io[ch] + offset;
+            std::fill(dst, dst + shortfall, 0.0f);
+            std::memcpy(dst + shortfall, out, static_cast<size_t>(available) * sizeof(float));
+        }
+        if (outFill_ > available)
+            std::memmove(out, out + available, static_cast<size_t>(outFill_ - available) * sizeof(float));
+    }
+    outFill_ -= available;
+}
+
+} // namespace directpipe
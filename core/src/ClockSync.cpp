@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file ClockSync.cpp
+ * @brief Producer/consumer clock ratio estimation
+ */
+
+#include "directpipe/ClockSync.h"
+
+namespace directpipe {
+
+void ClockRatioEstimator::RateTracker::add(uint64_t hostTimeNs, uint64_t samples)
+{
+    if (!hasAnchor || samples < lastSamples || hostTimeNs < anchorNs) {
+        // First stamp, or the counter/clock went backwards (stream restarted)
+        anchorNs = lastNs = hostTimeNs;
+        anchorSamples = lastSamples = samples;
+        hasAnchor = true;
+        return;
+    }
+    if (hostTimeNs <= lastNs)
+        return;  // Same block seen again
+    lastNs = hostTimeNs;
+    lastSamples = samples;
+
+    const uint64_t spanNs = hostTimeNs - anchorNs;
+    if (spanNs < kMinWindowNs)
+        return;
+
+    rateHz = static_cast<double>(samples - anchorSamples) * 1e9 / static_cast<double>(spanNs);
+
+    // Restart the window; the last rate is kept until the new one is long enough
+    if (spanNs >= kMaxWindowNs) {
+        anchorNs = hostTimeNs;
+        anchorSamples = samples;
+    }
+}
+
+void ClockRatioEstimator::reset()
+{
+    producer_ = RateTracker{};
+    consumer_ = RateTracker{};
+}
+
+void ClockRatioEstimator::addProducerStamp(uint64_t hostTimeNs, uint64_t sampleCounter)
+{
+    producer_.add(hostTimeNs, sampleCounter);
+}
+
+void ClockRatioEstimator::addConsumerStamp(uint64_t hostTimeNs, uint64_t sampleCounter)
+{
+    consumer_.add(hostTimeNs, sampleCounter);
+}
+
+double ClockRatioEstimator::ratio() const
+{
+    if (producer_.rateHz <= 0.0 || consumer_.rateHz <= 0.0)
+        return 0.0;
+    return producer_.rateHz / consumer_.rateHz;
+}
+
+} // namespace directpipe
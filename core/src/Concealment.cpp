@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file Concealment.cpp
+ * @brief Pitch-synchronous waveform repeat for consumer underruns
+ */
+
+#include "directpipe/Concealment.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace directpipe {
+
+namespace {
+
+/// Coarse pitch search rate (Hz); speech and music fundamentals sit well below its Nyquist
+constexpr double kSearchRate = 8000.0;
+
+/// Mean square below which the history counts as silence (-90 dBFS)
+constexpr double kSilenceMeanSquare = 1e-9;
+
+uint32_t msToFrames(double ms, double sampleRate)
+{
+    return static_cast<uint32_t>(std::lround(ms * sampleRate / 1000.0));
+}
+
+/// Normalized correlation of x[end - len, end) with the `lag` frames earlier window
+float correlationAt(const float* x, uint32_t end, uint32_t len, uint32_t lag)
+{
+    const float* a = x + end - len;
+    const float* b = a - lag;
+    double xy = 0.0, xx = 0.0, yy = 0.0;
+    for (uint32_t i = 0; i < len; ++i) {
+        xy += static_cast<double>(a[i]) * b[i];
+        xx += static_cast<double>(a[i]) * a[i];
+        yy += static_cast<double>(b[i]) * b[i];
+    }
+    const double norm = xx * yy;
+    return norm > 0.0 ? static_cast<float>(xy / std::sqrt(norm)) : 0.0f;
+}
+
+} // namespace
+
+void PacketLossConcealer::prepare(double sampleRate, uint32_t channels)
+{
+    channels_ = (std::min)((std::max)(channels, 1u), kMaxChannels);
+    minLag_ = (std::max)(msToFrames(kMinPeriodMs, sampleRate), 2u);
+    maxLag_ = (std::max)(msToFrames(kMaxPeriodMs, sampleRate), minLag_ + 1);
+    historyFrames_ = 2 * maxLag_;
+    decimation_ = (std::max)(static_cast<uint32_t>(std::lround(sampleRate / kSearchRate)), 1u);
+    minLoopFrames_ = msToFrames(kMinLoopMs, sampleRate);
+    fullGainFrames_ = msToFrames(kFullGainMs, sampleRate);
+    maxConcealFrames_ = (std::max)(msToFrames(kMaxConcealMs, sampleRate), fullGainFrames_ + 1);
+    recoveryFrames_ = (std::max)(msToFrames(kRecoveryMs, sampleRate), 1u);
+
+    for (uint32_t ch = 0; ch < kMaxChannels; ++ch) {
+        history_[ch].assign(ch < channels_ ? historyFrames_ : 0, 0.0f);
+        loop_[ch].assign(ch < channels_ ? historyFrames_ : 0, 0.0f);
+    }
+    mono_.assign(historyFrames_, 0.0f);
+    decimated_.assign(historyFrames_ / decimation_ + 1, 0.0f);
+    concealedFrames_ = 0;
+    historyFilled_ = 1;   // Force the clear below
+    reset();
+}
+
+void PacketLossConcealer::reset()
+{
+    // Cheap when called every block while muted / idle
+    if (historyFilled_ == 0 && !inGap_)
+        return;
+    for (uint32_t ch = 0; ch < channels_; ++ch)
+        std::fill(history_[ch].begin(), history_[ch].end(), 0.0f);
+    historyFilled_ = 0;
+    inGap_ = false;
+    silent_ = false;
+    gapFrame_ = 0;
+    loopPos_ = 0;
+    period_ = 0;
+}
+
+uint32_t PacketLossConcealer::process(float* const* channelData, uint32_t numChannels,
+                                      uint32_t validFrames, uint32_t totalFrames)
+{
+    const uint32_t channels = (std::min)(numChannels, channels_);
+    if (channels == 0 || historyFrames_ == 0)
+        return 0;   // Not prepared
+    validFrames = (std::min)(validFrames, totalFrames);
+
+    // Input is back: crossfade from the loop into it (from silence after a long gap)
+    if (inGap_ && validFrames > 0) {
+        const uint32_t fade = (std::min)(recoveryFrames_, validFrames);
+        for (uint32_t i = 0; i < fade; ++i) {
+            const float w = static_cast<float>(i + 1) / static_cast<float>(fade + 1);
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                channelData[ch][i] = w * channelData[ch][i] + (1.0f - w) * nextSample(ch);
+            advance();
+        }
+        inGap_ = false;
+    }
+    pushHistory(channelData, channels, 0, validFrames);
+
+    uint32_t concealed = 0;
+    if (validFrames < totalFrames) {
+        if (!inGap_)
+            startGap();
+        for (uint32_t i = validFrames; i < totalFrames; ++i) {
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                channelData[ch][i] = nextSample(ch);
+            if (!silent_ && gapFrame_ < maxConcealFrames_)
+                ++concealed;
+            advance();
+        }
+        // What we played is what the next gap extrapolates from
+        pushHistory(channelData, channels, validFrames, totalFrames - validFrames);
+    }
+    concealedFrames_ += concealed;
+    return concealed;
+}
+
+void PacketLossConcealer::pushHistory(float* const* channelData, uint32_t channels,
+                                      uint32_t offset, uint32_t frames)
+{
+    if (frames == 0)
+        return;
+    const uint32_t keep = (std::min)(frames, historyFrames_);
+    const uint32_t shift = historyFrames_ - keep;
+    for (uint32_t ch = 0; ch < channels_; ++ch) {
+        float* h = history_[ch].data();
+        if (shift > 0)
+            std::memmove(h, h + keep, static_cast<size_t>(shift) * sizeof(float));
+        if (ch < channels)
+            std::memcpy(h + shift, channelData[ch] + offset + (frames - keep),
+                        static_cast<size_t>(keep) * sizeof(float));
+        else
+            std::fill(h + shift, h + historyFrames_, 0.0f);
+    }
+    historyFilled_ = (std::min)(historyFilled_ + keep, historyFrames_);
+}
+
+void PacketLossConcealer::startGap()
+{
+    inGap_ = true;
+    silent_ = true;
+    gapFrame_ = 0;
+    loopPos_ = 0;
+    period_ = 0;
+    if (historyFilled_ < historyFrames_)
+        return;   // Just started — not enough audio to find a period in
+
+    const uint32_t H = historyFrames_;
+    const float scale = 1.0f / static_cast<float>(channels_);
+    for (uint32_t i = 0; i < H; ++i) {
+        float sum = 0.0f;
+        for (uint32_t ch = 0; ch < channels_; ++ch)
+            sum += history_[ch][i];
+        mono_[i] = sum * scale;
+    }
+    double energy = 0.0;
+    for (uint32_t i = H - maxLag_; i < H; ++i)
+        energy += static_cast<double>(mono_[i]) * mono_[i];
+    if (energy < kSilenceMeanSquare * maxLag_)
+        return;   // Silence: nothing to repeat
+
+    float correlation = 0.0f;
+    uint32_t period = findPeriod(correlation);
+    if (correlation < kMinCorrelation)
+        period = maxLag_;   // Unvoiced / noise: longest loop, least buzz
+    period_ = period;
+
+    // Whole periods, at least kMinLoopMs, with room for the tail crossfade
+    const uint32_t overlap = (std::max)(period / 4, 1u);
+    uint32_t periods = (std::max)((minLoopFrames_ + period - 1) / period, 1u);
+    while (periods > 1 && periods * period + overlap > H)
+        --periods;
+    loopFrames_ = periods * period;
+
+    for (uint32_t ch = 0; ch < channels_; ++ch) {
+        const float* x = history_[ch].data();
+        float* loop = loop_[ch].data();
+        std::memcpy(loop, x + H - loopFrames_, static_cast<size_t>(loopFrames_) * sizeof(float));
+        // Blend the tail into the audio one loop earlier: its end then runs
+        // into loop[0] the way the original did
+        for (uint32_t j = 0; j < overlap; ++j) {
+            const uint32_t i = loopFrames_ - overlap + j;
+            const float w = static_cast<float>(j + 1) / static_cast<float>(overlap + 1);
+            loop[i] = (1.0f - w) * x[H - loopFrames_ + i] + w * x[H - 2 * loopFrames_ + i];
+        }
+        // The last real sample is not where loop[0] expects to follow from
+        spliceOffset_[ch] = x[H - 1] - loop[loopFrames_ - 1];
+    }
+    spliceFrames_ = overlap;
+    silent_ = false;
+}
+
+uint32_t PacketLossConcealer::findPeriod(float& correlation)
+{
+    const uint32_t H = historyFrames_;
+    uint32_t lo = minLag_;
+    uint32_t hi = maxLag_;
+
+    // Coarse search on the decimated mix, then refine around it at full rate
+    const uint32_t D = decimation_;
+    if (D > 1) {
+        const uint32_t M = H / D;
+        const uint32_t start = H - M * D;
+        float* dec = decimated_.data();
+        for (uint32_t k = 0; k < M; ++k) {
+            float sum = 0.0f;
+            for (uint32_t j = 0; j < D; ++j)
+                sum += mono_[start + k * D + j];
+            dec[k] = sum / static_cast<float>(D);
+        }
+        const uint32_t lagLo = (std::max)((minLag_ + D - 1) / D, 1u);
+        const uint32_t lagHi = maxLag_ / D;
+        uint32_t coarse = lagHi;
+        float best = -1.0f;
+        for (uint32_t lag = lagLo; lag <= lagHi; ++lag) {
+            const float c = correlationAt(dec, M, lagHi, lag);
+            if (c > best) {
+                best = c;
+                coarse = lag;
+            }
+        }
+        lo = (std::max)(coarse * D > D ? coarse * D - D : 0u, minLag_);
+        hi = (std::min)(coarse * D + D, maxLag_);
+    }
+
+    uint32_t period = maxLag_;
+    correlation = -1.0f;
+    for (uint32_t lag = lo; lag <= hi; ++lag) {
+        const float c = correlationAt(mono_.data(), H, maxLag_, lag);
+        if (c > correlation) {
+            correlation = c;
+            period = lag;
+        }
+    }
+    return period;
+}
+
+float PacketLossConcealer::gainAt(uint32_t gapFrame) const
+{
+    if (gapFrame < fullGainFrames_)
+        return 1.0f;
+    if (gapFrame >= maxConcealFrames_)
+        return 0.0f;
+    return static_cast<float>(maxConcealFrames_ - gapFrame)
+           / static_cast<float>(maxConcealFrames_ - fullGainFrames_);
+}
+
+float PacketLossConcealer::nextSample(uint32_t ch) const
+{
+    if (silent_ || gapFrame_ >= maxConcealFrames_ || ch >= channels_)
+        return 0.0f;
+    float sample = loop_[ch][loopPos_];
+    if (gapFrame_ < spliceFrames_)
+        sample += spliceOffset_[ch] * static_cast<float>(spliceFrames_ - gapFrame_)
+                                    / static_cast<float>(spliceFrames_);
+    return sample * gainAt(gapFrame_);
+}
+
+void PacketLossConcealer::advance()
+{
+    if (gapFrame_ >= maxConcealFrames_)
+        return;   // Silent from here on (and no counter to wrap on a long disconnect)
+    ++gapFrame_;
+    if (!silent_ && ++loopPos_ >= loopFrames_)
+        loopPos_ = 0;
+}
+
+} // namespace directpipe
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file JitterBuffer.cpp
+ * @brief Jitter-adaptive target fill selection
+ */
+
+#include "directpipe/JitterBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace directpipe {
+
+namespace {
+
+/// Blocks the histogram must hold before its quantile is trusted
+constexpr double kMinWeight = 100.0;
+
+} // namespace
+
+void JitterBufferSizer::reset(const Config& config)
+{
+    config_ = config;
+    config_.minTarget = (std::max)(config_.minTarget, kQuantum);
+    config_.maxTarget = (std::max)(config_.maxTarget, config_.minTarget);
+    setUnderrunBudget(config_.underrunBudget);
+    reset();
+}
+
+void JitterBufferSizer::reset()
+{
+    std::fill(bins_, bins_ + kBins, 0.0f);
+    totalWeight_ = 0.0;
+    sinceEvaluate_ = 0.0;
+    sinceUnderrun_ = 0.0;
+    sinceShrink_ = 0.0;
+    target_ = clampTarget(config_.initialTarget);
+    measured_ = 0;
+    underruns_ = 0;
+}
+
+void JitterBufferSizer::setUnderrunBudget(double budget)
+{
+    config_.underrunBudget = (std::min)((std::max)(budget, 1e-6), 0.5);
+}
+
+uint32_t JitterBufferSizer::clampTarget(double frames) const
+{
+    // Round up to the quantum, then into [minTarget, maxTarget]
+    const double quanta = std::ceil((std::max)(frames, 0.0) / kQuantum);
+    const double rounded = quanta * kQuantum;
+    if (rounded >= static_cast<double>(config_.maxTarget))
+        return config_.maxTarget;
+    return (std::max)(static_cast<uint32_t>(rounded), config_.minTarget);
+}
+
+bool JitterBufferSizer::observe(double deficitFrames, double elapsedSec)
+{
+    const double bin = std::floor((std::max)(deficitFrames, 0.0) / kQuantum);
+    bins_[bin >= kBins - 1 ? kBins - 1 : static_cast<uint32_t>(bin)] += 1.0f;
+    totalWeight_ += 1.0;
+
+    sinceUnderrun_ += elapsedSec;
+    sinceShrink_ += elapsedSec;
+    sinceEvaluate_ += elapsedSec;
+    if (sinceEvaluate_ < kEvaluateIntervalSec)
+        return false;
+
+    const uint32_t before = target_;
+    evaluate();
+    return target_ != before;
+}
+
+void JitterBufferSizer::evaluate()
+{
+    // Exponential forgetting, applied once per evaluation
+    const auto decay = static_cast<float>(std::exp(-sinceEvaluate_ / kWindowSec));
+    sinceEvaluate_ = 0.0;
+    double total = 0.0;
+    for (uint32_t b = 0; b < kBins; ++b) {
+        bins_[b] *= decay;
+        total += bins_[b];
+    }
+    totalWeight_ = total;
+    if (totalWeight_ < kMinWeight)
+        return;
+
+    // Smallest bin b with at most budget * total weight above it: a target
+    // past that bin's upper edge underruns at most `budget` of the time
+    const double allowedTail = config_.underrunBudget * totalWeight_;
+    double tail = 0.0;
+    uint32_t b = kBins - 1;
+    while (b > 0 && tail + bins_[b] <= allowedTail) {
+        tail += bins_[b];
+        --b;
+    }
+    measured_ = clampTarget(static_cast<double>(b + 2) * kQuantum);   // upper edge + one quantum
+
+    if (measured_ > target_) {
+        target_ = measured_;
+        sinceShrink_ = 0.0;
+    } else if (measured_ < target_ && sinceUnderrun_ >= kShrinkHoldSec
+               && sinceShrink_ >= kShrinkIntervalSec) {
+        target_ = (std::max)(measured_, target_ - kQuantum);
+        sinceShrink_ = 0.0;
+    }
+}
+
+bool JitterBufferSizer::onUnderrun()
+{
+    ++underruns_;
+    sinceUnderrun_ = 0.0;
+    sinceShrink_ = 0.0;
+
+    const uint32_t grown = clampTarget(
+        (std::max)(static_cast<double>(target_) * kGrowFactor, static_cast<double>(measured_)));
+    if (grown <= target_)
+        return false;
+    target_ = grown;
+    return true;
+}
+
+} // namespace directpipe
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file Resampler.cpp
+ * @brief Fill-level PI loop and variable-ratio polyphase resampler
+ */
+
+#include "directpipe/Resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace directpipe {
+
+// ─── FillLevelController ────────────────────────────────────────
+
+void FillLevelController::prepare(double sampleRate)
+{
+    sampleRate_ = sampleRate > 0.0 ? sampleRate : 48000.0;
+    reset();
+}
+
+void FillLevelController::reset()
+{
+    smoothedFill_ = -1.0;
+    integral_ = 0.0;
+    ratio_ = 1.0;
+}
+
+double FillLevelController::update(double fillFrames, double targetFrames, uint32_t blockFrames)
+{
+    const double dt = static_cast<double>(blockFrames) / sampleRate_;
+    if (smoothedFill_ < 0.0)
+        smoothedFill_ = fillFrames;
+    else
+        smoothedFill_ += (fillFrames - smoothedFill_) * (dt / (kFillSmoothingSec + dt));
+
+    // Fill error e (frames) moves at fs * (drift - correction); with
+    // correction = kp*e + ki*integral(e) the loop is e'' + fs*kp*e' + fs*ki*e = 0,
+    // critically damped at wn for kp = 2*wn/fs, ki = wn^2/fs.
+    const double maxCorrection = kMaxCorrectionPpm * 1e-6;
+    const double kp = 2.0 * kLoopBandwidthRad / sampleRate_;
+    const double ki = kLoopBandwidthRad * kLoopBandwidthRad / sampleRate_;
+    const double error = smoothedFill_ - targetFrames;
+
+    integral_ += error * dt;
+    const double integralLimit = maxCorrection / ki;
+    integral_ = (std::max)(-integralLimit, (std::min)(integral_, integralLimit));
+
+    const double correction = kp * error + ki * integral_;
+    ratio_ = 1.0 + (std::max)(-maxCorrection, (std::min)(correction, maxCorrection));
+    return ratio_;
+}
+
+// ─── AdaptiveResampler ──────────────────────────────────────────
+
+namespace {
+
+struct SincDesign {
+    uint32_t baseTaps;
+    double rolloff;   // cutoff as a fraction of the (output) Nyquist frequency
+    double beta;      // Kaiser window shape
+};
+
+SincDesign sincDesign(ResamplerQuality quality)
+{
+    switch (quality) {
+        case ResamplerQuality::Sinc16: return { 16, 0.85, 6.0 };
+        case ResamplerQuality::Sinc64: return { 64, 0.945, 10.0 };
+        case ResamplerQuality::Sinc32:
+        default:                       return { 32, 0.90, 8.0 };
+    }
+}
+
+/// Zeroth-order modified Bessel function of the first kind (Kaiser window)
+double besselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    const double q = x * x * 0.25;
+    for (int k = 1; k < 50 && term > sum * 1e-12; ++k) {
+        term *= q / (static_cast<double>(k) * static_cast<double>(k));
+        sum += term;
+    }
+    return sum;
+}
+
+uint32_t evenCeil(double v)
+{
+    auto n = static_cast<uint32_t>(std::ceil(v));
+    return n + (n & 1u);
+}
+
+} // namespace
+
+void AdaptiveResampler::prepare(uint32_t channels, uint32_t maxOutputFrames, double maxRatio)
+{
+    channels_ = (std::min)((std::max)(channels, 1u), kMaxChannels);
+    maxOutputFrames_ = maxOutputFrames;
+    maxStretch_ = (std::max)(maxRatio, 1.0);
+    maxInputFrames_ = static_cast<uint32_t>(
+        std::ceil(static_cast<double>(maxOutputFrames) * maxStretch_)) + 1;
+    maxTaps_ = evenCeil(kMaxBaseTaps * maxStretch_);
+    for (uint32_t ch = 0; ch < kMaxChannels; ++ch)
+        work_[ch].assign(ch < channels_ ? maxTaps_ + maxInputFrames_ : 0, 0.0f);
+    table_.assign(static_cast<size_t>(kPhases + 1) * maxTaps_, 0.0f);
+    configure(ResamplerQuality::Cubic, 1.0);
+}
+
+void AdaptiveResampler::configure(ResamplerQuality quality, double nominalRatio)
+{
+    quality_ = quality;
+    if (quality == ResamplerQuality::Cubic || table_.empty()) {
+        quality_ = ResamplerQuality::Cubic;
+        taps_ = 4;
+        reset();
+        return;
+    }
+
+    // Downsampling: widen the kernel by the ratio so the cutoff lands below
+    // the output Nyquist frequency (upsampling keeps the input's)
+    const SincDesign design = sincDesign(quality);
+    const double stretch = (std::min)((std::max)(nominalRatio, 1.0), maxStretch_);
+    taps_ = (std::min)(tapsFor(quality, nominalRatio, maxStretch_), maxTaps_);
+    const double cutoff = design.rolloff / stretch;   // fraction of input Nyquist
+    const double half = static_cast<double>(taps_) / 2.0;
+    const double windowNorm = 1.0 / besselI0(design.beta);
+    constexpr double kPi = 3.14159265358979323846;
+
+    // Row p holds h(p/kPhases + half - 1 - k) for window slot k, normalised to
+    // unity DC gain; row kPhases (offset 1.0) is the interpolation end point
+    for (uint32_t p = 0; p <= kPhases; ++p) {
+        float* row = table_.data() + static_cast<size_t>(p) * taps_;
+        const double offset = static_cast<double>(p) / kPhases;
+        double sum = 0.0;
+        for (uint32_t k = 0; k < taps_; ++k) {
+            const double x = offset + half - 1.0 - static_cast<double>(k);
+            const double u = x / half;
+            const double window = std::fabs(u) >= 1.0
+                ? 0.0 : besselI0(design.beta * std::sqrt(1.0 - u * u)) * windowNorm;
+            const double arg = kPi * cutoff * x;
+            const double sinc = std::fabs(arg) < 1e-12 ? 1.0 : std::sin(arg) / arg;
+            const double h = cutoff * sinc * window;
+            row[k] = static_cast<float>(h);
+            sum += h;
+        }
+        if (sum != 0.0)
+            for (uint32_t k = 0; k < taps_; ++k)
+                row[k] = static_cast<float>(row[k] / sum);
+    }
+    reset();
+}
+
+uint32_t AdaptiveResampler::tapsFor(ResamplerQuality quality, double nominalRatio, double maxStretch)
+{
+    if (quality == ResamplerQuality::Cubic)
+        return 4;
+    const double stretch = (std::min)((std::max)(nominalRatio, 1.0), (std::max)(maxStretch, 1.0));
+    return evenCeil(sincDesign(quality).baseTaps * stretch);
+}
+
+double AdaptiveResampler::latencyFramesFor(ResamplerQuality quality, double nominalRatio, double maxRatio)
+{
+    // prepare() sizes maxTaps_ for the longest kernel at maxRatio, so the clamp never bites
+    return static_cast<double>(tapsFor(quality, nominalRatio, maxRatio) / 2 + 1);
+}
+
+void AdaptiveResampler::reset()
+{
+    for (uint32_t ch = 0; ch < channels_; ++ch)
+        std::fill(work_[ch].begin(), work_[ch].end(), 0.0f);
+    phase_ = 0.0;
+}
+
+uint32_t AdaptiveResampler::inputFramesFor(uint32_t outFrames, double ratio) const
+{
+    // Every input frame the output position passes is consumed
+    return static_cast<uint32_t>(phase_ + static_cast<double>(outFrames) * ratio);
+}
+
+uint32_t AdaptiveResampler::outputFramesFor(uint32_t inFrames, double ratio) const
+{
+    if (ratio <= 0.0)
+        return 0;
+    auto out = static_cast<uint32_t>(
+        (std::max)(0.0, (static_cast<double>(inFrames) + 1.0 - phase_) / ratio));
+    out = (std::min)(out, maxOutputFrames_);
+    // The division above can land one frame off either way; settle exactly
+    while (out > 0 && inputFramesFor(out, ratio) > inFrames)
+        --out;
+    while (out < maxOutputFrames_ && inputFramesFor(out + 1, ratio) <= inFrames)
+        ++out;
+    return out;
+}
+
+void AdaptiveResampler::processCubic(const float* x, float* dest, uint32_t outFrames,
+                                     double ratio, uint32_t lastStart) const
+{
+    double pos = phase_;
+    for (uint32_t i = 0; i < outFrames; ++i, pos += ratio) {
+        // Interpolate between x[n + 1] and x[n + 2]
+        const auto n = (std::min)(static_cast<uint32_t>(pos), lastStart);
+        const float f = static_cast<float>(pos - static_cast<double>(n));
+        const float x0 = x[n], x1 = x[n + 1], x2 = x[n + 2], x3 = x[n + 3];
+        const float c1 = 0.5f * (x2 - x0);
+        const float c2 = x0 - 2.5f * x1 + 2.0f * x2 - 0.5f * x3;
+        const float c3 = 0.5f * (x3 - x0) + 1.5f * (x1 - x2);
+        dest[i] = ((c3 * f + c2) * f + c1) * f + x1;
+    }
+}
+
+void AdaptiveResampler::processSinc(const float* x, float* dest, uint32_t outFrames,
+                                    double ratio, uint32_t lastStart) const
+{
+    const uint32_t taps = taps_;
+    double pos = phase_;
+    for (uint32_t i = 0; i < outFrames; ++i, pos += ratio) {
+        const auto n = (std::min)(static_cast<uint32_t>(pos), lastStart);
+        const double phase = (pos - static_cast<double>(n)) * kPhases;
+        const auto p = (std::min)(static_cast<uint32_t>(phase), kPhases - 1);
+        const float a = static_cast<float>(phase - static_cast<double>(p));
+
+        // Two neighbouring phases, blended: one pass over the window
+        const float* c0 = table_.data() + static_cast<size_t>(p) * taps;
+        const float* c1 = c0 + taps;
+        const float* w = x + n;
+        float s0 = 0.0f, s1 = 0.0f;
+        for (uint32_t k = 0; k < taps; ++k) {
+            s0 += w[k] * c0[k];
+            s1 += w[k] * c1[k];
+        }
+        dest[i] = s0 + a * (s1 - s0);
+    }
+}
+
+void AdaptiveResampler::process(uint32_t inFrames, float* const* out, uint32_t outFrames,
+                                double ratio)
+{
+    inFrames = (std::min)(inFrames, maxInputFrames_);
+    outFrames = (std::min)(outFrames, maxOutputFrames_);
+    // Last window start that stays inside the data; guards against a caller
+    // passing too few input frames
+    const uint32_t lastStart = inFrames;
+
+    for (uint32_t ch = 0; ch < channels_; ++ch) {
+        if (out[ch] == nullptr)
+            continue;
+        if (quality_ == ResamplerQuality::Cubic)
+            processCubic(work_[ch].data(), out[ch], outFrames, ratio, lastStart);
+        else
+            processSinc(work_[ch].data(), out[ch], outFrames, ratio, lastStart);
+    }
+
+    // Keep the newest taps_ input frames in front of the next block
+    for (uint32_t ch = 0; ch < channels_; ++ch) {
+        float* w = work_[ch].data();
+        std::memmove(w, w + inFrames, taps_ * sizeof(float));
+    }
+    phase_ += static_cast<double>(outFrames) * ratio - static_cast<double>(inFrames);
+    phase_ = (std::max)(0.0, phase_);
+}
+
+} // namespace directpipe
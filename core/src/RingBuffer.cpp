@@ -18,7 +18,7 @@
 
 /**
  * @file RingBuffer.cpp
- * @brief SPSC lock-free ring buffer implementation
+ * @brief Single-producer, multi-consumer broadcast ring buffer implementation
  */
 
 #include "directpipe/RingBuffer.h"
@@ -30,7 +30,8 @@
 namespace directpipe {
 
 void RingBuffer::initAsProducer(void* memory, uint32_t capacity_frames,
-                                 uint32_t channels, uint32_t sample_rate)
+                                 uint32_t channels, uint32_t sample_rate,
+                                 SampleFormat format, SampleLayout layout)
 {
     assert(memory != nullptr);
     assert(isPowerOfTwo(capacity_frames));
@@ -47,17 +48,30 @@ void RingBuffer::initAsProducer(void* memory, uint32_t capacity_frames,
     header_->channels = channels;
     header_->buffer_frames = capacity_frames;
     header_->version = PROTOCOL_VERSION;
+    header_->sample_format = static_cast<uint32_t>(format);
+    header_->sample_layout = static_cast<uint32_t>(layout);
+    header_->overrun_policy.store(static_cast<uint32_t>(overrunPolicy_), std::memory_order_relaxed);
+    consumerSlot_ = -1;
+    for (auto& tracker : stall_)
+        tracker = StallTracker{};
+    overwrittenFrames_.store(0, std::memory_order_relaxed);
     header_->producer_active.store(true, std::memory_order_release);
 
     // PCM data starts right after the header
-    data_ = reinterpret_cast<float*>(static_cast<uint8_t*>(memory) + sizeof(DirectPipeHeader));
+    data_ = static_cast<uint8_t*>(memory) + sizeof(DirectPipeHeader);
     mask_ = capacity_frames - 1;
-
-    // Zero out the audio buffer
-    std::memset(data_, 0, static_cast<size_t>(capacity_frames) * channels * sizeof(float));
+    format_ = format;
+    layout_ = layout;
+    frameBytes_ = channels * bytesPerSample(format);
+    strideBytes_ = layout == SampleLayout::Planar ? bytesPerSample(format) : frameBytes_;
+    planeStride_ = layout == SampleLayout::Planar
+        ? static_cast<size_t>(capacity_frames) * bytesPerSample(format) : 0;
+
+    // Zero out the audio buffer (all-zero bytes are silence in every format)
+    std::memset(data_, 0, static_cast<size_t>(capacity_frames) * frameBytes_);
 }
 
-bool RingBuffer::attachAsConsumer(void* memory, size_t mappedSizeBytes)
+bool RingBuffer::attachAsConsumer(void* memory, size_t mappedSizeBytes, uint32_t acceptedFormats)
 {
     if (!memory) return false;
 
@@ -82,135 +96,659 @@ bool RingBuffer::attachAsConsumer(void* memory, size_t mappedSizeBytes)
     // Validate buffer parameters
     if (!isPowerOfTwo(header_->buffer_frames) ||
         header_->channels == 0 || header_->channels > 2 ||
-        header_->sample_rate == 0) {
+        header_->sample_rate == 0 ||
+        !isValidSampleFormat(header_->sample_format) ||
+        !isValidSampleLayout(header_->sample_layout)) {
+        header_ = nullptr;
+        return false;
+    }
+
+    // Format negotiation: refuse a ring we cannot decode
+    const auto format = static_cast<SampleFormat>(header_->sample_format);
+    if ((acceptedFormats & sampleFormatBit(format)) == 0) {
+        formatRejected_ = true;
         header_ = nullptr;
         return false;
     }
+    formatRejected_ = false;
+
+    const uint32_t frameBytes = header_->channels * bytesPerSample(format);
 
     if (mappedSizeBytes != 0) {
-        if (std::numeric_limits<size_t>::max() / sizeof(float) < header_->channels ||
-            std::numeric_limits<size_t>::max() / (header_->channels * sizeof(float)) < header_->buffer_frames) {
+        if (std::numeric_limits<size_t>::max() / frameBytes < header_->buffer_frames) {
             header_ = nullptr;
             return false;
         }
 
-        const size_t requiredBytes = calculateSharedMemorySize(header_->buffer_frames, header_->channels);
+        const size_t requiredBytes = calculateSharedMemorySize(header_->buffer_frames,
+                                                               header_->channels, format);
         if (mappedSizeBytes < requiredBytes) {
             header_ = nullptr;
             return false;
         }
     }
 
-    data_ = reinterpret_cast<float*>(static_cast<uint8_t*>(memory) + sizeof(DirectPipeHeader));
+    data_ = static_cast<uint8_t*>(memory) + sizeof(DirectPipeHeader);
     mask_ = header_->buffer_frames - 1;
-
-    // Check if another consumer is already reading this buffer (SPSC violation).
-    // We still connect (audio will likely be corrupted), but flag it for UI warning.
-    if (header_->consumer_active.load(std::memory_order_acquire)) {
-        // Check if previous consumer is actually reading — if read_pos is far behind
-        // write_pos, assume the previous consumer crashed (stale flag)
-        const uint64_t wp = header_->write_pos.load(std::memory_order_relaxed);
-        const uint64_t rp = header_->read_pos.load(std::memory_order_relaxed);
-        const uint64_t behind = wp - rp;  // unsigned diff, handles 64-bit wrap
-        if (behind > (header_->buffer_frames * 80ULL) / 100ULL) {
-            // Previous consumer is stale (not reading) — clear flag, proceed normally
-            anotherConsumerWasActive_ = false;
-        } else {
-            anotherConsumerWasActive_ = true;
-        }
-    } else {
-        anotherConsumerWasActive_ = false;
+    format_ = format;
+    layout_ = static_cast<SampleLayout>(header_->sample_layout);
+    frameBytes_ = frameBytes;
+    strideBytes_ = layout_ == SampleLayout::Planar ? bytesPerSample(format) : frameBytes;
+    planeStride_ = layout_ == SampleLayout::Planar
+        ? static_cast<size_t>(header_->buffer_frames) * bytesPerSample(format) : 0;
+    acceptedFormats_ = acceptedFormats;
+
+    consumerSlot_ = -1;
+    consumerToken_ = 0;
+
+    // New consumers start at the retention tail so data written before we
+    // attached (and not yet consumed by anyone) is still delivered — except on
+    // an overwrite-oldest ring, where only live audio matters.
+    const bool latestWins = header_->overrun_policy.load(std::memory_order_relaxed)
+                         == static_cast<uint32_t>(OverrunPolicy::OverwriteOldest);
+    const uint64_t startPos = latestWins ? header_->write_pos.load(std::memory_order_acquire)
+                                         : header_->read_pos.load(std::memory_order_acquire);
+    if (!claimConsumerSlot(startPos)) {
+        consumerSlotsExhausted_ = true;
+        header_ = nullptr;
+        data_ = nullptr;
+        mask_ = 0;
+        frameBytes_ = 0;
+        strideBytes_ = 0;
+        planeStride_ = 0;
+        return false;
     }
-    header_->consumer_active.store(true, std::memory_order_release);
+    consumerSlotsExhausted_ = false;
 
     return true;
 }
 
-// Memory ordering rationale for SPSC:
-// - Own position (write_pos for producer, read_pos for consumer): relaxed
+namespace {
+
+/// Zero a telemetry entry for a new owner (it may hold a departed consumer's totals)
+void resetConsumerStats(ConsumerStats& stats)
+{
+    stats.blocks.store(0, std::memory_order_relaxed);
+    stats.frames_padded.store(0, std::memory_order_relaxed);
+    stats.frames_skipped.store(0, std::memory_order_relaxed);
+    stats.frames_concealed.store(0, std::memory_order_relaxed);
+    stats.underruns.store(0, std::memory_order_relaxed);
+    stats.fill_frames.store(0, std::memory_order_relaxed);
+    stats.resample_ratio_micros.store(0, std::memory_order_relaxed);
+    stats.process_ns.store(0, std::memory_order_relaxed);
+    stats.process_peak_ns.store(0, std::memory_order_relaxed);
+    for (auto& bin : stats.fill_histogram)
+        bin.store(0, std::memory_order_relaxed);
+}
+
+} // namespace
+
+bool RingBuffer::claimConsumerSlot(uint64_t startPos)
+{
+    const uint64_t token = header_->next_consumer_token.fetch_add(1, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < MAX_CONSUMERS; ++i) {
+        auto& slot = header_->consumers[i];
+        uint64_t expected = 0;
+        if (!slot.owner.compare_exchange_strong(expected, CONSUMER_SLOT_CLAIMING,
+                                                std::memory_order_acq_rel))
+            continue;
+
+        // The producer ignores CLAIMING slots, so the cursor can be set up
+        // before it becomes visible. Publish the token with release so the
+        // producer sees the initialised cursor together with the owner.
+        slot.read_pos.store(startPos, std::memory_order_relaxed);
+        slot.accepted_formats.store(acceptedFormats_, std::memory_order_relaxed);
+        slot.latency_us.store(0, std::memory_order_relaxed);
+        resetConsumerStats(header_->consumer_stats[i]);
+        heartbeat_ = slot.heartbeat.load(std::memory_order_relaxed);
+        slot.owner.store(token, std::memory_order_release);
+
+        // The producer may have advanced the tail past startPos while we were
+        // claiming — never start behind the retention tail.
+        const uint64_t tail = header_->read_pos.load(std::memory_order_acquire);
+        uint64_t cursor = startPos;
+        if (static_cast<int64_t>(tail - cursor) > 0)
+            slot.read_pos.compare_exchange_strong(cursor, tail, std::memory_order_release);
+
+        consumerSlot_ = static_cast<int>(i);
+        consumerToken_ = token;
+        return true;
+    }
+
+    return false;
+}
+
+void RingBuffer::releaseConsumerSlot()
+{
+    if (header_ && consumerSlot_ >= 0) {
+        // Only free the slot if it is still ours (the producer may have evicted
+        // us and another consumer may already own it).
+        uint64_t expected = consumerToken_;
+        header_->consumers[consumerSlot_].owner.compare_exchange_strong(
+            expected, 0, std::memory_order_acq_rel);
+    }
+    consumerSlot_ = -1;
+    consumerToken_ = 0;
+}
+
+void RingBuffer::setOverrunPolicy(OverrunPolicy policy)
+{
+    overrunPolicy_ = policy;
+    if (isValid())
+        header_->overrun_policy.store(static_cast<uint32_t>(policy), std::memory_order_relaxed);
+}
+
+OverrunPolicy RingBuffer::getOverrunPolicy() const
+{
+    if (!isValid()) return overrunPolicy_;
+    return header_->overrun_policy.load(std::memory_order_relaxed)
+               == static_cast<uint32_t>(OverrunPolicy::OverwriteOldest)
+        ? OverrunPolicy::OverwriteOldest : OverrunPolicy::DropNewest;
+}
+
+uint32_t RingBuffer::getConsumerCount() const
+{
+    if (!isValid()) return 0;
+
+    uint32_t count = 0;
+    for (const auto& slot : header_->consumers) {
+        const uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner != 0 && owner != CONSUMER_SLOT_CLAIMING)
+            ++count;
+    }
+    return count;
+}
+
+uint32_t RingBuffer::getConsumerFormatMask() const
+{
+    if (!isValid()) return ALL_SAMPLE_FORMATS;
+
+    uint32_t mask = ALL_SAMPLE_FORMATS;
+    for (const auto& slot : header_->consumers) {
+        const uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner != 0 && owner != CONSUMER_SLOT_CLAIMING)
+            mask &= slot.accepted_formats.load(std::memory_order_relaxed);
+    }
+    return mask;
+}
+
+uint64_t RingBuffer::slowestCursor(uint64_t write_pos) const
+{
+    const uint64_t capacity = header_->buffer_frames;
+    bool anyLive = false;
+    uint64_t maxLag = 0;
+
+    for (const auto& slot : header_->consumers) {
+        const uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner == 0 || owner == CONSUMER_SLOT_CLAIMING) continue;
+
+        const uint64_t lag = std::min(write_pos - slot.read_pos.load(std::memory_order_acquire),
+                                      capacity);
+        if (!anyLive || lag > maxLag)
+            maxLag = lag;
+        anyLive = true;
+    }
+
+    if (!anyLive)
+        return header_->read_pos.load(std::memory_order_relaxed);
+    return write_pos - maxLag;
+}
+
+void RingBuffer::evictStalledConsumers(uint64_t write_pos, uint32_t frames)
+{
+    const uint64_t capacity = header_->buffer_frames;
+    bool haveNow = false;
+    std::chrono::steady_clock::time_point now;
+
+    for (uint32_t i = 0; i < MAX_CONSUMERS; ++i) {
+        auto& slot = header_->consumers[i];
+        auto& tracker = stall_[i];
+        const uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner == 0 || owner == CONSUMER_SLOT_CLAIMING) {
+            tracker.armed = false;
+            continue;
+        }
+
+        const uint64_t lag = std::min(write_pos - slot.read_pos.load(std::memory_order_acquire),
+                                      capacity);
+        if (lag + frames <= capacity) {
+            tracker.armed = false;  // Not blocking this write
+            continue;
+        }
+
+        // This consumer blocks the write. Only the (rare) blocked path reads the clock.
+        if (!haveNow) {
+            now = std::chrono::steady_clock::now();
+            haveNow = true;
+        }
+
+        const uint64_t hb = slot.heartbeat.load(std::memory_order_relaxed);
+        if (!tracker.armed || tracker.owner != owner || tracker.heartbeat != hb) {
+            tracker.owner = owner;
+            tracker.heartbeat = hb;
+            tracker.since = now;
+            tracker.armed = true;
+            continue;
+        }
+
+        if (now - tracker.since < std::chrono::milliseconds(stallTimeoutMs_))
+            continue;
+
+        // Stalled: no read() for the whole timeout while holding the buffer full.
+        // CAS on the unique token — a consumer that re-claimed in the meantime
+        // has a different token and is left alone.
+        // The frames it was holding are released: the tail is recomputed from the
+        // remaining consumers in write(), or jumps to write_pos if none remain.
+        uint64_t expected = owner;
+        if (slot.owner.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+            evictedConsumers_.fetch_add(1, std::memory_order_relaxed);
+            header_->read_pos.store(write_pos, std::memory_order_release);
+        }
+        tracker.armed = false;
+    }
+}
+
+// Memory ordering rationale:
+// - Own position (write_pos for producer, own slot cursor for consumer): relaxed
 //   (single writer, no contention — we are the only one advancing this)
-// - Other's position (read_pos for producer, write_pos for consumer): acquire
+// - Other's position (consumer cursors for producer, write_pos for consumer): acquire
 //   (must see the other side's latest advance to compute available space correctly)
+// - The producer publishes the slowest cursor as header read_pos (retention tail);
+//   consumers only read it when claiming a slot.
+// - oldest_pos is raised (relaxed store + release fence) before any frame it
+//   excludes is overwritten; consumers re-check it after an acquire fence once
+//   they have copied a region (same pairing as the block metadata seqlock).
 
-uint32_t RingBuffer::write(const float* data, uint32_t frames)
+RingBuffer::WriteRegion RingBuffer::beginWrite(uint32_t frames)
 {
-    if (detached_.load(std::memory_order_acquire)) return 0;
-    if (!isValid() || frames == 0) return 0;
+    pendingWriteFrames_ = 0;
+    if (detached_.load(std::memory_order_acquire)) return {};
+    if (!isValid() || frames == 0) return {};
 
-    const uint32_t channels = header_->channels;
     const uint32_t capacity = header_->buffer_frames;
     const uint64_t write_pos = header_->write_pos.load(std::memory_order_relaxed);
-    const uint64_t read_pos = header_->read_pos.load(std::memory_order_acquire);
 
-    // Calculate available space
-    const uint64_t used = write_pos - read_pos;
+    evictStalledConsumers(write_pos, frames);
+    const uint64_t tail = slowestCursor(write_pos);
+
+    // Calculate available space (bounded by the slowest live consumer)
+    const uint64_t used = std::min(write_pos - tail, static_cast<uint64_t>(capacity));
     const uint32_t available = capacity - static_cast<uint32_t>(used);
-    const uint32_t to_write = std::min(frames, available);
 
-    if (to_write == 0) return 0;
+    // Latest wins: take the whole block (up to one ring) and recycle the oldest frames
+    const bool latestWins = overrunPolicy_ == OverrunPolicy::OverwriteOldest;
+    const uint32_t to_write = std::min(frames, latestWins ? capacity : available);
+
+    if (to_write == 0) {
+        header_->read_pos.store(tail, std::memory_order_release);
+        return {};
+    }
+
+    // Retire the frames this write will overwrite before touching them.
+    // Under DropNewest this never passes a live cursor (to_write <= available).
+    const uint64_t end = write_pos + to_write;
+    const uint64_t oldest = end > capacity ? end - capacity : 0;
+    if (oldest > header_->oldest_pos.load(std::memory_order_relaxed)) {
+        header_->oldest_pos.store(oldest, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    header_->read_pos.store(std::max(tail, oldest), std::memory_order_release);
+    if (to_write > available)
+        overwrittenFrames_.fetch_add(to_write - available, std::memory_order_relaxed);
 
-    // Write data in up to two segments (wrap-around)
+    // Split at the wrap point
     const uint32_t write_index = static_cast<uint32_t>(write_pos) & mask_;
     const uint32_t first_chunk = std::min(to_write, capacity - write_index);
     const uint32_t second_chunk = to_write - first_chunk;
 
-    // First segment
-    std::memcpy(data_ + static_cast<size_t>(write_index) * channels,
-                data,
-                static_cast<size_t>(first_chunk) * channels * sizeof(float));
+    pendingWritePos_ = write_pos;
+    pendingWriteFrames_ = to_write;
 
-    // Second segment (after wrap-around)
+    WriteRegion region;
+    region.format = format_;
+    region.layout = layout_;
+    region.planeStride = planeStride_;
+    region.position = write_pos;
+    region.bytes1 = data_ + static_cast<size_t>(write_index) * strideBytes_;
+    region.frames1 = first_chunk;
     if (second_chunk > 0) {
-        std::memcpy(data_,
-                    data + static_cast<size_t>(first_chunk) * channels,
-                    static_cast<size_t>(second_chunk) * channels * sizeof(float));
+        region.bytes2 = data_;
+        region.frames2 = second_chunk;
+    }
+    if (format_ == SampleFormat::Float32) {
+        region.span1 = reinterpret_cast<float*>(region.bytes1);
+        region.span2 = reinterpret_cast<float*>(region.bytes2);
     }
+    return region;
+}
+
+void RingBuffer::commitWrite(uint32_t frames)
+{
+    const uint32_t to_commit = std::min(frames, pendingWriteFrames_);
+    pendingWriteFrames_ = 0;
+    if (to_commit == 0 || detached_.load(std::memory_order_acquire) || !isValid()) return;
 
     // Publish the new write position with release semantics
-    // so the consumer sees the written data
-    header_->write_pos.store(write_pos + to_write, std::memory_order_release);
+    // so the consumer sees the written data (and where the newest block starts)
+    header_->last_block_pos.store(pendingWritePos_, std::memory_order_relaxed);
+    header_->write_pos.store(pendingWritePos_ + to_commit, std::memory_order_release);
+}
+
+uint32_t RingBuffer::write(const float* data, uint32_t frames)
+{
+    const WriteRegion region = beginWrite(frames);
+    const uint32_t to_write = region.frames();
+    if (to_write == 0) return 0;
+
+    const uint32_t channels = header_->channels;
+
+    if (layout_ == SampleLayout::Planar) {
+        // De-interleave into one plane per channel
+        packInterleavedToPlanes(format_, data, channels, region.frames1, region.bytes1,
+                                planeStride_, ditherMode_, ditherState_);
+        if (region.frames2 > 0) {
+            packInterleavedToPlanes(format_, data + static_cast<size_t>(region.frames1) * channels,
+                                    channels, region.frames2, region.bytes2,
+                                    planeStride_, ditherMode_, ditherState_);
+        }
+        commitWrite(to_write);
+        return to_write;
+    }
+
+    // First segment (plain copy for Float32, pack for compact formats)
+    packSamples(format_, data, static_cast<size_t>(region.frames1) * channels,
+                region.bytes1, ditherMode_, ditherState_);
+
+    // Second segment (after wrap-around)
+    if (region.frames2 > 0) {
+        packSamples(format_, data + static_cast<size_t>(region.frames1) * channels,
+                    static_cast<size_t>(region.frames2) * channels,
+                    region.bytes2, ditherMode_, ditherState_);
+    }
 
+    commitWrite(to_write);
     return to_write;
 }
 
-uint32_t RingBuffer::read(float* data, uint32_t frames)
+RingBuffer::ReadRegion RingBuffer::beginRead(uint32_t frames)
 {
-    if (detached_.load(std::memory_order_acquire)) return 0;
-    if (!isValid() || frames == 0) return 0;
+    pendingReadFrames_ = 0;
+    if (detached_.load(std::memory_order_acquire)) return {};
+    if (!isValid() || consumerSlot_ < 0) return {};
+
+    auto& slot = header_->consumers[consumerSlot_];
+
+    // Evicted by the producer (we stalled) — re-join at the live edge.
+    // If the table is full, claimConsumerSlot() keeps our old slot index and
+    // token, so the next read retries.
+    if (slot.owner.load(std::memory_order_acquire) != consumerToken_) {
+        if (claimConsumerSlot(header_->write_pos.load(std::memory_order_acquire)))
+            ++evictionCount_;
+        return {};
+    }
+
+    // Heartbeat: tells the producer we are alive even when nothing is readable
+    slot.heartbeat.store(++heartbeat_, std::memory_order_relaxed);
+
+    if (frames == 0) return {};
 
-    const uint32_t channels = header_->channels;
     const uint32_t capacity = header_->buffer_frames;
     const uint64_t write_pos = header_->write_pos.load(std::memory_order_acquire);
-    const uint64_t read_pos = header_->read_pos.load(std::memory_order_relaxed);
+    uint64_t slot_pos = slot.read_pos.load(std::memory_order_relaxed);
+
+    // Lapped: frames behind oldest_pos are gone or being overwritten. This
+    // happens when an overwrite-oldest producer laps a stalled consumer, or
+    // (under either policy) in the claim race, see claimConsumerSlot. Resume
+    // at the newest block instead of replaying a ring's worth of stale audio,
+    // and move the cursor now so an empty read does not count the same lap twice.
+    // oldest_pos is raised before write_pos, so oldest >= write_pos - capacity.
+    uint64_t read_pos = slot_pos;
+    const uint64_t oldest = header_->oldest_pos.load(std::memory_order_acquire);
+    if (static_cast<int64_t>(oldest - read_pos) > 0) {
+        const uint64_t newest = header_->last_block_pos.load(std::memory_order_relaxed);
+        read_pos = std::min(std::max(newest, oldest), write_pos);
+        uint64_t expected = slot_pos;
+        if (slot.read_pos.compare_exchange_strong(expected, read_pos, std::memory_order_release,
+                                                  std::memory_order_relaxed))
+            slot_pos = read_pos;
+        ++lapCount_;
+    }
 
     // Calculate available data
-    const uint64_t available64 = write_pos - read_pos;
-    const uint32_t available = static_cast<uint32_t>(std::min(available64, static_cast<uint64_t>(capacity)));
+    const uint32_t available = static_cast<uint32_t>(write_pos - read_pos);
     const uint32_t to_read = std::min(frames, available);
 
-    if (to_read == 0) return 0;
+    if (to_read == 0) return {};
 
-    // Read data in up to two segments (wrap-around)
+    // Split at the wrap point
     const uint32_t read_index = static_cast<uint32_t>(read_pos) & mask_;
     const uint32_t first_chunk = std::min(to_read, capacity - read_index);
     const uint32_t second_chunk = to_read - first_chunk;
 
-    // First segment
-    std::memcpy(data,
-                data_ + static_cast<size_t>(read_index) * channels,
-                static_cast<size_t>(first_chunk) * channels * sizeof(float));
-
-    // Second segment (after wrap-around)
+    pendingSlotPos_ = slot_pos;
+    pendingReadPos_ = read_pos;
+    pendingReadFrames_ = to_read;
+
+    ReadRegion region;
+    region.format = format_;
+    region.layout = layout_;
+    region.planeStride = planeStride_;
+    region.position = read_pos;
+    region.bytes1 = data_ + static_cast<size_t>(read_index) * strideBytes_;
+    region.frames1 = first_chunk;
     if (second_chunk > 0) {
-        std::memcpy(data + static_cast<size_t>(first_chunk) * channels,
-                    data_ + 0,
-                    static_cast<size_t>(second_chunk) * channels * sizeof(float));
+        region.bytes2 = data_;
+        region.frames2 = second_chunk;
     }
+    if (format_ == SampleFormat::Float32) {
+        region.span1 = reinterpret_cast<const float*>(region.bytes1);
+        region.span2 = reinterpret_cast<const float*>(region.bytes2);
+    }
+    return region;
+}
+
+bool RingBuffer::commitRead(uint32_t frames)
+{
+    const uint32_t to_commit = std::min(frames, pendingReadFrames_);
+    pendingReadFrames_ = 0;
+    if (to_commit == 0 || detached_.load(std::memory_order_acquire) ||
+        !isValid() || consumerSlot_ < 0)
+        return true;
+
+    // Torn-read check: did the producer retire our region while we copied it?
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header_->oldest_pos.load(std::memory_order_relaxed) > pendingReadPos_)
+        return false;
+
+    // Publish the new read position with release semantics. CAS so that a
+    // late store after eviction never clobbers the slot's next owner.
+    uint64_t expected = pendingSlotPos_;
+    header_->consumers[consumerSlot_].read_pos.compare_exchange_strong(
+        expected, pendingReadPos_ + to_commit,
+        std::memory_order_release, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t RingBuffer::read(float* data, uint32_t frames)
+{
+    // A copy torn by an overwrite-oldest producer is retried once; the retry
+    // starts at the newest block, which the producer will not reach for a
+    // whole ring's worth of writes.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const ReadRegion region = beginRead(frames);
+        const uint32_t to_read = region.frames();
+        if (to_read == 0) return 0;
+
+        const uint32_t channels = header_->channels;
+
+        if (layout_ == SampleLayout::Planar) {
+            // Interleave from the per-channel planes
+            unpackPlanesToInterleaved(format_, region.bytes1, planeStride_, channels,
+                                      region.frames1, data);
+            if (region.frames2 > 0) {
+                unpackPlanesToInterleaved(format_, region.bytes2, planeStride_, channels, region.frames2,
+                                          data + static_cast<size_t>(region.frames1) * channels);
+            }
+        } else {
+            // First segment (plain copy for Float32, unpack for compact formats)
+            unpackSamples(format_, region.bytes1, static_cast<size_t>(region.frames1) * channels, data);
+
+            // Second segment (after wrap-around)
+            if (region.frames2 > 0) {
+                unpackSamples(format_, region.bytes2, static_cast<size_t>(region.frames2) * channels,
+                              data + static_cast<size_t>(region.frames1) * channels);
+            }
+        }
+
+        if (commitRead(to_read))
+            return to_read;
+    }
+    return 0;
+}
+
+// Block metadata seqlock:
+// - Writer: seq -> odd (relaxed), release fence, field stores (relaxed),
+//   seq -> even (release), then block_meta_head (release).
+// - Reader: seq (acquire), field loads (relaxed), acquire fence, seq again;
+//   the copy is valid only if both seq loads match and are even.
+
+void RingBuffer::publishBlockMeta(uint64_t streamPos, uint32_t frames,
+                                  uint64_t hostTimeNs, uint64_t sampleCounter)
+{
+    if (detached_.load(std::memory_order_acquire) || !isValid()) return;
+
+    const uint64_t head = header_->block_meta_head.load(std::memory_order_relaxed);
+    auto& entry = header_->block_meta[head & (BLOCK_META_CAPACITY - 1)];
+
+    const uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+    entry.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
 
-    // Publish the new read position with release semantics
-    header_->read_pos.store(read_pos + to_read, std::memory_order_release);
+    entry.frames.store(frames, std::memory_order_relaxed);
+    entry.stream_pos.store(streamPos, std::memory_order_relaxed);
+    entry.host_time_ns.store(hostTimeNs, std::memory_order_relaxed);
+    entry.sample_counter.store(sampleCounter, std::memory_order_relaxed);
 
-    return to_read;
+    entry.seq.store(seq + 2, std::memory_order_release);
+    header_->block_meta_head.store(head + 1, std::memory_order_release);
+}
+
+bool RingBuffer::readBlockMeta(const BlockMeta& entry, BlockMetaSnapshot& out) const
+{
+    // The producer rewrites an entry at most once per block, so a couple of
+    // retries is enough; give up rather than spin on the RT thread.
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        const uint32_t seq1 = entry.seq.load(std::memory_order_acquire);
+        if (seq1 & 1u) continue;
+
+        out.frames = entry.frames.load(std::memory_order_relaxed);
+        out.stream_pos = entry.stream_pos.load(std::memory_order_relaxed);
+        out.host_time_ns = entry.host_time_ns.load(std::memory_order_relaxed);
+        out.sample_counter = entry.sample_counter.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.seq.load(std::memory_order_relaxed) == seq1)
+            return true;
+    }
+    return false;
+}
+
+bool RingBuffer::latestBlockMeta(BlockMetaSnapshot& out) const
+{
+    if (!isValid()) return false;
+
+    const uint64_t head = header_->block_meta_head.load(std::memory_order_acquire);
+    if (head == 0) return false;
+    return readBlockMeta(header_->block_meta[(head - 1) & (BLOCK_META_CAPACITY - 1)], out);
+}
+
+bool RingBuffer::findBlockMeta(uint64_t streamPos, BlockMetaSnapshot& out) const
+{
+    if (!isValid()) return false;
+
+    const uint64_t head = header_->block_meta_head.load(std::memory_order_acquire);
+    const uint64_t oldest = head > BLOCK_META_CAPACITY ? head - BLOCK_META_CAPACITY : 0;
+
+    for (uint64_t n = head; n > oldest; --n) {
+        BlockMetaSnapshot meta;
+        if (!readBlockMeta(header_->block_meta[(n - 1) & (BLOCK_META_CAPACITY - 1)], meta))
+            continue;
+        if (streamPos >= meta.stream_pos && streamPos - meta.stream_pos < meta.frames) {
+            out = meta;
+            return true;
+        }
+        // Entries are published in stream order — nothing older can match
+        if (meta.stream_pos + meta.frames <= streamPos)
+            return false;
+    }
+    return false;
+}
+
+void RingBuffer::reportLatencyUs(uint32_t latencyUs)
+{
+    if (detached_.load(std::memory_order_acquire) || !isValid() || consumerSlot_ < 0) return;
+    header_->consumers[consumerSlot_].latency_us.store(latencyUs, std::memory_order_relaxed);
+}
+
+uint32_t RingBuffer::getMaxConsumerLatencyUs() const
+{
+    if (!isValid()) return 0;
+
+    uint32_t maxUs = 0;
+    for (const auto& slot : header_->consumers) {
+        const uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner != 0 && owner != CONSUMER_SLOT_CLAIMING)
+            maxUs = std::max(maxUs, slot.latency_us.load(std::memory_order_relaxed));
+    }
+    return maxUs;
+}
+
+void RingBuffer::publishConsumerStats(const ConsumerStatsSnapshot& stats)
+{
+    if (detached_.load(std::memory_order_acquire) || !isValid() || consumerSlot_ < 0) return;
+    auto& out = header_->consumer_stats[consumerSlot_];
+    out.blocks.store(stats.blocks, std::memory_order_relaxed);
+    out.frames_padded.store(stats.frames_padded, std::memory_order_relaxed);
+    out.frames_skipped.store(stats.frames_skipped, std::memory_order_relaxed);
+    out.frames_concealed.store(stats.frames_concealed, std::memory_order_relaxed);
+    out.underruns.store(stats.underruns, std::memory_order_relaxed);
+    out.fill_frames.store(stats.fill_frames, std::memory_order_relaxed);
+    out.resample_ratio_micros.store(stats.resample_ratio_micros, std::memory_order_relaxed);
+    out.process_ns.store(stats.process_ns, std::memory_order_relaxed);
+    out.process_peak_ns.store(stats.process_peak_ns, std::memory_order_relaxed);
+    for (uint32_t b = 0; b < FILL_HISTOGRAM_BINS; ++b)
+        out.fill_histogram[b].store(stats.fill_histogram[b], std::memory_order_relaxed);
+}
+
+uint32_t RingBuffer::readConsumerStats(ConsumerStatsSnapshot* out, uint32_t maxConsumers) const
+{
+    if (!isValid() || out == nullptr) return 0;
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < MAX_CONSUMERS && count < maxConsumers; ++i) {
+        const auto& slot = header_->consumers[i];
+        const uint64_t owner = slot.owner.load(std::memory_order_acquire);
+        if (owner == 0 || owner == CONSUMER_SLOT_CLAIMING)
+            continue;
+
+        const auto& in = header_->consumer_stats[i];
+        auto& s = out[count++];
+        s.slot = i;
+        s.latency_us = slot.latency_us.load(std::memory_order_relaxed);
+        s.blocks = in.blocks.load(std::memory_order_relaxed);
+        s.frames_padded = in.frames_padded.load(std::memory_order_relaxed);
+        s.frames_skipped = in.frames_skipped.load(std::memory_order_relaxed);
+        s.frames_concealed = in.frames_concealed.load(std::memory_order_relaxed);
+        s.underruns = in.underruns.load(std::memory_order_relaxed);
+        s.fill_frames = in.fill_frames.load(std::memory_order_relaxed);
+        s.resample_ratio_micros = in.resample_ratio_micros.load(std::memory_order_relaxed);
+        s.process_ns = in.process_ns.load(std::memory_order_relaxed);
+        s.process_peak_ns = in.process_peak_ns.load(std::memory_order_relaxed);
+        for (uint32_t b = 0; b < FILL_HISTOGRAM_BINS; ++b)
+            s.fill_histogram[b] = in.fill_histogram[b].load(std::memory_order_relaxed);
+    }
+    return count;
 }
 
 uint32_t RingBuffer::availableRead() const
@@ -218,7 +756,9 @@ uint32_t RingBuffer::availableRead() const
     if (!isValid()) return 0;
 
     const uint64_t write_pos = header_->write_pos.load(std::memory_order_acquire);
-    const uint64_t read_pos = header_->read_pos.load(std::memory_order_relaxed);
+    const uint64_t read_pos = (consumerSlot_ >= 0)
+        ? header_->consumers[consumerSlot_].read_pos.load(std::memory_order_relaxed)
+        : slowestCursor(write_pos);
     const uint64_t available = write_pos - read_pos;
     return static_cast<uint32_t>(std::min(available, static_cast<uint64_t>(header_->buffer_frames)));
 }
@@ -227,9 +767,8 @@ uint32_t RingBuffer::availableWrite() const
 {
     if (!isValid()) return 0;
 
-    const uint64_t write_pos = header_->write_pos.load(std::memory_order_relaxed);
-    const uint64_t read_pos = header_->read_pos.load(std::memory_order_acquire);
-    const uint64_t used = write_pos - read_pos;
+    const uint64_t write_pos = header_->write_pos.load(std::memory_order_acquire);
+    const uint64_t used = write_pos - slowestCursor(write_pos);
     // Clamp to [0, buffer_frames] — mirrors availableRead() safety guard
     const uint64_t clamped = std::min(used, static_cast<uint64_t>(header_->buffer_frames));
     return header_->buffer_frames - static_cast<uint32_t>(clamped);
@@ -240,6 +779,12 @@ void RingBuffer::reset()
     if (!isValid()) return;
     header_->write_pos.store(0, std::memory_order_relaxed);
     header_->read_pos.store(0, std::memory_order_relaxed);
+    header_->oldest_pos.store(0, std::memory_order_relaxed);
+    header_->last_block_pos.store(0, std::memory_order_relaxed);
+    for (auto& slot : header_->consumers)
+        slot.read_pos.store(0, std::memory_order_relaxed);
+    // Stamped stream positions are meaningless after a rewind
+    header_->block_meta_head.store(0, std::memory_order_relaxed);
 }
 
 uint32_t RingBuffer::getChannels() const
@@ -257,4 +802,14 @@ uint32_t RingBuffer::getCapacity() const
     return isValid() ? header_->buffer_frames : 0;
 }
 
+SampleFormat RingBuffer::getSampleFormat() const
+{
+    return isValid() ? format_ : SampleFormat::Float32;
+}
+
+SampleLayout RingBuffer::getSampleLayout() const
+{
+    return isValid() ? layout_ : SampleLayout::Interleaved;
+}
+
 } // namespace directpipe
@@ -0,0 +1,477 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file SampleConvert.cpp
+ * @brief float <-> SampleFormat conversion kernels
+ */
+
+#include "directpipe/SampleConvert.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DIRECTPIPE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace directpipe {
+
+namespace {
+
+constexpr float kInt16Scale = 32767.0f;
+constexpr float kInt24Scale = 8388607.0f;
+
+/// Clamp to [-1, 1]; NaN maps to -1 (same as the SSE2 max/min sequence)
+inline float clampUnit(float x)
+{
+    if (!(x >= -1.0f)) return -1.0f;
+    return x > 1.0f ? 1.0f : x;
+}
+
+/// TPDF noise in LSB units: difference of two uniforms in [0, 1) -> (-1, 1)
+inline float tpdfNoise(DitherState& state)
+{
+    auto next = [&state]() {
+        uint32_t x = state.rng;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state.rng = x;
+        return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+    };
+    const float a = next();
+    return a - next();
+}
+
+inline int32_t quantize(float x, float scale, int32_t minVal, int32_t maxVal,
+                        DitherMode dither, DitherState& state)
+{
+    float v = clampUnit(x) * scale;
+    if (dither == DitherMode::Tpdf)
+        v += tpdfNoise(state);
+    const long q = std::lrintf(v);
+    return static_cast<int32_t>(q < minVal ? minVal : (q > maxVal ? maxVal : q));
+}
+
+// ─── IEEE binary16 ──────────────────────────────────────────────
+
+inline uint16_t floatToHalf(float f)
+{
+    uint32_t x;
+    std::memcpy(&x, &f, sizeof(x));
+    const uint32_t sign = (x >> 16) & 0x8000u;
+    const uint32_t absx = x & 0x7FFFFFFFu;
+
+    if (absx >= 0x7F800000u)  // Inf / NaN (keep NaN quiet)
+        return static_cast<uint16_t>(sign | 0x7C00u | (absx > 0x7F800000u ? 0x200u : 0u));
+    if (absx >= 0x477FF000u)  // >= 65520 rounds to Inf
+        return static_cast<uint16_t>(sign | 0x7C00u);
+
+    if (absx < 0x38800000u) {  // below 2^-14: half subnormal or zero
+        if (absx <= 0x33000000u)  // <= 2^-25 rounds (to even) to zero
+            return static_cast<uint16_t>(sign);
+        const uint32_t exp = absx >> 23;
+        const uint32_t mant = (absx & 0x7FFFFFu) | 0x800000u;
+        const uint32_t shift = 126u - exp;
+        uint32_t m = mant >> shift;
+        const uint32_t rem = mant & ((1u << shift) - 1u);
+        const uint32_t halfway = 1u << (shift - 1u);
+        if (rem > halfway || (rem == halfway && (m & 1u))) ++m;
+        return static_cast<uint16_t>(sign | m);
+    }
+
+    // Normal: rebias exponent (127 -> 15), round mantissa 23 -> 10 bits to nearest even.
+    // A mantissa carry correctly bumps the exponent.
+    uint32_t h = (absx - 0x38000000u) >> 13;
+    const uint32_t rem = absx & 0x1FFFu;
+    if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) ++h;
+    return static_cast<uint16_t>(sign | h);
+}
+
+inline float halfToFloat(uint16_t h)
+{
+    const uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    const uint32_t exp = (h >> 10) & 0x1Fu;
+    const uint32_t mant = h & 0x3FFu;
+
+    uint32_t bits;
+    if (exp == 0) {
+        // Zero / subnormal: mant * 2^-24
+        const float f = static_cast<float>(mant) * (1.0f / 16777216.0f);
+        return sign ? -f : f;
+    } else if (exp == 31) {
+        bits = sign | 0x7F800000u | (mant << 13);
+    } else {
+        bits = sign | ((exp + 112u) << 23) | (mant << 13);
+    }
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// ─── Per-format codecs (one sample) ─────────────────────────────
+
+template <SampleFormat F> struct Codec;
+
+template <> struct Codec<SampleFormat::Float32> {
+    static constexpr size_t kBytes = 4;
+    static void encode(float x, uint8_t* out, DitherMode, DitherState&) { std::memcpy(out, &x, 4); }
+    static float decode(const uint8_t* in) { float x; std::memcpy(&x, in, 4); return x; }
+};
+
+template <> struct Codec<SampleFormat::Int16> {
+    static constexpr size_t kBytes = 2;
+    static void encode(float x, uint8_t* out, DitherMode d, DitherState& s)
+    {
+        const auto v = static_cast<int16_t>(quantize(x, kInt16Scale, -32768, 32767, d, s));
+        std::memcpy(out, &v, 2);
+    }
+    static float decode(const uint8_t* in)
+    {
+        int16_t v;
+        std::memcpy(&v, in, 2);
+        return static_cast<float>(v) * (1.0f / kInt16Scale);
+    }
+};
+
+template <> struct Codec<SampleFormat::Int24> {
+    static constexpr size_t kBytes = 3;
+    static void encode(float x, uint8_t* out, DitherMode d, DitherState& s)
+    {
+        const auto v = static_cast<uint32_t>(quantize(x, kInt24Scale, -8388608, 8388607, d, s));
+        out[0] = static_cast<uint8_t>(v);
+        out[1] = static_cast<uint8_t>(v >> 8);
+        out[2] = static_cast<uint8_t>(v >> 16);
+    }
+    static float decode(const uint8_t* in)
+    {
+        // Assemble in the top 24 bits, then arithmetic-shift to sign-extend
+        const auto u = (static_cast<uint32_t>(in[0]) << 8)
+                     | (static_cast<uint32_t>(in[1]) << 16)
+                     | (static_cast<uint32_t>(in[2]) << 24);
+        const int32_t v = static_cast<int32_t>(u) >> 8;
+        return static_cast<float>(v) * (1.0f / kInt24Scale);
+    }
+};
+
+template <> struct Codec<SampleFormat::Float16> {
+    static constexpr size_t kBytes = 2;
+    static void encode(float x, uint8_t* out, DitherMode, DitherState&)
+    {
+        const uint16_t h = floatToHalf(x);
+        std::memcpy(out, &h, 2);
+    }
+    static float decode(const uint8_t* in)
+    {
+        uint16_t h;
+        std::memcpy(&h, in, 2);
+        return halfToFloat(h);
+    }
+};
+
+// ─── Generic loops ──────────────────────────────────────────────
+
+template <SampleFormat F>
+void packSamplesT(const float* src, size_t count, uint8_t* dest, DitherMode d, DitherState& s)
+{
+    for (size_t i = 0; i < count; ++i)
+        Codec<F>::encode(src[i], dest + i * Codec<F>::kBytes, d, s);
+}
+
+template <SampleFormat F>
+void unpackSamplesT(const uint8_t* src, size_t count, float* dest)
+{
+    for (size_t i = 0; i < count; ++i)
+        dest[i] = Codec<F>::decode(src + i * Codec<F>::kBytes);
+}
+
+template <SampleFormat F>
+void packStereoT(const float* left, const float* right, uint32_t frames, uint8_t* dest,
+                 DitherMode d, DitherState& s)
+{
+    constexpr size_t kFrame = 2 * Codec<F>::kBytes;
+    for (uint32_t i = 0; i < frames; ++i) {
+        Codec<F>::encode(left[i], dest + i * kFrame, d, s);
+        Codec<F>::encode(right[i], dest + i * kFrame + Codec<F>::kBytes, d, s);
+    }
+}
+
+template <SampleFormat F>
+void unpackStereoT(const uint8_t* src, uint32_t frames, float* left, float* right)
+{
+    constexpr size_t kFrame = 2 * Codec<F>::kBytes;
+    if (left)
+        for (uint32_t i = 0; i < frames; ++i)
+            left[i] = Codec<F>::decode(src + i * kFrame);
+    if (right)
+        for (uint32_t i = 0; i < frames; ++i)
+            right[i] = Codec<F>::decode(src + i * kFrame + Codec<F>::kBytes);
+}
+
+// ─── SSE2 int16 fast paths (no dither) ──────────────────────────
+
+#if DIRECTPIPE_SSE2
+inline __m128i floatToInt16x4(__m128 v)
+{
+    // max/min return the second operand for NaN, so NaN -> -1 like clampUnit()
+    v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, _mm_set1_ps(kInt16Scale)));
+}
+
+/// Returns the number of samples handled (a multiple of 8)
+size_t packInt16Sse2(const float* src, size_t count, int16_t* dest)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i a = floatToInt16x4(_mm_loadu_ps(src + i));
+        const __m128i b = floatToInt16x4(_mm_loadu_ps(src + i + 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packs_epi32(a, b));
+    }
+    return i;
+}
+
+size_t unpackInt16Sse2(const int16_t* src, size_t count, float* dest)
+{
+    const __m128 inv = _mm_set1_ps(1.0f / kInt16Scale);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // Duplicate each int16 into both halves of an int32, then shift to sign-extend
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), inv));
+        _mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), inv));
+    }
+    return i;
+}
+
+/// Returns the number of frames handled (a multiple of 4)
+uint32_t packStereoInt16Sse2(const float* left, const float* right, uint32_t frames, int16_t* dest)
+{
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128i l = floatToInt16x4(_mm_loadu_ps(left + i));
+        const __m128i r = floatToInt16x4(_mm_loadu_ps(right + i));
+        // [L0..L3 x4] / [R0..R3 x4] -> L0 R0 L1 R1 L2 R2 L3 R3
+        const __m128i inter = _mm_unpacklo_epi16(_mm_packs_epi32(l, l), _mm_packs_epi32(r, r));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + static_cast<size_t>(i) * 2), inter);
+    }
+    return i;
+}
+
+uint32_t unpackStereoInt16Sse2(const int16_t* src, uint32_t frames, float* left, float* right)
+{
+    const __m128 inv = _mm_set1_ps(1.0f / kInt16Scale);
+    uint32_t i = 0;
+    for (; i + 4 <= frames; i += 4) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + static_cast<size_t>(i) * 2));
+        const __m128 a = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), inv);
+        const __m128 b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), inv);
+        // a = L0 R0 L1 R1, b = L2 R2 L3 R3
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    return i;
+}
+#endif
+
+} // namespace
+
+// ─── Public entry points ────────────────────────────────────────
+
+void packSamples(SampleFormat format, const float* src, size_t count, void* dest,
+                 DitherMode dither, DitherState& state)
+{
+    auto* out = static_cast<uint8_t*>(dest);
+    switch (format) {
+        case SampleFormat::Float32:
+            std::memcpy(out, src, count * sizeof(float));
+            break;
+        case SampleFormat::Int16: {
+            size_t done = 0;
+#if DIRECTPIPE_SSE2
+            if (dither == DitherMode::None)
+                done = packInt16Sse2(src, count, reinterpret_cast<int16_t*>(out));
+#endif
+            packSamplesT<SampleFormat::Int16>(src + done, count - done, out + done * 2, dither, state);
+            break;
+        }
+        case SampleFormat::Int24:
+            packSamplesT<SampleFormat::Int24>(src, count, out, dither, state);
+            break;
+        case SampleFormat::Float16:
+            packSamplesT<SampleFormat::Float16>(src, count, out, dither, state);
+            break;
+    }
+}
+
+void unpackSamples(SampleFormat format, const void* src, size_t count, float* dest)
+{
+    const auto* in = static_cast<const uint8_t*>(src);
+    switch (format) {
+        case SampleFormat::Float32:
+            std::memcpy(dest, in, count * sizeof(float));
+            break;
+        case SampleFormat::Int16: {
+            size_t done = 0;
+#if DIRECTPIPE_SSE2
+            done = unpackInt16Sse2(reinterpret_cast<const int16_t*>(in), count, dest);
+#endif
+            unpackSamplesT<SampleFormat::Int16>(in + done * 2, count - done, dest + done);
+            break;
+        }
+        case SampleFormat::Int24:
+            unpackSamplesT<SampleFormat::Int24>(in, count, dest);
+            break;
+        case SampleFormat::Float16:
+            unpackSamplesT<SampleFormat::Float16>(in, count, dest);
+            break;
+    }
+}
+
+void packInterleaved(SampleFormat format, const float* const* src, uint32_t channels,
+                     uint32_t frames, void* dest, DitherMode dither, DitherState& state)
+{
+    if (channels == 1) {
+        packSamples(format, src[0], frames, dest, dither, state);
+        return;
+    }
+
+    auto* out = static_cast<uint8_t*>(dest);
+    const float* left = src[0];
+    const float* right = src[1];
+    switch (format) {
+        case SampleFormat::Float32:
+            packStereoT<SampleFormat::Float32>(left, right, frames, out, dither, state);
+            break;
+        case SampleFormat::Int16: {
+            uint32_t done = 0;
+#if DIRECTPIPE_SSE2
+            if (dither == DitherMode::None)
+                done = packStereoInt16Sse2(left, right, frames, reinterpret_cast<int16_t*>(out));
+#endif
+            packStereoT<SampleFormat::Int16>(left + done, right + done, frames - done,
+                                             out + static_cast<size_t>(done) * 4, dither, state);
+            break;
+        }
+        case SampleFormat::Int24:
+            packStereoT<SampleFormat::Int24>(left, right, frames, out, dither, state);
+            break;
+        case SampleFormat::Float16:
+            packStereoT<SampleFormat::Float16>(left, right, frames, out, dither, state);
+            break;
+    }
+}
+
+void unpackInterleaved(SampleFormat format, const void* src, uint32_t channels,
+                       uint32_t frames, float* const* dest)
+{
+    if (channels == 1) {
+        if (dest[0]) unpackSamples(format, src, frames, dest[0]);
+        return;
+    }
+
+    const auto* in = static_cast<const uint8_t*>(src);
+    float* left = dest[0];
+    float* right = dest[1];
+    switch (format) {
+        case SampleFormat::Float32:
+            unpackStereoT<SampleFormat::Float32>(in, frames, left, right);
+            break;
+        case SampleFormat::Int16: {
+            uint32_t done = 0;
+#if DIRECTPIPE_SSE2
+            if (left && right)
+                done = unpackStereoInt16Sse2(reinterpret_cast<const int16_t*>(in), frames, left, right);
+#endif
+            unpackStereoT<SampleFormat::Int16>(in + static_cast<size_t>(done) * 4, frames - done,
+                                               left ? left + done : nullptr,
+                                               right ? right + done : nullptr);
+            break;
+        }
+        case SampleFormat::Int24:
+            unpackStereoT<SampleFormat::Int24>(in, frames, left, right);
+            break;
+        case SampleFormat::Float16:
+            unpackStereoT<SampleFormat::Float16>(in, frames, left, right);
+            break;
+    }
+}
+
+void packPlanes(SampleFormat format, const float* const* src, uint32_t channels,
+                uint32_t frames, void* dest, size_t planeStride,
+                DitherMode dither, DitherState& state)
+{
+    auto* out = static_cast<uint8_t*>(dest);
+    for (uint32_t ch = 0; ch < channels; ++ch)
+        packSamples(format, src[ch], frames, out + ch * planeStride, dither, state);
+}
+
+void unpackPlanes(SampleFormat format, const void* src, size_t planeStride,
+                  uint32_t channels, uint32_t frames, float* const* dest)
+{
+    const auto* in = static_cast<const uint8_t*>(src);
+    for (uint32_t ch = 0; ch < channels; ++ch)
+        if (dest[ch]) unpackSamples(format, in + ch * planeStride, frames, dest[ch]);
+}
+
+// The interleaved <-> planes paths gather/scatter one channel at a time
+// through a small stack buffer, so every format reuses the contiguous kernels.
+namespace {
+constexpr uint32_t kGatherFrames = 256;
+}
+
+void packInterleavedToPlanes(SampleFormat format, const float* src, uint32_t channels,
+                             uint32_t frames, void* dest, size_t planeStride,
+                             DitherMode dither, DitherState& state)
+{
+    auto* out = static_cast<uint8_t*>(dest);
+    const size_t bps = bytesPerSample(format);
+    float gather[kGatherFrames];
+
+    for (uint32_t ch = 0; ch < channels; ++ch) {
+        for (uint32_t start = 0; start < frames; start += kGatherFrames) {
+            const uint32_t n = (frames - start) < kGatherFrames ? (frames - start) : kGatherFrames;
+            const float* in = src + static_cast<size_t>(start) * channels + ch;
+            for (uint32_t i = 0; i < n; ++i)
+                gather[i] = in[static_cast<size_t>(i) * channels];
+            packSamples(format, gather, n, out + ch * planeStride + start * bps, dither, state);
+        }
+    }
+}
+
+void unpackPlanesToInterleaved(SampleFormat format, const void* src, size_t planeStride,
+                               uint32_t channels, uint32_t frames, float* dest)
+{
+    const auto* in = static_cast<const uint8_t*>(src);
+    const size_t bps = bytesPerSample(format);
+    float scatter[kGatherFrames];
+
+    for (uint32_t ch = 0; ch < channels; ++ch) {
+        for (uint32_t start = 0; start < frames; start += kGatherFrames) {
+            const uint32_t n = (frames - start) < kGatherFrames ? (frames - start) : kGatherFrames;
+            unpackSamples(format, in + ch * planeStride + start * bps, n, scatter);
+            float* out = dest + static_cast<size_t>(start) * channels + ch;
+            for (uint32_t i = 0; i < n; ++i)
+                out[static_cast<size_t>(i) * channels] = scatter[i];
+        }
+    }
+}
+
+} // namespace directpipe
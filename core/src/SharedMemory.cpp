@@ -22,8 +22,30 @@
  */
 
 #include "directpipe/SharedMemory.h"
+#include <algorithm>
 #include <cassert>
 
+namespace directpipe {
+
+/// Fault in every page of a fresh mapping so the RT thread never takes a
+/// first-touch fault. The producer writes each page back to itself (allocating
+/// it); a consumer only reads, so it never races the producer's data.
+static void prefaultPages(void* data, size_t size, size_t pageSize, bool writable)
+{
+    if (!data || pageSize == 0) return;
+    volatile uint8_t* bytes = static_cast<volatile uint8_t*>(data);
+    uint8_t sink = 0;
+    for (size_t offset = 0; offset < size; offset += pageSize) {
+        if (writable)
+            bytes[offset] = bytes[offset];
+        else
+            sink = static_cast<uint8_t>(sink + bytes[offset]);
+    }
+    (void)sink;
+}
+
+} // namespace directpipe
+
 #ifdef _WIN32
 // ═══════════════════════════════════════════════════════════════
 // Windows Implementation
@@ -36,11 +58,13 @@ namespace directpipe {
 SharedMemory::~SharedMemory() { close(); }
 
 SharedMemory::SharedMemory(SharedMemory&& other) noexcept
-    : data_(other.data_), size_(other.size_), isCreator_(other.isCreator_), mapping_(other.mapping_)
+    : data_(other.data_), size_(other.size_), isCreator_(other.isCreator_),
+      applied_(other.applied_), mapping_(other.mapping_)
 {
     other.data_ = nullptr;
     other.size_ = 0;
     other.isCreator_ = false;
+    other.applied_ = {};
     other.mapping_ = nullptr;
 }
 
@@ -51,45 +75,77 @@ SharedMemory& SharedMemory::operator=(SharedMemory&& other) noexcept
         data_ = other.data_;
         size_ = other.size_;
         isCreator_ = other.isCreator_;
+        applied_ = other.applied_;
         mapping_ = other.mapping_;
         other.data_ = nullptr;
         other.size_ = 0;
         other.isCreator_ = false;
+        other.applied_ = {};
         other.mapping_ = nullptr;
     }
     return *this;
 }
 
-bool SharedMemory::create(const std::string& name, size_t size)
+bool SharedMemory::create(const std::string& name, size_t size, const SharedMemoryOptions& options)
 {
     close();
 
-    DWORD sizeHigh = static_cast<DWORD>((size >> 32) & 0xFFFFFFFF);
-    DWORD sizeLow = static_cast<DWORD>(size & 0xFFFFFFFF);
+    // Large pages: the section must be a multiple of the large page size and
+    // the process needs SeLockMemoryPrivilege. Fall back to normal pages.
+    bool largePages = false;
+    if (options.hugePages) {
+        const SIZE_T largePage = GetLargePageMinimum();
+        if (largePage != 0 && size >= largePage) {
+            const size_t rounded = (size + largePage - 1) / largePage * largePage;
+            mapping_ = CreateFileMappingA(
+                INVALID_HANDLE_VALUE, nullptr,
+                PAGE_READWRITE | SEC_COMMIT | SEC_LARGE_PAGES,
+                static_cast<DWORD>((rounded >> 32) & 0xFFFFFFFF),
+                static_cast<DWORD>(rounded & 0xFFFFFFFF),
+                name.c_str());
+            if (mapping_) {
+                data_ = MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS | FILE_MAP_LARGE_PAGES, 0, 0, rounded);
+                if (data_) {
+                    largePages = true;
+                } else {
+                    CloseHandle(mapping_);
+                    mapping_ = nullptr;
+                }
+            }
+        }
+    }
 
-    mapping_ = CreateFileMappingA(
-        INVALID_HANDLE_VALUE,  // Use paging file
-        nullptr,               // Default security
-        PAGE_READWRITE,        // Read/write access
-        sizeHigh, sizeLow,
-        name.c_str()
-    );
+    if (!largePages) {
+        DWORD sizeHigh = static_cast<DWORD>((size >> 32) & 0xFFFFFFFF);
+        DWORD sizeLow = static_cast<DWORD>(size & 0xFFFFFFFF);
 
-    if (!mapping_) return false;
+        mapping_ = CreateFileMappingA(
+            INVALID_HANDLE_VALUE,  // Use paging file
+            nullptr,               // Default security
+            PAGE_READWRITE,        // Read/write access
+            sizeHigh, sizeLow,
+            name.c_str()
+        );
 
-    data_ = MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size);
-    if (!data_) {
-        CloseHandle(mapping_);
-        mapping_ = nullptr;
-        return false;
+        if (!mapping_) return false;
+
+        data_ = MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!data_) {
+            CloseHandle(mapping_);
+            mapping_ = nullptr;
+            return false;
+        }
     }
 
     size_ = size;
     isCreator_ = true;  // Mark as creator so close() can clean up properly
+    applyOptions(options, true);
+    applied_.hugePages = largePages;  // Large pages are always resident
+    if (largePages) applied_.lock = true;
     return true;
 }
 
-bool SharedMemory::open(const std::string& name, size_t size)
+bool SharedMemory::open(const std::string& name, size_t size, const SharedMemoryOptions& options)
 {
     close();
 
@@ -124,9 +180,57 @@ bool SharedMemory::open(const std::string& name, size_t size)
         size_ = size;
     }
 
+    applyOptions(options, false);
+    return true;
+}
+
+bool SharedMemory::openOrCreate(const std::string& name, size_t size)
+{
+    close();
+
+    // CreateFileMapping returns the existing section (ERROR_ALREADY_EXISTS)
+    // when another process created it first; a new section is zero-filled.
+    mapping_ = CreateFileMappingA(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>((static_cast<uint64_t>(size) >> 32) & 0xFFFFFFFF),
+        static_cast<DWORD>(size & 0xFFFFFFFF),
+        name.c_str());
+    if (!mapping_) return false;
+
+    data_ = MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!data_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+        return false;
+    }
+
+    size_ = size;
+    isCreator_ = false;  // Shared by every producer — nobody owns it
+    applied_ = {};
     return true;
 }
 
+void SharedMemory::applyOptions(const SharedMemoryOptions& options, bool writable)
+{
+    applied_ = {};
+
+    if (options.prefault) {
+        SYSTEM_INFO si{};
+        GetSystemInfo(&si);
+        prefaultPages(data_, size_, si.dwPageSize, writable);
+        applied_.prefault = true;
+    }
+
+    // VirtualLock fails beyond the working-set minimum; grow it by our size first
+    if (options.lock) {
+        SIZE_T minWs = 0, maxWs = 0;
+        HANDLE process = GetCurrentProcess();
+        if (GetProcessWorkingSetSize(process, &minWs, &maxWs))
+            SetProcessWorkingSetSize(process, minWs + size_, (std::max)(maxWs, minWs + size_));
+        applied_.lock = VirtualLock(data_, size_) != FALSE;
+    }
+}
+
 void SharedMemory::close()
 {
     if (data_) {
@@ -139,6 +243,7 @@ void SharedMemory::close()
     }
     size_ = 0;
     isCreator_ = false;
+    applied_ = {};
 }
 
 // ─── NamedEvent ─────────────────────────────────────────────────
@@ -195,6 +300,11 @@ void NamedEvent::close()
 
 bool NamedEvent::isOpen() const { return event_ != nullptr; }
 
+// Auto-reset events already coalesce and SetEvent is cheap — no shared word needed
+bool NamedEvent::bindSharedWord(std::atomic<uint32_t>*, std::atomic<uint32_t>*) { return false; }
+
+bool NamedEvent::isSharedWordBound() const { return false; }
+
 } // namespace directpipe
 
 #else
@@ -217,11 +327,12 @@ SharedMemory::~SharedMemory() { close(); }
 
 SharedMemory::SharedMemory(SharedMemory&& other) noexcept
     : data_(other.data_), size_(other.size_), isCreator_(other.isCreator_),
-      fd_(other.fd_), name_(::std::move(other.name_))
+      applied_(other.applied_), fd_(other.fd_), name_(::std::move(other.name_))
 {
     other.data_ = nullptr;
     other.size_ = 0;
     other.isCreator_ = false;
+    other.applied_ = {};
     other.fd_ = -1;
 }
 
@@ -232,11 +343,13 @@ SharedMemory& SharedMemory::operator=(SharedMemory&& other) noexcept
         data_ = other.data_;
         size_ = other.size_;
         isCreator_ = other.isCreator_;
+        applied_ = other.applied_;
         fd_ = other.fd_;
         name_ = ::std::move(other.name_);
         other.data_ = nullptr;
         other.size_ = 0;
         other.isCreator_ = false;
+        other.applied_ = {};
         other.fd_ = -1;
     }
     return *this;
@@ -258,7 +371,7 @@ static ::std::string toPosixName(const ::std::string& name)
     return "/" + result;
 }
 
-bool SharedMemory::create(const ::std::string& name, size_t size)
+bool SharedMemory::create(const ::std::string& name, size_t size, const SharedMemoryOptions& options)
 {
     close();
     name_ = toPosixName(name);
@@ -287,10 +400,11 @@ bool SharedMemory::create(const ::std::string& name, size_t size)
 
     size_ = size;
     isCreator_ = true;
+    applyOptions(options, true);
     return true;
 }
 
-bool SharedMemory::open(const ::std::string& name, size_t size)
+bool SharedMemory::open(const ::std::string& name, size_t size, const SharedMemoryOptions& options)
 {
     close();
     name_ = toPosixName(name);
@@ -324,9 +438,86 @@ bool SharedMemory::open(const ::std::string& name, size_t size)
 
     size_ = mapSize;
     isCreator_ = false;  // Consumer doesn't own the shared memory
+    applyOptions(options, false);
     return true;
 }
 
+bool SharedMemory::openOrCreate(const ::std::string& name, size_t size)
+{
+    close();
+    name_ = toPosixName(name);
+
+    // No unlink: keep whatever another producer already published
+    fd_ = shm_open(name_.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd_ < 0) return false;
+
+    struct ::stat st;
+    if (fstat(fd_, &st) < 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    // Growing from 0 zero-fills; two producers racing here truncate to the same size
+    if (static_cast<size_t>(st.st_size) < size
+        && ftruncate(fd_, static_cast<off_t>(size)) < 0) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    data_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    size_ = size;
+    isCreator_ = false;  // Shared by every producer — never unlinked
+    applied_ = {};
+    return true;
+}
+
+#if defined(__linux__)
+/// Whether the kernel backs shmem (tmpfs / shm_open) with transparent huge
+/// pages for an madvise'd region. "never"/"deny" ignore MADV_HUGEPAGE.
+static bool shmemHugePagesEnabled()
+{
+    int fd = ::open("/sys/kernel/mm/transparent_hugepage/shmem_enabled", O_RDONLY);
+    if (fd < 0) return false;
+    char buf[128] = {};
+    const ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+    ::close(fd);
+    if (n <= 0) return false;
+    return std::strstr(buf, "[always]") || std::strstr(buf, "[within_size]")
+        || std::strstr(buf, "[advise]") || std::strstr(buf, "[force]");
+}
+#endif
+
+void SharedMemory::applyOptions(const SharedMemoryOptions& options, bool writable)
+{
+    applied_ = {};
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Advise before pre-faulting so the faults can allocate huge pages.
+    // A region smaller than one huge page can never get one.
+    constexpr size_t kHugePageSize = 2u * 1024u * 1024u;
+    if (options.hugePages && size_ >= kHugePageSize && shmemHugePagesEnabled())
+        applied_.hugePages = madvise(data_, size_, MADV_HUGEPAGE) == 0;
+#endif
+
+    if (options.prefault) {
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        prefaultPages(data_, size_, pageSize > 0 ? static_cast<size_t>(pageSize) : 4096u, writable);
+        applied_.prefault = true;
+    }
+
+    // Fails with EPERM/ENOMEM beyond RLIMIT_MEMLOCK; munmap() drops the lock
+    if (options.lock)
+        applied_.lock = mlock(data_, size_) == 0;
+}
+
 void SharedMemory::close()
 {
     if (data_) {
@@ -346,6 +537,7 @@ void SharedMemory::close()
     name_.clear();
     size_ = 0;
     isCreator_ = false;
+    applied_ = {};
 }
 
 // ─── NamedEvent ─────────────────────────────────────────────────
@@ -446,23 +638,48 @@ void NamedEvent::close()
 
 bool NamedEvent::isOpen() const { return sem_ != nullptr; }
 
+// No futex on macOS — keep the named semaphore
+bool NamedEvent::bindSharedWord(::std::atomic<uint32_t>*, ::std::atomic<uint32_t>*) { return false; }
+
+bool NamedEvent::isSharedWordBound() const { return false; }
+
 #else
 // ═══ Linux: POSIX named semaphore (sem_open/sem_post/sem_timedwait) ═══
+// After bindSharedWord(), signal/wait switch to a futex on a word in the
+// shared header. The semaphore stays open so create()/open() keep their
+// meaning (producer presence), but a bound signal() no longer posts it:
+// every waiter must bind the same words, or it is never woken.
 
 } // close namespace directpipe for system includes
 
 #include <semaphore.h>
 #include <time.h>
+#include <climits>
+#include <chrono>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 
 namespace directpipe {
 
+// Shared (non-PRIVATE) futex ops: the word is mapped into several processes
+static long futexCall(::std::atomic<uint32_t>* word, int op, uint32_t val,
+                      const struct timespec* timeout)
+{
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, val,
+                   timeout, nullptr, 0);
+}
+
 NamedEvent::~NamedEvent() { close(); }
 
 NamedEvent::NamedEvent(NamedEvent&& other) noexcept
-    : sem_(other.sem_), name_(::std::move(other.name_)), isCreator_(other.isCreator_)
+    : sem_(other.sem_), name_(::std::move(other.name_)), isCreator_(other.isCreator_),
+      futexSeq_(other.futexSeq_), futexWaiters_(other.futexWaiters_),
+      lastSeenSeq_(other.lastSeenSeq_)
 {
     other.sem_ = nullptr;
     other.isCreator_ = false;
+    other.futexSeq_ = nullptr;
+    other.futexWaiters_ = nullptr;
 }
 
 NamedEvent& NamedEvent::operator=(NamedEvent&& other) noexcept
@@ -472,8 +689,13 @@ NamedEvent& NamedEvent::operator=(NamedEvent&& other) noexcept
         sem_ = other.sem_;
         name_ = ::std::move(other.name_);
         isCreator_ = other.isCreator_;
+        futexSeq_ = other.futexSeq_;
+        futexWaiters_ = other.futexWaiters_;
+        lastSeenSeq_ = other.lastSeenSeq_;
         other.sem_ = nullptr;
         other.isCreator_ = false;
+        other.futexSeq_ = nullptr;
+        other.futexWaiters_ = nullptr;
     }
     return *this;
 }
@@ -507,11 +729,49 @@ bool NamedEvent::open(const ::std::string& name)
 
 void NamedEvent::signal()
 {
+    if (futexSeq_) {
+        // Publish first, then look for sleepers. Pairs with the waiter's
+        // consumer_waiting increment in wait(): either we see the waiter and
+        // wake it, or its FUTEX_WAIT sees the new sequence and returns at once.
+        futexSeq_->fetch_add(1, ::std::memory_order_seq_cst);
+        if (futexWaiters_->load(::std::memory_order_seq_cst) != 0)
+            futexCall(futexSeq_, FUTEX_WAKE, INT_MAX, nullptr);
+        return;
+    }
     if (sem_) sem_post(static_cast<sem_t*>(sem_));
 }
 
 bool NamedEvent::wait(uint32_t timeout_ms)
 {
+    if (futexSeq_) {
+        const auto deadline = ::std::chrono::steady_clock::now()
+                            + ::std::chrono::milliseconds(timeout_ms);
+        for (;;) {
+            // Any number of signals since the last successful wait count as one
+            const uint32_t seq = futexSeq_->load(::std::memory_order_acquire);
+            if (seq != lastSeenSeq_) {
+                lastSeenSeq_ = seq;
+                return true;
+            }
+
+            const auto now = ::std::chrono::steady_clock::now();
+            if (now >= deadline) return false;
+
+            const auto remaining = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
+                deadline - now).count();
+            struct timespec rel;
+            rel.tv_sec = static_cast<time_t>(remaining / 1000000000LL);
+            rel.tv_nsec = static_cast<long>(remaining % 1000000000LL);
+
+            // The kernel re-checks the word against seq, so a signal landing
+            // between the load above and the sleep returns EAGAIN instead of
+            // being lost. EINTR / spurious wakeups just loop.
+            futexWaiters_->fetch_add(1, ::std::memory_order_seq_cst);
+            futexCall(futexSeq_, FUTEX_WAIT, seq, &rel);
+            futexWaiters_->fetch_sub(1, ::std::memory_order_seq_cst);
+        }
+    }
+
     if (!sem_) return false;
     auto* s = static_cast<sem_t*>(sem_);
 
@@ -530,6 +790,12 @@ bool NamedEvent::wait(uint32_t timeout_ms)
 
 void NamedEvent::close()
 {
+    // Drop the futex binding first — the words live in shared memory that
+    // the caller is about to unmap
+    futexSeq_ = nullptr;
+    futexWaiters_ = nullptr;
+    lastSeenSeq_ = 0;
+
     if (sem_) {
         if (sem_close(static_cast<sem_t*>(sem_)) != 0) {
             // Log but continue cleanup
@@ -545,6 +811,19 @@ void NamedEvent::close()
 
 bool NamedEvent::isOpen() const { return sem_ != nullptr; }
 
+bool NamedEvent::bindSharedWord(::std::atomic<uint32_t>* seq, ::std::atomic<uint32_t>* waiters)
+{
+    if (!sem_ || !seq || !waiters) return false;
+    futexSeq_ = seq;
+    futexWaiters_ = waiters;
+    // Signals issued before binding are not replayed — same as attaching to
+    // an auto-reset event that nobody has waited on yet
+    lastSeenSeq_ = seq->load(::std::memory_order_acquire);
+    return true;
+}
+
+bool NamedEvent::isSharedWordBound() const { return futexSeq_ != nullptr; }
+
 #endif // __APPLE__ vs Linux
 
 } // namespace directpipe
@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file StreamRegistry.cpp
+ * @brief Stream directory publish / lookup
+ */
+
+#include "directpipe/StreamRegistry.h"
+
+#include <cstring>
+
+namespace directpipe {
+
+namespace {
+
+void copyText(char* dest, size_t destSize, const char* src)
+{
+    size_t n = 0;
+    if (src) {
+        while (n + 1 < destSize && src[n] != '\0') {
+            dest[n] = src[n];
+            ++n;
+        }
+    }
+    std::memset(dest + n, 0, destSize - n);
+}
+
+bool sameId(const char* a, const char* b)
+{
+    return std::strncmp(a, b, STREAM_ID_LEN) == 0;
+}
+
+} // namespace
+
+bool isValidStreamId(const char* id)
+{
+    if (!id || id[0] == '\0') return false;
+    size_t n = 0;
+    for (; id[n] != '\0'; ++n) {
+        if (n + 1 >= STREAM_ID_LEN) return false;
+        const char c = id[n];
+        const bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                     || (c >= '0' && c <= '9') || c == '_' || c == '-';
+        if (!ok) return false;
+    }
+    return true;
+}
+
+bool makeStreamInfo(const char* id, const char* description, StreamInfo& out)
+{
+    if (!isValidStreamId(id)) return false;
+
+    out = StreamInfo{};
+    copyText(out.id, sizeof(out.id), id);
+    copyText(out.description, sizeof(out.description), description);
+
+    if (sameId(id, MAIN_STREAM_ID)) {
+        copyText(out.shmName, sizeof(out.shmName), SHM_NAME);
+        copyText(out.eventName, sizeof(out.eventName), EVENT_NAME);
+    } else {
+        // "Local\DirectPipeAudio_<id>" / "Local\DirectPipeDataReady_<id>" (fits: 22/26 + 31 < 64)
+        std::string shm = std::string(SHM_NAME) + "_" + id;
+        std::string evt = std::string(EVENT_NAME) + "_" + id;
+        copyText(out.shmName, sizeof(out.shmName), shm.c_str());
+        copyText(out.eventName, sizeof(out.eventName), evt.c_str());
+    }
+    return true;
+}
+
+bool StreamRegistry::openForPublishing(const std::string& name)
+{
+    return attach(name, true);
+}
+
+bool StreamRegistry::openForReading(const std::string& name)
+{
+    return attach(name, false);
+}
+
+bool StreamRegistry::attach(const std::string& name, bool create)
+{
+    close();
+
+    const bool mapped = create
+        ? memory_.openOrCreate(name, sizeof(StreamDirectory))
+        : memory_.open(name, sizeof(StreamDirectory));
+    if (!mapped) return false;
+    if (memory_.getSize() < sizeof(StreamDirectory)) {
+        memory_.close();
+        return false;
+    }
+
+    auto* directory = static_cast<StreamDirectory*>(memory_.getData());
+
+    // A fresh (zero-filled) region is an empty directory: stamp the version
+    uint32_t version = directory->version.load(std::memory_order_acquire);
+    if (version == 0 && create) {
+        directory->version.compare_exchange_strong(version, REGISTRY_VERSION,
+                                                   std::memory_order_acq_rel);
+        version = directory->version.load(std::memory_order_acquire);
+    }
+    if (version != REGISTRY_VERSION) {
+        memory_.close();
+        return false;
+    }
+
+    directory_ = directory;
+    return true;
+}
+
+void StreamRegistry::close()
+{
+    directory_ = nullptr;
+    memory_.close();
+}
+
+bool StreamRegistry::publish(const StreamInfo& info)
+{
+    if (!directory_ || !isValidStreamId(info.id)) return false;
+
+    // Rewrite our existing entry in place...
+    const int existing = findIndex(info.id);
+    if (existing >= 0) {
+        auto& entry = directory_->streams[existing];
+        uint32_t expected = STREAM_ENTRY_ACTIVE;
+        if (entry.state.compare_exchange_strong(expected, STREAM_ENTRY_CLAIMED,
+                                                std::memory_order_acq_rel)) {
+            writeEntry(entry, info);
+            return true;
+        }
+    }
+
+    // ...or claim a free one
+    for (auto& entry : directory_->streams) {
+        uint32_t expected = STREAM_ENTRY_FREE;
+        if (entry.state.compare_exchange_strong(expected, STREAM_ENTRY_CLAIMED,
+                                                std::memory_order_acq_rel)) {
+            writeEntry(entry, info);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StreamRegistry::withdraw(const char* id)
+{
+    if (!directory_ || !id) return false;
+
+    const int index = findIndex(id);
+    if (index < 0) return false;
+
+    auto& entry = directory_->streams[index];
+    uint32_t expected = STREAM_ENTRY_ACTIVE;
+    if (!entry.state.compare_exchange_strong(expected, STREAM_ENTRY_CLAIMED,
+                                             std::memory_order_acq_rel))
+        return false;
+
+    const uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+    entry.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memset(entry.id, 0, sizeof(entry.id));
+    entry.seq.store(seq + 2, std::memory_order_release);
+
+    entry.state.store(STREAM_ENTRY_FREE, std::memory_order_release);
+    return true;
+}
+
+void StreamRegistry::writeEntry(StreamEntry& entry, const StreamInfo& info)
+{
+    // Caller holds the claim (state == CLAIMED)
+    const uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+    entry.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    entry.channels.store(info.channels, std::memory_order_relaxed);
+    entry.sample_rate.store(info.sampleRate, std::memory_order_relaxed);
+    copyText(entry.id, sizeof(entry.id), info.id);
+    copyText(entry.description, sizeof(entry.description), info.description);
+    copyText(entry.shm_name, sizeof(entry.shm_name), info.shmName);
+    copyText(entry.event_name, sizeof(entry.event_name), info.eventName);
+
+    entry.seq.store(seq + 2, std::memory_order_release);
+    entry.state.store(STREAM_ENTRY_ACTIVE, std::memory_order_release);
+}
+
+bool StreamRegistry::readEntry(const StreamEntry& entry, StreamInfo& out) const
+{
+    // Entries change only on publish/withdraw, so a few retries are plenty
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        if (entry.state.load(std::memory_order_acquire) != STREAM_ENTRY_ACTIVE)
+            return false;
+        const uint32_t seq1 = entry.seq.load(std::memory_order_acquire);
+        if (seq1 & 1u) continue;
+
+        out.channels = entry.channels.load(std::memory_order_relaxed);
+        out.sampleRate = entry.sample_rate.load(std::memory_order_relaxed);
+        std::memcpy(out.id, entry.id, sizeof(out.id));
+        std::memcpy(out.description, entry.description, sizeof(out.description));
+        std::memcpy(out.shmName, entry.shm_name, sizeof(out.shmName));
+        std::memcpy(out.eventName, entry.event_name, sizeof(out.eventName));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.seq.load(std::memory_order_relaxed) == seq1
+            && entry.state.load(std::memory_order_relaxed) == STREAM_ENTRY_ACTIVE) {
+            // Never trust NUL termination across processes
+            out.id[sizeof(out.id) - 1] = '\0';
+            out.description[sizeof(out.description) - 1] = '\0';
+            out.shmName[sizeof(out.shmName) - 1] = '\0';
+            out.eventName[sizeof(out.eventName) - 1] = '\0';
+            return true;
+        }
+    }
+    return false;
+}
+
+int StreamRegistry::findIndex(const char* id) const
+{
+    for (uint32_t i = 0; i < MAX_STREAMS; ++i) {
+        StreamInfo info;
+        if (readEntry(directory_->streams[i], info) && sameId(info.id, id))
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+uint32_t StreamRegistry::list(StreamInfo* out, uint32_t maxStreams) const
+{
+    if (!directory_ || !out) return 0;
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < MAX_STREAMS && count < maxStreams; ++i) {
+        if (readEntry(directory_->streams[i], out[count]))
+            ++count;
+    }
+    return count;
+}
+
+bool StreamRegistry::find(const char* id, StreamInfo& out) const
+{
+    if (!directory_ || !id) return false;
+
+    const int index = findIndex(id);
+    return index >= 0 && readEntry(directory_->streams[index], out) && sameId(out.id, id);
+}
+
+} // namespace directpipe
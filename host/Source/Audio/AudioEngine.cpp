@@ -25,7 +25,10 @@
 #include "../Control/Log.h"
 #include "../Platform/PlatformAudio.h"
 #include "../Util/ScopedGuard.h"
+#include "directpipe/ClockSync.h"
 #include <cmath>
+#include <chrono>
+#include <thread>
 
 namespace directpipe {
 
@@ -50,6 +53,10 @@ static bool processBlockSEH(VSTChain& chain, juce::AudioBuffer<float>& buffer, i
 AudioEngine::AudioEngine()
 {
     setSafetyHeadroomdB(-0.3f);
+
+    sharedMemWriter_.setStream(directpipe::MAIN_STREAM_ID, "DirectPipe output (post-limiter)");
+    ipcTapWriters_[static_cast<size_t>(IpcTap::Input)].setStream("input", "DirectPipe raw input");
+    ipcTapWriters_[static_cast<size_t>(IpcTap::PostChain)].setStream("post-chain", "DirectPipe post-chain (pre-limiter)");
 }
 
 AudioEngine::~AudioEngine()
@@ -186,6 +193,7 @@ void AudioEngine::shutdown()
     // was never started (e.g. init failure) only shut down if still connected.
     if (sharedMemWriter_.isConnected())
         sharedMemWriter_.shutdown();
+    stopIpcTaps();
     ipcEnabled_.store(false, std::memory_order_relaxed);
     monitorOutput_.shutdown();
     outputRouter_.shutdown();
@@ -204,6 +212,7 @@ void AudioEngine::setIpcEnabled(bool enabled)
         uint32_t sr = static_cast<uint32_t>(currentSampleRate_);
         if (sharedMemWriter_.initialize(sr, 2, directpipe::DEFAULT_BUFFER_FRAMES)) {
             ipcEnabled_.store(true, std::memory_order_release);
+            startIpcTaps();
             Log::info("IPC", "Output enabled (SR=" + juce::String(sr) + ")");
         } else {
             Log::error("IPC", "Output failed to initialize (SR=" + juce::String(sr) + ")");
@@ -215,10 +224,79 @@ void AudioEngine::setIpcEnabled(bool enabled)
         // change), audioDeviceAboutToStart won't re-enable it.
         ipcWasEnabled_ = false;
         sharedMemWriter_.shutdown();
+        stopIpcTaps();
+        latencyMonitor_.setIpcLatencyMs(0.0);  // No Receiver measurement without IPC
         Log::info("IPC", "Output disabled");
     }
 }
 
+void AudioEngine::setIpcSampleFormat(directpipe::SampleFormat format, directpipe::DitherMode dither)
+{
+    // Negotiate against the consumers already attached: switching to a format
+    // one of them cannot decode would lock it out after the restart.
+    if ((sharedMemWriter_.getConsumerFormatMask() & directpipe::sampleFormatBit(format)) == 0) {
+        Log::warn("IPC", "Attached consumer cannot decode the requested sample format, keeping float32");
+        format = directpipe::SampleFormat::Float32;
+    }
+
+    sharedMemWriter_.setSampleFormat(format, dither);
+    for (auto& tap : ipcTapWriters_)
+        tap.setSampleFormat(format, dither);
+
+    if (!ipcEnabled_.load(std::memory_order_acquire))
+        return;  // Applied on the next setIpcEnabled(true) / device restart
+
+    // Stop RT writes before initialize() re-creates the shared memory
+    ipcEnabled_.store(false, std::memory_order_release);
+    uint32_t sr = static_cast<uint32_t>(currentSampleRate_);
+    if (sharedMemWriter_.initialize(sr, 2, directpipe::DEFAULT_BUFFER_FRAMES)) {
+        ipcEnabled_.store(true, std::memory_order_release);
+        startIpcTaps();
+        Log::info("IPC", "Output restarted with new sample format");
+    } else {
+        Log::error("IPC", "Output failed to re-initialize after sample format change (SR=" + juce::String(sr) + ")");
+    }
+}
+
+void AudioEngine::setIpcTapEnabled(IpcTap tap, bool enabled)
+{
+    const auto index = static_cast<size_t>(tap);
+    if (ipcTapRequested_[index] == enabled)
+        return;
+    ipcTapRequested_[index] = enabled;
+
+    if (!ipcEnabled_.load(std::memory_order_acquire))
+        return;  // Started with the main stream on the next setIpcEnabled(true)
+
+    // Safe while the RT thread writes: SharedMemWriter's connected_/writeInFlight_
+    // handshake keeps writeAudio() off the mapping during (re)initialization
+    auto& writer = ipcTapWriters_[index];
+    if (enabled) {
+        const uint32_t sr = static_cast<uint32_t>(currentSampleRate_);
+        if (!writer.initialize(sr, 2, directpipe::DEFAULT_BUFFER_FRAMES))
+            Log::error("IPC", "Stream '" + writer.getStreamId() + "' failed to initialize");
+    } else {
+        writer.shutdown();
+    }
+}
+
+void AudioEngine::startIpcTaps()
+{
+    const uint32_t sr = static_cast<uint32_t>(currentSampleRate_);
+    for (size_t i = 0; i < ipcTapWriters_.size(); ++i) {
+        if (!ipcTapRequested_[i])
+            continue;
+        if (!ipcTapWriters_[i].initialize(sr, 2, directpipe::DEFAULT_BUFFER_FRAMES))
+            Log::error("IPC", "Stream '" + ipcTapWriters_[i].getStreamId() + "' failed to initialize");
+    }
+}
+
+void AudioEngine::stopIpcTaps()
+{
+    for (auto& tap : ipcTapWriters_)
+        tap.shutdown();
+}
+
 ActionResult AudioEngine::setInputDevice(const juce::String& deviceName)
 {
     { const juce::SpinLock::ScopedLockType sl(desiredDeviceLock_); desiredInputDevice_ = deviceName; }
@@ -509,6 +587,58 @@ void AudioEngine::setChannelMode(int channels)
     channelMode_.store(juce::jlimit(1, 2, channels), std::memory_order_relaxed);
 }
 
+void AudioEngine::setProcessingBlockSize(int frames)
+{
+    const int size = frames <= 0 ? 0
+        : juce::jlimit(kMinProcessingBlockSize, kMaxProcessingBlockSize, frames);
+    const int previous = processingBlockSize_.exchange(size, std::memory_order_relaxed);
+    if (previous == size)
+        return;
+
+    Log::info("AUDIO", size > 0 ? "Processing block size: " + juce::String(size) + " samples"
+                                : juce::String("Processing block size: follow device"));
+
+    // Without a running device the next audioDeviceAboutToStart picks the size up.
+    // Otherwise only the adapter and the chain are re-prepared: the device, IPC,
+    // recording and monitor keep running (a short silent gap in the chain output).
+    auto* device = deviceManager_.getCurrentAudioDevice();
+    if (!running_ || device == nullptr)
+        return;
+
+    chainReconfiguring_.store(true, std::memory_order_seq_cst);
+    if (!waitForChainSectionExit()) {
+        // The callback is stuck inside a plugin: leave the adapter alone and keep
+        // the size it was prepared for rather than restarting the device
+        processingBlockSize_.store(previous, std::memory_order_relaxed);
+        chainReconfiguring_.store(false, std::memory_order_seq_cst);
+        Log::warn("AUDIO", "Processing block size unchanged: audio callback did not leave the chain");
+        return;
+    }
+
+    // Same sizing as audioDeviceAboutToStart (the RT thread is out of the section)
+    const int maxChannels = juce::jmax(8, device->getActiveInputChannels().countNumberOfSetBits(),
+                                          device->getActiveOutputChannels().countNumberOfSetBits());
+    const int deviceBlock = currentBufferSize_.load();
+    chainAdapter_.prepare(static_cast<uint32_t>(maxChannels), static_cast<uint32_t>(size),
+                          static_cast<uint32_t>(deviceBlock), static_cast<uint32_t>(deviceBlock));
+    vstChain_.prepareToPlay(currentSampleRate_, size > 0 ? size : deviceBlock, size > 0);
+    latencyMonitor_.setBlockAdapterLatencySamples(static_cast<int>(chainAdapter_.latencyFrames()));
+    chainReconfiguring_.store(false, std::memory_order_seq_cst);
+}
+
+bool AudioEngine::waitForChainSectionExit() const
+{
+    // Paired with the seq_cst store/load in the callback: a block that entered the
+    // section before chainReconfiguring_ was raised is still visible here
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kChainReconfigureWaitMs);
+    while (chainSectionActive_.load(std::memory_order_seq_cst)) {
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
 ActionResult AudioEngine::setSampleRate(double sampleRate)
 {
     // Skip restart if device already has the requested sample rate
@@ -1051,14 +1181,18 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
 
     latencyMonitor_.markCallbackStart();
 
+    // Block timestamp + device sample counter for the IPC side channel.
+    // Counted before any early return so dropped/skipped callbacks still advance it.
+    const uint64_t callbackTimeNs = directpipe::steadyClockNs();
+    const uint64_t blockSampleCounter = deviceSampleCounter_.load(std::memory_order_relaxed);
+    deviceSampleCounter_.store(blockSampleCounter + static_cast<uint64_t>(juce::jmax(0, numSamples)),
+                               std::memory_order_relaxed);
+
     const int chMode = channelMode_.load(std::memory_order_relaxed);
     const float gain = inputGain_.load(std::memory_order_relaxed);
     const bool muted = muted_.load(std::memory_order_relaxed);
     const bool outputMuted = outputMuted_.load(std::memory_order_relaxed);
 
-    const int callbackSamples = numSamples;
-    numSamples = juce::jlimit(0, workBuffer_.getNumSamples(), numSamples);
-
     auto clearOutputRange = [&](int startSample, int samplesToClear) {
         if (samplesToClear <= 0) return;
         for (int ch = 0; ch < numOutputChannels; ++ch)
@@ -1069,7 +1203,7 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
 
     // Fast path: panic muted zero output, skip all processing
     if (muted) {
-        clearOutputRange(0, callbackSamples);
+        clearOutputRange(0, numSamples);
         inputLevel_.store(0.0f, std::memory_order_relaxed);
         outputLevel_.store(0.0f, std::memory_order_relaxed);
         latencyMonitor_.markCallbackEnd();
@@ -1078,17 +1212,67 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
 
     // Plugin crash guard: chain crashed previously silence all outputs
     if (chainCrashed_.load(std::memory_order_relaxed)) {
-        clearOutputRange(0, callbackSamples);
+        clearOutputRange(0, numSamples);
         latencyMonitor_.markCallbackEnd();
         return;
     }
 
-    if (numSamples <= 0) {
-        clearOutputRange(0, callbackSamples);
+    const int maxBlock = workBuffer_.getNumSamples();
+    if (numSamples <= 0 || maxBlock <= 0) {
+        clearOutputRange(0, numSamples);
         latencyMonitor_.markCallbackEnd();
         return;
     }
 
+    // Some drivers deliver more than the buffer size they advertised (WASAPI
+    // period changes, ASIO drivers rounding up). Run the whole pipeline in
+    // prepared-size sub-blocks rather than dropping the excess; the chain,
+    // Safety Guard, recorder, IPC and monitor all see consecutive blocks.
+    if (numSamples > maxBlock)
+        oversizedCallbacks_.fetch_add(1, std::memory_order_relaxed);
+
+    // Measure levels (RMS) decimated: every 4th callback (~23Hz at 48kHz/512smp).
+    // UI timer runs at 30Hz so per-callback RMS is wasted work.
+    const bool measureThisCallback = (++rmsDecimationCounter_ & 3) == 0;
+    const double sampleRate = currentSampleRate_.load(std::memory_order_relaxed);
+
+    for (int offset = 0; offset < numSamples; offset += maxBlock) {
+        const int subBlock = juce::jmin(maxBlock, numSamples - offset);
+        if (chainCrashed_.load(std::memory_order_relaxed)) {
+            clearOutputRange(offset, numSamples - offset);
+            break;
+        }
+        // IPC block stamps advance with the sub-block, so consumers see an
+        // evenly clocked stream
+        const uint64_t subBlockTimeNs = offset == 0 || sampleRate <= 0.0
+            ? callbackTimeNs
+            : callbackTimeNs + static_cast<uint64_t>(static_cast<double>(offset) * 1.0e9 / sampleRate);
+        processSubBlock(inputChannelData, numInputChannels, outputChannelData, numOutputChannels,
+                        offset, subBlock, chMode, gain, outputMuted, subBlockTimeNs,
+                        blockSampleCounter + static_cast<uint64_t>(offset),
+                        measureThisCallback && offset + subBlock == numSamples);
+    }
+
+    latencyMonitor_.markCallbackEnd();
+}
+
+void AudioEngine::processSubBlock(const float* const* inputChannelData, int numInputChannels,
+                                  float* const* outputChannelData, int numOutputChannels,
+                                  int offset, int numSamples, int chMode, float gain, bool outputMuted,
+                                  uint64_t callbackTimeNs, uint64_t blockSampleCounter,
+                                  bool measureLevels)
+{
+    // Per-stage timing: one clock read per stage boundary, fed to lock-free
+    // histograms in LatencyMonitor (aggregated by StatusUpdater)
+    uint64_t stageStartNs = directpipe::steadyClockNs();
+    auto lap = [&stageStartNs] {
+        const uint64_t now = directpipe::steadyClockNs();
+        const uint64_t elapsed = now - stageStartNs;
+        stageStartNs = now;
+        return elapsed;
+    };
+    uint64_t ipcNs = 0;
+
     // 1. Copy input data into the pre-allocated work buffer (no heap allocation)
     auto& buffer = workBuffer_;
     int workChannels = juce::jmin(
@@ -1110,9 +1294,9 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
             for (int ch = 0; ch < numInputChannels; ++ch) {
                 if (inputChannelData[ch] != nullptr) {
                     if (validInputChannels == 0)
-                        buffer.copyFrom(0, 0, inputChannelData[ch], numSamples);
+                        buffer.copyFrom(0, 0, inputChannelData[ch] + offset, numSamples);
                     else
-                        buffer.addFrom(0, 0, inputChannelData[ch], numSamples);
+                        buffer.addFrom(0, 0, inputChannelData[ch] + offset, numSamples);
                     ++validInputChannels;
                 }
             }
@@ -1126,12 +1310,14 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
             // Stereo mode: copy channels as-is
             for (int ch = 0; ch < numInputChannels && ch < workChannels; ++ch) {
                 if (inputChannelData[ch] != nullptr) {
-                    buffer.copyFrom(ch, 0, inputChannelData[ch], numSamples);
+                    buffer.copyFrom(ch, 0, inputChannelData[ch] + offset, numSamples);
                 }
             }
         }
     }
 
+    latencyMonitor_.recordStage(CallbackStage::Input, lap());
+
     // Apply input gain (SIMD-optimized inside JUCE)
     if (std::abs(gain - 1.0f) > 0.001f) {
         buffer.applyGain(gain);
@@ -1144,35 +1330,59 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
         buffer.clear();
     }
 
-    // Measure input level (RMS) decimated: every 4th callback (~23Hz at 48kHz/512smp).
-    // UI timer runs at 30Hz so per-callback RMS is wasted work.
-    const bool measureThisCallback = (++rmsDecimationCounter_ & 3) == 0;
-    if (measureThisCallback && buffer.getNumChannels() > 0) {
+    latencyMonitor_.recordStage(CallbackStage::Gain, lap());
+
+    // 1.5. Raw input tap (IPC stream "input"): before the chain processes in place
+    const bool ipcOn = ipcEnabled_.load(std::memory_order_acquire);
+    if (ipcOn)
+        ipcTapWriters_[static_cast<size_t>(IpcTap::Input)].writeAudio(
+            buffer, numSamples, callbackTimeNs, blockSampleCounter);
+    ipcNs += lap();
+
+    // Measure input level (RMS) on the callback's last sub-block
+    if (measureLevels && buffer.getNumChannels() > 0) {
         float rms = calculateRMS(buffer.getReadPointer(0), numSamples);
         inputLevel_.store(rms, std::memory_order_relaxed);
     }
+    lap();  // Metering is not a timed stage
 
     // 2. Process through VST plugin chain (inline, zero additional latency)
-    // Each plugin's bypass flag is atomic can be toggled from any thread
-    //
-    // Windows: __try/__except catches SEH exceptions (access violations) that
-    //          try/catch(...) silently misses. The helper is extracted into a
-    //          separate function because MSVC forbids __try in functions with
-    //          C++ objects that have destructors on the stack.
-    // Other:   try/catch(...) is the best available mechanism.
-#if defined(_WIN32)
-    if (!processBlockSEH(vstChain_, buffer, numSamples)) {
-        buffer.clear();
-        chainCrashed_.store(true, std::memory_order_relaxed);
-    }
-#else
-    try {
-        vstChain_.processBlock(buffer, numSamples);
-    } catch (...) {
+    // Each plugin's bypass flag is atomic can be toggled from any thread.
+    // With a fixed processing block size the chain runs on exactly that many
+    // frames through chainAdapter_, which delays the stream by its reported
+    // latency (quantum 0 = in place on this sub-block, no delay).
+    // While setProcessingBlockSize re-prepares the adapter and chain the section
+    // is skipped (silence); chainSectionActive_ lets it wait for this block to leave.
+    chainSectionActive_.store(true, std::memory_order_seq_cst);
+    if (chainReconfiguring_.load(std::memory_order_seq_cst)) {
         buffer.clear();
-        chainCrashed_.store(true, std::memory_order_relaxed);
+    } else {
+        bool chainOk = true;
+        chainAdapter_.process(buffer.getArrayOfWritePointers(),
+                              static_cast<uint32_t>(buffer.getNumChannels()),
+                              static_cast<uint32_t>(numSamples),
+                              [this, &chainOk](float* const* data, uint32_t channels, uint32_t frames) {
+                                  if (!chainOk) return;
+                                  // Reference-only view: no allocation for <= 32 channels
+                                  juce::AudioBuffer<float> block(data, static_cast<int>(channels),
+                                                                 static_cast<int>(frames));
+                                  chainOk = processChain(block, static_cast<int>(frames));
+                              });
+        if (!chainOk) {
+            buffer.clear();
+            chainAdapter_.reset();
+            chainCrashed_.store(true, std::memory_order_relaxed);
+        }
+        latencyMonitor_.setBlockAdapterLatencySamples(static_cast<int>(chainAdapter_.latencyFrames()));
     }
-#endif
+    chainSectionActive_.store(false, std::memory_order_release);
+    latencyMonitor_.recordStage(CallbackStage::Chain, lap());
+
+    // 2.05. Post-chain tap (IPC stream "post-chain"): deliberately before Safety Guard
+    if (ipcOn)
+        ipcTapWriters_[static_cast<size_t>(IpcTap::PostChain)].writeAudio(
+            buffer, numSamples, callbackTimeNs, blockSampleCounter);
+    ipcNs += lap();
 
     // CRITICAL: Steps 2.1-4 MUST execute in this exact order.
     // Safety Guard (legacy SafetyLimiter) must run BEFORE all output paths (steps 2.5-4).
@@ -1180,61 +1390,88 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
 
     // 2.1. Safety Guard clip prevention for all output paths (RT-safe)
     safetyLimiter_.process(buffer, numSamples);
+    latencyMonitor_.recordStage(CallbackStage::SafetyLimiter, lap());
 
     // 2.2. Safety Volume: final global headroom trim for all output paths.
     const bool safetyHeadroomEnabled = safetyHeadroomEnabled_.load(std::memory_order_relaxed);
     const float safetyHeadroomGain = safetyHeadroomGain_.load(std::memory_order_relaxed);
     if (safetyHeadroomEnabled && safetyHeadroomGain < 0.9999f)
         buffer.applyGain(safetyHeadroomGain);
+    latencyMonitor_.recordStage(CallbackStage::Headroom, lap());
 
     // 2.5. Write processed audio to recorder (lock-free)
     recorder_.writeBlock(buffer, numSamples);
+    latencyMonitor_.recordStage(CallbackStage::Recorder, lap());
 
     // 2.6. Write to shared memory for Receiver VST (if IPC enabled)
     if (ipcEnabled_.load(std::memory_order_acquire)) {
-        sharedMemWriter_.writeAudio(buffer, numSamples);
+        sharedMemWriter_.writeAudio(buffer, numSamples, callbackTimeNs, blockSampleCounter);
+        latencyMonitor_.setIpcLatencyMs(sharedMemWriter_.getConsumerLatencyMs());
     }
+    latencyMonitor_.recordStage(CallbackStage::Ipc, ipcNs + lap());
 
     // 3. Route processed audio to monitor (separate WASAPI device)
     outputRouter_.routeAudio(buffer, numSamples);
+    latencyMonitor_.recordStage(CallbackStage::Monitor, lap());
 
     // 4. Apply output volume & copy to main output (AudioSettings Output device)
     float outVol = outputRouter_.getVolume(OutputRouter::Output::Main);
     for (int ch = 0; ch < numOutputChannels; ++ch) {
         if (!outputChannelData[ch]) continue;
+        float* out = outputChannelData[ch] + offset;
         if (ch < buffer.getNumChannels() && !outputMuted) {
             if (std::abs(outVol - 1.0f) < 0.001f) {
                 // Unity gain direct copy (most common path)
-                std::memcpy(outputChannelData[ch], buffer.getReadPointer(ch),
+                std::memcpy(out, buffer.getReadPointer(ch),
                             sizeof(float) * static_cast<size_t>(numSamples));
             } else if (outVol > 0.001f) {
                 // Apply gain
                 const float* src = buffer.getReadPointer(ch);
                 for (int i = 0; i < numSamples; ++i)
-                    outputChannelData[ch][i] = src[i] * outVol;
+                    out[i] = src[i] * outVol;
             } else {
                 // Volume ~0 silence
-                std::memset(outputChannelData[ch], 0,
+                std::memset(out, 0,
                             sizeof(float) * static_cast<size_t>(numSamples));
             }
         } else {
-            std::memset(outputChannelData[ch], 0,
+            std::memset(out, 0,
                         sizeof(float) * static_cast<size_t>(numSamples));
         }
     }
-    clearOutputRange(numSamples, callbackSamples - numSamples);
+    latencyMonitor_.recordStage(CallbackStage::Output, lap());
 
     // Measure output level same decimation as input
-    if (measureThisCallback && buffer.getNumChannels() > 0) {
+    if (measureLevels && buffer.getNumChannels() > 0) {
         float rms = calculateRMS(buffer.getReadPointer(0), numSamples);
         if (buffer.getNumChannels() > 1)
             rms = juce::jmax(rms, calculateRMS(buffer.getReadPointer(1), numSamples));
         outputLevel_.store(rms, std::memory_order_relaxed);
     }
 
-    latencyMonitor_.markCallbackEnd();
 }
 
+
+bool AudioEngine::processChain(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    // Windows: __try/__except catches SEH exceptions (access violations) that
+    //          try/catch(...) silently misses. The helper is extracted into a
+    //          separate function because MSVC forbids __try in functions with
+    //          C++ objects that have destructors on the stack.
+    // Other:   try/catch(...) is the best available mechanism.
+#if defined(_WIN32)
+    return processBlockSEH(vstChain_, buffer, numSamples);
+#else
+    try {
+        vstChain_.processBlock(buffer, numSamples);
+        return true;
+    } catch (...) {
+        return false;
+    }
+#endif
+}
+
+
 // Device Start/Reconnection Handler
 // Device start/reconnection handler notes:
 // Called on the device thread (not the message thread).
@@ -1248,6 +1485,10 @@ void AudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
     // Reset MMCSS flag new device means new audio thread, re-registration needed
     mmcssRegistered_.store(false, std::memory_order_release);
 
+    // New stream: restart the device sample counter (consumers re-anchor their
+    // clock estimate when it goes backwards)
+    deviceSampleCounter_.store(0, std::memory_order_relaxed);
+
 #if defined(_WIN32)
     if (!avSetMmThreadChar_) {
         if (auto* avrt = LoadLibraryA("avrt.dll")) {
@@ -1466,7 +1707,19 @@ void AudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
     // On first access, virtual memory pages may trigger soft faults, causing latency spikes.
     workBuffer_.clear();
 
-    vstChain_.prepareToPlay(currentSampleRate_, currentBufferSize_);
+    // Fixed processing block size: the chain is prepared for (and only ever
+    // sees) that size; the adapter absorbs the difference to the device block
+    const int processingBlock = processingBlockSize_.load(std::memory_order_relaxed);
+    chainAdapter_.prepare(static_cast<uint32_t>(maxChannels),
+                          static_cast<uint32_t>(processingBlock),
+                          static_cast<uint32_t>(currentBufferSize_.load()),
+                          static_cast<uint32_t>(currentBufferSize_.load()));
+    const bool fixedBlock = processingBlock > 0;
+    vstChain_.prepareToPlay(currentSampleRate_, fixedBlock ? processingBlock : currentBufferSize_.load(),
+                            fixedBlock);
+    if (fixedBlock)
+        Log::info("AUDIO", "Processing block: " + juce::String(processingBlock) + " samples (adapter delay "
+                  + juce::String(static_cast<int>(chainAdapter_.latencyFrames())) + " samples)");
     // NOTE: chainCrashed_ is NOT reset here device events (WASAPI session changes,
     // ASIO buffer size change) fire audioDeviceAboutToStart without any chain change,
     // which would silently re-enable a crashed chain. Instead, chainCrashed_ is cleared
@@ -1474,6 +1727,7 @@ void AudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
     safetyLimiter_.prepareToPlay(currentSampleRate_);
     outputRouter_.initialize(currentSampleRate_, currentBufferSize_);
     latencyMonitor_.reset(currentSampleRate_, currentBufferSize_);
+    latencyMonitor_.setBlockAdapterLatencySamples(static_cast<int>(chainAdapter_.latencyFrames()));
 
     // Re-initialize monitor output if configured (SR may have changed).
     // Deferred to message thread to avoid blocking device startup with
@@ -1495,6 +1749,7 @@ void AudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
         if (sharedMemWriter_.initialize(sr, 2, directpipe::DEFAULT_BUFFER_FRAMES)) {
             ipcEnabled_.store(true, std::memory_order_release);
             ipcWasEnabled_ = false;
+            startIpcTaps();
         } else {
             Log::error("IPC", "Failed to re-initialize after device restart (SR=" + juce::String(sr) + ")");
             ipcWasEnabled_ = false;
@@ -1526,6 +1781,7 @@ void AudioEngine::audioDeviceStopped()
     vstChain_.releaseResources();
     outputRouter_.shutdown();
     sharedMemWriter_.shutdown();
+    stopIpcTaps();
 
     // Stop recording to prevent WAV corruption at wrong sample rate after device loss
     if (recorder_.isRecording())
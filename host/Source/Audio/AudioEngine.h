@@ -35,7 +35,9 @@
 #include "AudioRecorder.h"
 #include "SafetyLimiter.h"
 #include "../IPC/SharedMemWriter.h"
+#include "directpipe/BlockAdapter.h"
 
+#include <array>
 #include <atomic>
 #include <functional>
 #include <map>
@@ -144,6 +146,21 @@ public:
     [[nodiscard]] ActionResult setMonitorBufferSize(int bufferSize);
     int getMonitorBufferSize() const { return monitorOutput_.getPreferredBufferSize(); }
 
+    /**
+     * @brief Run the plugin chain at a fixed block size instead of the device's.
+     *
+     * 0 = follow the device (default). Otherwise the chain always sees exactly
+     * `frames` samples per call, behind a FixedBlockAdapter whose delay is added
+     * to the latency figures. With a running device only the adapter and the
+     * chain are re-prepared (briefly silencing the chain output); the device,
+     * IPC streams and an active recording are not interrupted.
+     */
+    void setProcessingBlockSize(int frames);  // [Message thread]
+    int getProcessingBlockSize() const { return processingBlockSize_.load(std::memory_order_relaxed); }
+
+    static constexpr int kMinProcessingBlockSize = 32;
+    static constexpr int kMaxProcessingBlockSize = 2048;
+
     void setChannelMode(int channels);
     int getChannelMode() const { return channelMode_.load(std::memory_order_relaxed); }
 
@@ -177,6 +194,33 @@ public:
     /** @brief Block IPC from being enabled (audio-only multi-instance mode). */
     void setIpcAllowed(bool allowed) { ipcAllowed_ = allowed; }
 
+    /**
+     * @brief Select the IPC ring sample format (Float32 default, Int16/Int24/Float16
+     * compact) and dither. Restarts IPC output if it is running. Falls back to
+     * Float32 if an attached consumer cannot decode the requested format.
+     */
+    void setIpcSampleFormat(directpipe::SampleFormat format, directpipe::DitherMode dither);
+    directpipe::SampleFormat getIpcSampleFormat() const { return sharedMemWriter_.getSampleFormat(); }
+    /// Main-stream IPC health: what the Receivers report back, and the host's own losses
+    uint32_t getIpcConsumerStats(directpipe::ConsumerStatsSnapshot* out, uint32_t maxConsumers) const {  // [Message thread]
+        return sharedMemWriter_.getConsumerStats(out, maxConsumers);
+    }
+    uint64_t getIpcDroppedFrames() const { return sharedMemWriter_.getDroppedFrames(); }
+    uint64_t getIpcOverwrittenFrames() const { return sharedMemWriter_.getOverwrittenFrames(); }
+
+    /**
+     * @brief Extra IPC streams published beside the main (post-limiter) stream.
+     * Each is its own ring listed in the stream directory; the Receiver picks
+     * one by id. Taps are only written while IPC output is enabled and a
+     * Receiver is attached to them. PostChain is taken before Safety Guard,
+     * so it is not clip-protected.
+     */
+    enum class IpcTap { Input = 0, PostChain = 1 };
+    static constexpr int kNumIpcTaps = 2;
+
+    void setIpcTapEnabled(IpcTap tap, bool enabled);  // [Message thread]
+    bool isIpcTapEnabled(IpcTap tap) const { return ipcTapRequested_[static_cast<size_t>(tap)]; }
+
     float getInputLevel() const { return inputLevel_.load(std::memory_order_relaxed); }
     float getOutputLevel() const { return outputLevel_.load(std::memory_order_relaxed); }
 
@@ -196,6 +240,9 @@ public:
     /** @brief Request xrun counter reset (safe from any thread; sets atomic flag). */
     void requestXRunReset() { xrunResetRequested_.store(true, std::memory_order_release); }
 
+    /** @brief Callbacks larger than the prepared block size since launch (processed in sub-blocks). */
+    uint64_t getOversizedCallbackCount() const { return oversizedCallbacks_.load(std::memory_order_relaxed); }
+
     /** @brief Check and attempt device reconnection (call from message thread timer). */
     void checkReconnection();  // [Message thread only]
     /** @brief True if the audio device was lost (error/disconnect). */
@@ -253,6 +300,8 @@ private:
     void pushNotification(const juce::String& msg, NotificationLevel level);
     void changeListenerCallback(juce::ChangeBroadcaster* source) override;
     void attemptReconnection();
+    void startIpcTaps();  // [Message/device thread] after the main stream is up
+    void stopIpcTaps();   // [Message/device thread]
     // [RT thread only]
     void audioDeviceIOCallbackWithContext(
         const float* const* inputChannelData,
@@ -261,6 +310,15 @@ private:
         int numOutputChannels,
         int numSamples,
         const juce::AudioIODeviceCallbackContext& context) override;
+    // [RT thread only] Input → chain → Safety Guard → recorder/IPC/monitor → output
+    // for [offset, offset + numSamples) of the callback; numSamples <= workBuffer_ size
+    void processSubBlock(const float* const* inputChannelData, int numInputChannels,
+                         float* const* outputChannelData, int numOutputChannels,
+                         int offset, int numSamples, int chMode, float gain, bool outputMuted,
+                         uint64_t callbackTimeNs, uint64_t blockSampleCounter,
+                         bool measureLevels);
+    // [RT thread only] vstChain_.processBlock behind the crash guard; false = plugin crashed
+    bool processChain(juce::AudioBuffer<float>& buffer, int numSamples);
 
     void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
     void audioDeviceStopped() override;
@@ -281,11 +339,13 @@ private:
     AudioRecorder recorder_;
     SafetyLimiter safetyLimiter_;
     SharedMemWriter sharedMemWriter_;
+    std::array<SharedMemWriter, kNumIpcTaps> ipcTapWriters_;  // indexed by IpcTap; writeAudio() no-ops until initialized
 
     // Cross-thread atomics
     std::atomic<bool> ipcEnabled_{false};              // [Message write, RT read]
     std::atomic<bool> ipcWasEnabled_{false};            // [Device callbacks only] Remembers IPC state across device stop/start
     bool ipcAllowed_ = true;                            // [Message thread only] false in audio-only multi-instance mode
+    std::array<bool, kNumIpcTaps> ipcTapRequested_{};   // [Message thread only] taps to publish while IPC is enabled
 
     std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);  // [callAsync lifetime guard]
     std::atomic<bool> running_{false};                  // [Message write, RT read]
@@ -297,6 +357,7 @@ private:
     std::atomic<float> safetyHeadroomdB_{-0.3f};        // [Message write, RT read]
     std::atomic<float> safetyHeadroomGain_{1.0f};       // [Message write, RT read] cached linear gain
     std::atomic<int> channelMode_{2};                   // [Message write, RT read]
+    std::atomic<int> processingBlockSize_{0};           // [Message write, Device thread read] 0 = device block size
     std::atomic<bool> muted_{false};                    // [Message write, RT read]
     std::atomic<bool> inputMuted_{false};               // [Any thread write, RT read] Independent input mute: silences input, chain keeps running
     std::atomic<bool> outputMuted_{false};              // [Message write, RT read]
@@ -342,10 +403,17 @@ private:
 
     // RT thread only
     juce::AudioBuffer<float> workBuffer_;               // [RT thread only]
+    directpipe::FixedBlockAdapter chainAdapter_;        // [Device thread / Message thread while chainReconfiguring_ prepare, RT thread only] Fixed processing block size
+    std::atomic<bool> chainReconfiguring_{false};       // [Message write, RT read] Skip adapter + chain (silence) while re-preparing them
+    std::atomic<bool> chainSectionActive_{false};       // [RT write, Message read] RT thread is inside the adapter + chain section
+    static constexpr int kChainReconfigureWaitMs = 200; // One block is at most a few tens of ms
+    bool waitForChainSectionExit() const;               // [Message thread] false on timeout
     uint32_t rmsDecimationCounter_ = 0;                 // [RT thread only] RMS computed every 4th callback (no atomic needed)
     std::atomic<bool> chainCrashed_{false};              // [RT write, Message read] Plugin processBlock exception: silence output
     std::atomic<bool> chainCrashNotified_{false};        // [Message thread only] One-shot notification for chainCrashed_
     std::atomic<bool> mmcssRegistered_{false};           // [Device thread reset, RT thread write+read] MMCSS registration flag (Windows)
+    std::atomic<uint64_t> oversizedCallbacks_{0};        // [RT write, any read] Callbacks split into sub-blocks
+    std::atomic<uint64_t> deviceSampleCounter_{0};       // [Device thread reset, RT thread write+read] Frames delivered since device start (IPC block timestamps)
 
 #if defined(_WIN32)
     // Cached MMCSS function pointers loaded once in audioDeviceAboutToStart (device thread),
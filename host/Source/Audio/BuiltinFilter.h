@@ -10,7 +10,7 @@ namespace directpipe {
 /**
  * @brief Built-in HPF + LPF filter -- AudioProcessor for chain insertion.
  *
- * Behaves like a VST plugin in the AudioProcessorGraph.
+ * Behaves like a VST plugin in the chain.
  * Edit button opens FilterEditPanel (DirectPipe custom UI).
  *
  * Thread Ownership:
@@ -97,8 +97,11 @@ void BuiltinNoiseRemoval::prepareToPlay(double sampleRate, int samplesPerBlock)
         }
     }
 
+    // Whole-frame blocks bypass the FIFOs (no delay); anything else goes through them
+    wholeFrames_ = fixedBlockSize_ > 0 && fixedBlockSize_ % kRNNFrameSize == 0;
+
     // I2: Use base class setLatencySamples for proper AudioProcessor latency reporting
-    setLatencySamples(kRNNFrameSize);  // 480 samples FIFO delay
+    setLatencySamples(wholeFrames_ ? 0 : kRNNFrameSize);  // 480 samples FIFO delay
 }
 
 void BuiltinNoiseRemoval::releaseResources()
@@ -121,6 +124,24 @@ void BuiltinNoiseRemoval::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     if (numSamples == 0)
         return;
 
+    // Fixed whole-frame blocks: denoise in place, no FIFO round trip. Only
+    // while the FIFOs are empty, so a stray odd block cannot reorder audio.
+    if (wholeFrames_ && numSamples % kRNNFrameSize == 0
+        && inputFifoWriteL_ == 0 && outputFifoWriteL_ == outputFifoReadL_
+        && inputFifoWriteR_ == 0 && outputFifoWriteR_ == outputFifoReadR_) {
+        for (int offset = 0; offset < numSamples; offset += kRNNFrameSize) {
+            if (numChannels > 0) {
+                float* data = buffer.getWritePointer(0, offset);
+                processFrame(data, data, rnnL_, gateGainL_, holdCounterL_);
+            }
+            if (numChannels > 1 && rnnR_ != nullptr) {
+                float* data = buffer.getWritePointer(1, offset);
+                processFrame(data, data, rnnR_, gateGainR_, holdCounterR_);
+            }
+        }
+        return;
+    }
+
     // Channel 0 (Left / mono)
     if (numChannels > 0) {
         processChannel(buffer.getReadPointer(0), buffer.getWritePointer(0),
@@ -146,8 +167,8 @@ void BuiltinNoiseRemoval::processBlock(juce::AudioBuffer<float>& buffer, juce::M
 //
 // ## 2-Pass Architecture (critical for correctness)
 //
-// IMPORTANT: `in` and `out` may point to the SAME buffer (JUCE AudioProcessorGraph
-// in-place optimization). If we read from `in[i]` and write to `out[i]` in the
+// IMPORTANT: `in` and `out` may point to the SAME buffer (the chain
+// renders in place). If we read from `in[i]` and write to `out[i]` in the
 // same loop, we corrupt unread input samples.
 //
 // Solution: 2-pass approach:
@@ -170,58 +191,18 @@ void BuiltinNoiseRemoval::processChannel(
     std::vector<float>& outputFifo, uint32_t& outputFifoRead, uint32_t& outputFifoWrite,
     float& gateGain, int& holdCounter)
 {
-    const float threshold = vadThreshold_.load(std::memory_order_relaxed);
-
-    // Gate smoothing coefficient (gateSmooth_): controls how fast the gate opens/closes.
-    // Derivation: for a 20ms time constant at sample rate SR:
-    //   gateSmooth_ = exp(-1 / (SR * 0.020))
-    //   At 48kHz: exp(-1/960) ≈ 0.9990, at 44.1kHz: exp(-1/882) ≈ 0.9989
-    //
-    // NOTE: Was originally 5ms (0.9958 at 48kHz) but that was too abrupt -- the gate
-    // opening/closing was audible as a "click" between words. 20ms gives a
-    // smooth, natural fade that's imperceptible to listeners.
-    // Recalculated from sample rate in prepareToPlay (member variable gateSmooth_).
-
-    // IMPORTANT: RNNoise was trained on int16 audio data (range [-32767, +32767]).
-    // JUCE provides float audio in [-1.0, +1.0]. We MUST scale up before processing
-    // and scale back down after, or RNNoise treats all input as near-zero silence
-    // and outputs garbage.
-    constexpr float kScale = 32767.0f;
-    constexpr float kInvScale = 1.0f / 32767.0f;
-
     // ══ PASS 1: Consume ALL host input, process complete RNNoise frames ══
-    // IMPORTANT: in and out may alias (JUCE AudioProcessorGraph in-place buffer reuse).
+    // IMPORTANT: in and out may alias (in-place chain rendering).
     // We MUST read ALL input before writing ANY output. See function-level comment above.
     for (int i = 0; i < numSamples; ++i) {
         inputFifo[static_cast<size_t>(inputFifoWrite)] = in[i];
         ++inputFifoWrite;
 
         if (inputFifoWrite >= kRNNFrameSize) {
-            float rnnIn[kRNNFrameSize];
-            float rnnOut[kRNNFrameSize];
-
-            for (int j = 0; j < kRNNFrameSize; ++j)
-                rnnIn[j] = inputFifo[static_cast<size_t>(j)] * kScale;
-
-            float vad = rnnoise_process_frame(rnn, rnnOut, rnnIn);
-
-            // VAD gate with hold time — keeps gate open between words
-            // holdCounter tracks how many samples since last voice detection
-            float targetGate;
-            if (vad >= threshold) {
-                targetGate = 1.0f;
-                holdCounter = 0;  // reset hold
-            } else if (holdCounter < holdSamples_) {
-                targetGate = 1.0f;  // still in hold period — stay open
-                // Hold counter tracks time in SAMPLES, not frames. Since this decision runs once per
-                // RNNoise frame (480 samples), advance by kRNNFrameSize (not by 1).
-                // Changing to holdCounter++ would reduce 300ms hold time to ~10ms.
-                holdCounter += kRNNFrameSize;
-            } else {
-                targetGate = 0.0f;  // hold expired — close gate
-            }
+            float frameOut[kRNNFrameSize];
+            processFrame(inputFifo.data(), frameOut, rnn, gateGain, holdCounter);
 
-            // Apply per-sample gate smoothing and store in output ring buffer.
+            // Store in the output ring buffer.
             // NOTE: outputFifoWrite grows monotonically and wraps via % kFifoCapacity.
             // This ring buffer approach avoids the need for a linear reset of read/write
             // positions (which would require coordination). The modulo wrap is safe because
@@ -232,8 +213,7 @@ void BuiltinNoiseRemoval::processChannel(
             // subtraction gives the correct count even after UINT32_MAX wraparound
             // (~25 hours at 48kHz).
             for (int j = 0; j < kRNNFrameSize; ++j) {
-                gateGain = gateSmooth_ * gateGain + (1.0f - gateSmooth_) * targetGate;
-                outputFifo[static_cast<size_t>(outputFifoWrite % kFifoCapacity)] = rnnOut[j] * kInvScale * gateGain;
+                outputFifo[static_cast<size_t>(outputFifoWrite % kFifoCapacity)] = frameOut[j];
                 ++outputFifoWrite;
             }
 
@@ -256,6 +236,59 @@ void BuiltinNoiseRemoval::processChannel(
     }
 }
 
+void BuiltinNoiseRemoval::processFrame(const float* in, float* out, DenoiseState* rnn,
+                                       float& gateGain, int& holdCounter)
+{
+    const float threshold = vadThreshold_.load(std::memory_order_relaxed);
+
+    // Gate smoothing coefficient (gateSmooth_): controls how fast the gate opens/closes.
+    // Derivation: for a 20ms time constant at sample rate SR:
+    //   gateSmooth_ = exp(-1 / (SR * 0.020))
+    //   At 48kHz: exp(-1/960) ≈ 0.9990, at 44.1kHz: exp(-1/882) ≈ 0.9989
+    //
+    // NOTE: Was originally 5ms (0.9958 at 48kHz) but that was too abrupt -- the gate
+    // opening/closing was audible as a "click" between words. 20ms gives a
+    // smooth, natural fade that's imperceptible to listeners.
+    // Recalculated from sample rate in prepareToPlay (member variable gateSmooth_).
+
+    // IMPORTANT: RNNoise was trained on int16 audio data (range [-32767, +32767]).
+    // JUCE provides float audio in [-1.0, +1.0]. We MUST scale up before processing
+    // and scale back down after, or RNNoise treats all input as near-zero silence
+    // and outputs garbage.
+    constexpr float kScale = 32767.0f;
+    constexpr float kInvScale = 1.0f / 32767.0f;
+
+    float rnnIn[kRNNFrameSize];
+    float rnnOut[kRNNFrameSize];
+
+    for (int j = 0; j < kRNNFrameSize; ++j)
+        rnnIn[j] = in[j] * kScale;
+
+    float vad = rnnoise_process_frame(rnn, rnnOut, rnnIn);
+
+    // VAD gate with hold time — keeps gate open between words
+    // holdCounter tracks how many samples since last voice detection
+    float targetGate;
+    if (vad >= threshold) {
+        targetGate = 1.0f;
+        holdCounter = 0;  // reset hold
+    } else if (holdCounter < holdSamples_) {
+        targetGate = 1.0f;  // still in hold period — stay open
+        // Hold counter tracks time in SAMPLES, not frames. Since this decision runs once per
+        // RNNoise frame (480 samples), advance by kRNNFrameSize (not by 1).
+        // Changing to holdCounter++ would reduce 300ms hold time to ~10ms.
+        holdCounter += kRNNFrameSize;
+    } else {
+        targetGate = 0.0f;  // hold expired — close gate
+    }
+
+    // Apply per-sample gate smoothing (in was fully consumed above, so in == out is safe)
+    for (int j = 0; j < kRNNFrameSize; ++j) {
+        gateGain = gateSmooth_ * gateGain + (1.0f - gateSmooth_) * targetGate;
+        out[j] = rnnOut[j] * kInvScale * gateGain;
+    }
+}
+
 // ─── Strength / VAD threshold ───────────────────────────────────
 
 void BuiltinNoiseRemoval::setStrength(int strength)
@@ -26,13 +26,19 @@ namespace directpipe {
  * then feeds it to RNNoise. The output FIFO stores processed frames for
  * the host to drain at its own pace.
  *
- * IMPORTANT: JUCE's AudioProcessorGraph may reuse the SAME buffer for both
- * input and output (in-place / aliased processing). If we read input and write
+ * IMPORTANT: the chain renders in place (SerialChainExecutor), so input and
+ * output are the SAME buffer (aliased processing). If we read input and write
  * output to the same buffer simultaneously, we corrupt the input data.
  * The 2-pass design solves this: Pass 1 copies ALL input into the FIFO first,
  * then Pass 2 writes processed output back. This is the ONLY safe approach
  * when `in` and `out` pointers may alias.
  *
+ * ### Fixed Processing Block (FIFO bypass)
+ * When the host runs the chain at a fixed block size that is a multiple of
+ * 480 (AudioEngine processing block size, see setFixedBlockSize), every
+ * block is whole frames. The FIFOs are then skipped: frames are denoised in
+ * place and the reported latency is 0 instead of 480.
+ *
  * ### RNNoise Scaling (int16 range)
  * IMPORTANT: RNNoise was trained on int16 audio data, so it expects sample
  * values in the range [-32767, +32767]. JUCE audio is float [-1.0, +1.0].
@@ -124,6 +130,10 @@ public:
     /** Set VAD threshold directly (advanced override, 0.0-1.0). */
     void setVADThreshold(float threshold);
 
+    /** Host block-size guarantee: every processBlock() will be exactly `frames`
+     *  samples (0 = variable). [Message thread, before prepareToPlay] */
+    void setFixedBlockSize(int frames) { fixedBlockSize_ = frames; }
+
     // I5: Status accessors for UI (e.g., edit panel can show resampling warning)
     bool isActive() const { return !needsResampling_.load(std::memory_order_relaxed); }
     bool needsResampling() const { return needsResampling_.load(std::memory_order_relaxed); }
@@ -171,6 +181,10 @@ private:
     uint32_t outputFifoReadR_  = 0;
     uint32_t outputFifoWriteR_ = 0;
 
+    // -- Fixed block size (FIFO bypass) --
+    int fixedBlockSize_ = 0;       // [Message thread only] hint from the host
+    bool wholeFrames_ = false;     // [Message write in prepareToPlay, RT read] blocks are whole RNNoise frames
+
     // -- Resampling (TODO) --
     double hostSampleRate_ = 48000.0;
     std::atomic<bool> needsResampling_{false};  // I5: atomic -- set in prepareToPlay (msg), read in processBlock (RT)
@@ -204,6 +218,11 @@ private:
                         std::vector<float>& inputFifo, int& inputFifoWrite,
                         std::vector<float>& outputFifo, uint32_t& outputFifoRead, uint32_t& outputFifoWrite,
                         float& gateGain, int& holdCounter);
+
+    /** Denoise + gate one 480-sample frame. `in` and `out` may alias
+     *  (the whole frame is read before anything is written). */
+    void processFrame(const float* in, float* out, DenoiseState* rnn,
+                      float& gateGain, int& holdCounter);
 };
 
 } // namespace directpipe
@@ -28,6 +28,7 @@ static_assert(std::atomic<double>::is_always_lock_free,
     "std::atomic<double> must be lock-free for RT audio thread safety");
 static_assert(std::atomic<uint64_t>::is_always_lock_free,
     "std::atomic<uint64_t> must be lock-free for RT audio thread safety");
+#include <algorithm>
 #include <chrono>
 
 namespace directpipe {
@@ -45,8 +46,15 @@ void LatencyMonitor::reset(double sampleRate, int bufferSize)
     outputLatencyMs_.store(bufferMs, std::memory_order_relaxed);
     processingTimeMs_.store(0.0, std::memory_order_relaxed);
     cpuUsage_.store(0.0, std::memory_order_relaxed);
+    ipcLatencyMs_.store(0.0, std::memory_order_relaxed);
+    blockAdapterLatency_.store(0, std::memory_order_relaxed);
     avgProcessingTime_.store(0.0, std::memory_order_relaxed);
     callbackOverruns_.store(0, std::memory_order_relaxed);
+
+    // Called while the device is stopped (audioDeviceAboutToStart), so the RT
+    // thread is not writing
+    for (auto& stage : stages_)
+        stage.reset();
 }
 
 void LatencyMonitor::markCallbackStart()
@@ -89,17 +97,108 @@ void LatencyMonitor::markCallbackEnd()
     }
 }
 
+const char* callbackStageName(CallbackStage stage)
+{
+    switch (stage) {
+        case CallbackStage::Input:         return "input";
+        case CallbackStage::Gain:          return "gain";
+        case CallbackStage::Chain:         return "chain";
+        case CallbackStage::SafetyLimiter: return "safety_limiter";
+        case CallbackStage::Headroom:      return "headroom";
+        case CallbackStage::Recorder:      return "recorder";
+        case CallbackStage::Ipc:           return "ipc";
+        case CallbackStage::Monitor:       return "monitor";
+        case CallbackStage::Output:        return "output";
+        case CallbackStage::Count:         break;
+    }
+    return "unknown";
+}
+
+double StageTimingSnapshot::percentileUs(double q) const
+{
+    uint64_t total = 0;
+    for (auto n : histogram)
+        total += n;
+    if (total == 0)
+        return 0.0;
+
+    const double target = q * static_cast<double>(total);
+    uint64_t seen = 0;
+    for (int bin = 0; bin < kStageTimingBins; ++bin) {
+        seen += histogram[static_cast<size_t>(bin)];
+        if (static_cast<double>(seen) >= target && seen > 0) {
+            const double upperUs = bin < kStageTimingBins - 1
+                ? static_cast<double>(1ull << bin)
+                : static_cast<double>(maxNs) / 1000.0;
+            return std::min(upperUs, static_cast<double>(maxNs) / 1000.0);
+        }
+    }
+    return static_cast<double>(maxNs) / 1000.0;
+}
+
+void StageTimingHistogram::record(uint64_t ns)
+{
+    // Single writer: plain load/store, no locked RMW
+    auto& bin = histogram_[static_cast<size_t>(stageTimingBin(ns))];
+    bin.store(bin.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    totalNs_.store(totalNs_.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    if (ns > maxNs_.load(std::memory_order_relaxed))
+        maxNs_.store(ns, std::memory_order_relaxed);
+}
+
+void StageTimingHistogram::snapshot(StageTimingSnapshot& out) const
+{
+    out.count = 0;
+    for (size_t bin = 0; bin < histogram_.size(); ++bin) {
+        out.histogram[bin] = histogram_[bin].load(std::memory_order_relaxed);
+        out.count += out.histogram[bin];
+    }
+    out.totalNs = totalNs_.load(std::memory_order_relaxed);
+    out.maxNs = maxNs_.load(std::memory_order_relaxed);
+}
+
+void StageTimingHistogram::reset()
+{
+    totalNs_.store(0, std::memory_order_relaxed);
+    maxNs_.store(0, std::memory_order_relaxed);
+    for (auto& bin : histogram_)
+        bin.store(0, std::memory_order_relaxed);
+}
+
+void LatencyMonitor::recordStage(CallbackStage stage, uint64_t ns)
+{
+    stages_[static_cast<size_t>(stage)].record(ns);
+}
+
+void LatencyMonitor::getStageTimings(std::array<StageTimingSnapshot, kNumCallbackStages>& out) const
+{
+    for (size_t i = 0; i < stages_.size(); ++i)
+        stages_[i].snapshot(out[i]);
+}
+
+double LatencyMonitor::getBlockAdapterLatencyMs() const
+{
+    return static_cast<double>(blockAdapterLatency_.load(std::memory_order_relaxed))
+           / sampleRate_.load(std::memory_order_relaxed) * 1000.0;
+}
+
 double LatencyMonitor::getTotalLatencyOBSMs() const
 {
-    // OBS path: Input buffer + Processing + Shared memory (negligible)
+    // OBS path: Input buffer + block adapter + (callback start -> Receiver read).
+    // The measured IPC latency covers processing and ring buffering; until a
+    // Receiver reports one, fall back to processing time alone. The block
+    // timestamps are taken at callback start, so the adapter delay is not in it.
+    const double ipcMs = ipcLatencyMs_.load(std::memory_order_relaxed);
     return inputLatencyMs_.load(std::memory_order_relaxed) +
-           processingTimeMs_.load(std::memory_order_relaxed);
+           getBlockAdapterLatencyMs() +
+           (ipcMs > 0.0 ? ipcMs : processingTimeMs_.load(std::memory_order_relaxed));
 }
 
 double LatencyMonitor::getTotalLatencyVirtualMicMs() const
 {
-    // Virtual mic path: Input buffer + Processing + Output buffer (WASAPI)
+    // Virtual mic path: Input buffer + Block adapter + Processing + Output buffer (WASAPI)
     return inputLatencyMs_.load(std::memory_order_relaxed) +
+           getBlockAdapterLatencyMs() +
            processingTimeMs_.load(std::memory_order_relaxed) +
            outputLatencyMs_.load(std::memory_order_relaxed);
 }
@@ -24,14 +24,83 @@
  * - Input buffer latency (WASAPI)
  * - VST processing time
  * - Output buffer latency
+ *
+ * and keeps a per-stage timing histogram of the audio callback, so a spike
+ * can be attributed to the plugin chain or to the host's own fan-out.
  */
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 
 namespace directpipe {
 
+/// Stages of the audio callback timed by LatencyMonitor::recordStage, in callback order
+enum class CallbackStage : int {
+    Input = 0,       // input copy / mono mix
+    Gain,            // input gain + input mute
+    Chain,           // VST chain (incl. fixed-block adapter)
+    SafetyLimiter,   // Safety Guard
+    Headroom,        // Safety Volume trim
+    Recorder,        // recorder FIFO write
+    Ipc,             // all IPC stream writes (input, post-chain, main)
+    Monitor,         // monitor output routing
+    Output,          // main output copy / volume
+    Count
+};
+
+constexpr int kNumCallbackStages = static_cast<int>(CallbackStage::Count);
+
+/// Stable JSON name of a stage ("input", "chain", ...)
+const char* callbackStageName(CallbackStage stage);
+
+/// Number of bins in a stage histogram (see stageTimingBin)
+constexpr int kStageTimingBins = 16;
+
+/// Histogram bin for a stage time: bin 0 is < 1 us, bin k is [2^(k-1), 2^k) us,
+/// the last bin is open-ended (>= 16.4 ms)
+constexpr int stageTimingBin(uint64_t ns)
+{
+    const uint64_t us = ns / 1000;
+    int bin = 0;
+    for (uint64_t edge = 1; bin < kStageTimingBins - 1 && us >= edge; edge <<= 1)
+        ++bin;
+    return bin;
+}
+
+/// Non-RT copy of one stage's counters
+struct StageTimingSnapshot {
+    uint64_t count = 0;      // sub-blocks timed
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+    std::array<uint32_t, kStageTimingBins> histogram{};
+
+    double meanUs() const { return count > 0 ? static_cast<double>(totalNs) / static_cast<double>(count) / 1000.0 : 0.0; }
+
+    /// Upper edge of the bin holding quantile q (0..1), capped at maxNs; 0 if empty
+    double percentileUs(double q) const;
+};
+
+/**
+ * @brief Lock-free timing histogram with a single RT writer.
+ *
+ * record() is called from one audio thread only and uses plain relaxed
+ * load/store (no locked RMW). snapshot() may run on any thread; reset()
+ * only while the writer is stopped.
+ */
+class StageTimingHistogram {
+public:
+    void record(uint64_t ns);
+    void snapshot(StageTimingSnapshot& out) const;
+    void reset();
+
+private:
+    std::atomic<uint64_t> totalNs_{0};
+    std::atomic<uint64_t> maxNs_{0};
+    std::array<std::atomic<uint32_t>, kStageTimingBins> histogram_{};
+};
+
 /**
  * @brief Measures and reports audio path latency.
  *
@@ -75,8 +144,42 @@ public:
      */
     double getOutputLatencyMs() const { return outputLatencyMs_.load(std::memory_order_relaxed); }
 
+    /**
+     * @brief Set the delay of the fixed processing block adapter (called from RT thread).
+     *
+     * 0 when the chain runs at the device block size. Added to both totals:
+     * the adapter delays the audio itself, not just its processing.
+     */
+    void setBlockAdapterLatencySamples(int samples) { blockAdapterLatency_.store(samples, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the processing block adapter delay in samples.
+     */
+    int getBlockAdapterLatencySamples() const { return blockAdapterLatency_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the processing block adapter delay in milliseconds.
+     */
+    double getBlockAdapterLatencyMs() const;
+
+    /**
+     * @brief Set the measured shared-memory path latency (called from RT thread).
+     *
+     * Measured by the Receiver from the block timestamp stamped at callback
+     * start to its read, so it already includes processing time and ring
+     * buffering. 0 = no consumer has reported yet.
+     */
+    void setIpcLatencyMs(double ms) { ipcLatencyMs_.store(ms, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the measured shared-memory path latency in milliseconds (0 = unknown).
+     */
+    double getIpcLatencyMs() const { return ipcLatencyMs_.load(std::memory_order_relaxed); }
+
     /**
      * @brief Get the total end-to-end latency for shared memory path (OBS).
+     * Uses the Receiver-measured IPC latency when available, otherwise
+     * input buffer + processing time; plus the block adapter delay.
      */
     double getTotalLatencyOBSMs() const;
 
@@ -112,6 +215,21 @@ public:
      */
     void resetCallbackOverruns() { callbackOverruns_.store(0, std::memory_order_relaxed); }
 
+    /**
+     * @brief Add one timing sample to a callback stage (called from RT thread).
+     *
+     * Lock-free: relaxed increments on the stage's histogram bin and totals.
+     */
+    void recordStage(CallbackStage stage, uint64_t ns);
+
+    /**
+     * @brief Copy every stage's counters since the last reset (any non-RT thread).
+     *
+     * Fields are read one by one while the RT thread may be writing, so a
+     * snapshot can be off by the sample in flight; fine for telemetry.
+     */
+    void getStageTimings(std::array<StageTimingSnapshot, kNumCallbackStages>& out) const;
+
 private:
     std::atomic<double> sampleRate_{48000.0};       // [Message write, RT read]
     std::atomic<int> bufferSize_{128};               // [Message write, RT read]
@@ -122,6 +240,8 @@ private:
     std::atomic<double> processingTimeMs_{0.0};
     std::atomic<double> outputLatencyMs_{0.0};
     std::atomic<double> cpuUsage_{0.0};
+    std::atomic<double> ipcLatencyMs_{0.0};           // [RT write, Any read] consumer-measured, 0 = unknown
+    std::atomic<int> blockAdapterLatency_{0};         // [Device/RT write, Any read] fixed-block adapter delay (samples)
 
     // Running average for smooth display
     std::atomic<double> avgProcessingTime_{0.0};     // [Message write (reset), RT read+write]
@@ -129,6 +249,9 @@ private:
 
     // Callback overrun detection: processing time > buffer period = guaranteed glitch
     std::atomic<uint32_t> callbackOverruns_{0};       // [RT write, Message read]
+
+    // Per-stage callback timing, cumulative since reset()
+    std::array<StageTimingHistogram, kNumCallbackStages> stages_{};  // [RT write, Any read]
 };
 
 } // namespace directpipe
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file ParameterQueue.cpp
+ * @brief Coalescing lock-free plugin parameter changes into the audio thread
+ */
+
+#include "ParameterQueue.h"
+
+namespace directpipe {
+
+void ParameterQueue::setSmoothing(double sampleRate, double smoothingMs)
+{
+    smoothingSamples_.store(juce::jmax(0, juce::roundToInt(sampleRate * smoothingMs / 1000.0)),
+                            std::memory_order_relaxed);
+}
+
+bool ParameterQueue::push(const std::shared_ptr<juce::AudioProcessor>& owner,
+                          juce::AudioProcessorParameter* parameter, float value, bool smooth)
+{
+    const juce::AudioProcessor* stage = owner.get();
+    if (stage == nullptr || parameter == nullptr)
+        return false;
+
+    // The pair's own slot, else a never-used one, else one the audio thread is done with
+    int match = -1, empty = -1, idle = -1;
+    for (int i = 0; i < kSlots; ++i) {
+        const auto& slot = slots_[i];
+        if (slot.stage == stage && slot.parameter == parameter) {
+            match = i;
+            break;
+        }
+        if (slot.stage == nullptr) {
+            if (empty < 0)
+                empty = i;
+        } else if (idle < 0 && (slot.state.load(std::memory_order_acquire) & (kQueued | kRamping)) == 0) {
+            idle = i;
+        }
+    }
+    const int index = match >= 0 ? match : (empty >= 0 ? empty : idle);
+    if (index < 0)
+        return false;
+
+    auto& slot = slots_[index];
+    if (index != match) {
+        // Neither queued nor ramping, so the audio thread is not reading the key
+        slot.stage = stage;
+        slot.parameter = parameter;
+        slot.owner = owner;   // previous key's stage is released here, on this thread
+    }
+    slot.value.store(value, std::memory_order_relaxed);
+
+    uint32_t state = slot.state.load(std::memory_order_relaxed);
+    uint32_t next;
+    do {
+        next = ((state & ~(kQueued | kSmooth)) + kCountStep) | kQueued | (smooth ? kSmooth : 0u);
+    } while (!slot.state.compare_exchange_weak(state, next, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+
+    // Already queued: the audio thread will read the new value (coalesced)
+    if ((state & kQueued) == 0) {
+        const uint32_t w = writeIdx_.load(std::memory_order_relaxed);
+        ring_[w % kSlots] = index;
+        writeIdx_.store(w + 1, std::memory_order_release);
+    }
+    return true;
+}
+
+void ParameterQueue::releaseStagesNotIn(const SerialChainExecutor::Plan& plan)
+{
+    for (auto& slot : slots_) {
+        if (slot.stage == nullptr || inPlan(plan, slot.stage))
+            continue;
+        if ((slot.state.load(std::memory_order_acquire) & (kQueued | kRamping)) != 0)
+            continue;   // the audio thread drops it (stage not in its Plan), release next time
+        slot.stage = nullptr;
+        slot.parameter = nullptr;
+        slot.owner.reset();
+    }
+}
+
+int ParameterQueue::pendingCount() const
+{
+    return static_cast<int>(writeIdx_.load(std::memory_order_acquire)
+                            - readIdx_.load(std::memory_order_acquire));
+}
+
+bool ParameterQueue::inPlan(const SerialChainExecutor::Plan& plan, const juce::AudioProcessor* stage)
+{
+    for (const auto& s : plan.stages)
+        if (s.processor == stage)
+            return true;
+    return false;
+}
+
+void ParameterQueue::applyBlock(const SerialChainExecutor::Plan& plan, int numSamples)
+{
+    const uint32_t end = writeIdx_.load(std::memory_order_acquire);
+    uint32_t r = readIdx_.load(std::memory_order_relaxed);
+    for (; r != end; ++r) {
+        const int index = ring_[r % kSlots];
+        auto& slot = slots_[index];
+        const bool live = inPlan(plan, slot.stage);
+
+        // Clear `queued` only if nothing changed since the value was read;
+        // otherwise read again (the producer saw `queued` and did not requeue)
+        uint32_t state = slot.state.load(std::memory_order_acquire);
+        for (;;) {
+            const float value = slot.value.load(std::memory_order_relaxed);
+            if (live)
+                setTarget(index, value, (state & kSmooth) != 0);
+            if (slot.state.compare_exchange_weak(state, state & ~kQueued, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire))
+                break;
+        }
+    }
+    readIdx_.store(r, std::memory_order_release);
+
+    advanceRamps(plan, numSamples);
+}
+
+void ParameterQueue::setTarget(int slot, float value, bool smooth)
+{
+    auto* parameter = slots_[slot].parameter;
+    int ramp = -1;
+    for (int i = 0; i < numRamps_ && ramp < 0; ++i)
+        if (ramps_[i].slot == slot)
+            ramp = i;
+
+    const int samples = smoothingSamples_.load(std::memory_order_relaxed);
+    if (!smooth || samples <= 0 || parameter->isDiscrete() || parameter->isBoolean()) {
+        if (ramp >= 0)
+            removeRamp(ramp);
+        parameter->setValue(value);
+        return;
+    }
+
+    if (ramp < 0) {
+        if (numRamps_ == kMaxRamps) {
+            parameter->setValue(value);
+            return;
+        }
+        ramp = numRamps_++;
+        ramps_[ramp].slot = slot;
+        ramps_[ramp].current = parameter->getValue();
+        slots_[slot].state.fetch_or(kRamping, std::memory_order_relaxed);
+    }
+    ramps_[ramp].target = value;
+    ramps_[ramp].samplesLeft = samples;
+}
+
+void ParameterQueue::removeRamp(int ramp)
+{
+    // Release: the producer may rewrite the key once it sees the bit clear
+    slots_[ramps_[ramp].slot].state.fetch_and(~kRamping, std::memory_order_release);
+    ramps_[ramp] = ramps_[--numRamps_];
+}
+
+void ParameterQueue::advanceRamps(const SerialChainExecutor::Plan& plan, int numSamples)
+{
+    for (int i = 0; i < numRamps_;) {
+        auto& ramp = ramps_[i];
+        const auto& slot = slots_[ramp.slot];
+        if (!inPlan(plan, slot.stage)) {
+            removeRamp(i);   // stage removed: stop touching its parameter
+            continue;
+        }
+
+        // Linear glide, one step per block (parameters are read once per block)
+        if (numSamples >= ramp.samplesLeft) {
+            ramp.current = ramp.target;
+            ramp.samplesLeft = 0;
+        } else {
+            ramp.current += (ramp.target - ramp.current) * static_cast<float>(numSamples)
+                            / static_cast<float>(ramp.samplesLeft);
+            ramp.samplesLeft -= numSamples;
+        }
+        slot.parameter->setValue(ramp.current);
+
+        if (ramp.samplesLeft == 0)
+            removeRamp(i);
+        else
+            ++i;
+    }
+}
+
+} // namespace directpipe
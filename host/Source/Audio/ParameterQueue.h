@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file ParameterQueue.h
+ * @brief Coalescing lock-free plugin parameter changes into the audio thread
+ */
+#pragma once
+
+#include <JuceHeader.h>
+#include "SerialChainExecutor.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace directpipe {
+
+/**
+ * @brief Carries plugin parameter changes from the message thread to the
+ *        audio thread, which applies them at the start of the next block.
+ *
+ * Each (stage, parameter) pair owns one slot holding only its latest
+ * value, so a controller sweep never queues more than one change per
+ * parameter: a slot waiting for the audio thread is just overwritten. Slot
+ * indices travel through an SPSC ring; a slot is in the ring at most once,
+ * so the ring cannot overflow.
+ *
+ * Slot state is one atomic word,
+ * (update count << 3) | ramping << 2 | smooth << 1 | queued.
+ * The audio thread clears `queued` with a compare-exchange against the word
+ * it read with the value, so an update racing the read is applied on the
+ * next pass instead of being lost. It holds `ramping` while the parameter
+ * glides; a slot that is queued or ramping keeps its key.
+ *
+ * Smoothed changes of continuous parameters glide to their target over the
+ * smoothing time, one step per block (plugins read parameters once per
+ * block); discrete and boolean parameters, and unsmoothed changes, jump.
+ *
+ * A change names the chain stage (the processor the Plan renders) and a
+ * parameter owned by it or by the plugin it wraps. Changes and ramps are
+ * only applied while that stage is in the Plan being rendered, which keeps
+ * the parameter alive for the block. A slot also shares ownership of its
+ * stage until the slot is reused or released, so a removed plugin's address
+ * cannot come back as a new plugin while a change for it is still queued.
+ *
+ * Thread Ownership:
+ *   push(), releaseStagesNotIn() -- [Message thread only — single producer]
+ *   applyBlock()      -- [RT audio thread, inside SerialChainExecutor::process]
+ *   setSmoothing()    -- [Any thread]
+ */
+class ParameterQueue {
+public:
+    /// (stage, parameter) pairs that can have a change in flight at once
+    static constexpr int kSlots = 256;
+    /// Parameters gliding at once; further smoothed changes jump
+    static constexpr int kMaxRamps = 64;
+
+    ParameterQueue() = default;
+
+    /** @brief Ramp length for smoothed changes (0 = no smoothing). [Any thread] */
+    void setSmoothing(double sampleRate, double smoothingMs);
+
+    /**
+     * @brief Queue `value` (0.0-1.0) for `parameter`, owned by (the plugin inside) `stage`.
+     * @param smooth Glide to the value (continuous parameters only) instead of jumping.
+     * @return false when kSlots other pairs are still waiting (change dropped).
+     */
+    bool push(const std::shared_ptr<juce::AudioProcessor>& stage, juce::AudioProcessorParameter* parameter,
+              float value, bool smooth);
+
+    /**
+     * @brief Let go of stages `plan` no longer renders (call before publishing it).
+     *
+     * Slots still waiting for the audio thread keep their stage until a later call.
+     */
+    void releaseStagesNotIn(const SerialChainExecutor::Plan& plan);
+
+    /**
+     * @brief Apply queued changes and advance ramps by numSamples. [RT thread — no locks, no allocation]
+     *
+     * Changes and ramps for stages that are not in `plan` are dropped.
+     */
+    void applyBlock(const SerialChainExecutor::Plan& plan, int numSamples);
+
+    /** @brief Slots waiting for the audio thread (diagnostics/tests). */
+    int pendingCount() const;
+
+private:
+    struct Slot {
+        // Key: written by the producer only while the slot is not queued
+        const juce::AudioProcessor* stage = nullptr;
+        juce::AudioProcessorParameter* parameter = nullptr;
+        std::shared_ptr<juce::AudioProcessor> owner;   // [Message thread only] keeps `stage` alive
+        std::atomic<float> value{0.0f};          // [Message write, RT read]
+        std::atomic<uint32_t> state{0};          // [Message CAS, RT CAS] see class doc
+    };
+
+    struct Ramp {
+        int slot = 0;
+        float current = 0.0f;
+        float target = 0.0f;
+        int samplesLeft = 0;
+    };
+
+    static constexpr uint32_t kQueued = 1u;
+    static constexpr uint32_t kSmooth = 2u;
+    static constexpr uint32_t kRamping = 4u;
+    static constexpr uint32_t kCountStep = 8u;
+
+    static bool inPlan(const SerialChainExecutor::Plan& plan, const juce::AudioProcessor* stage);
+
+    void setTarget(int slot, float value, bool smooth);
+    void removeRamp(int ramp);
+    void advanceRamps(const SerialChainExecutor::Plan& plan, int numSamples);
+
+    Slot slots_[kSlots];
+    int ring_[kSlots] = {};                      // slot indices, [Message write, RT read]
+    std::atomic<uint32_t> writeIdx_{0};          // [Message write, RT read]
+    std::atomic<uint32_t> readIdx_{0};           // [RT write, Message read]
+    std::atomic<int> smoothingSamples_{0};       // [Any write, RT read]
+
+    Ramp ramps_[kMaxRamps];                      // [RT thread only]
+    int numRamps_ = 0;                           // [RT thread only]
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterQueue)
+};
+
+} // namespace directpipe
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file PluginLoadPool.cpp
+ * @brief Bounded concurrent plugin instance creation
+ */
+
+#include "PluginLoadPool.h"
+#include "PluginLoadHelper.h"
+#include "../Control/Log.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#if JUCE_WINDOWS
+ #include <objbase.h>   // CoInitializeEx / CoUninitialize (VST3 COM requirement)
+#endif
+
+namespace directpipe {
+
+namespace {
+
+// ─── Format gate ────────────────────────────────────────────────────
+// JUCE의 포맷 로더는 모듈 목록을 락 없이 관리 (VST2 모듈 핸들, VST3 DLL 캐시)
+// → 모듈을 새로 여는 생성은 배타적으로, 이미 열린 VST3 모듈의 추가 인스턴스만 공유 락으로 동시 생성
+// 프로세스 전역: replaceChainAsync와 프리로드가 동시에 돌아도 같은 게이트를 씀
+// ────────────────────────────────────────────────────────────────────
+std::shared_mutex& formatGate()
+{
+    static std::shared_mutex gate;
+    return gate;
+}
+
+/// VST3 modules by first-load state (a loaded module stays in JUCE's DLL cache)
+struct ModuleRegistry {
+    enum class State { Loading, Loaded };
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::map<juce::String, State> modules;   // [Protected by mutex]
+};
+
+ModuleRegistry& modules()
+{
+    static ModuleRegistry registry;
+    return registry;
+}
+
+/**
+ * True: the module is loaded, create under the shared gate. False: create
+ * exclusively (and, for VST3, report the outcome with finishFirstLoad()).
+ * Waits while another worker is loading the same module for the first time.
+ */
+bool beginLoad(const juce::PluginDescription& desc)
+{
+    if (desc.pluginFormatName != "VST3")
+        return false;
+    auto& registry = modules();
+    std::unique_lock<std::mutex> lock(registry.mutex);
+    for (;;) {
+        auto it = registry.modules.find(desc.fileOrIdentifier);
+        if (it == registry.modules.end()) {
+            registry.modules.emplace(desc.fileOrIdentifier, ModuleRegistry::State::Loading);
+            return false;
+        }
+        if (it->second == ModuleRegistry::State::Loaded)
+            return true;
+        registry.changed.wait(lock);
+    }
+}
+
+void finishFirstLoad(const juce::PluginDescription& desc, bool loaded)
+{
+    if (desc.pluginFormatName != "VST3")
+        return;
+    auto& registry = modules();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (loaded)
+            registry.modules[desc.fileOrIdentifier] = ModuleRegistry::State::Loaded;
+        else
+            registry.modules.erase(desc.fileOrIdentifier);   // next attempt loads it exclusively again
+    }
+    registry.changed.notify_all();
+}
+
+void createOne(PluginLoadJob& job, juce::AudioPluginFormatManager& formatMgr,
+               double sampleRate, int blockSize,
+               const std::shared_ptr<std::atomic<bool>>& alive, std::atomic<bool>* cancelToken)
+{
+    auto create = [&] {
+        try {
+            job.instance = createPluginOnCorrectThread(formatMgr, job.desc, sampleRate, blockSize,
+                                                       job.error, alive, cancelToken);
+        } catch (const std::exception& e) {
+            job.error = "Plugin threw exception: " + juce::String(e.what());
+        } catch (...) {
+            job.error = "Plugin crashed during initialization (unknown exception)";
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    if (beginLoad(job.desc)) {
+        std::shared_lock<std::shared_mutex> shared(formatGate());
+        create();
+    } else {
+        {
+            std::unique_lock<std::shared_mutex> exclusive(formatGate());
+            create();
+        }
+        finishFirstLoad(job.desc, job.instance != nullptr);
+    }
+    job.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    job.attempted = true;
+}
+
+} // namespace
+
+int defaultPluginLoadWorkers()
+{
+#if JUCE_MAC
+    return 1;   // createPluginOnCorrectThread runs every creation on the main thread
+#else
+    const int hw = static_cast<int>(std::thread::hardware_concurrency());
+    return juce::jlimit(1, kMaxPluginLoadWorkers, hw / 2);
+#endif
+}
+
+// ─── createPluginsConcurrently ──────────────────────────────────────
+// 호출 스레드도 워커 하나로 참여 (워커 1개면 기존 순차 로딩과 동일)
+// 작업은 atomic 인덱스로 순서대로 가져감 → 앞선 작업(우선순위 높은 슬롯)이 먼저 시작
+// WARNING: 추가 워커마다 Windows COM STA 초기화 필수 (VST3 플러그인 팩토리)
+// WARNING: 워커는 인스턴스를 파괴하지 않음 — 실패/취소분 정리는 호출자가 Message 스레드에서
+// ────────────────────────────────────────────────────────────────────
+void createPluginsConcurrently(std::vector<PluginLoadJob>& jobs,
+                               juce::AudioPluginFormatManager& formatMgr,
+                               double sampleRate, int blockSize,
+                               const std::function<bool()>& isCancelled,
+                               std::shared_ptr<std::atomic<bool>> alive,
+                               std::atomic<bool>* cancelToken,
+                               int maxWorkers)
+{
+    if (jobs.empty())
+        return;
+
+    const auto start = std::chrono::steady_clock::now();
+    const int workers = juce::jlimit(1, static_cast<int>(jobs.size()), maxWorkers);
+    std::atomic<size_t> next{0};
+
+    auto work = [&] {
+        for (;;) {
+            const size_t i = next.fetch_add(1);
+            if (i >= jobs.size())
+                return;
+            if (isCancelled && isCancelled()) {
+                next.store(jobs.size());   // leave the rest unattempted
+                return;
+            }
+            auto& job = jobs[i];
+            createOne(job, formatMgr, sampleRate, blockSize, alive, cancelToken);
+            if (job.instance)
+                Log::info("VST", "Plugin created: " + job.desc.name + " (" + job.desc.pluginFormatName + ", "
+                          + juce::String(job.loadMs, 1) + "ms)");
+        }
+    };
+
+    std::vector<std::thread> extra;
+    extra.reserve(static_cast<size_t>(workers - 1));
+    for (int w = 1; w < workers; ++w) {
+        extra.emplace_back([&work] {
+        #if JUCE_WINDOWS
+            // Same apartment as the caller's thread: VST3 factories need STA. DO NOT change this.
+            CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
+            struct ComScope { ~ComScope() { CoUninitialize(); } } comGuard;
+        #endif
+            work();
+        });
+    }
+    work();
+    for (auto& t : extra)
+        t.join();
+
+    int created = 0, attempted = 0;
+    double sumMs = 0.0, slowestMs = 0.0;
+    juce::String slowest;
+    for (const auto& job : jobs) {
+        if (!job.attempted) continue;
+        ++attempted;
+        if (job.instance) ++created;
+        sumMs += job.loadMs;
+        if (job.loadMs > slowestMs) {
+            slowestMs = job.loadMs;
+            slowest = job.desc.name;
+        }
+    }
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Log::info("VST", "Plugin load batch: " + juce::String(created) + "/" + juce::String(static_cast<int>(jobs.size()))
+              + " created, " + juce::String(workers) + " workers, " + juce::String(juce::roundToInt(wallMs))
+              + "ms wall, " + juce::String(juce::roundToInt(sumMs)) + "ms summed"
+              + (slowest.isNotEmpty() ? ", slowest " + slowest + " " + juce::String(juce::roundToInt(slowestMs)) + "ms" : juce::String())
+              + (attempted < static_cast<int>(jobs.size()) ? " (cancelled)" : ""));
+}
+
+} // namespace directpipe
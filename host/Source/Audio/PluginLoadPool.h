@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file PluginLoadPool.h
+ * @brief Create a batch of plugin instances on a bounded set of worker threads
+ *
+ * Used by VSTChain::replaceChainAsync and PluginPreloadCache::preloadAllSlots,
+ * which used to create plugins one after another on their background thread.
+ */
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace directpipe {
+
+/** One plugin to create, and the outcome. */
+struct PluginLoadJob {
+    juce::PluginDescription desc;
+    std::unique_ptr<juce::AudioPluginInstance> instance;  ///< nullptr on failure or cancel
+    juce::String error;
+    double loadMs = 0.0;       ///< wall time of the creation call
+    bool attempted = false;    ///< false when cancelled before it started
+};
+
+/// Upper bound on concurrent plugin creations (each may map a large DLL and allocate a lot)
+constexpr int kMaxPluginLoadWorkers = 4;
+
+/** @brief Workers for a batch: half the hardware threads, 1..kMaxPluginLoadWorkers (1 on macOS). */
+int defaultPluginLoadWorkers();
+
+/**
+ * @brief Create every job's plugin, up to `maxWorkers` at a time. Blocks until done.
+ *
+ * The calling thread works as one of the workers; the others are started for
+ * this call only. Jobs are started in vector order, so earlier jobs finish first.
+ *
+ * Threading constraints honoured per job:
+ *   - creation goes through createPluginOnCorrectThread() (macOS main-thread
+ *     dispatch; there the pool uses one worker since creation is serialised anyway)
+ *   - every extra worker initialises COM as STA on Windows, like the caller
+ *   - a process-wide gate serialises creation for formats whose loaders keep
+ *     unsynchronised module state (VST2, AU, LV2, ...) and for the first
+ *     instance of each VST3 module; further instances of a loaded VST3
+ *     module (waiting for its first load if one is under way) are created
+ *     concurrently
+ *
+ * Instances are handed back to the caller, never destroyed by a worker, so the
+ * caller can release them on the message thread as before.
+ *
+ * @param isCancelled Polled before each job starts; true leaves the rest unattempted.
+ * @param alive       Passed to createPluginOnCorrectThread (shutdown guard).
+ * @param cancelToken Passed to createPluginOnCorrectThread (aborts a macOS dispatch wait).
+ *
+ * Thread Ownership: [BG thread — never the message thread (macOS dispatch would deadlock)]
+ */
+void createPluginsConcurrently(std::vector<PluginLoadJob>& jobs,
+                               juce::AudioPluginFormatManager& formatMgr,
+                               double sampleRate, int blockSize,
+                               const std::function<bool()>& isCancelled,
+                               std::shared_ptr<std::atomic<bool>> alive = nullptr,
+                               std::atomic<bool>* cancelToken = nullptr,
+                               int maxWorkers = defaultPluginLoadWorkers());
+
+} // namespace directpipe
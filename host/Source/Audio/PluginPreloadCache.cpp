@@ -22,7 +22,7 @@
  */
 
 #include "PluginPreloadCache.h"
-#include "PluginLoadHelper.h"
+#include "PluginLoadPool.h"
 
 #if JUCE_WINDOWS
  #include <objbase.h>   // CoInitializeEx / CoUninitialize (VST3 COM requirement)
@@ -64,7 +64,8 @@ bool PluginPreloadCache::isCached(int slotIndex, double currentSR, int currentBS
 
 // ─── Background Preload Thread ──────────────────────────────────────
 // BG 스레드에서 실행 — Message thread 아님
-// WARNING: Windows에서 COM STA 초기화 필수 (CoInitializeEx)
+// 슬롯 파싱 → 전체 플러그인을 createPluginsConcurrently로 병렬 생성 → 슬롯별 조립/저장
+// WARNING: Windows에서 COM STA 초기화 필수 (CoInitializeEx, 풀의 추가 워커도 각자 초기화)
 // slotVersions_: 프리로드 시작 시 캡처, 완료 시 재확인 (중간에 invalidate되면 폐기)
 // preloadGeneration_: 전체 프리로드 세션 카운터 (새 요청이 이전 요청을 대체)
 // cancelPreload_: non-blocking 취소 플래그
@@ -144,12 +145,24 @@ void PluginPreloadCache::preloadAllSlots(
         if (preloadGeneration_.load() == myGeneration)
             cancelPreload_.store(false);
 
+        const auto startMs = juce::Time::getMillisecondCounter();
+
         // Collect partially-built slots here so we never destroy plugin
         // instances on this background thread (DLL unload race condition).
         std::vector<std::unique_ptr<CachedSlot>> pendingDestroy;
 
+        auto cancelled = [this, myGeneration] {
+            return cancelPreload_.load() || preloadGeneration_.load() != myGeneration;
+        };
+
+        // 1. Parse every slot that needs loading (no plugin created yet)
+        struct ParsedSlot {
+            const SlotData* source;
+            std::unique_ptr<CachedSlot> slot;
+        };
+        std::vector<ParsedSlot> parsedSlots;
         for (auto& slotData : slotsToLoad) {
-            if (cancelPreload_.load() || preloadGeneration_.load() != myGeneration) break;
+            if (cancelled()) break;
 
             // Skip if already cached with matching SR/BS (persistent cache)
             {
@@ -176,8 +189,6 @@ void PluginPreloadCache::preloadAllSlots(
             cachedSlot->blockSize = bs;
 
             for (auto& pluginVar : *pluginsArray) {
-                if (cancelPreload_.load() || preloadGeneration_.load() != myGeneration) break;
-
                 auto* pluginObj = pluginVar.getDynamicObject();
                 if (!pluginObj) continue;
 
@@ -217,33 +228,46 @@ void PluginPreloadCache::preloadAllSlots(
 
                 if (entry.desc.name.isEmpty()) continue;
 
-                juce::String error;
-                try {
-                    entry.instance = createPluginOnCorrectThread(formatMgr, entry.desc, sr, static_cast<int>(bs), error, nullptr, &cancelPreload_);
-                } catch (const std::exception& e) {
-                    juce::Logger::writeToLog("[VST] Preload crashed: " + entry.name + " - " + juce::String(e.what()));
-                    continue;
-                } catch (...) {
-                    juce::Logger::writeToLog("[VST] Preload crashed: " + entry.name + " (unknown exception)");
-                    continue;
-                }
-                if (!entry.instance) {
-                    juce::Logger::writeToLog("[VST] Preload failed: " + entry.name + " - " + error);
+                cachedSlot->entries.push_back(std::move(entry));
+            }
+            if (!cachedSlot->entries.empty())
+                parsedSlots.push_back({ &slotData, std::move(cachedSlot) });
+        }
+
+        // 2. Create all instances on the load pool, in slot priority order
+        std::vector<PluginLoadJob> jobs;
+        for (const auto& parsedSlot : parsedSlots)
+            for (const auto& entry : parsedSlot.slot->entries)
+                jobs.push_back({ entry.desc });
+        createPluginsConcurrently(jobs, formatMgr, sr, static_cast<int>(bs), cancelled, nullptr, &cancelPreload_);
+
+        // 3. Hand instances to their entries (plugins that failed are left out, as before)
+        size_t job = 0;
+        for (auto& parsedSlot : parsedSlots) {
+            auto& cachedSlot = parsedSlot.slot;
+            std::vector<CachedEntry> created;
+            for (auto& entry : cachedSlot->entries) {
+                auto& loaded = jobs[job++];
+                if (!loaded.instance) {
+                    if (loaded.attempted)
+                        juce::Logger::writeToLog("[VST] Preload failed: " + entry.name + " - " + loaded.error);
                     continue;
                 }
-
-                cachedSlot->entries.push_back(std::move(entry));
+                entry.instance = std::move(loaded.instance);
+                created.push_back(std::move(entry));
             }
+            cachedSlot->entries = std::move(created);
 
-            if (cancelPreload_.load() || preloadGeneration_.load() != myGeneration) {
+            if (cancelled()) {
                 // Don't destroy plugin instances on background thread!
                 // Move to pendingDestroy → cleaned up on message thread.
                 if (!cachedSlot->entries.empty())
                     pendingDestroy.push_back(std::move(cachedSlot));
-                break;
+                continue;
             }
 
             if (!cachedSlot->entries.empty()) {
+                const auto& slotData = *parsedSlot.source;
                 // Check slot version: if it changed since we read the file,
                 // the chain was modified and our cached data is stale.
                 // This prevents the race where a stale preload overwrites
@@ -269,7 +293,8 @@ void PluginPreloadCache::preloadAllSlots(
                 std::lock_guard<std::mutex> lock(cacheMutex_);
                 cachedCount = static_cast<int>(cache_.size());
             }
-            juce::Logger::writeToLog("[VST] Preload complete: " + juce::String(cachedCount) + " slots cached");
+            juce::Logger::writeToLog("[VST] Preload complete: " + juce::String(cachedCount) + " slots cached ("
+                                     + juce::String(static_cast<int>(juce::Time::getMillisecondCounter() - startMs)) + "ms)");
         }
 
         // Move any orphaned plugin instances to message thread for safe destruction.
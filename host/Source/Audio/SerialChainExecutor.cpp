@@ -0,0 +1,391 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file SerialChainExecutor.cpp
+ * @brief Lock-free serial plugin chain renderer
+ */
+
+#include "SerialChainExecutor.h"
+#include "ParameterQueue.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace directpipe {
+
+namespace {
+
+bool fadesIn(SerialChainExecutor::Fade fade)
+{
+    return fade == SerialChainExecutor::Fade::In || fade == SerialChainExecutor::Fade::FromBypass;
+}
+
+bool fadesOut(SerialChainExecutor::Fade fade)
+{
+    return fade == SerialChainExecutor::Fade::Out || fade == SerialChainExecutor::Fade::ToBypass;
+}
+
+} // namespace
+
+// ─── DryDelay ───────────────────────────────────────────────────
+
+void SerialChainExecutor::DryDelay::prepare(int channels, int latencySamples, int maxBlockSize)
+{
+    latency_ = juce::jmax(0, latencySamples);
+    ring_.setSize(latency_ > 0 ? juce::jmax(0, channels) : 0, latency_ + juce::jmax(1, maxBlockSize));
+    ring_.clear();
+    writePos_ = 0;
+}
+
+void SerialChainExecutor::DryDelay::write(const juce::AudioBuffer<float>& src, int channels, int numSamples)
+{
+    const int size = ring_.getNumSamples();
+    const int first = juce::jmin(numSamples, size - writePos_);
+    for (int ch = 0; ch < channels; ++ch) {
+        ring_.copyFrom(ch, writePos_, src, ch, 0, first);
+        if (first < numSamples)
+            ring_.copyFrom(ch, 0, src, ch, first, numSamples - first);
+    }
+    writePos_ = (writePos_ + numSamples) % size;
+}
+
+void SerialChainExecutor::DryDelay::read(juce::AudioBuffer<float>& dest, int channels, int numSamples) const
+{
+    // The ring holds latency + maxBlockSize samples, so the oldest of these
+    // is never overwritten by the write() that preceded this read
+    const int size = ring_.getNumSamples();
+    const int start = ((writePos_ - numSamples - latency_) % size + size) % size;
+    const int first = juce::jmin(numSamples, size - start);
+    for (int ch = 0; ch < channels; ++ch) {
+        dest.copyFrom(ch, 0, ring_, ch, start, first);
+        if (first < numSamples)
+            dest.copyFrom(ch, first, ring_, ch, 0, numSamples - first);
+    }
+}
+
+// ─── Plan ───────────────────────────────────────────────────────
+
+void SerialChainExecutor::Plan::addStage(std::shared_ptr<juce::AudioProcessor> processor, bool bypassed,
+                                         Fade fade, DryDelay* dryDelay, std::shared_ptr<FadeState> state)
+{
+    Stage stage;
+    stage.processor = processor.get();
+    stage.dryDelay = dryDelay != nullptr && dryDelay->getLatency() > 0 ? dryDelay : nullptr;
+    stage.bypassed = bypassed;
+    stage.fade = fade;
+    stage.processedTarget = !bypassed && (fade == Fade::None || fadesIn(fade));
+    stage.delayedTarget = fade != Fade::Out;
+    if (processor) {
+        const int ins = processor->getTotalNumInputChannels();
+        const int outs = processor->getTotalNumOutputChannels();
+        stage.numChannels = juce::jlimit(0, kMaxStageChannels, juce::jmax(ins, outs));
+        stage.numOutputs = juce::jmin(outs, stage.numChannels);
+    }
+
+    // A new state starts where the fade starts; a carried one where the
+    // previous Plan left it (the audio thread owns it from then on)
+    if (!state)
+        state = std::make_shared<FadeState>();
+    if (!state->placed) {
+        state->position = !bypassed && (fade == Fade::None || fadesOut(fade)) ? 1.0f : 0.0f;
+        state->delayed = fade == Fade::In ? 0.0f : 1.0f;
+        state->placed = true;
+    }
+    stage.state = state.get();
+
+    stages.push_back(stage);
+    keepAlive.push_back(std::move(processor));
+    fadeStates.push_back(std::move(state));
+}
+
+void SerialChainExecutor::Plan::allocate(int bufferChannels, int maxBlockSize, int fadeSamples)
+{
+    int widest = 0;
+    for (auto& stage : stages) {
+        if (stage.dryDelay != nullptr && stage.dryDelay->getMaxBlockSize() < maxBlockSize)
+            stage.dryDelay = nullptr;   // prepared for smaller blocks: run without alignment
+        if (stage.processor != nullptr)   // bypassed too: it may still be fading out
+            widest = juce::jmax(widest, stage.numChannels);
+    }
+    this->maxBlockSize = juce::jmax(1, maxBlockSize);
+    scratch.setSize(juce::jmax(0, widest - juce::jmax(0, bufferChannels)), this->maxBlockSize);
+    scratch.clear();   // touch the pages here, not on the audio thread
+
+    // Carried stages may still be mid-fade even where nothing new fades, so
+    // whether anything moves is only known on the audio thread
+    this->fadeSamples = juce::jmax(0, fadeSamples);
+    dry.setSize(this->fadeSamples > 0 ? juce::jmax(0, bufferChannels) : 0, this->maxBlockSize);
+    dry.clear();
+    input.setSize(dry.getNumChannels(), this->maxBlockSize);
+    input.clear();
+    transitionDone.store(this->fadeSamples == 0, std::memory_order_relaxed);
+}
+
+// ─── Executor ───────────────────────────────────────────────────
+
+SerialChainExecutor::~SerialChainExecutor()
+{
+    // The owner stops the audio callback first; nothing can be inside process()
+    delete current_.exchange(nullptr);
+    retired_.clear();
+}
+
+void SerialChainExecutor::publish(std::unique_ptr<Plan> plan)
+{
+    // seq_cst exchange + load pairs with process()'s increment + load: either
+    // the audio thread's next block sees the new Plan, or the stamp read here
+    // shows it is inside a block (odd) and we wait for that block to end
+    Plan* old = current_.exchange(plan.release(), std::memory_order_seq_cst);
+    if (old != nullptr)
+        retired_.push_back({ std::unique_ptr<Plan>(old), rtSequence_.load(std::memory_order_seq_cst) });
+    reclaim();
+}
+
+void SerialChainExecutor::reclaim()
+{
+    // Wait for at most one block per pass, and never again for a block that
+    // already outlasted a wait: entries retired during one long block share
+    // its stamp, and each would otherwise stall this thread for kMaxWaitMs.
+    // What is left is retried on the next publish.
+    bool mayWait = true;
+    for (auto it = retired_.begin(); it != retired_.end();) {
+        const bool left = mayWait && it->stamp != stuckStamp_ ? waitForRtExit(it->stamp)
+                                                              : rtHasLeft(it->stamp);
+        if (left) {
+            it = retired_.erase(it);   // destroys the Plan and any processor only it held
+        } else {
+            mayWait = false;
+            stuckStamp_ = it->stamp;
+            ++it;
+        }
+    }
+}
+
+void SerialChainExecutor::setSuspended(bool suspended)
+{
+    suspended_.store(suspended, std::memory_order_seq_cst);
+    if (suspended)
+        waitForRtExit(rtSequence_.load(std::memory_order_seq_cst));
+}
+
+bool SerialChainExecutor::isTransitionActive() const
+{
+    // current_ is only replaced on this thread, so the Plan cannot go away here
+    const Plan* plan = current_.load(std::memory_order_acquire);
+    return plan != nullptr && !plan->transitionDone.load(std::memory_order_acquire);
+}
+
+bool SerialChainExecutor::rtHasLeft(uint64_t stamp) const
+{
+    return (stamp & 1u) == 0 || rtSequence_.load(std::memory_order_acquire) != stamp;
+}
+
+bool SerialChainExecutor::waitForRtExit(uint64_t stamp) const
+{
+    if (rtHasLeft(stamp))
+        return true;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kMaxWaitMs);
+    while (!rtHasLeft(stamp)) {
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void SerialChainExecutor::process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    // Odd for the whole block, also when a plugin throws out of it
+    struct InBlock {
+        std::atomic<uint64_t>& seq;
+        explicit InBlock(std::atomic<uint64_t>& s) : seq(s) { seq.fetch_add(1, std::memory_order_seq_cst); }
+        ~InBlock() { seq.fetch_add(1, std::memory_order_release); }
+    } inBlock(rtSequence_);
+
+    if (suspended_.load(std::memory_order_seq_cst)) {
+        buffer.clear();
+        return;
+    }
+    if (Plan* plan = current_.load(std::memory_order_seq_cst)) {
+        // Parameter changes land at block start, while the Plan keeps their stages alive
+        if (parameters_ != nullptr)
+            parameters_->applyBlock(*plan, buffer.getNumSamples());
+        runPlan(*plan, buffer, midi);
+    }
+}
+
+void SerialChainExecutor::runPlan(Plan& plan, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples > plan.maxBlockSize)
+        return;   // Plan not sized for this block: pass through rather than overrun scratch
+
+    const int bufferChannels = buffer.getNumChannels();
+    const bool fading = plan.fadeSamples > 0;
+    float* channels[kMaxStageChannels];
+
+    // Nothing fades in this Plan: every stage is where its fade would end.
+    // Without latency there is no dry path to re-align either.
+    // Fade-ins that have not started wait until every fade-out is over.
+    bool fadingOut = false;
+    for (const auto& stage : plan.stages) {
+        if (stage.processor == nullptr || stage.numChannels == 0)
+            continue;
+        FadeState& state = *stage.state;
+        if (!fading || stage.dryDelay == nullptr)
+            state.delayed = stage.delayedTarget ? 1.0f : 0.0f;
+        if (!fading) {
+            state.position = stage.processedTarget ? 1.0f : 0.0f;
+            state.heldSamples = 0;
+        }
+        fadingOut |= state.position > (stage.processedTarget ? 1.0f : 0.0f)
+                  || state.delayed > (stage.delayedTarget ? 1.0f : 0.0f);
+    }
+
+    bool settled = true;
+    for (const auto& stage : plan.stages) {
+        if (stage.processor == nullptr || stage.numChannels == 0)
+            continue;
+        FadeState& state = *stage.state;
+        const float positionTarget = stage.processedTarget ? 1.0f : 0.0f;
+        const float delayedTarget = stage.delayedTarget ? 1.0f : 0.0f;
+        const bool rising = state.position < positionTarget || state.delayed < delayedTarget;
+        const bool falling = state.position > positionTarget || state.delayed > delayedTarget;
+        const bool started = state.heldSamples > 0 || state.position > 0.0f
+                          || (state.delayed > 0.0f && state.delayed < 1.0f);
+        const bool waiting = rising && fadingOut && !started;
+        const bool moving = (rising && !waiting) || falling;
+
+        if (!moving) {
+            state.heldSamples = 0;
+            settled &= !rising;
+            // Dry: not processed this block. Bypassed keeps the stage's latency;
+            // absent (faded out of the chain, or not faded in yet) is nothing at all
+            if (state.position == 0.0f) {
+                if (state.delayed > 0.0f)
+                    runBypassed(stage, buffer, numSamples);
+                continue;
+            }
+        }
+
+        // Dry path: the stage's input, delayed by its latency when it has one,
+        // and as it arrived while the delay is faded in or out
+        const int dryChannels = moving ? juce::jmin(bufferChannels, plan.dry.getNumChannels()) : 0;
+        for (int ch = 0; ch < dryChannels; ++ch)
+            plan.input.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        if (stage.dryDelay != nullptr) {
+            const int delayChannels = juce::jmin(bufferChannels, stage.dryDelay->getNumChannels());
+            stage.dryDelay->write(buffer, delayChannels, numSamples);
+            if (moving)
+                stage.dryDelay->read(plan.dry, juce::jmin(dryChannels, delayChannels), numSamples);
+        }
+        for (int ch = stage.dryDelay != nullptr ? stage.dryDelay->getNumChannels() : 0; ch < dryChannels; ++ch)
+            plan.dry.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+
+        // Only a stage that is, or is about to be, heard runs its plugin; the
+        // dry path alone moves while it stays at zero gain
+        if (state.position > 0.0f || (rising && stage.processedTarget)) {
+            // The stage's channels: the buffer's own first, then cleared scratch
+            for (int ch = 0; ch < stage.numChannels; ++ch) {
+                if (ch < bufferChannels) {
+                    channels[ch] = buffer.getWritePointer(ch);
+                } else {
+                    channels[ch] = plan.scratch.getWritePointer(ch - bufferChannels);
+                    juce::FloatVectorOperations::clear(channels[ch], numSamples);
+                }
+            }
+
+            // Stack view: AudioBuffer keeps fewer than 32 channel pointers inline
+            juce::AudioBuffer<float> view(channels, stage.numChannels, numSamples);
+            stage.processor->processBlock(view, midi);
+
+            if (stage.numOutputs == 1 && bufferChannels > 1)
+                buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+        }
+
+        if (moving) {
+            mixFade(plan, stage, buffer, dryChannels, numSamples, rising,
+                    stage.dryDelay != nullptr ? stage.dryDelay->getLatency() : 0);
+            settled &= state.position == positionTarget && state.delayed == delayedTarget;
+            if (!rising)
+                state.heldSamples = 0;   // a later rise holds again
+        }
+    }
+
+    if (settled && !plan.transitionDone.load(std::memory_order_relaxed))
+        plan.transitionDone.store(true, std::memory_order_release);
+}
+
+void SerialChainExecutor::runBypassed(const Stage& stage, juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    if (stage.dryDelay == nullptr)
+        return;
+    const int channels = juce::jmin(buffer.getNumChannels(), stage.dryDelay->getNumChannels());
+    stage.dryDelay->write(buffer, channels, numSamples);
+    stage.dryDelay->read(buffer, channels, numSamples);
+}
+
+void SerialChainExecutor::mixFade(const Plan& plan, const Stage& stage, juce::AudioBuffer<float>& buffer,
+                                  int channels, int numSamples, bool rising, int holdSamples)
+{
+    // Position along the fade at the end of each sample: the last sample of a
+    // fade-out is fully dry, the last of a fade-in fully processed. Gains sum
+    // to one: with the dry path latency-aligned, processed and dry audio are
+    // correlated, and an equal-power curve would bump the level mid-fade.
+    // Rising from 0 first holds for the stage's latency, until the plugin has
+    // flushed what it held from before and the delay holds only the input
+    // at this place in the chain; then the dry path moves onto the delay,
+    // then the processed gain rises. Falling runs the other way round.
+    FadeState& state = *stage.state;
+    const float positionTarget = stage.processedTarget ? 1.0f : 0.0f;
+    const float delayedTarget = stage.delayedTarget ? 1.0f : 0.0f;
+    const float step = 1.0f / static_cast<float>(plan.fadeSamples);
+    const auto up = [step](float x) { return x + step > 1.0f - 0.5f * step ? 1.0f : x + step; };
+    const auto down = [step](float x) { return x - step < 0.5f * step ? 0.0f : x - step; };
+    const auto curve = [](float x) { return 0.5f - 0.5f * std::cos(x * juce::MathConstants<float>::pi); };
+
+    float position = state.position;
+    float delayed = state.delayed;
+    for (int i = 0; i < numSamples; ++i) {
+        if (!rising) {
+            if (position > positionTarget)
+                position = down(position);
+            else if (delayed > delayedTarget)
+                delayed = down(delayed);
+        } else if (position == 0.0f && state.heldSamples < holdSamples) {
+            ++state.heldSamples;
+        } else if (delayed < delayedTarget) {
+            delayed = up(delayed);
+        } else if (position < positionTarget) {
+            position = up(position);
+        }
+        const float rise = curve(position);
+        const float align = curve(delayed);
+        for (int ch = 0; ch < channels; ++ch) {
+            float* out = buffer.getWritePointer(ch);
+            const float dry = plan.dry.getSample(ch, i) * align + plan.input.getSample(ch, i) * (1.0f - align);
+            out[i] = out[i] * rise + dry * (1.0f - rise);
+        }
+    }
+    state.position = position;
+    state.delayed = delayed;
+}
+
+} // namespace directpipe
@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file SerialChainExecutor.h
+ * @brief Lock-free serial plugin chain renderer (flat alternative to AudioProcessorGraph)
+ */
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace directpipe {
+
+class ParameterQueue;
+
+/**
+ * @brief Runs a strictly serial list of processors in place on the audio buffer.
+ *
+ * The chain the audio thread sees is an immutable Plan: a preallocated array
+ * of processor pointers with per-slot bypass flags, plus scratch channels for
+ * processors with more than the buffer's channels (sidechain inputs). The
+ * message thread builds a new Plan for every edit (add, remove, move, bypass)
+ * and publishes it with one atomic pointer exchange; the next block runs the
+ * new Plan. Nothing is suspended and no connection graph is rebuilt.
+ *
+ * The audio thread brackets each block with an increment of a sequence
+ * counter (odd while it is inside the chain). A replaced Plan — and any
+ * processor only it still holds — is destroyed on the message thread once
+ * the counter shows the audio thread has left the block that might have used
+ * it (bounded wait, at most one block; a Plan still in use after the wait is
+ * kept and freed on a later publish).
+ *
+ * Channel handling per stage: a processor with N = max(inputs, outputs)
+ * channels gets the buffer's first channels, then silent scratch channels for
+ * the rest. A mono-output processor's output is copied to channel 1 so the
+ * right channel does not go silent behind it.
+ *
+ * Transitions: a stage can fade in (dry -> processed) or out (processed ->
+ * dry) over the Plan's fadeSamples with a raised-cosine curve. Where a stage
+ * is along its fade lives in its FadeState, which successive Plans share: a
+ * Plan published mid-fade carries on from the current gain — or reverses
+ * from it — instead of starting over or cutting. All fade-outs run first;
+ * fade-ins that have not started yet begin on the block after they end (at
+ * once when there are none). A faded-out stage is skipped afterwards, so the
+ * same processor may appear twice in one Plan — fading out at its old
+ * position, then in at its new one — without ever processing the same block
+ * twice. Shared processors are never run on a copy of the audio, so stateful
+ * plugins stay consistent.
+ *
+ * Latency: a stage may carry a DryDelay matching its processor's latency.
+ * Its dry path (fade mix, and the whole signal while bypassed) is then read
+ * through the delay, so processed and dry audio stay time-aligned and
+ * bypassing a plugin neither combs nor shifts the chain's timing. The delay
+ * is fed every block the stage is in the chain, bypassed or not. A stage
+ * fading in holds its processed gain at zero for its latency first, until
+ * the plugin has flushed whatever it held from before. A stage with latency
+ * entering or leaving the chain (In, Out) also crossfades its dry path
+ * between the undelayed input and the delay, so the chain's timing changes
+ * without a splice: leaving, after its fade-out; entering, once the hold has
+ * refilled the delay with the input at its new place, before its fade-in.
+ *
+ * Parameters: an attached ParameterQueue is applied at the start of every
+ * block that renders a Plan, before the first stage runs.
+ *
+ * Thread Ownership:
+ *   process()                          -- [RT audio thread]
+ *   setParameterQueue()                -- [Before audio starts]
+ *   publish(), setSuspended(), reclaim() -- [Message thread]
+ *   isTransitionActive()               -- [Message thread]
+ */
+class SerialChainExecutor {
+public:
+    /// Most channels one stage may use (JUCE's AudioBuffer view stays heap-free below 32)
+    static constexpr int kMaxStageChannels = 16;
+
+    /// How a stage enters or leaves the chain when its Plan is published
+    enum class Fade {
+        None,
+        In,          ///< absent during the fade-out phase, then dry -> processed
+        Out,         ///< processed -> dry, then absent
+        FromBypass,  ///< bypassed during the fade-out phase, then dry -> processed
+        ToBypass     ///< processed -> dry, then bypassed
+    };
+
+    /**
+     * @brief Delays a stage's input by the stage's latency (its dry path).
+     *
+     * Sized once while the stage is not being rendered; afterwards only the
+     * audio thread touches it.
+     */
+    class DryDelay {
+    public:
+        /** @brief Size for `channels` x `latencySamples` of delay and blocks up to maxBlockSize; clears. */
+        void prepare(int channels, int latencySamples, int maxBlockSize);
+        int getLatency() const noexcept { return latency_; }
+        int getNumChannels() const noexcept { return ring_.getNumChannels(); }
+        int getMaxBlockSize() const noexcept { return ring_.getNumSamples() - latency_; }
+
+        /** @brief Append src's first `channels` channels. [RT thread] */
+        void write(const juce::AudioBuffer<float>& src, int channels, int numSamples);
+        /** @brief The last write()'s samples as they were `latency` samples earlier. [RT thread] */
+        void read(juce::AudioBuffer<float>& dest, int channels, int numSamples) const;
+
+    private:
+        juce::AudioBuffer<float> ring_;   // latency + maxBlockSize samples per channel
+        int latency_ = 0;
+        int writePos_ = 0;
+    };
+
+    /**
+     * @brief Where one stage is along its fade, shared by the Plans that carry the stage.
+     *
+     * Created on the message thread; once published only the audio thread
+     * reads or writes the fade fields.
+     */
+    struct FadeState {
+        float position = 1.0f;   ///< 0 = dry (absent or bypassed) .. 1 = processed, before the curve
+        float delayed = 1.0f;    ///< dry path: 0 = the input as is (absent) .. 1 = through the stage's delay
+        int heldSamples = 0;     ///< spent in the chain at zero gain so far while rising (latency hold)
+        bool placed = false;     ///< [Message thread] initialised by the first Plan that carries it
+    };
+
+    struct Stage {
+        juce::AudioProcessor* processor = nullptr;
+        DryDelay* dryDelay = nullptr;   ///< owned by the processor's owner (kept alive with it)
+        FadeState* state = nullptr;     ///< kept alive by Plan::fadeStates
+        bool bypassed = false;
+        Fade fade = Fade::None;
+        bool processedTarget = true;    ///< where the fade ends: processed (true) or dry
+        bool delayedTarget = true;      ///< ... and with the dry path delayed (true) or absent
+        int numChannels = 2;    ///< max(total inputs, total outputs), clamped to kMaxStageChannels
+        int numOutputs = 2;
+    };
+
+    /** @brief What the audio thread renders: built and destroyed on the message thread. */
+    struct Plan {
+        /**
+         * @brief Append a stage (chain order); the Plan shares ownership of the processor.
+         * @param dryDelay Optional latency delay for the stage's dry path; must
+         *                 outlive the Plan (e.g. held in dryDelays).
+         * @param state    The stage's fade state in the Plan it replaces, to carry
+         *                 an unfinished fade over; nullptr = a new one, starting
+         *                 where `fade` starts.
+         */
+        void addStage(std::shared_ptr<juce::AudioProcessor> processor, bool bypassed,
+                      Fade fade = Fade::None, DryDelay* dryDelay = nullptr,
+                      std::shared_ptr<FadeState> state = nullptr);
+
+        /**
+         * @brief Allocate scratch channels; call once after the last addStage().
+         * @param bufferChannels Channels of the buffer process() will be given.
+         * @param maxBlockSize   Largest numSamples process() will be given.
+         * @param fadeSamples    Length of a full fade (0 = none: every stage jumps to where it ends).
+         */
+        void allocate(int bufferChannels, int maxBlockSize, int fadeSamples = 0);
+
+        std::vector<Stage> stages;
+        /// Owners of the stage processors; a processor lives as long as any Plan holding it
+        std::vector<std::shared_ptr<juce::AudioProcessor>> keepAlive;
+        /// Owners of dry delays the stages' owner may replace while this Plan is live
+        std::vector<std::shared_ptr<DryDelay>> dryDelays;
+        /// The stages' fade states, in stage order (pass them to the next Plan's addStage)
+        std::vector<std::shared_ptr<FadeState>> fadeStates;
+        /// Channels past the buffer's own, for stages that need more (cleared per stage)
+        juce::AudioBuffer<float> scratch;
+        /// A fading stage's input through its delay, mixed back under its output
+        juce::AudioBuffer<float> dry;
+        /// A fading stage's input as it arrived, while its dry path is re-aligned
+        juce::AudioBuffer<float> input;
+        int maxBlockSize = 0;
+        int fadeSamples = 0;
+        std::atomic<bool> transitionDone{true};   // [RT write, Message read] every stage where its fade ends
+    };
+
+    SerialChainExecutor() = default;
+    ~SerialChainExecutor();
+
+    /**
+     * @brief Make `plan` the chain rendered from the next block on (nullptr = pass-through).
+     *
+     * The previous Plan is reclaimed here once the audio thread is done with it.
+     */
+    void publish(std::unique_ptr<Plan> plan);
+
+    /**
+     * @brief Render the current Plan in place. [RT thread — no locks, no allocation]
+     *
+     * While suspended the buffer is cleared instead. Plugin exceptions propagate
+     * to the caller (AudioEngine::processChain).
+     */
+    void process(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);
+
+    /**
+     * @brief Mute the chain (true) and wait until the audio thread has left it,
+     *        e.g. to restore plugin state. Resumes with false.
+     */
+    void setSuspended(bool suspended);
+    bool isSuspended() const { return suspended_.load(std::memory_order_relaxed); }
+
+    /** @brief Apply `queue` at every block start (nullptr = none); must outlive the executor's use. */
+    void setParameterQueue(ParameterQueue* queue) { parameters_ = queue; }
+
+    /** @brief Free replaced Plans the audio thread can no longer be using (waits for one block at most). */
+    void reclaim();
+
+    /** @brief Replaced Plans still waiting to be freed (diagnostics/tests). */
+    size_t pendingReclaimCount() const { return retired_.size(); }
+
+    /** @brief True while the current Plan's fades have not finished. [Message thread] */
+    bool isTransitionActive() const;
+
+private:
+    /// True once the audio thread has left the block it was in when `stamp` was read
+    bool rtHasLeft(uint64_t stamp) const;
+    /// Wait (bounded) for rtHasLeft(stamp)
+    bool waitForRtExit(uint64_t stamp) const;
+
+    static void runPlan(Plan& plan, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);
+    /// A bypassed stage: the buffer through its dry delay (unchanged without latency)
+    static void runBypassed(const Stage& stage, juce::AudioBuffer<float>& buffer, int numSamples);
+    /// Raised-cosine mix of a fading stage's output with its dry input, advancing its FadeState
+    static void mixFade(const Plan& plan, const Stage& stage, juce::AudioBuffer<float>& buffer, int channels,
+                        int numSamples, bool rising, int holdSamples);
+
+    struct Retired {
+        std::unique_ptr<Plan> plan;
+        uint64_t stamp = 0;
+    };
+
+    std::atomic<Plan*> current_{nullptr};        // [Message write, RT read]
+    std::atomic<uint64_t> rtSequence_{0};        // [RT write, Message read] odd while process() runs
+    std::atomic<bool> suspended_{false};         // [Message write, RT read]
+    std::vector<Retired> retired_;               // [Message thread only]
+    uint64_t stuckStamp_ = 0;                    // [Message thread only] a block that outlasted kMaxWaitMs
+    ParameterQueue* parameters_ = nullptr;       // set before audio starts
+
+    static constexpr int kMaxWaitMs = 200;       // one block is at most a few tens of ms
+
+    JUCE_DECLARE_NON_COPYABLE(SerialChainExecutor)
+};
+
+} // namespace directpipe
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file TimedPluginProcessor.cpp
+ * @brief Chain stage wrapper that times one plugin's processBlock
+ */
+
+#include "TimedPluginProcessor.h"
+#include "directpipe/ClockSync.h"
+
+namespace directpipe {
+
+namespace {
+
+/// One main bus each way with the inner processor's total channel counts, so
+/// the executor gives the wrapper exactly the plugin's channels
+juce::AudioProcessor::BusesProperties mirrorBuses(const juce::AudioProcessor& inner)
+{
+    juce::AudioProcessor::BusesProperties props;
+    const int ins = inner.getTotalNumInputChannels();
+    const int outs = inner.getTotalNumOutputChannels();
+    if (ins > 0)
+        props = props.withInput("Input", juce::AudioChannelSet::canonicalChannelSet(ins), true);
+    if (outs > 0)
+        props = props.withOutput("Output", juce::AudioChannelSet::canonicalChannelSet(outs), true);
+    return props;
+}
+
+} // namespace
+
+TimedPluginProcessor::TimedPluginProcessor(std::unique_ptr<juce::AudioProcessor> inner,
+                                           const std::atomic<bool>& enabled)
+    : AudioProcessor(mirrorBuses(*inner)),
+      inner_(std::move(inner)),
+      enabled_(enabled)
+{
+    setLatencySamples(inner_->getLatencySamples());
+    inner_->addListener(this);
+}
+
+TimedPluginProcessor::~TimedPluginProcessor()
+{
+    inner_->removeListener(this);
+}
+
+void TimedPluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    inner_->setRateAndBufferSizeDetails(sampleRate, samplesPerBlock);
+    inner_->prepareToPlay(sampleRate, samplesPerBlock);
+    setLatencySamples(inner_->getLatencySamples());
+    timing_.reset();
+}
+
+void TimedPluginProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    // Same guard AudioProcessorGraph applies to its nodes
+    const juce::ScopedLock sl(inner_->getCallbackLock());
+    if (inner_->isSuspended()) {
+        buffer.clear();
+        return;
+    }
+
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        inner_->processBlock(buffer, midi);
+        return;
+    }
+
+    const uint64_t startNs = steadyClockNs();
+    inner_->processBlock(buffer, midi);
+    timing_.record(steadyClockNs() - startNs);
+}
+
+void TimedPluginProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    const juce::ScopedLock sl(inner_->getCallbackLock());
+    inner_->processBlockBypassed(buffer, midi);
+}
+
+void TimedPluginProcessor::audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details)
+{
+    if (!details.latencyChanged)
+        return;
+    setLatencySamples(inner_->getLatencySamples());
+    if (onLatencyChanged)
+        onLatencyChanged();
+}
+
+} // namespace directpipe
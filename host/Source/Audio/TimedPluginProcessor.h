@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+//
+// This file is part of DirectPipe.
+//
+// DirectPipe is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// DirectPipe is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with DirectPipe. If not, see <https://www.gnu.org/licenses/>.
+
+/**
+ * @file TimedPluginProcessor.h
+ * @brief Chain stage wrapper that times one plugin's processBlock
+ */
+#pragma once
+
+#include <JuceHeader.h>
+#include "LatencyMonitor.h"
+#include "SerialChainExecutor.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace directpipe {
+
+/**
+ * @brief Owns a chain processor (VST or built-in) as one SerialChainExecutor
+ *        stage and records how long each of its processBlock calls takes.
+ *
+ * The executor only sees the wrapper; PluginSlot keeps raw pointers to the
+ * inner processor, so editors, parameters and state go straight to the plugin.
+ * Channel layout, latency (mirrored on change), tail, MIDI and bypass
+ * parameter are forwarded so stage channels and PDC match the plugin.
+ *
+ * When the shared enable flag is off, processBlock costs one relaxed atomic
+ * load on top of the plugin call.
+ *
+ * It also holds the stage's current DryDelay. VSTChain sizes it to the
+ * plugin's latency after prepareToPlay, and replaces it with a new one when
+ * the plugin changes its latency; Plans keep the delay they were built with
+ * alive until they are freed.
+ *
+ * Thread Ownership:
+ *   processBlock()          -- [RT audio thread]
+ *   prepareToPlay()         -- [Message / device thread, not while processing]
+ *   getTiming()             -- [Any thread]
+ *   get/setDryDelay()       -- [Message thread]
+ *   onLatencyChanged        -- [Any thread: wherever the plugin reports the change]
+ */
+class TimedPluginProcessor : public juce::AudioProcessor,
+                             private juce::AudioProcessorListener {
+public:
+    /**
+     * @param inner   Processor to own and time.
+     * @param enabled Timing switch owned by VSTChain; must outlive the wrapper.
+     */
+    TimedPluginProcessor(std::unique_ptr<juce::AudioProcessor> inner, const std::atomic<bool>& enabled);
+    ~TimedPluginProcessor() override;
+
+    /** @brief The wrapped processor (non-owning view). */
+    juce::AudioProcessor* getInner() const noexcept { return inner_.get(); }
+
+    /** @brief processBlock times since the last prepareToPlay. [Any thread] */
+    void getTiming(StageTimingSnapshot& out) const { timing_.snapshot(out); }
+
+    /** @brief Latency delay for this stage's dry path (see SerialChainExecutor). */
+    const std::shared_ptr<SerialChainExecutor::DryDelay>& getDryDelay() const noexcept { return dryDelay_; }
+    /** @brief Replace the dry delay; Plans already published keep rendering the old one. */
+    void setDryDelay(std::shared_ptr<SerialChainExecutor::DryDelay> delay) { dryDelay_ = std::move(delay); }
+
+    /** Called after the plugin reported a new latency, on the thread it did so from; must be RT-safe */
+    std::function<void()> onLatencyChanged;
+
+    // AudioProcessor interface
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override { inner_->releaseResources(); }
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) override;
+    void processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) override;
+
+    const juce::String getName() const override { return inner_->getName(); }
+    double getTailLengthSeconds() const override { return inner_->getTailLengthSeconds(); }
+    bool acceptsMidi() const override { return inner_->acceptsMidi(); }
+    bool producesMidi() const override { return inner_->producesMidi(); }
+    juce::AudioProcessorParameter* getBypassParameter() const override { return inner_->getBypassParameter(); }
+
+    void getStateInformation(juce::MemoryBlock& destData) override { inner_->getStateInformation(destData); }
+    void setStateInformation(const void* data, int sizeInBytes) override { inner_->setStateInformation(data, sizeInBytes); }
+
+    // Editor and programs stay on the inner processor (opened via PluginSlot)
+    bool hasEditor() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+
+private:
+    // AudioProcessorListener: keep the reported latency in step for chain PDC
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int, float) override {}
+    void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails& details) override;
+
+    std::unique_ptr<juce::AudioProcessor> inner_;
+    const std::atomic<bool>& enabled_;      // [Message write, RT read]
+    StageTimingHistogram timing_;           // [RT write, Any read]
+    std::shared_ptr<SerialChainExecutor::DryDelay> dryDelay_ =
+        std::make_shared<SerialChainExecutor::DryDelay>();   // [Message thread] Plans hold their own reference
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimedPluginProcessor)
+};
+
+} // namespace directpipe
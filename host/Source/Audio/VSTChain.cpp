@@ -22,8 +22,9 @@
  */
 
 #include "VSTChain.h"
-#include "PluginLoadHelper.h"
+#include "PluginLoadPool.h"
 #include "../Control/Log.h"
+#include <algorithm>
 
 #if JUCE_WINDOWS
  #include <objbase.h>   // CoInitializeEx / CoUninitialize (VST3 COM requirement)
@@ -94,14 +95,21 @@ VSTChain::VSTChain()
 {
     // Register standard plugin formats (VST2, VST3)
     formatManager_.addDefaultFormats();
+    executor_.setParameterQueue(&parameterQueue_);
 
-    // Create the audio processor graph
-    graph_ = std::make_unique<juce::AudioProcessorGraph>();
+    struct DryDelayUpdate : juce::AsyncUpdater {
+        explicit DryDelayUpdate(VSTChain& c) : chain(c) {}
+        void handleAsyncUpdate() override { chain.updateDryDelays(); }
+        VSTChain& chain;
+    };
+    dryDelayUpdate_ = std::make_unique<DryDelayUpdate>(*this);
 }
 
 VSTChain::~VSTChain()
 {
     alive_->store(false);
+    transitionCleanup_.reset();
+    dryDelayUpdate_.reset();
 
     // Wait for any async loading to finish before destroying
     if (loadThread_ && loadThread_->joinable())
@@ -110,65 +118,124 @@ VSTChain::~VSTChain()
     releaseResources();
     editorWindows_.clear();
     chain_.clear();
-    graph_.reset();
+    liveStages_.clear();
+    executor_.publish(nullptr);  // last Plan lets go: processors are destroyed here
 }
 
-void VSTChain::prepareToPlay(double sampleRate, int blockSize)
+void VSTChain::prepareToPlay(double sampleRate, int blockSize, bool fixedBlockSize)
 {
+    // Called from audioDeviceAboutToStart (the audio callback is not running)
+    // or while AudioEngine keeps the callback out of the chain. Unprepared
+    // until the end, so the Plan below starts fresh instead of carrying fades.
+    prepared_ = false;
     currentSampleRate_ = sampleRate;
     currentBlockSize_ = blockSize;
-
-    graph_->setPlayConfigDetails(2, 2, sampleRate, blockSize);
-    graph_->prepareToPlay(sampleRate, blockSize);
-
-    // Suspend processing during graph structural changes (I/O node swap)
-    graph_->suspendProcessing(true);
-
-    // Remove old I/O nodes to prevent accumulation on repeated prepareToPlay calls
-    if (inputNodeId_.uid != 0)
-        graph_->removeNode(inputNodeId_);
-    if (outputNodeId_.uid != 0)
-        graph_->removeNode(outputNodeId_);
-
-    // Add fresh I/O nodes
-    auto inputNode = graph_->addNode(
-        std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
-            juce::AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode));
-    auto outputNode = graph_->addNode(
-        std::make_unique<juce::AudioProcessorGraph::AudioGraphIOProcessor>(
-            juce::AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode));
-
-    if (inputNode && outputNode) {
-        inputNodeId_ = inputNode->nodeID;
-        outputNodeId_ = outputNode->nodeID;
-    }
+    fixedBlockSize_ = fixedBlockSize;
 
     // Pre-allocate MidiBuffer to avoid RT allocation
     emptyMidi_.ensureSize(256);
     emptyMidi_.clear();
-
-    rebuildGraph();
+    parameterQueue_.setSmoothing(sampleRate, kParameterSmoothingMs);
 
     int pluginCount;
     {
         const juce::ScopedLock sl(chainLock_);
+        for (const auto& slot : chain_) {
+            // Hint first: built-ins read it in prepareToPlay
+            applyBlockSizeHint(slot.getProcessor());
+            slot.node->setRateAndBufferSizeDetails(sampleRate, blockSize);
+            slot.node->prepareToPlay(sampleRate, blockSize);
+            prepareDryDelay(*slot.node);
+        }
+        publishChain();  // scratch sized for the new block size
         pluginCount = static_cast<int>(chain_.size());
     }
     prepared_ = true;
     juce::Logger::writeToLog("[VST] Prepare: " + juce::String(sampleRate) + "Hz, " + juce::String(blockSize) + " samples, " + juce::String(pluginCount) + " plugins");
 }
 
+void VSTChain::applyBlockSizeHint(juce::AudioProcessor* processor) const
+{
+    if (auto* nr = dynamic_cast<BuiltinNoiseRemoval*>(processor))
+        nr->setFixedBlockSize(fixedBlockSize_ ? currentBlockSize_ : 0);
+}
+
+std::shared_ptr<TimedPluginProcessor> VSTChain::makeNode(std::unique_ptr<juce::AudioProcessor> processor)
+{
+    if (!processor)
+        return nullptr;
+    applyBlockSizeHint(processor.get());
+    auto node = std::make_shared<TimedPluginProcessor>(std::move(processor), pluginTimingEnabled_);
+    node->setRateAndBufferSizeDetails(currentSampleRate_, currentBlockSize_);
+    node->prepareToPlay(currentSampleRate_, currentBlockSize_);
+    prepareDryDelay(*node);
+
+    // Plugins report latency changes from any thread (often the audio
+    // thread): only flag it, the dry delay is rebuilt on the message thread
+    node->onLatencyChanged = [alive = alive_, update = dryDelayUpdate_.get()] {
+        if (alive->load())
+            update->triggerAsyncUpdate();
+    };
+    return node;
+}
+
+void VSTChain::prepareDryDelay(TimedPluginProcessor& node) const
+{
+    // After prepareToPlay: most plugins only know their latency once prepared.
+    // Always a new delay: a published Plan may be rendering the old one
+    auto delay = std::make_shared<SerialChainExecutor::DryDelay>();
+    delay->prepare(kChainChannels, node.getLatencySamples(), currentBlockSize_);
+    node.setDryDelay(std::move(delay));
+}
+
+// ─── updateDryDelays: 런타임 레이턴시 변경 반영 ──────────────────
+// 플러그인이 레이턴시를 바꾸면 (lookahead, 오버샘플링 설정 등) dry 딜레이를
+// 새로 만들어 다음 Plan에 게시 — 라이브 Plan은 이전 딜레이를 계속 사용
+// 바이패스된 플러그인은 이전 딜레이 → 새 딜레이로 dry 경로를 크로스페이드
+// ──────────────────────────────────────────────────────────────
+void VSTChain::updateDryDelays()
+{
+    const juce::ScopedLock sl(chainLock_);
+    if (!prepared_.load(std::memory_order_relaxed))
+        return;   // prepareToPlay sizes every delay anyway
+
+    auto stages = chainStages();
+    bool changed = false;
+    for (size_t i = stages.size(); i-- > 0;) {
+        auto& stage = stages[i];
+        if (stage.node == nullptr
+            || stage.node->getDryDelay()->getLatency() == juce::jmax(0, stage.node->getLatencySamples()))
+            continue;
+        auto previous = stage.node->getDryDelay();
+        prepareDryDelay(*stage.node);
+        changed = true;
+        if (stage.bypassed) {
+            // Out on the old delay, then in on the new one once the hold has filled it
+            ChainStage out = stage;
+            out.fade = SerialChainExecutor::Fade::Out;
+            out.dryDelay = std::move(previous);
+            stage.fade = SerialChainExecutor::Fade::In;
+            stage.state = nullptr;
+            stages.insert(stages.begin() + static_cast<std::ptrdiff_t>(i), std::move(out));
+        }
+    }
+    if (changed)
+        publishStages(stages);
+}
+
 void VSTChain::releaseResources()
 {
     prepared_ = false;
-    graph_->releaseResources();
+    const juce::ScopedLock sl(chainLock_);
+    for (const auto& slot : chain_)
+        slot.node->releaseResources();
 }
 
 void VSTChain::processBlock(juce::AudioBuffer<float>& buffer, int numSamples)
 {
-    // No chainLock_ here — AudioProcessorGraph internally swaps render sequences atomically.
+    // No chainLock_ here — the executor swaps Plans atomically.
     // Holding chainLock_ in the RT callback would risk deadlock with message-thread operations
-    // that hold chainLock_ and call suspendProcessing() (which waits for the RT callback to finish).
+    // that hold chainLock_ and wait for the RT callback to leave the chain (Plan reclaim, suspend).
 
     // RT thread only — must NOT be called from the message thread
     jassert(!juce::MessageManager::getInstanceWithoutCreating()
@@ -179,15 +246,12 @@ void VSTChain::processBlock(juce::AudioBuffer<float>& buffer, int numSamples)
     // Safety: clamp numSamples to buffer capacity
     if (numSamples > buffer.getNumSamples()) return;
 
-    // Use a lightweight sub-buffer view instead of mutating the buffer size.
-    // This avoids setSize overhead (channel pointer recalculation) on every callback.
-    if (numSamples < buffer.getNumSamples()) {
-        juce::AudioBuffer<float> subBuffer(buffer.getArrayOfWritePointers(),
-                                            buffer.getNumChannels(), numSamples);
-        graph_->processBlock(subBuffer, emptyMidi_);
-    } else {
-        graph_->processBlock(buffer, emptyMidi_);
-    }
+    // Use a lightweight view (the chain's stereo pair, numSamples) instead of
+    // mutating the buffer size. This avoids setSize overhead (channel pointer
+    // recalculation) on every callback.
+    juce::AudioBuffer<float> chainBuffer(buffer.getArrayOfWritePointers(),
+                                         juce::jmin(kChainChannels, buffer.getNumChannels()), numSamples);
+    executor_.process(chainBuffer, emptyMidi_);
 
     // Clear immediately after processing to prevent MIDI output accumulation
     // (avoids heap growth if plugins write MIDI into the buffer)
@@ -235,31 +299,24 @@ int VSTChain::addPlugin(const juce::PluginDescription& desc)
         return -1;
     }
 
-    // addNode inserts into the node list — the render sequence is not rebuilt
-    // until rebuildGraph() which handles its own suspend/resume pair.
-    // Do NOT suspendProcessing here: JUCE uses a counter, so an extra
-    // suspend(true) without a matching suspend(false) leaves the graph muted.
-    auto node = graph_->addNode(std::move(instance));
-    if (!node) {
-        juce::Logger::writeToLog("[VST] Failed to add to graph: " + desc.name);
-        if (onPluginLoadFailed) onPluginLoadFailed(desc.name, "Failed to add to audio graph");
-        return -1;
-    }
+    // Prepared here, on the message thread; the audio thread only sees the
+    // plugin once publishChain() below hands it a Plan containing it.
+    auto node = makeNode(std::move(instance));
 
     // Create plugin slot
     PluginSlot slot;
     slot.name = desc.name;
     slot.path = desc.fileOrIdentifier;
     slot.desc = desc;
-    slot.nodeId = node->nodeID;
-    slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getProcessor());
+    slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getInner());
+    slot.node = std::move(node);
 
     int resultIdx;
     juce::String auditOrder;
     {
         const juce::ScopedLock sl(chainLock_);
         chain_.push_back(slot);
-        rebuildGraph();  // rebuildGraph calls suspendProcessing(false) internally
+        publishWithFadeIn(slot.node.get());
         resultIdx = static_cast<int>(chain_.size()) - 1;
         if (Log::isAuditMode())
             auditOrder = buildChainOrderStr(chain_);
@@ -320,28 +377,23 @@ int VSTChain::addPlugin(const juce::String& pluginPath)
         return -1;
     }
 
-    // See addPlugin(PluginDescription) comment — no suspendProcessing here
-    auto node = graph_->addNode(std::move(instance));
-    if (!node) {
-        juce::Logger::writeToLog("[VST] Failed to add to graph: " + desc.name);
-        if (onPluginLoadFailed) onPluginLoadFailed(desc.name, "Failed to add to audio graph");
-        return -1;
-    }
+    // See addPlugin(PluginDescription) comment
+    auto node = makeNode(std::move(instance));
 
     // Create plugin slot
     PluginSlot slot;
     slot.name = desc.name;
     slot.path = pluginPath;
     slot.desc = desc;
-    slot.nodeId = node->nodeID;
-    slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getProcessor());
+    slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getInner());
+    slot.node = std::move(node);
 
     int resultIdx;
     juce::String auditOrder;
     {
         const juce::ScopedLock sl(chainLock_);
         chain_.push_back(slot);
-        rebuildGraph();
+        publishWithFadeIn(slot.node.get());
         resultIdx = static_cast<int>(chain_.size()) - 1;
         if (Log::isAuditMode())
             auditOrder = buildChainOrderStr(chain_);
@@ -360,7 +412,7 @@ int VSTChain::addPlugin(const juce::String& pluginPath)
 // Built-in processors (Filter, Noise Removal, Auto Gain) are compiled into
 // the host binary. Unlike VST plugins, they don't require DLL loading, COM
 // initialization, or crash-safe scanning. They are created as plain C++ objects
-// and added to the AudioProcessorGraph just like VST plugins.
+// and added to the chain just like VST plugins.
 
 ActionResult VSTChain::addBuiltinProcessor(PluginSlot::Type type, int insertIndex)
 {
@@ -394,30 +446,29 @@ ActionResult VSTChain::addBuiltinProcessor(PluginSlot::Type type, int insertInde
             return ActionResult::fail("Invalid built-in processor type");
     }
 
-    // IMPORTANT: setPlayConfigDetails(2, 2, ...) must be called BEFORE addNode().
-    // AudioProcessorGraph::addNode() reads the processor's channel configuration
-    // to set up internal routing. Without this call, the processor reports 0 channels
-    // and the graph won't create audio connections to/from it.
+    // IMPORTANT: setPlayConfigDetails(2, 2, ...) must be called BEFORE makeNode().
+    // The timing wrapper and the executor read the processor's channel configuration
+    // to size the stage. Without this call, the processor reports 0 channels
+    // and the executor skips it.
     // The (2, 2) means stereo in, stereo out -- matching the host's bus layout.
     processor->setPlayConfigDetails(2, 2, currentSampleRate_, currentBlockSize_);
-    processor->prepareToPlay(currentSampleRate_, currentBlockSize_);
 
-    // Add to graph (mirrors addPlugin flow: addNode → create slot → rebuildGraph).
+    // Wrap and prepare (mirrors addPlugin flow: makeNode → create slot → publishChain).
     //
-    // IMPORTANT: Save raw pointer BEFORE std::move transfers ownership to the graph.
-    // After addNode(std::move(processor)), the unique_ptr is empty and we can no
-    // longer access the processor through it. The raw pointer remains valid because
-    // the graph keeps the processor alive as part of its Node.
+    // IMPORTANT: Save raw pointer BEFORE std::move transfers ownership to the wrapper.
+    // After makeNode(std::move(processor)), the unique_ptr is empty and we can no
+    // longer access the processor through it. The raw pointer remains valid as long
+    // as the slot's node holds the wrapper (and the processor inside it).
     auto* rawPtr = processor.get();
-    auto node = graph_->addNode(std::move(processor));
+    auto node = makeNode(std::move(processor));
     if (!node)
-        return ActionResult::fail("Failed to add built-in processor to graph");
+        return ActionResult::fail("Failed to create built-in processor");
 
     // Create plugin slot
     PluginSlot slot;
     slot.name = name;
     slot.type = type;
-    slot.nodeId = node->nodeID;
+    slot.node = std::move(node);
     slot.instance = nullptr;
     slot.builtinProcessor = rawPtr;
 
@@ -435,11 +486,11 @@ ActionResult VSTChain::addBuiltinProcessor(PluginSlot::Type type, int insertInde
             resultIdx = static_cast<int>(chain_.size()) - 1;
         }
 
-        // NOTE: rebuildGraph() is called INSIDE chainLock_ scope to ensure the
-        // graph's audio connections match the chain_ vector atomically. If we
-        // rebuilt outside the lock, processBlock could see a chain_ with the new
-        // slot but graph connections without it, causing audio routing errors.
-        rebuildGraph();
+        // NOTE: the Plan is published INSIDE chainLock_ scope so Plans are
+        // published in the same order as chain_ changes. Outside the lock, two
+        // edits could publish out of order and the audio thread would keep
+        // rendering the older chain.
+        publishWithFadeIn(slot.node.get());
 
         if (Log::isAuditMode())
             auditOrder = buildChainOrderStr(chain_);
@@ -520,12 +571,17 @@ bool VSTChain::removePlugin(int index)
             editorWindows_.erase(editorWindows_.begin() + index);
         }
 
-        juce::String removedName = chain_[static_cast<size_t>(index)].name;
+        const auto removed = chain_[static_cast<size_t>(index)];
+        juce::String removedName = removed.name;
         int oldCount = static_cast<int>(chain_.size());
-        auto& slot = chain_[static_cast<size_t>(index)];
-        graph_->removeNode(slot.nodeId);
         chain_.erase(chain_.begin() + index);
-        rebuildGraph();
+
+        // Fade it out where it was; only Plans hold it from here, and it is
+        // destroyed when the cleanup Plan replaces them
+        auto stages = chainStages();
+        stages.insert(stages.begin() + index, { removed.node, removed.bypassed, SerialChainExecutor::Fade::Out,
+                                                liveState(removed.node.get()) });
+        publishStages(stages);
         newCount = static_cast<int>(chain_.size());
         logMsg = "[VST] Removed: \"" + removedName + "\" at index " + juce::String(index) + " (" + juce::String(oldCount) + " -> " + juce::String(newCount) + " plugins)";
         if (Log::isAuditMode())
@@ -571,7 +627,17 @@ bool VSTChain::movePlugin(PluginIndex from, PluginIndex to)
             editorWindows_.insert(editorWindows_.begin() + toIndex, std::move(win));
         }
 
-        rebuildGraph();
+        // Fade out at the old position, then in at the new one. The others
+        // keep their order, so the old position among them is fromIndex,
+        // shifted by one when the fade-in copy sits in front of it. The old
+        // position keeps the live fade state; the new one starts its own.
+        auto stages = chainStages();
+        stages[static_cast<size_t>(toIndex)].fade = SerialChainExecutor::Fade::In;
+        stages[static_cast<size_t>(toIndex)].state = nullptr;
+        const int outIndex = fromIndex < toIndex ? fromIndex : fromIndex + 1;
+        stages.insert(stages.begin() + outIndex, { slot.node, slot.bypassed, SerialChainExecutor::Fade::Out,
+                                                   liveState(slot.node.get()) });
+        publishStages(stages);
         logMsg = "[VST] Moved: \"" + movedName + "\" from index " + juce::String(fromIndex) + " to " + juce::String(toIndex);
         if (Log::isAuditMode())
             auditOrder = buildChainOrderStr(chain_);
@@ -606,41 +672,74 @@ bool VSTChain::isPluginBypassed(int index) const
 
 void VSTChain::setPluginBypassed(int index, bool bypassed)
 {
-    juce::String logMsg;
+    setPluginsBypassed({ index }, bypassed);
+}
+
+void VSTChain::setAllPluginsBypassed(bool bypassed)
+{
+    std::vector<int> indices;
     {
         const juce::ScopedLock sl(chainLock_);
+        for (int i = 0; i < static_cast<int>(chain_.size()); ++i)
+            indices.push_back(i);
+    }
+    setPluginsBypassed(indices, bypassed);
+}
 
-        if (index < 0 || index >= static_cast<int>(chain_.size()))
-            return;
+void VSTChain::setPluginsBypassed(const std::vector<int>& indices, bool bypassed)
+{
+    juce::StringArray logMsgs;
+    {
+        const juce::ScopedLock sl(chainLock_);
 
-        // Skip if no change (avoids unnecessary saves and callbacks)
-        if (chain_[static_cast<size_t>(index)].bypassed == bypassed)
-            return;
+        // Crossfade between each plugin and its latency-aligned dry path. A
+        // plugin keeps running until its fade-out is over; the executor then
+        // skips it and only its dry delay stays in the chain. All changes go
+        // into one Plan so their fades run together.
+        auto stages = chainStages();
+        std::vector<size_t> changed;
+        for (int index : indices) {
+            if (index < 0 || index >= static_cast<int>(chain_.size()))
+                continue;
+            auto& slot = chain_[static_cast<size_t>(index)];
+            // Skip if no change (avoids unnecessary saves and callbacks)
+            if (slot.bypassed == bypassed)
+                continue;
 
-        chain_[static_cast<size_t>(index)].bypassed = bypassed;
-        logMsg = "[VST] Bypass: \"" + chain_[static_cast<size_t>(index)].name + "\" [" + juce::String(index) + "] = " + (bypassed ? "true" : "false");
-
-        // Sync node + plugin bypass state. replaceChainWithPreloaded sets
-        // node->setBypassed(true) for cached plugins (but does NOT call
-        // setValueNotifyingHost — only the graph-level bypass is set).
-        // Without clearing these here, un-bypassing leaves the plugin's internal
-        // bypass active (e.g., Clear, RNNoise with getBypassParameter()).
-        if (auto* node = graph_->getNodeForId(chain_[static_cast<size_t>(index)].nodeId)) {
-            node->setBypassed(bypassed);
-            if (auto* bp = node->getProcessor()->getBypassParameter())
-                bp->setValueNotifyingHost(bypassed ? 1.0f : 0.0f);
+            slot.bypassed = bypassed;
+            stages[static_cast<size_t>(index)].bypassed = false;
+            stages[static_cast<size_t>(index)].fade = bypassed ? SerialChainExecutor::Fade::ToBypass
+                                                               : SerialChainExecutor::Fade::FromBypass;
+            changed.push_back(static_cast<size_t>(index));
+            logMsgs.add("[VST] Bypass: \"" + slot.name + "\" [" + juce::String(index) + "] = " + (bypassed ? "true" : "false"));
+        }
+        if (changed.empty())
+            return;
+        publishStages(stages);
+
+        // Sync the plugin's own bypass parameter. A plugin that was saved
+        // bypassed may have its internal bypass active (e.g., Clear, RNNoise
+        // with getBypassParameter()); without clearing it here, un-bypassing
+        // would leave it silent. Engaging it waits for the fade-out (see
+        // scheduleTransitionCleanup), so the fade is heard from the plugin's
+        // real output rather than its own, unaligned bypass.
+        const bool deferParam = bypassed && executor_.isTransitionActive();
+        for (size_t index : changed) {
+            const auto& slot = chain_[index];
+            bypassParamAfterFade_.erase(std::remove(bypassParamAfterFade_.begin(), bypassParamAfterFade_.end(), slot.node),
+                                        bypassParamAfterFade_.end());
+            if (auto* proc = slot.getProcessor())
+                if (auto* bp = proc->getBypassParameter()) {
+                    if (deferParam)
+                        bypassParamAfterFade_.push_back(slot.node);
+                    else
+                        bp->setValueNotifyingHost(bypassed ? 1.0f : 0.0f);
+                }
         }
-
-        // Rebuild graph connections: bypassed plugins are disconnected from the
-        // signal chain (audio routes around them). This is more reliable than
-        // JUCE's node->setBypassed() which doesn't work for plugins that have
-        // their own bypass parameter (VST2 canDo("bypass"), VST3 bypass param).
-        // suspend=false: only connections change (no nodes added/removed), so
-        // the render sequence swaps atomically without audio gap.
-        rebuildGraph(/*suspend=*/false);
     }
 
-    juce::Logger::writeToLog(logMsg);
+    for (const auto& msg : logMsgs)
+        juce::Logger::writeToLog(msg);
     // Notify outside of lock scope (deadlock prevention, consistent with removePlugin/movePlugin)
     if (onChainChanged) onChainChanged();
 }
@@ -657,8 +756,7 @@ std::vector<PluginLatencyInfo> VSTChain::getPluginLatencies() const
     std::vector<PluginLatencyInfo> result;
     result.reserve(chain_.size());
 
-    // Get sample rate from graph if available
-    double sr = graph_ ? graph_->getSampleRate() : 48000.0;
+    const double sr = currentSampleRate_;
 
     for (const auto& slot : chain_) {
         PluginLatencyInfo info;
@@ -672,12 +770,43 @@ std::vector<PluginLatencyInfo> VSTChain::getPluginLatencies() const
     return result;
 }
 
+std::vector<PluginTimingInfo> VSTChain::getPluginTimings() const
+{
+    const juce::ScopedLock sl(chainLock_);
+    std::vector<PluginTimingInfo> result;
+    result.reserve(chain_.size());
+    const double budgetUs = currentSampleRate_ > 0.0
+        ? static_cast<double>(currentBlockSize_) / currentSampleRate_ * 1.0e6 : 0.0;
+    for (const auto& slot : chain_) {
+        PluginTimingInfo info;
+        if (slot.node != nullptr) {
+            StageTimingSnapshot snap;
+            slot.node->getTiming(snap);
+            info.blocks = snap.count;
+            info.meanUs = static_cast<float>(snap.meanUs());
+            info.p99Us = static_cast<float>(snap.percentileUs(0.99));
+            info.maxUs = static_cast<float>(snap.maxNs) / 1000.0f;
+            if (budgetUs > 0.0)
+                info.budgetPercent = static_cast<float>(snap.meanUs() / budgetUs * 100.0);
+        }
+        result.push_back(info);
+    }
+    return result;
+}
+
 int VSTChain::getTotalChainPDC() const
 {
+    // Serial chain: the delay through it is the sum of the plugins' latencies.
+    // A bypassed plugin keeps its latency as its dry delay (re-sized when the
+    // plugin reports a new latency, see updateDryDelays).
     const juce::ScopedLock sl(chainLock_);
-    if (graph_ != nullptr)
-        return graph_->getLatencySamples();
-    return 0;
+    int total = 0;
+    for (const auto& slot : chain_) {
+        if (slot.node == nullptr)
+            continue;
+        total += slot.bypassed ? slot.node->getDryDelay()->getLatency() : slot.node->getLatencySamples();
+    }
+    return total;
 }
 
 const PluginSlot* VSTChain::getPluginSlot(int index) const
@@ -710,16 +839,22 @@ juce::String VSTChain::getPluginParameterName(int pluginIndex, int paramIndex) c
     return params[paramIndex]->getName(64);
 }
 
-void VSTChain::setPluginParameter(int pluginIndex, int paramIndex, float value)
+void VSTChain::setPluginParameter(int pluginIndex, int paramIndex, float value, bool smooth)
 {
+    // Only resolve here; the audio thread applies the value at block start
+    // (no setValue on this thread, no race with the plugin's processBlock)
     const juce::ScopedLock sl(chainLock_);
     if (pluginIndex < 0 || pluginIndex >= static_cast<int>(chain_.size()))
         return;
-    auto* proc = chain_[static_cast<size_t>(pluginIndex)].getProcessor();
+    const auto& slot = chain_[static_cast<size_t>(pluginIndex)];
+    auto* proc = slot.getProcessor();
     if (!proc) return;
     auto& params = proc->getParameters();
     if (paramIndex < 0 || paramIndex >= params.size()) return;
-    params[paramIndex]->setValue(value);
+    // Set directly when no audio drains the queue, or every slot is busy (rather than drop)
+    if (!prepared_.load(std::memory_order_relaxed)
+        || !parameterQueue_.push(slot.node, params[paramIndex], juce::jlimit(0.0f, 1.0f, value), smooth))
+        params[paramIndex]->setValue(value);
 }
 
 float VSTChain::getPluginParameter(int pluginIndex, int paramIndex) const
@@ -738,7 +873,7 @@ void VSTChain::openPluginEditor(int index, juce::Component* /*parentComponent*/)
 {
     juce::AudioProcessor* processorForEditor = nullptr;
     juce::String pluginName;
-    juce::AudioProcessorGraph::NodeID capturedNodeId{};
+    const TimedPluginProcessor* capturedNode = nullptr;
 
     // First lock scope: validate index, check existing window, extract plugin data
     {
@@ -762,7 +897,7 @@ void VSTChain::openPluginEditor(int index, juce::Component* /*parentComponent*/)
         if (!processorForEditor) return;
 
         pluginName = slot.name;
-        capturedNodeId = slot.nodeId;
+        capturedNode = slot.node.get();
     }
     // Lock released — safe to create GUI without risk of deadlock from plugin callbacks
 
@@ -785,13 +920,13 @@ void VSTChain::openPluginEditor(int index, juce::Component* /*parentComponent*/)
     };
 
     // Second lock scope: store the window in editorWindows_
-    // Use capturedNodeId to re-find the correct position — index may have shifted
+    // Use capturedNode to re-find the correct position — index may have shifted
     // if removePlugin ran between the two lock scopes (TOCTOU prevention).
     {
         const juce::ScopedLock sl(chainLock_);
         int validIndex = -1;
         for (size_t i = 0; i < chain_.size(); ++i) {
-            if (chain_[i].nodeId == capturedNodeId) {
+            if (chain_[i].node.get() == capturedNode) {
                 validIndex = static_cast<int>(i);
                 break;
             }
@@ -822,76 +957,146 @@ void VSTChain::closePluginEditor(int index)
         Log::audit("VST", auditMsg);
 }
 
-// ─── rebuildGraph: 그래프 연결 재구성 ─────────────────────────
-// suspend=true: 노드 추가/제거 시 (오디오 갭 발생 가능)
-// suspend=false: 바이패스 토글 시 (연결만 변경, 갭 없음)
-// 바이패스된 플러그인은 연결 그래프에서 건너뜀
-// WARNING: getConnections() 복사 후 제거 루프 실행 (이터레이터 안전)
+// ─── publishChain: 오디오 스레드에 새 Plan 게시 ─────────────────
+// chain_ 순서 + 바이패스 플래그로 불변 Plan을 만들어 원자적 포인터 교체
+// 이전 Plan은 오디오 스레드가 떠난 뒤 메시지 스레드에서 해제
+// 바이패스된 플러그인은 executor가 건너뜀 (suspend 없음)
 // ──────────────────────────────────────────────────────────────
-void VSTChain::rebuildGraph(bool suspend)
+void VSTChain::publishChain()
 {
-    using UK = juce::AudioProcessorGraph::UpdateKind;
-
-    // When nodes are added/removed, suspend processing to prevent the RT thread
-    // from accessing a half-built graph. When only connections change (bypass
-    // toggle), suspension is unnecessary — the render sequence swaps atomically
-    // via UK::sync, so the audio thread sees either the old or new sequence.
-    if (suspend)
-        graph_->suspendProcessing(true);
-
-    // Guard: I/O nodes must exist (created in prepareToPlay)
-    if (inputNodeId_.uid == 0 || outputNodeId_.uid == 0) {
-        if (suspend) graph_->suspendProcessing(false);
-        return;
-    }
+    publishStages(chainStages());
+}
 
-    // Remove all existing connections (async — defer render sequence rebuild).
-    // Copy first: removeConnection may modify the internal array, invalidating
-    // the range-based for iterator. Explicit copy avoids undefined behavior.
-    {
-        auto conns = graph_->getConnections();
-        for (const auto& conn : conns)
-            graph_->removeConnection(conn, UK::async);
-    }
+std::vector<VSTChain::ChainStage> VSTChain::chainStages() const
+{
+    std::vector<ChainStage> stages;
+    stages.reserve(chain_.size() + 1);
+    for (const auto& slot : chain_)
+        stages.push_back({ slot.node, slot.bypassed, SerialChainExecutor::Fade::None, liveState(slot.node.get()) });
+    return stages;
+}
 
-    if (chain_.empty()) {
-        // Direct connection: input -> output (last connection triggers rebuild)
-        graph_->addConnection({{inputNodeId_, 0}, {outputNodeId_, 0}}, UK::async);
-        graph_->addConnection({{inputNodeId_, 1}, {outputNodeId_, 1}}, UK::sync);
-        if (suspend) graph_->suspendProcessing(false);
-        return;
-    }
+std::shared_ptr<SerialChainExecutor::FadeState> VSTChain::liveState(const TimedPluginProcessor* node) const
+{
+    for (const auto& stage : liveStages_)
+        if (stage.node.get() == node && stage.fade != SerialChainExecutor::Fade::Out)
+            return stage.state;
+    return nullptr;
+}
 
-    // Build serial chain: Input -> Plugin[0] -> ... -> Plugin[N-1] -> Output
-    // Bypassed plugins are skipped in the connection graph (audio routes around them).
-    // This is more reliable than JUCE's node->setBypassed() which doesn't work for
-    // VST2/VST3 plugins that report their own bypass parameter (getBypassParameter()).
-    // All connections use async except the very last one (triggers single rebuild)
-    auto prevNodeId = inputNodeId_;
-    for (size_t i = 0; i < chain_.size(); ++i) {
-        auto& slot = chain_[i];
-        if (slot.bypassed) continue;  // skip bypassed plugins in connection graph
-        for (int ch = 0; ch < 2; ++ch) {
-            bool ok = graph_->addConnection({
-                {prevNodeId, ch},
-                {slot.nodeId, ch}
-            }, UK::async);
-            if (!ok) {
-                juce::String msg = "WRN [VST] Connection FAILED: node " + juce::String(prevNodeId.uid)
-                    + " ch" + juce::String(ch) + " -> node " + juce::String(slot.nodeId.uid)
-                    + " ch" + juce::String(ch) + " (\"" + slot.name + "\")";
-                juce::Logger::writeToLog(msg);
-            }
+void VSTChain::publishStages(const std::vector<ChainStage>& stages, bool carryFades)
+{
+    using Fade = SerialChainExecutor::Fade;
+
+    bool anyFade = false;
+    for (const auto& stage : stages)
+        anyFade |= stage.fade != Fade::None;
+    const bool prepared = prepared_.load(std::memory_order_relaxed);
+    const bool fade = prepared && carryFades && (anyFade || executor_.isTransitionActive());
+
+    std::vector<ChainStage> planned;
+    planned.reserve(stages.size() + liveStages_.size());
+    if (fade) {
+        planned = stages;
+        // Stages still fading out of the live Plan stay behind the stage they
+        // followed there (or in front), so they finish their fade
+        auto plannedIndex = [&planned](const SerialChainExecutor::FadeState* state) {
+            for (size_t i = 0; i < planned.size(); ++i)
+                if (planned[i].state.get() == state)
+                    return static_cast<int>(i);
+            return -1;
+        };
+        for (size_t i = 0; i < liveStages_.size(); ++i) {
+            const auto& live = liveStages_[i];
+            if (live.fade != Fade::Out || plannedIndex(live.state.get()) >= 0)
+                continue;
+            int at = 0;
+            for (size_t j = i; j-- > 0;)
+                if (const int prev = plannedIndex(liveStages_[j].state.get()); prev >= 0) {
+                    at = prev + 1;
+                    break;
+                }
+            planned.insert(planned.begin() + at, live);
+        }
+    } else {
+        // Nothing to fade: faded-out stages go, the rest is where its fade ends.
+        // Fade states are only worth keeping for a chain that is running.
+        for (const auto& stage : stages) {
+            if (stage.fade == Fade::Out)
+                continue;
+            planned.push_back({ stage.node, stage.bypassed || stage.fade == Fade::ToBypass, Fade::None,
+                                prepared ? stage.state : nullptr, stage.dryDelay });
         }
-        prevNodeId = slot.nodeId;
     }
 
-    // Last non-bypassed plugin (or input) -> Output (final connection triggers the single rebuild)
-    graph_->addConnection({{prevNodeId, 0}, {outputNodeId_, 0}}, UK::async);
-    graph_->addConnection({{prevNodeId, 1}, {outputNodeId_, 1}}, UK::sync);
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->stages.reserve(planned.size());
+    plan->keepAlive.reserve(planned.size());
+    plan->fadeStates.reserve(planned.size());
+    plan->dryDelays.reserve(planned.size());
+    for (auto& stage : planned) {
+        // Unset = the node's current delay; a stage fading out on a delay its
+        // node has since replaced keeps that one
+        if (stage.dryDelay == nullptr && stage.node != nullptr)
+            stage.dryDelay = stage.node->getDryDelay();
+        plan->addStage(stage.node, stage.bypassed, stage.fade, stage.dryDelay.get(), stage.state);
+        plan->dryDelays.push_back(stage.dryDelay);
+    }
+    for (size_t i = 0; i < planned.size(); ++i)
+        planned[i].state = plan->fadeStates[i];
+    const int fadeSamples = fade ? juce::jmax(1, juce::roundToInt(currentSampleRate_ * kEditFadeMs / 1000.0)) : 0;
+    plan->allocate(kChainChannels, currentBlockSize_, fadeSamples);
+    parameterQueue_.releaseStagesNotIn(*plan);
+    executor_.publish(std::move(plan));
+    liveStages_ = std::move(planned);
+
+    if (fade)
+        scheduleTransitionCleanup();
+}
+
+void VSTChain::publishWithFadeIn(const TimedPluginProcessor* node)
+{
+    auto stages = chainStages();
+    for (auto& stage : stages)
+        if (stage.node.get() == node)
+            stage.fade = SerialChainExecutor::Fade::In;
+    publishStages(stages);
+}
+
+// ─── Transition cleanup: 페이드 종료 후 정리 Plan 게시 ──────────
+// 페이드 아웃된 stage(제거/이동 전 위치/교체 전 체인)를 Plan에서 빼서
+// 그것만 붙잡고 있던 플러그인을 메시지 스레드에서 해제
+// 바이패스로 페이드 아웃된 플러그인은 이때 자체 bypass 파라미터를 켬
+// 오디오가 멈춰 페이드가 끝나지 않으면 kTransitionCleanupMaxPolls 후 강제 게시
+// ──────────────────────────────────────────────────────────────
+void VSTChain::scheduleTransitionCleanup()
+{
+    struct CleanupTimer : juce::Timer {
+        explicit CleanupTimer(VSTChain& c) : chain(c) {}
+        void timerCallback() override
+        {
+            const juce::ScopedLock sl(chain.chainLock_);
+            if (chain.executor_.isTransitionActive() && ++polls < kTransitionCleanupMaxPolls)
+                return;
+            stopTimer();
+            chain.publishStages(chain.chainStages(), false);  // settles a fade that never finished
+
+            for (const auto& node : chain.bypassParamAfterFade_)
+                for (const auto& slot : chain.chain_)
+                    if (slot.node == node && slot.bypassed)
+                        if (auto* proc = slot.getProcessor())
+                            if (auto* bp = proc->getBypassParameter())
+                                bp->setValueNotifyingHost(1.0f);
+            chain.bypassParamAfterFade_.clear();
+        }
+        VSTChain& chain;
+        int polls = 0;
+    };
 
-    if (suspend)
-        graph_->suspendProcessing(false);
+    if (!transitionCleanup_)
+        transitionCleanup_ = std::make_unique<CleanupTimer>(*this);
+    static_cast<CleanupTimer*>(transitionCleanup_.get())->polls = 0;
+    transitionCleanup_->startTimer(kTransitionCleanupMs);  // restarts the wait for the newest transition
 }
 
 std::unique_ptr<juce::AudioPluginInstance> VSTChain::loadPlugin(
@@ -914,7 +1119,7 @@ std::unique_ptr<juce::AudioPluginInstance> VSTChain::loadPlugin(
 // ─── replaceChainAsync: Background Plugin Loading ───────────────────────
 // Pattern: Keep-Old-Until-Ready
 //   1. 현재 체인은 계속 오디오 처리 (끊김 없음)
-//   2. BG 스레드에서 새 플러그인 로드 (DLL 로딩은 느림)
+//   2. BG 스레드에서 새 플러그인 로드 (DLL 로딩은 느림) — createPluginsConcurrently로 병렬 생성
 //   3. callAsync로 Message 스레드에서 그래프 교체 (alive_ 가드)
 //   4. asyncGeneration_ 카운터로 오래된 로드 폐기 (새 요청이 이전 요청을 대체)
 // WARNING: Windows에서 COM STA 초기화 필수 (VST3 플러그인 팩토리)
@@ -928,7 +1133,7 @@ void VSTChain::replaceChainAsync(std::vector<PluginLoadRequest> requests,
     if (loadThread_ && loadThread_->joinable())
         loadThread_->join();
 
-    // Keep-Old-Until-Ready: old chain stays in graph and continues
+    // Keep-Old-Until-Ready: old chain stays published and continues
     // processing audio while new plugins are loaded on background thread.
     // Swap happens atomically on the message thread when loading completes.
 
@@ -955,10 +1160,11 @@ void VSTChain::replaceChainAsync(std::vector<PluginLoadRequest> requests,
     auto result = std::make_shared<AsyncLoadResult>();
 
     auto aliveFlag = alive_;
+    const auto loadStartMs = juce::Time::getMillisecondCounter();
 
     loadThread_ = std::make_unique<std::thread>(
         [this, requests = std::move(requests), onComplete = std::move(onComplete),
-         preWork = std::move(preWork), sr, bs, result, aliveFlag, generation]()
+         preWork = std::move(preWork), sr, bs, result, aliveFlag, generation, loadStartMs]()
     {
     #if JUCE_WINDOWS
         // COM must be initialized as APARTMENTTHREADED (STA) for VST3 plugin factories.
@@ -973,25 +1179,38 @@ void VSTChain::replaceChainAsync(std::vector<PluginLoadRequest> requests,
         // to avoid blocking the message thread
         if (preWork) preWork();
 
+        // Create the VST instances concurrently; a superseded load stops starting new ones
+        std::vector<PluginLoadJob> jobs;
+        for (const auto& req : requests)
+            if (req.builtinType == PluginSlot::Type::VST)
+                jobs.push_back({ req.desc });
+        createPluginsConcurrently(jobs, formatManager_, sr, bs,
+                                  [this, aliveFlag, generation] {
+                                      return !aliveFlag->load() || asyncGeneration_.load() != generation;
+                                  },
+                                  aliveFlag);
+
+        // Chain order is the request order, whatever order the instances finished in
+        size_t job = 0;
         for (auto& req : requests) {
             if (req.builtinType != PluginSlot::Type::VST) {
                 // Built-in processors don't need DLL loading — pass through with null instance
                 result->entries.push_back({nullptr, std::move(req)});
                 continue;
             }
-            juce::String error;
-            auto inst = createPluginOnCorrectThread(formatManager_, req.desc, sr, bs, error, aliveFlag);
-            if (inst)
-                result->entries.push_back({std::move(inst), std::move(req)});
-            else {
-                juce::Logger::writeToLog("ERR [VST] Async load failed: " + req.name + " (path=" + req.path + "): " + error);
-                result->failures.push_back({req.name, error});
+            auto& loaded = jobs[job++];
+            if (loaded.instance)
+                result->entries.push_back({std::move(loaded.instance), std::move(req)});
+            else if (loaded.attempted) {
+                juce::Logger::writeToLog("ERR [VST] Async load failed: " + req.name + " (path=" + req.path + "): " + loaded.error);
+                result->failures.push_back({req.name, loaded.error});
             }
         }
+        const auto loadMs = juce::Time::getMillisecondCounter() - loadStartMs;
 
-        // Post to message thread to wire into graph
+        // Post to message thread to swap the new chain in
         juce::MessageManager::callAsync(
-            [this, result, onComplete, aliveFlag, generation]()
+            [this, result, onComplete, aliveFlag, generation, loadMs]()
         {
             if (!aliveFlag->load()) return;
             // Stale callAsync from a superseded replaceChainAsync — discard
@@ -1003,16 +1222,11 @@ void VSTChain::replaceChainAsync(std::vector<PluginLoadRequest> requests,
             {
                 const juce::ScopedLock sl(chainLock_);
 
-                graph_->suspendProcessing(true);
-
-                // Remove OLD chain nodes (async to defer rebuild until the end)
-                editorWindows_.clear();
-                for (auto& slot : chain_)
-                    graph_->removeNode(slot.nodeId,
-                        juce::AudioProcessorGraph::UpdateKind::async);
-                chain_.clear();
-
-                // Add NEW nodes (async — single rebuild at end)
+                // Build the NEW chain off to the side: the old one keeps
+                // rendering until the single publish below, and state can be
+                // restored before the audio thread ever sees these plugins
+                std::vector<PluginSlot> newChain;
+                newChain.reserve(result->entries.size());
                 for (auto& entry : result->entries) {
                     PluginSlot slot;
                     slot.bypassed = entry.request.bypassed;
@@ -1038,22 +1252,17 @@ void VSTChain::replaceChainAsync(std::vector<PluginLoadRequest> requests,
                         }
 
                         processor->setPlayConfigDetails(2, 2, currentSampleRate_, currentBlockSize_);
-                        processor->prepareToPlay(currentSampleRate_, currentBlockSize_);
 
                         auto* rawPtr = processor.get();
-                        auto node = graph_->addNode(std::move(processor), {},
-                            juce::AudioProcessorGraph::UpdateKind::async);
+                        auto node = makeNode(std::move(processor));
                         if (!node) continue;
 
                         slot.name = builtinName;
                         slot.type = entry.request.builtinType;
-                        slot.nodeId = node->nodeID;
+                        slot.node = std::move(node);
                         slot.instance = nullptr;
                         slot.builtinProcessor = rawPtr;
-                        chain_.push_back(slot);
-
-                        if (slot.bypassed)
-                            node->setBypassed(true);
+                        newChain.push_back(slot);
 
                         if (entry.request.hasState && rawPtr)
                             rawPtr->setStateInformation(
@@ -1061,19 +1270,15 @@ void VSTChain::replaceChainAsync(std::vector<PluginLoadRequest> requests,
                                 static_cast<int>(entry.request.stateData.getSize()));
                     } else {
                         // VST plugin
-                        auto node = graph_->addNode(std::move(entry.instance), {},
-                            juce::AudioProcessorGraph::UpdateKind::async);
+                        auto node = makeNode(std::move(entry.instance));
                         if (!node) continue;
 
                         slot.name = entry.request.name;
                         slot.path = entry.request.path;
                         slot.desc = entry.request.desc;
-                        slot.nodeId = node->nodeID;
-                        slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getProcessor());
-                        chain_.push_back(slot);
-
-                        if (slot.bypassed)
-                            node->setBypassed(true);
+                        slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getInner());
+                        slot.node = std::move(node);
+                        newChain.push_back(slot);
 
                         if (entry.request.hasState && slot.instance)
                             slot.instance->setStateInformation(
@@ -1082,8 +1287,17 @@ void VSTChain::replaceChainAsync(std::vector<PluginLoadRequest> requests,
                     }
                 }
 
-                rebuildGraph();  // single rebuild with connections + suspendProcessing(false)
-                logMsg = "[VST] Async chain load complete: " + juce::String(chain_.size()) + " plugins loaded";
+                // Editors belong to the old plugins: close them before those go
+                editorWindows_.clear();
+                auto stages = chainStages();
+                for (auto& stage : stages)
+                    stage.fade = SerialChainExecutor::Fade::Out;
+                chain_ = std::move(newChain);
+                for (auto& stage : chainStages())
+                    stages.push_back({ stage.node, stage.bypassed, SerialChainExecutor::Fade::In });
+                publishStages(stages);  // old chain fades out, new one in; old freed by the cleanup Plan
+                logMsg = "[VST] Async chain load complete: " + juce::String(chain_.size()) + " plugins loaded ("
+                         + juce::String(static_cast<int>(loadMs)) + "ms)";
                 if (Log::isAuditMode()) {
                     auditChainOrder = buildChainOrderStr(chain_);
                     for (size_t i = 0; i < chain_.size(); ++i)
@@ -1129,35 +1343,22 @@ void VSTChain::replaceChainWithPreloaded(std::vector<PreloadedPlugin> preloaded,
     {
         const juce::ScopedLock sl(chainLock_);
 
-        graph_->suspendProcessing(true);
-
-        // Remove OLD chain nodes (async to defer rebuild until the end)
-        editorWindows_.clear();
-        for (auto& slot : chain_)
-            graph_->removeNode(slot.nodeId,
-                juce::AudioProcessorGraph::UpdateKind::async);
-        chain_.clear();
-
-        // Add pre-loaded nodes (async — single rebuild at end)
+        // Build the new chain aside; the old one renders until the publish below
+        std::vector<PluginSlot> newChain;
+        newChain.reserve(preloaded.size());
         for (auto& entry : preloaded) {
-            auto node = graph_->addNode(std::move(entry.instance), {},
-                juce::AudioProcessorGraph::UpdateKind::async);
-            if (!node) {
-                juce::Logger::writeToLog("ERR [VST] Failed to add cached node to graph: " + entry.request.name);
+            auto node = makeNode(std::move(entry.instance));
+            if (!node)
                 continue;
-            }
 
             PluginSlot slot;
             slot.name = entry.request.name;
             slot.path = entry.request.path;
             slot.desc = entry.request.desc;
-            slot.nodeId = node->nodeID;
-            slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getProcessor());
+            slot.instance = dynamic_cast<juce::AudioPluginInstance*>(node->getInner());
+            slot.node = std::move(node);
             slot.bypassed = entry.request.bypassed;
-            chain_.push_back(slot);
-
-            if (slot.bypassed)
-                node->setBypassed(true);
+            newChain.push_back(slot);
 
             if (entry.request.hasState && slot.instance)
                 slot.instance->setStateInformation(
@@ -1165,7 +1366,14 @@ void VSTChain::replaceChainWithPreloaded(std::vector<PreloadedPlugin> preloaded,
                     static_cast<int>(entry.request.stateData.getSize()));
         }
 
-        rebuildGraph();  // single rebuild with connections + suspendProcessing(false)
+        editorWindows_.clear();
+        auto stages = chainStages();
+        for (auto& stage : stages)
+            stage.fade = SerialChainExecutor::Fade::Out;
+        chain_ = std::move(newChain);
+        for (auto& stage : chainStages())
+            stages.push_back({ stage.node, stage.bypassed, SerialChainExecutor::Fade::In });
+        publishStages(stages);  // one swap: old chain fades out, then the new one in
         auto elapsed = juce::Time::getMillisecondCounter() - startMs;
         logMsg = "INF [VST] Cached chain swap: " + juce::String(chain_.size())
             + " plugins (" + juce::String(elapsed) + "ms)";
@@ -21,7 +21,7 @@
  * @brief VST plugin chain management
  *
  * Manages loading, ordering, and processing of VST2/VST3 plugins
- * in a serial chain. Uses JUCE's AudioProcessorGraph internally.
+ * in a serial chain. Rendered by SerialChainExecutor (flat, lock-free).
  */
 #pragma once
 
@@ -31,6 +31,9 @@
 #include "BuiltinFilter.h"
 #include "BuiltinNoiseRemoval.h"
 #include "BuiltinAutoGain.h"
+#include "TimedPluginProcessor.h"
+#include "SerialChainExecutor.h"
+#include "ParameterQueue.h"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -46,14 +49,31 @@ struct PluginLatencyInfo {
     float latencyMs = 0.0f;
 };
 
+/**
+ * @brief Per-plugin processing time since the chain was last prepared.
+ *
+ * budgetPercent is the mean time as a share of one chain block period
+ * (block size / sample rate); p99Us is a histogram bin edge (see
+ * StageTimingSnapshot::percentileUs).
+ */
+struct PluginTimingInfo {
+    uint64_t blocks = 0;
+    float meanUs = 0.0f;
+    float p99Us = 0.0f;
+    float maxUs = 0.0f;
+    float budgetPercent = 0.0f;
+};
+
 /**
  * @brief Information about a loaded plugin in the chain.
  *
  * ## Ownership Model
  *
- * PluginSlot does NOT own its processor. The AudioProcessorGraph owns all
- * processor instances (via graph_->addNode(std::move(processor))). PluginSlot
- * holds only raw, non-owning pointers for access.
+ * Each processor lives inside a TimedPluginProcessor (`node`), shared between
+ * the slot and every SerialChainExecutor::Plan that renders it. The last
+ * owner to let go — the slot on removal, or a replaced Plan reclaimed after
+ * the audio thread left it — destroys it, always on the message thread.
+ * `instance` / `builtinProcessor` are raw, non-owning pointers into `node`.
  *
  * ## VST vs Built-in: Two Pointer Paths
  *
@@ -68,7 +88,8 @@ struct PluginLatencyInfo {
  *   - type == Type::BuiltinFilter / BuiltinNoiseRemoval / BuiltinAutoGain
  *
  * IMPORTANT: Always use getProcessor() for generic access. Never assume
- * instance is non-null without checking type first.
+ * instance is non-null without checking type first. `node` is the timing
+ * wrapper the chain renders; read it for per-plugin CPU time only.
  */
 struct PluginSlot {
     /// Type discriminator: VST for external plugins loaded from DLL/dylib/so,
@@ -81,19 +102,18 @@ struct PluginSlot {
     juce::String path;           ///< fileOrIdentifier (may be shared for shell plugins)
     juce::PluginDescription desc; ///< Full description for accurate re-loading
     bool bypassed = false;
-    juce::AudioProcessorGraph::NodeID nodeId;
+
+    /// Owning: the timing wrapper around this slot's processor (see Ownership Model).
+    std::shared_ptr<TimedPluginProcessor> node;
 
     /// Non-owning pointer to the VST plugin instance. NULL for built-in processors.
-    /// The AudioProcessorGraph owns the actual instance via its Node.
+    /// Owned by `node`.
     juce::AudioPluginInstance* instance = nullptr;
 
     Type type = Type::VST;
 
     /// Non-owning pointer to the built-in processor. NULL for VST plugins.
-    /// The AudioProcessorGraph owns the actual instance via its Node.
-    /// IMPORTANT: This pointer is obtained BEFORE addNode(std::move(processor)),
-    /// which transfers ownership. The raw pointer remains valid as long as the
-    /// node exists in the graph.
+    /// Owned by `node`; valid as long as the slot (or a Plan rendering it) holds `node`.
     juce::AudioProcessor* builtinProcessor = nullptr;
 
     /// Unified accessor -- returns whichever processor is active (built-in or VST).
@@ -111,7 +131,27 @@ struct PluginSlot {
  * Manages a serial chain of VST plugins:
  * Input → Plugin1 → Plugin2 → ... → PluginN → Output
  *
- * All plugin processing is inline (zero additional latency).
+ * All plugin processing is inline (zero additional latency). The audio
+ * thread renders an immutable SerialChainExecutor::Plan; every chain edit
+ * (add, remove, move, bypass, chain swap) publishes a new one without
+ * suspending audio.
+ *
+ * Edits are crossfaded at the plugin they touch (kEditFadeMs, raised cosine):
+ * an inserted plugin fades in from dry, a removed one fades out to dry, a
+ * moved one fades out at its old position and then in at its new one, and a
+ * chain swap fades the old plugins out before the new ones fade in. Once the
+ * fades are over a cleanup Plan without the faded-out stages is published,
+ * which releases removed plugins on the message thread. An edit made while
+ * fades are running carries them over (liveStages_): they continue, or
+ * reverse, from their current gain.
+ *
+ * Bypass crossfades the same way against a dry path delayed by the plugin's
+ * latency, and a bypassed plugin keeps that delay: toggling bypass on a
+ * look-ahead plugin neither combs during the fade nor shifts the output.
+ * A plugin with latency that enters or leaves the chain (insert, remove,
+ * move) also fades that delay in or out, so the chain's timing changes
+ * without a splice and a moved plugin's delay never replays audio from
+ * its old position.
  */
 class VSTChain {
 public:
@@ -122,8 +162,11 @@ public:
      * @brief Prepare the chain for playback.
      * @param sampleRate Audio sample rate.
      * @param blockSize Maximum expected block size.
+     * @param fixedBlockSize True when every processBlock() call will be exactly
+     *        blockSize samples (AudioEngine processing block size); built-ins
+     *        with a natural frame size can then skip their own buffering.
      */
-    void prepareToPlay(double sampleRate, int blockSize);
+    void prepareToPlay(double sampleRate, int blockSize, bool fixedBlockSize = false);
 
     /**
      * @brief Release resources when playback stops.
@@ -194,10 +237,19 @@ public:
 
     /**
      * @brief Toggle bypass for a plugin.
+     *
+     * Crossfades (kEditFadeMs) against the plugin's dry input delayed by its
+     * latency; the plugin stops being processed once the fade-out is over.
+     *
      * @param index Position in the chain.
      * @param bypassed true to bypass.
      */
-    void setPluginBypassed(int index, bool bypassed);
+    void setPluginBypassed(int index, bool bypassed);  // [Message thread — holds chainLock_]
+
+    /**
+     * @brief Bypass or un-bypass every plugin, all fading together (master bypass).
+     */
+    void setAllPluginsBypassed(bool bypassed);  // [Message thread — holds chainLock_]
 
     /**
      * @brief Toggle bypass state (read under lock, then call setPluginBypassed).
@@ -218,9 +270,29 @@ public:
     /** Get per-plugin latency info. [Message thread — acquires chainLock_] */
     std::vector<PluginLatencyInfo> getPluginLatencies() const;
 
-    /** Get total chain PDC from AudioProcessorGraph. [Message thread — acquires chainLock_] */
+    /** Get total chain PDC: sum of the active plugins' latencies. [Message thread — acquires chainLock_] */
     int getTotalChainPDC() const;
 
+    /**
+     * Rebuild the dry delay of every plugin whose latency changed since it was
+     * sized, and publish them in a new Plan. A bypassed plugin crossfades from
+     * the old delay to the new one. Runs asynchronously after a plugin reports
+     * a latency change. [Message thread — acquires chainLock_]
+     */
+    void updateDryDelays();
+
+    /** Get per-plugin processing time, in chain order. [Message thread — acquires chainLock_] */
+    std::vector<PluginTimingInfo> getPluginTimings() const;
+
+    /**
+     * @brief Turn per-plugin timing on or off. [Any thread]
+     *
+     * Off, each plugin call costs one extra relaxed atomic load; the numbers
+     * from getPluginTimings() stop moving.
+     */
+    void setPluginTimingEnabled(bool enabled) { pluginTimingEnabled_.store(enabled, std::memory_order_relaxed); }
+    bool isPluginTimingEnabled() const { return pluginTimingEnabled_.load(std::memory_order_relaxed); }
+
     /**
      * @brief Get plugin slot info at the given index.
      */
@@ -232,8 +304,15 @@ public:
     /** @brief Get parameter name. */
     juce::String getPluginParameterName(int pluginIndex, int paramIndex) const;
 
-    /** @brief Set a plugin parameter value (0.0-1.0 normalized). */
-    void setPluginParameter(int pluginIndex, int paramIndex, float value);
+    /**
+     * @brief Set a plugin parameter value (0.0-1.0 normalized).
+     *
+     * Queued for the audio thread, which applies it at the next block start
+     * (latest value per parameter wins). With `smooth`, continuous parameters
+     * glide there over kParameterSmoothingMs instead of jumping.
+     * [Message thread — brief chainLock_ to resolve the parameter]
+     */
+    void setPluginParameter(int pluginIndex, int paramIndex, float value, bool smooth = true);
 
     /** @brief Get a plugin parameter value (0.0-1.0 normalized). */
     float getPluginParameter(int pluginIndex, int paramIndex) const;
@@ -251,7 +330,7 @@ public:
     /**
      * @brief Open the native editor window for a plugin.
      *
-     * Uses two lock scopes with NodeID re-lookup to prevent TOCTOU issues
+     * Uses two lock scopes with node re-lookup to prevent TOCTOU issues
      * if the chain is modified between validation and window storage.
      *
      * @param index Plugin chain index.
@@ -280,9 +359,9 @@ public:
     /**
      * @brief Replace the entire chain asynchronously (non-blocking).
      *
-     * Clears current chain immediately (audio goes silent), then loads
-     * new plugins on a background thread. Wires them into the graph
-     * on the message thread via callAsync when done.
+     * The current chain keeps processing while new plugins load on a
+     * background thread; the new chain is published on the message
+     * thread via callAsync when done.
      * @param requests Plugins to load.
      * @param onComplete Called on message thread when loading finishes.
      */
@@ -292,7 +371,7 @@ public:
                            std::function<void()> preWork = nullptr);
 
     /**
-     * @brief A pre-loaded plugin instance ready for graph insertion.
+     * @brief A pre-loaded plugin instance ready for chain insertion.
      */
     struct PreloadedPlugin {
         std::unique_ptr<juce::AudioPluginInstance> instance;
@@ -304,7 +383,7 @@ public:
      *
      * Must be called on the message thread. Used with PluginPreloadCache
      * to skip DLL loading entirely. Old chain continues processing until
-     * swap completes (~10-50ms suspend).
+     * the new Plan is published (no suspend).
      * @param preloaded Pre-created plugin instances with metadata.
      * @param onComplete Called after swap is complete.
      */
@@ -318,8 +397,11 @@ public:
      *  Used by SettingsAutosaver as an additional guard beyond loadingSlot_. */
     bool isStable() const { return prepared_.load(std::memory_order_relaxed) && !asyncLoading_.load(std::memory_order_relaxed); }
 
-    /** @brief Suspend/resume graph processing (for safe state changes). */
-    void suspendProcessing(bool suspend) { graph_->suspendProcessing(suspend); }
+    /**
+     * @brief Mute the chain and wait for the audio thread to leave it (true),
+     *        or resume (false) — for plugin state restores, not chain edits.
+     */
+    void suspendProcessing(bool suspend) { executor_.setSuspended(suspend); }
 
     // Callback when the chain changes (for UI update)
     std::function<void()> onChainChanged;
@@ -331,13 +413,70 @@ public:
     std::function<void(const juce::String&, const juce::String&)> onPluginLoadFailed;
 
 private:
+    /// The chain processes the buffer's first two channels (stereo pair)
+    static constexpr int kChainChannels = 2;
+    /// Crossfade length for an inserted/removed/moved/(un)bypassed plugin (per phase)
+    static constexpr double kEditFadeMs = 10.0;
+    /// Cleanup poll interval, and how many polls to wait for fades that never finish (audio stopped)
+    static constexpr int kTransitionCleanupMs = 50;
+    static constexpr int kTransitionCleanupMaxPolls = 20;
+    /// Glide time for smoothed parameter changes (controller sweeps)
+    static constexpr double kParameterSmoothingMs = 20.0;
+
+    /// One stage of a Plan to publish
+    struct ChainStage {
+        std::shared_ptr<TimedPluginProcessor> node;
+        bool bypassed = false;
+        SerialChainExecutor::Fade fade = SerialChainExecutor::Fade::None;
+        /// The stage's fade state in the live Plan (carries an unfinished fade); nullptr = new stage
+        std::shared_ptr<SerialChainExecutor::FadeState> state;
+        /// The stage's dry delay; nullptr = the node's current one
+        std::shared_ptr<SerialChainExecutor::DryDelay> dryDelay;
+    };
+
+    /**
+     * @brief Publish chain_ (order + bypass flags) to the audio thread as a new Plan.
+     *        Call with chainLock_ held after every chain_ change that needs no fade.
+     */
+    void publishChain();
+
+    /** @brief chain_ as Plan stages, no new fades; each keeps its live fade state. [chainLock_ held] */
+    std::vector<ChainStage> chainStages() const;
+
+    /** @brief Fade state of `node`'s stage in the live Plan, not counting one fading out. [chainLock_ held] */
+    std::shared_ptr<SerialChainExecutor::FadeState> liveState(const TimedPluginProcessor* node) const;
+
     /**
-     * @brief Rebuild the audio graph connections after chain modification.
-     * @param suspend If true, suspend/resume processing around rebuild
-     *        (needed when nodes are added/removed). If false, only connections
-     *        change and the render sequence swaps atomically (no audio gap).
+     * @brief Publish `stages` as a Plan, fading the stages marked In/Out.
+     *
+     * While the live Plan is still fading, its stages that are fading out
+     * and missing from `stages` are kept in place, and every stage carries
+     * its fade state over, so an edit never cuts a fade short. Without a
+     * running device there is nothing to fade: Out stages are dropped and
+     * In stages start fully processed. `carryFades` = false settles every
+     * fade at once (cleanup). [chainLock_ held]
      */
-    void rebuildGraph(bool suspend = true);
+    void publishStages(const std::vector<ChainStage>& stages, bool carryFades = true);
+
+    /** @brief Publish chain_ with `node` fading in (just inserted). [chainLock_ held] */
+    void publishWithFadeIn(const TimedPluginProcessor* node);
+
+    /** @brief Bypass fade for the plugins at `indices`, published as one Plan. [Message thread] */
+    void setPluginsBypassed(const std::vector<int>& indices, bool bypassed);
+
+    /** @brief Republish chain_ once the current fades are over. [Message thread, chainLock_ held] */
+    void scheduleTransitionCleanup();
+    /** Pass the fixed block size guarantee to built-ins that can use it (before prepareToPlay). */
+    void applyBlockSizeHint(juce::AudioProcessor* processor) const;
+
+    /**
+     * @brief Wrap a chain processor in a TimedPluginProcessor and prepare it
+     *        for the current sample rate and block size.
+     */
+    std::shared_ptr<TimedPluginProcessor> makeNode(std::unique_ptr<juce::AudioProcessor> processor);
+
+    /** @brief Give the node a new dry delay sized to its latency; the next Plan picks it up. [Message thread] */
+    void prepareDryDelay(TimedPluginProcessor& node) const;
 
     /**
      * @brief Load a VST plugin from a description.
@@ -351,25 +490,26 @@ private:
 
     juce::AudioPluginFormatManager formatManager_;       // [Message thread only]
     juce::KnownPluginList knownPlugins_;                 // [Message thread only]
-    std::unique_ptr<juce::AudioProcessorGraph> graph_;   // [RT: processBlock, Message: node add/remove]
-
-    // I/O nodes in the graph
-    juce::AudioProcessorGraph::NodeID inputNodeId_;      // [Protected by chainLock_]
-    juce::AudioProcessorGraph::NodeID outputNodeId_;     // [Protected by chainLock_]
+    std::atomic<bool> pluginTimingEnabled_{true};         // [Any write, RT read] Declared before executor_/chain_: wrappers reference it
+    ParameterQueue parameterQueue_;                      // [Message: push, RT: applyBlock] Declared before executor_: it applies the queue
+    SerialChainExecutor executor_;                       // [RT: process, Message: publish/suspend]
 
     // ─── Protected by chainLock_ ───
     std::vector<PluginSlot> chain_;                      // [Protected by chainLock_]
     std::vector<std::unique_ptr<juce::DocumentWindow>> editorWindows_;  // [Protected by chainLock_]
+    std::vector<ChainStage> liveStages_;                 // [Protected by chainLock_] stages of the live Plan, with their fade states
 
     double currentSampleRate_ = 48000.0;                 // [Message thread only]
     int currentBlockSize_ = 128;                         // [Message thread only]
+    bool fixedBlockSize_ = false;                        // [Message thread only] every block is currentBlockSize_
     std::atomic<bool> prepared_{false};                   // [Message write, RT read]
+    std::unique_ptr<juce::Timer> transitionCleanup_;      // [Message thread only] see scheduleTransitionCleanup()
+    std::unique_ptr<juce::AsyncUpdater> dryDelayUpdate_;  // [Message thread; triggered from any thread] runs updateDryDelays()
+    std::vector<std::shared_ptr<TimedPluginProcessor>> bypassParamAfterFade_;  // [Protected by chainLock_] bypass param to engage at cleanup
 
     juce::MidiBuffer emptyMidi_;                         // [RT thread only] Pre-allocated (avoids per-callback allocation)
 
-    std::atomic<bool> chainDirty_{false};                // [Message write, RT read] Lock-free chain swap flag
-
-    // [Protected: chain_, editorWindows_, graph nodes. NEVER in processBlock. NEVER writeToLog inside.]
+    // [Protected: chain_, editorWindows_, Plan publishing. NEVER in processBlock. NEVER writeToLog inside.]
     // Design note: CriticalSection (recursive mutex) used instead of shared_mutex because:
     //   1. No recursive locking (verified) — all methods use scoped block + unlock before calling peers
     //   2. Win32 CRITICAL_SECTION has user-mode fast-path, competitive with shared_mutex for low contention
@@ -44,7 +44,15 @@ void ActionDispatcher::dispatch(const ActionEvent& event)
     // If already on message thread: synchronous (no latency).
     // If on another thread (MIDI, WebSocket, HTTP, hotkey): callAsync.
     if (!juce::MessageManager::getInstance()->isThisTheMessageThread()) {
+        if (event.action == Action::SetPluginParameter) {
+            postParameter(event);
+            return;
+        }
+        // Close the pending parameter batch and post under the same lock, so a
+        // parameter change sent after this action is not delivered before it
         auto aliveFlag = alive_;
+        std::lock_guard<std::mutex> lock(paramMutex_);
+        openParamBatch_.reset();
         juce::MessageManager::callAsync([this, event, aliveFlag] {
             if (!aliveFlag->load()) return;
             dispatchOnMessageThread(event);
@@ -54,6 +62,47 @@ void ActionDispatcher::dispatch(const ActionEvent& event)
     dispatchOnMessageThread(event);
 }
 
+void ActionDispatcher::postParameter(const ActionEvent& event)
+{
+    // A knob sweep from MIDI/WebSocket/HTTP arrives far faster than it needs
+    // delivering: keep the latest value per parameter in the open batch. Only
+    // back-to-back changes share a batch; any other action closes it (dispatch),
+    // so the FIFO order across action kinds is kept.
+    std::lock_guard<std::mutex> lock(paramMutex_);
+    if (openParamBatch_ != nullptr) {
+        auto& pending = *openParamBatch_;
+        auto it = std::find_if(pending.begin(), pending.end(), [&](const ActionEvent& e) {
+            return e.intParam == event.intParam && e.intParam2 == event.intParam2;
+        });
+        if (it != pending.end())
+            *it = event;
+        else
+            pending.push_back(event);
+        return;
+    }
+    auto batch = std::make_shared<std::vector<ActionEvent>>();
+    batch->push_back(event);
+    openParamBatch_ = batch;
+    auto aliveFlag = alive_;
+    juce::MessageManager::callAsync([this, aliveFlag, batch] {
+        if (!aliveFlag->load()) return;
+        flushParameterBatch(batch);
+    });
+}
+
+void ActionDispatcher::flushParameterBatch(const std::shared_ptr<std::vector<ActionEvent>>& batch)
+{
+    std::vector<ActionEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(paramMutex_);
+        if (openParamBatch_ == batch)
+            openParamBatch_.reset();  // Later changes start a new batch
+        events.swap(*batch);
+    }
+    for (const auto& event : events)
+        dispatchOnMessageThread(event);
+}
+
 void ActionDispatcher::dispatchOnMessageThread(const ActionEvent& event)
 {
     // Copy listener list to avoid issues if a listener adds/removes listeners
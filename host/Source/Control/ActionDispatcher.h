@@ -87,6 +87,9 @@ public:
  * The dispatcher always delivers to listeners on the JUCE message thread.
  * If called from the message thread, delivery is synchronous (zero latency).
  * If called from another thread, delivery is deferred via callAsync.
+ * Consecutive off-thread SetPluginParameter events are coalesced into one
+ * callAsync carrying the latest value per (plugin, parameter); any other
+ * off-thread action ends the batch, so delivery order matches dispatch order.
  */
 class ActionDispatcher {
 public:
@@ -126,10 +129,17 @@ public:
 
 private:
     void dispatchOnMessageThread(const ActionEvent& event);
+    /// Queue an off-thread SetPluginParameter, replacing a pending one for the same parameter
+    void postParameter(const ActionEvent& event);
+    /// Deliver one batch of coalesced parameter events. [Message thread]
+    void flushParameterBatch(const std::shared_ptr<std::vector<ActionEvent>>& batch);
 
     std::vector<ActionListener*> listeners_;                // [Protected by listenerMutex_]
     std::mutex listenerMutex_;                              // [Protects listeners_]
 
+    std::shared_ptr<std::vector<ActionEvent>> openParamBatch_;  // [Protected by paramMutex_] Posted, not yet flushed; null = closed
+    std::mutex paramMutex_;                                 // [Protects openParamBatch_ and the callAsync post order]
+
     // [callAsync lifetime guard — shared_ptr captured by value in lambda, checked before accessing this]
     std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
 };
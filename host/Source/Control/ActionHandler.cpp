@@ -167,8 +167,7 @@ void ActionHandler::handle(const ActionEvent& event)
             }
             {
                 AtomicGuard loadGuard(loadingSlot_);
-                for (int i = 0; i < engine_.getVSTChain().getPluginCount(); ++i)
-                    engine_.getVSTChain().setPluginBypassed(i, anyActive);
+                engine_.getVSTChain().setAllPluginsBypassed(anyActive);
             }
             int activeSlot = presetMgr_.getActiveSlot();
             if (activeSlot >= 0 && !partialLoad_.load())
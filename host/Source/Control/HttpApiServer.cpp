@@ -295,6 +295,20 @@ std::pair<int, std::string> HttpApiServer::processRequest(const std::string& met
         obj->setProperty("sampleRate", monitor.getSampleRate());
         obj->setProperty("bufferSize", monitor.getBufferSize());
         obj->setProperty("xrunCount", engine_.getRecentXRunCount());
+        obj->setProperty("oversizedCallbacks", static_cast<juce::int64>(engine_.getOversizedCallbackCount()));
+        obj->setProperty("processingBlockSize", engine_.getProcessingBlockSize());
+        obj->setProperty("blockAdapterLatencySamples", monitor.getBlockAdapterLatencySamples());
+
+        // IPC health per Receiver, from the last status snapshot (the ring
+        // itself is message-thread only)
+        const auto state = broadcaster_.getState();
+        auto ipc = new juce::DynamicObject();
+        ipc->setProperty("enabled", state.ipcEnabled);
+        ipc->setProperty("droppedFrames", static_cast<juce::int64>(state.ipcDroppedFrames));
+        ipc->setProperty("overwrittenFrames", static_cast<juce::int64>(state.ipcOverwrittenFrames));
+        ipc->setProperty("consumers", StateBroadcaster::ipcConsumersToVar(state));
+        obj->setProperty("ipc", juce::var(ipc));
+        obj->setProperty("stages", StateBroadcaster::callbackStagesToVar(state));
         return {200, juce::JSON::toString(juce::var(obj), true).toStdString()};
     }
 
@@ -441,6 +455,7 @@ std::pair<int, std::string> HttpApiServer::processRequest(const std::string& met
         juce::Array<juce::var> arr;
         int count = chain.getPluginCount();
         auto latencies = chain.getPluginLatencies();
+        auto timings = chain.getPluginTimings();
         for (int i = 0; i < count; ++i) {
             auto* slot = chain.getPluginSlot(i);
             auto obj = new juce::DynamicObject();
@@ -451,6 +466,13 @@ std::pair<int, std::string> HttpApiServer::processRequest(const std::string& met
             obj->setProperty("parameterCount", chain.getPluginParameterCount(i));
             obj->setProperty("latencySamples",
                 (static_cast<size_t>(i) < latencies.size()) ? latencies[static_cast<size_t>(i)].latencySamples : 0);
+            if (static_cast<size_t>(i) < timings.size()) {
+                const auto& t = timings[static_cast<size_t>(i)];
+                obj->setProperty("cpuMeanUs", static_cast<double>(t.meanUs));
+                obj->setProperty("cpuP99Us", static_cast<double>(t.p99Us));
+                obj->setProperty("cpuMaxUs", static_cast<double>(t.maxUs));
+                obj->setProperty("cpuPercent", static_cast<double>(t.budgetPercent));
+            }
             arr.add(juce::var(obj));
         }
         return {200, juce::JSON::toString(juce::var(arr), true).toStdString()};
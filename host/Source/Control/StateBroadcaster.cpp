@@ -101,6 +101,33 @@ static uint32_t quickTelemetryHash(const AppState& s)
     hashBucket(s.cpuPercent, 1.0f);
     hashBucket(s.limiterGainReduction, 0.5f);
     h = h * 31u + static_cast<uint32_t>(s.recordingSeconds);
+    // IPC health: counters exactly, gauges bucketed. blocks and fillHistogram
+    // move every block and ride along with the fields below.
+    h = h * 31u + static_cast<uint32_t>(s.ipcDroppedFrames);
+    h = h * 31u + static_cast<uint32_t>(s.ipcOverwrittenFrames);
+    h = h * 31u + static_cast<uint32_t>(s.ipcConsumers.size());
+    for (const auto& c : s.ipcConsumers) {
+        h = h * 31u + static_cast<uint32_t>(c.slot);
+        h = h * 31u + c.underruns;
+        h = h * 31u + static_cast<uint32_t>(c.framesPadded);
+        h = h * 31u + static_cast<uint32_t>(c.framesSkipped);
+        h = h * 31u + static_cast<uint32_t>(c.framesConcealed);
+        hashBucket(static_cast<float>(c.fillFrames), 64.0f);
+        hashBucket(static_cast<float>(c.resampleRatio * 1e6), 10.0f);
+        hashBucket(c.processUs, 5.0f);
+        hashBucket(c.processPeakUs, 5.0f);
+        hashBucket(c.latencyMs, 0.1f);
+    }
+    // Stage timing: counts move every block; only a new peak or a shifted
+    // p99 is worth a broadcast of its own
+    for (const auto& st : s.callbackStages) {
+        hashBucket(st.p99Us, 1.0f);
+        hashBucket(st.maxUs, 1.0f);
+    }
+    for (const auto& p : s.plugins) {
+        hashBucket(p.cpuP99Us, 5.0f);
+        hashBucket(p.cpuPercent, 1.0f);
+    }
     return h;
 }
 
@@ -180,6 +207,51 @@ void StateBroadcaster::notifyOnMessageThread()
     }
 }
 
+juce::var StateBroadcaster::ipcConsumersToVar(const AppState& state)
+{
+    juce::Array<juce::var> consumers;
+    for (const auto& c : state.ipcConsumers) {
+        auto consumer = new juce::DynamicObject();
+        consumer->setProperty("slot", c.slot);
+        consumer->setProperty("blocks", static_cast<juce::int64>(c.blocks));
+        consumer->setProperty("underruns", static_cast<juce::int64>(c.underruns));
+        consumer->setProperty("frames_padded", static_cast<juce::int64>(c.framesPadded));
+        consumer->setProperty("frames_skipped", static_cast<juce::int64>(c.framesSkipped));
+        consumer->setProperty("frames_concealed", static_cast<juce::int64>(c.framesConcealed));
+        consumer->setProperty("fill_frames", c.fillFrames);
+        consumer->setProperty("resample_ratio", c.resampleRatio);
+        consumer->setProperty("process_us", static_cast<double>(c.processUs));
+        consumer->setProperty("process_peak_us", static_cast<double>(c.processPeakUs));
+        consumer->setProperty("latency_ms", static_cast<double>(c.latencyMs));
+        juce::Array<juce::var> histogram;
+        for (auto count : c.fillHistogram)
+            histogram.add(static_cast<juce::int64>(count));
+        consumer->setProperty("fill_histogram", histogram);
+        consumers.add(juce::var(consumer));
+    }
+    return consumers;
+}
+
+juce::var StateBroadcaster::callbackStagesToVar(const AppState& state)
+{
+    juce::Array<juce::var> stages;
+    for (const auto& st : state.callbackStages) {
+        auto stage = new juce::DynamicObject();
+        stage->setProperty("name", juce::String(st.name));
+        stage->setProperty("count", static_cast<juce::int64>(st.count));
+        stage->setProperty("mean_us", static_cast<double>(st.meanUs));
+        stage->setProperty("p50_us", static_cast<double>(st.p50Us));
+        stage->setProperty("p99_us", static_cast<double>(st.p99Us));
+        stage->setProperty("max_us", static_cast<double>(st.maxUs));
+        juce::Array<juce::var> histogram;
+        for (auto count : st.histogram)
+            histogram.add(static_cast<juce::int64>(count));
+        stage->setProperty("histogram", histogram);
+        stages.add(juce::var(stage));
+    }
+    return stages;
+}
+
 std::string StateBroadcaster::toJSON() const
 {
     auto state = getState();
@@ -198,6 +270,10 @@ std::string StateBroadcaster::toJSON() const
         plugin->setProperty("loaded", p.loaded);
         plugin->setProperty("latency_samples", p.latencySamples);
         plugin->setProperty("type", juce::String(p.type));
+        plugin->setProperty("cpu_mean_us", static_cast<double>(p.cpuMeanUs));
+        plugin->setProperty("cpu_p99_us", static_cast<double>(p.cpuP99Us));
+        plugin->setProperty("cpu_max_us", static_cast<double>(p.cpuMaxUs));
+        plugin->setProperty("cpu_percent", static_cast<double>(p.cpuPercent));
         plugins.add(juce::var(plugin));
     }
     data->setProperty("plugins", plugins);
@@ -252,6 +328,14 @@ std::string StateBroadcaster::toJSON() const
     data->setProperty("chain_pdc_samples", state.chainPDCSamples);
     data->setProperty("chain_pdc_ms", static_cast<double>(state.chainPDCMs));
 
+    // IPC health (host side + what each Receiver reports back)
+    data->setProperty("ipc_dropped_frames", static_cast<juce::int64>(state.ipcDroppedFrames));
+    data->setProperty("ipc_overwritten_frames", static_cast<juce::int64>(state.ipcOverwrittenFrames));
+    data->setProperty("ipc_consumers", ipcConsumersToVar(state));
+
+    // Audio callback time per stage
+    data->setProperty("callback_stages", callbackStagesToVar(state));
+
     root->setProperty("data", juce::var(data));
 
     return juce::JSON::toString(juce::var(root.get()), true).toStdString();
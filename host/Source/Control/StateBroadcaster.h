@@ -35,6 +35,12 @@
 #include <vector>
 #include <algorithm>
 #include <array>
+#include <cstdint>
+
+#include "directpipe/Protocol.h"
+#include "../Audio/LatencyMonitor.h"
+
+namespace juce { class var; }
 
 namespace directpipe {
 
@@ -46,6 +52,11 @@ struct AppState {
         bool loaded = false;
         int latencySamples = 0;
         std::string type;  // "vst", "builtin_filter", "builtin_noise_removal", "builtin_auto_gain"
+        // processBlock time since the chain was prepared (VSTChain::getPluginTimings)
+        float cpuMeanUs = 0.0f;
+        float cpuP99Us = 0.0f;
+        float cpuMaxUs = 0.0f;
+        float cpuPercent = 0.0f;   // Mean as % of one chain block period
     };
 
     std::vector<PluginState> plugins;
@@ -85,6 +96,37 @@ struct AppState {
     int chainPDCSamples = 0;
     float chainPDCMs = 0.0f;
 
+    // IPC health, as published back by each attached Receiver (main stream)
+    struct IpcConsumerState {
+        int slot = 0;                  // consumer table index
+        uint64_t blocks = 0;           // blocks rendered while connected
+        uint32_t underruns = 0;        // blocks whose read came up short
+        uint64_t framesPadded = 0;     // output frames the ring could not supply
+        uint64_t framesSkipped = 0;    // ring frames skipped (stall recovery)
+        uint64_t framesConcealed = 0;  // padded frames covered by waveform repeat
+        int fillFrames = 0;            // ring frames buffered at its last block
+        double resampleRatio = 0.0;    // read ratio (host rate / DAW rate x drift), 0 = unknown
+        float processUs = 0.0f;        // its processBlock time (smoothed)
+        float processPeakUs = 0.0f;
+        float latencyMs = 0.0f;        // measured end-to-end IPC latency
+        std::array<uint32_t, FILL_HISTOGRAM_BINS> fillHistogram{};  // bins: fillHistogramBin()
+    };
+    std::vector<IpcConsumerState> ipcConsumers;
+    uint64_t ipcDroppedFrames = 0;      // host side: frames the ring had no room for
+    uint64_t ipcOverwrittenFrames = 0;  // host side: frames recycled before the slowest Receiver read them
+
+    // Audio callback time per stage, cumulative since the device started
+    struct CallbackStageState {
+        std::string name;              // callbackStageName()
+        uint64_t count = 0;            // sub-blocks timed
+        float meanUs = 0.0f;
+        float p50Us = 0.0f;            // bin upper edge (see StageTimingSnapshot::percentileUs)
+        float p99Us = 0.0f;
+        float maxUs = 0.0f;
+        std::array<uint32_t, kStageTimingBins> histogram{};  // bins: stageTimingBin()
+    };
+    std::vector<CallbackStageState> callbackStages;
+
     std::array<std::string, 6> slotNames{};  // A-E (0-4) + Auto (5)
 };
 
@@ -134,6 +176,14 @@ public:
      */
     std::string toJSON() const;
 
+    /**
+     * @brief `state.ipcConsumers` as a JSON array (shared by toJSON() and /api/perf).
+     */
+    static juce::var ipcConsumersToVar(const AppState& state);
+
+    /// Per-stage callback timing as a JSON array (shared by the state and /api/perf)
+    static juce::var callbackStagesToVar(const AppState& state);
+
 private:
     void notifyListeners();
     void notifyOnMessageThread();
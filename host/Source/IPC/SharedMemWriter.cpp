@@ -45,44 +45,96 @@ bool SharedMemWriter::initialize(uint32_t sampleRate, uint32_t channels, uint32_
     if (wasConnected)
         std::this_thread::sleep_for(std::chrono::milliseconds(5));
 
+    StreamInfo stream;
+    if (!makeStreamInfo(streamId_.toRawUTF8(), streamDescription_.toRawUTF8(), stream)) {
+        juce::Logger::writeToLog("[IPC] SharedMemWriter: Invalid stream id '" + streamId_ + "'");
+        return false;
+    }
+    stream.channels = channels;
+    stream.sampleRate = sampleRate;
+
     channels_ = channels;
+    sampleFormat_ = requestedFormat_;
+    ditherMode_ = requestedDither_;
+    sampleLayout_ = requestedLayout_;
 
     // Calculate shared memory size
-    size_t shmSize = calculateSharedMemorySize(bufferFrames, channels);
+    size_t shmSize = calculateSharedMemorySize(bufferFrames, channels, sampleFormat_);
 
-    // Create shared memory region
-    if (!sharedMemory_.create(SHM_NAME, shmSize)) {
+    // Create shared memory region, pre-faulted and locked so the first RT
+    // writes after enabling IPC don't stall on page faults
+    if (!sharedMemory_.create(stream.shmName, shmSize, requestedMemoryOptions_)) {
         juce::Logger::writeToLog("[IPC] SharedMemWriter: Failed to create shared memory");
         return false;
     }
 
-    // Initialize ring buffer in the shared memory
-    ringBuffer_.initAsProducer(sharedMemory_.getData(), bufferFrames, channels, sampleRate);
+    auto describeOption = [](bool requested, bool applied) {
+        return juce::String(!requested ? "off" : applied ? "yes" : "unavailable");
+    };
+    const auto& applied = sharedMemory_.getAppliedOptions();
+    juce::Logger::writeToLog("[IPC] SharedMemWriter: Memory options - prefault: "
+        + describeOption(requestedMemoryOptions_.prefault, applied.prefault)
+        + ", lock: " + describeOption(requestedMemoryOptions_.lock, applied.lock)
+        + ", huge pages: " + describeOption(requestedMemoryOptions_.hugePages, applied.hugePages)
+        + " (" + juce::String(static_cast<juce::int64>(shmSize / 1024)) + " KB)");
+
+    // Initialize ring buffer in the shared memory (the policy is advertised in the header)
+    ringBuffer_.setOverrunPolicy(requestedOverrunPolicy_);
+    ringBuffer_.initAsProducer(sharedMemory_.getData(), bufferFrames, channels, sampleRate,
+                               sampleFormat_, sampleLayout_);
 
     // Create named event for signaling
-    if (!dataEvent_.create(EVENT_NAME)) {
+    if (!dataEvent_.create(stream.eventName)) {
         juce::Logger::writeToLog("[IPC] SharedMemWriter: Failed to create named event");
         sharedMemory_.close();
         return false;
     }
 
-    // Pre-allocate interleave buffer (max expected buffer size × channels)
-    interleaveBuffer_.resize(static_cast<size_t>(bufferFrames) * channels, 0.0f);
+    // Linux: signal through a futex word in the header so writeAudio() only
+    // makes a syscall when a Receiver is actually parked in wait().
+    // No-op on Windows/macOS (named event / semaphore stays in use).
+    auto* header = static_cast<DirectPipeHeader*>(sharedMemory_.getData());
+    dataEvent_.bindSharedWord(&header->data_seq, &header->consumer_waiting);
 
     connected_.store(true, std::memory_order_release);
     droppedFrames_.store(0, std::memory_order_relaxed);
+    consumerLatencyUs_.store(0, std::memory_order_relaxed);
 
-    juce::Logger::writeToLog("[IPC] SharedMemWriter: Initialized - " +
+    // List the stream in the directory. The main stream is reachable by its
+    // fixed name even when this fails, so it only costs discoverability.
+    if (!registry_.openForPublishing() || !registry_.publish(stream))
+        juce::Logger::writeToLog("[IPC] SharedMemWriter: Stream '" + streamId_
+                                 + "' not listed in the stream directory");
+
+    static const char* const kFormatNames[] = { "float32", "int16", "int24", "fp16" };
+    juce::Logger::writeToLog("[IPC] SharedMemWriter: Initialized '" + streamId_ + "' - " +
                              juce::String(sampleRate) + "Hz, " +
                              juce::String(channels) + "ch, " +
-                             juce::String(bufferFrames) + " frames buffer");
+                             juce::String(bufferFrames) + " frames buffer, " +
+                             kFormatNames[static_cast<uint32_t>(sampleFormat_)] +
+                             (sampleLayout_ == SampleLayout::Planar ? " planar" : " interleaved") +
+                             (ditherMode_ == DitherMode::Tpdf ? " (TPDF dither)" : "") +
+                             (requestedOverrunPolicy_ == OverrunPolicy::OverwriteOldest
+                                  ? ", overwrite-oldest" : ", drop-newest"));
 
     return true;
 }
 
 void SharedMemWriter::shutdown()
 {
-    connected_.store(false, std::memory_order_release);
+    connected_.store(false, std::memory_order_seq_cst);
+
+    // Unlist first so no new Receiver picks the stream while it goes away
+    if (registry_.isOpen()) {
+        registry_.withdraw(streamId_.toRawUTF8());
+        registry_.close();
+    }
+
+    // writeAudio() interleaves straight into the mapped pages, so wait for an
+    // in-flight write to finish before unmapping. Bounded: one RT write is a
+    // few microseconds, and once connected_ is false no new write starts.
+    while (writeInFlight_.load(std::memory_order_seq_cst))
+        std::this_thread::yield();
 
     // Signal receiver that producer is gone BEFORE unmapping shared memory.
     // The receiver checks producer_active to detect clean disconnects.
@@ -95,64 +147,117 @@ void SharedMemWriter::shutdown()
     }
 
     // Invalidate ring buffer pointers before unmapping shared memory.
-    // Prevents dangling pointer dereference if audio thread is still in writeAudio()
-    // (race window in setIpcEnabled(false) — audio thread may see stale ipcEnabled_=true).
+    // Any writeAudio() that starts after this point sees connected_=false or
+    // a detached ring buffer and returns without touching the mapping.
     ringBuffer_.detach();
     dataEvent_.close();
     sharedMemory_.close();
-    // NOTE: Do NOT clear interleaveBuffer_ here. The audio thread might still be
-    // reading it during the setIpcEnabled(false) race window. The buffer is harmless
-    // to leave allocated and gets repopulated on next initialize().
 }
 
-void SharedMemWriter::writeAudio(const juce::AudioBuffer<float>& buffer, int numSamples)
+void SharedMemWriter::setStream(const juce::String& id, const juce::String& description)
+{
+    streamId_ = id;
+    streamDescription_ = description;
+}
+
+void SharedMemWriter::setSampleFormat(SampleFormat format, DitherMode dither)
+{
+    requestedFormat_ = format;
+    requestedDither_ = dither;
+}
+
+uint32_t SharedMemWriter::getConsumerFormatMask() const
+{
+    // Message thread only: shutdown()/initialize() run on the same thread,
+    // so the ring cannot be detached underneath us
+    return connected_.load(std::memory_order_acquire) ? ringBuffer_.getConsumerFormatMask()
+                                                      : ALL_SAMPLE_FORMATS;
+}
+
+uint32_t SharedMemWriter::getConsumerStats(ConsumerStatsSnapshot* out, uint32_t maxConsumers) const
+{
+    // Message thread only, like getConsumerFormatMask(): the ring cannot be
+    // detached underneath us
+    return connected_.load(std::memory_order_acquire) ? ringBuffer_.readConsumerStats(out, maxConsumers)
+                                                      : 0;
+}
+
+void SharedMemWriter::writeAudio(const juce::AudioBuffer<float>& buffer, int numSamples,
+                                 uint64_t hostTimeNs, uint64_t sampleCounter)
 {
     // RT thread only — must NOT be called from the message thread
     jassert(!juce::MessageManager::getInstanceWithoutCreating()
             || !juce::MessageManager::getInstance()->isThisTheMessageThread());
 
-    if (!connected_.load(std::memory_order_relaxed)) return;
     if (numSamples <= 0) return;
 
-    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(channels_));
-    // Clamp to interleaveBuffer_ capacity to prevent buffer overrun
-    const auto maxFrames = interleaveBuffer_.size() / (std::max)(static_cast<size_t>(channels_), size_t{1});
-    const auto samples = (std::min)(static_cast<size_t>(numSamples), maxFrames);
-
-    // Convert from JUCE's non-interleaved format to interleaved
-    // JUCE: [L0 L1 L2 ...][R0 R1 R2 ...]
-    // Ring buffer: [L0 R0 L1 R1 L2 R2 ...]
-    if (channels_ == 1) {
-        // Mono: just copy channel 0
-        const float* src = buffer.getReadPointer(0);
-        std::memcpy(interleaveBuffer_.data(), src, samples * sizeof(float));
-    } else {
-        // Stereo: interleave channels
-        const float* left = buffer.getReadPointer(0);
-        const float* right = numChannels > 1 ? buffer.getReadPointer(1) : buffer.getReadPointer(0);
-
-        for (size_t i = 0; i < samples; ++i) {
-            interleaveBuffer_[i * 2] = left[i];
-            interleaveBuffer_[i * 2 + 1] = right[i];
-        }
+    // Dekker-style handshake with shutdown(): announce the write, then re-check
+    // connected_. shutdown() clears connected_ and then waits for writeInFlight_.
+    writeInFlight_.store(true, std::memory_order_seq_cst);
+    if (!connected_.load(std::memory_order_seq_cst)) {
+        writeInFlight_.store(false, std::memory_order_release);
+        return;
+    }
+
+    // Nobody listening: skip the copy and the signal. Nothing is lost —
+    // a consumer that attaches later skips to fresh audio on connect.
+    if (ringBuffer_.getConsumerCount() == 0) {
+        consumerLatencyUs_.store(0, std::memory_order_relaxed);
+        writeInFlight_.store(false, std::memory_order_release);
+        return;
     }
 
-    // Write to ring buffer (lock-free)
-    uint32_t written = ringBuffer_.write(interleaveBuffer_.data(),
-                                          static_cast<uint32_t>(samples));
+    const int numChannels = juce::jmin(buffer.getNumChannels(), static_cast<int>(channels_));
+    const float* left = buffer.getReadPointer(0);
+    const float* right = numChannels > 1 ? buffer.getReadPointer(1) : left;
+
+    // Reserve space in the shared ring and copy straight into it — one pass
+    // over the samples, no intermediate buffer. Compact formats
+    // (int16/int24/fp16) are packed in the same pass.
+    // JUCE:                [L0 L1 L2 ...][R0 R1 R2 ...]
+    // Planar ring:         [L0 L1 L2 ...] ... [R0 R1 R2 ...]  (one memcpy per channel)
+    // Interleaved ring:    [L0 R0 L1 R1 L2 R2 ...]
+    const auto region = ringBuffer_.beginWrite(static_cast<uint32_t>(numSamples));
+
+    auto interleaveInto = [&](uint8_t* dest, uint32_t srcOffset, uint32_t frames) {
+        const float* src[2] = { left + srcOffset, right + srcOffset };
+        if (region.layout == SampleLayout::Planar)
+            packPlanes(region.format, src, channels_, frames, dest, region.planeStride,
+                       ditherMode_, ditherState_);
+        else
+            packInterleaved(region.format, src, channels_, frames, dest, ditherMode_, ditherState_);
+    };
+
+    if (region.frames1 > 0)
+        interleaveInto(region.bytes1, 0, region.frames1);
+    if (region.frames2 > 0)
+        interleaveInto(region.bytes2, region.frames1, region.frames2);
 
-    if (written < static_cast<uint32_t>(samples)) {
-        // Buffer overrun — some frames were dropped
+    const uint32_t written = region.frames();
+
+    // Stamp the block before publishing it, so a consumer that sees the
+    // frames also finds their timestamp
+    if (written > 0)
+        ringBuffer_.publishBlockMeta(region.position, written, hostTimeNs, sampleCounter);
+    ringBuffer_.commitWrite(written);
+    consumerLatencyUs_.store(ringBuffer_.getMaxConsumerLatencyUs(), std::memory_order_relaxed);
+
+    if (written < static_cast<uint32_t>(numSamples)) {
+        // Buffer overrun — some frames were dropped (overwrite-oldest only
+        // drops the part of a block that exceeds the whole ring)
         droppedFrames_.fetch_add(
-            static_cast<uint32_t>(samples) - written,
+            static_cast<uint32_t>(numSamples) - written,
             std::memory_order_relaxed);
     }
 
     // Signal the consumer only when data was actually written.
     // Skipping the signal when written==0 avoids an unnecessary kernel syscall
     // (SetEvent/sem_post) on every callback, reducing DPC overhead.
+    // On Linux the futex path goes further: no syscall unless a reader is parked.
     if (written > 0)
         dataEvent_.signal();
+
+    writeInFlight_.store(false, std::memory_order_release);
 }
 
 } // namespace directpipe
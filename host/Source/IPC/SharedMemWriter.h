@@ -28,6 +28,7 @@
 #include <JuceHeader.h>
 #include "directpipe/RingBuffer.h"
 #include "directpipe/SharedMemory.h"
+#include "directpipe/StreamRegistry.h"
 #include "directpipe/Constants.h"
 
 #include <atomic>
@@ -37,8 +38,9 @@ namespace directpipe {
 /**
  * @brief Writes audio to shared memory for the OBS plugin to read.
  *
- * Creates and manages the shared memory region and named event.
- * Safe to call write methods from the real-time audio thread.
+ * Creates and manages the shared memory region and named event of one
+ * stream, and lists it in the stream directory (StreamRegistry) while
+ * initialized. Safe to call write methods from the real-time audio thread.
  */
 class SharedMemWriter {
 public:
@@ -61,15 +63,93 @@ public:
      */
     void shutdown();
 
+    /**
+     * @brief Select which stream this writer publishes (takes effect on the
+     * next initialize()). Defaults to the main stream (MAIN_STREAM_ID), which
+     * keeps the fixed SHM_NAME / EVENT_NAME.
+     * @param id Stream id, 1-31 characters of [A-Za-z0-9_-].
+     * @param description Label shown in the Receiver's stream selector.
+     */
+    void setStream(const juce::String& id, const juce::String& description);  // [Message thread]
+    const juce::String& getStreamId() const { return streamId_; }
+
+    /**
+     * @brief Select the ring sample format and dither (takes effect on the next
+     * initialize()). Float32 is the default; Int16 halves shared-memory size
+     * and bandwidth for consumers that only need 16-bit.
+     */
+    void setSampleFormat(SampleFormat format, DitherMode dither);  // [Message thread]
+    SampleFormat getSampleFormat() const { return sampleFormat_; }  // active format
+
+    /**
+     * @brief Select the ring channel layout (takes effect on the next
+     * initialize()). Planar is the default: each channel is one memcpy on
+     * both sides instead of an interleave/de-interleave pass.
+     */
+    void setSampleLayout(SampleLayout layout) { requestedLayout_ = layout; }  // [Message thread]
+    SampleLayout getSampleLayout() const { return sampleLayout_; }  // active layout
+
+    /**
+     * @brief Select what happens when a Receiver stops reading and the ring
+     * fills (takes effect on the next initialize()). OverwriteOldest is the
+     * default: the newest audio always goes in, and a Receiver that resumes
+     * (DAW transport restarted, OBS source shown again) starts within one
+     * block of live audio instead of replaying a full ring of stale audio.
+     */
+    void setOverrunPolicy(OverrunPolicy policy) { requestedOverrunPolicy_ = policy; }  // [Message thread]
+
+    /**
+     * @brief Select residency options for the shared memory region (takes
+     * effect on the next initialize()). All are on by default so the RT
+     * thread never takes first-touch page faults after IPC is enabled.
+     */
+    void setMemoryOptions(const SharedMemoryOptions& options) { requestedMemoryOptions_ = options; }  // [Message thread]
+
+    /**
+     * @brief Options that took effect for the current region (logged by initialize()).
+     */
+    SharedMemoryOptions getAppliedMemoryOptions() const { return sharedMemory_.getAppliedOptions(); }  // [Message thread]
+
+    /**
+     * @brief AND of the formats every attached consumer can decode
+     * (ALL_SAMPLE_FORMATS when disconnected or nobody is attached).
+     */
+    uint32_t getConsumerFormatMask() const;  // [Message thread]
+
     /**
      * @brief Write audio data to the shared ring buffer.
      *
      * Called from the real-time audio thread. No allocations, no locks.
+     * Returns immediately while no consumer is attached to the stream.
+     * Copies each channel into its plane (planar layout) or interleaves
+     * (interleaved layout) directly into the shared ring, packing compact
+     * formats in the same pass (RingBuffer::beginWrite/commitWrite), and stamps the block in the
+     * header's timestamp side channel (RingBuffer::publishBlockMeta) so
+     * consumers can measure end-to-end latency and clock drift.
      *
      * @param buffer JUCE audio buffer with processed audio.
      * @param numSamples Number of samples to write.
+     * @param hostTimeNs Monotonic time of the audio callback (steadyClockNs()).
+     * @param sampleCounter Device frames delivered before this block.
+     */
+    void writeAudio(const juce::AudioBuffer<float>& buffer, int numSamples,
+                    uint64_t hostTimeNs, uint64_t sampleCounter);  // [RT thread only — no alloc, no lock]
+
+    /**
+     * @brief Highest end-to-end latency reported by an attached consumer
+     * (producer block timestamp -> consumer read), 0 if none reported yet.
+     * Refreshed on every writeAudio().
      */
-    void writeAudio(const juce::AudioBuffer<float>& buffer, int numSamples);  // [RT thread only — no alloc, no lock]
+    double getConsumerLatencyMs() const {
+        return consumerLatencyUs_.load(std::memory_order_relaxed) / 1000.0;
+    }
+
+    /**
+     * @brief Telemetry every attached Receiver publishes back (underruns,
+     * padding, skips, fill histogram, resample ratio, processing time).
+     * @return Entries written to `out` (0 when disconnected).
+     */
+    uint32_t getConsumerStats(ConsumerStatsSnapshot* out, uint32_t maxConsumers) const;  // [Message thread]
 
     /**
      * @brief Check if the shared memory is active and connected.
@@ -77,23 +157,40 @@ public:
     bool isConnected() const { return connected_.load(std::memory_order_relaxed); }
 
     /**
-     * @brief Get the number of frames dropped due to buffer overrun.
+     * @brief Get the number of frames dropped due to buffer overrun
+     * (DropNewest policy, or blocks larger than the ring).
      */
     uint64_t getDroppedFrames() const { return droppedFrames_.load(std::memory_order_relaxed); }
 
+    /**
+     * @brief Frames overwritten before the slowest Receiver read them
+     * (OverwriteOldest policy).
+     */
+    uint64_t getOverwrittenFrames() const { return ringBuffer_.getOverwrittenFrames(); }
+
 private:
     SharedMemory sharedMemory_;
     NamedEvent dataEvent_;
     RingBuffer ringBuffer_;
-
-    // Pre-allocated interleave buffer (for converting JUCE's
-    // non-interleaved format to interleaved for the ring buffer)
-    std::vector<float> interleaveBuffer_;
+    StreamRegistry registry_;   // [Message thread] directory entry for this stream
 
     std::atomic<bool> connected_{false};
+    std::atomic<bool> writeInFlight_{false};  // [RT write, Message read] set while writeAudio() touches the mapping
     std::atomic<uint64_t> droppedFrames_{0};
+    std::atomic<uint32_t> consumerLatencyUs_{0};  // [RT write, Any read]
 
     uint32_t channels_ = DEFAULT_CHANNELS;
+    juce::String streamId_{MAIN_STREAM_ID};                 // [Message thread] set by setStream()
+    juce::String streamDescription_{"DirectPipe output"};   // [Message thread]
+    SampleFormat requestedFormat_ = SampleFormat::Float32;  // [Message thread] set by setSampleFormat()
+    DitherMode requestedDither_ = DitherMode::None;         // [Message thread]
+    SampleLayout requestedLayout_ = SampleLayout::Planar;   // [Message thread] set by setSampleLayout()
+    OverrunPolicy requestedOverrunPolicy_ = OverrunPolicy::OverwriteOldest;  // [Message thread] set by setOverrunPolicy()
+    SharedMemoryOptions requestedMemoryOptions_{true, true, true};  // [Message thread] prefault, lock, huge pages
+    SampleFormat sampleFormat_ = SampleFormat::Float32;  // [Message write in initialize() while no write is in flight, RT read]
+    DitherMode ditherMode_ = DitherMode::None;           // [same as sampleFormat_]
+    SampleLayout sampleLayout_ = SampleLayout::Planar;   // [same as sampleFormat_]
+    DitherState ditherState_;                            // [RT thread only]
 };
 
 } // namespace directpipe
@@ -264,6 +264,10 @@ MainComponent::MainComponent(bool enableExternalControls)
         audioEngine_.setIpcEnabled(enabled);
         markSettingsDirty();
     };
+    outputPanel_->onIpcTapToggle = [this](int tap, bool enabled) {
+        audioEngine_.setIpcTapEnabled(static_cast<AudioEngine::IpcTap>(tap), enabled);
+        markSettingsDirty();
+    };
 
     // Right-column Tabbed Panel
     rightTabs_ = std::make_unique<juce::TabbedComponent>(juce::TabbedButtonBar::TabsAtTop);
@@ -949,13 +953,14 @@ void MainComponent::timerCallback()
     // Sync Auto button visual (active/inactive)
     updateAutoButtonVisual();
 
-    // Sync limiter toggle + ceiling + GR in chain editor
+    // Sync limiter toggle + ceiling + GR + per-plugin CPU in chain editor
     if (pluginChainEditor_) {
         pluginChainEditor_->setLimiterState(audioEngine_.getSafetyLimiter().isEnabled());
         pluginChainEditor_->setLimiterCeiling(audioEngine_.getSafetyLimiter().getCeilingdB());
         pluginChainEditor_->setSafetyVolumeState(audioEngine_.isSafetyHeadroomEnabled());
         pluginChainEditor_->setSafetyHeadroom(audioEngine_.getSafetyHeadroomdB());
         pluginChainEditor_->setLimiterGR(audioEngine_.getSafetyLimiter().getCurrentGainReduction());
+        pluginChainEditor_->updatePluginTimings();
     }
 
     // Update recording state in OutputPanel (Monitor tab)
@@ -1028,8 +1033,11 @@ void MainComponent::refreshUI()
                             juce::Colour(muted ? 0xFF4CAF50u : 0xFFE05050u));
 
     // IPC toggle state (Output tab = index 1)
-    if (auto* outPanel = dynamic_cast<OutputPanel*>(rightTabs_->getTabContentComponent(1)))
+    if (auto* outPanel = dynamic_cast<OutputPanel*>(rightTabs_->getTabContentComponent(1))) {
         outPanel->setIpcToggleState(audioEngine_.isIpcEnabled());
+        for (int tap = 0; tap < AudioEngine::kNumIpcTaps; ++tap)
+            outPanel->setIpcTapToggleState(tap, audioEngine_.isIpcTapEnabled(static_cast<AudioEngine::IpcTap>(tap)));
+    }
 
     // Auto button visual state
     updateAutoButtonVisual();
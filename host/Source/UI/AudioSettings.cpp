@@ -23,6 +23,8 @@
 
 #include "AudioSettings.h"
 
+#include <iterator>
+
 namespace directpipe {
 
 // ─── Construction / Destruction ─────────────────────────────────────────────
@@ -91,6 +93,15 @@ AudioSettings::AudioSettings(AudioEngine& engine)
     styleCombo(bufferSizeCombo_);
     bufferSizeCombo_.onChange = [this] { onBufferSizeChanged(); };
 
+    // ── Processing block size ──
+    styleLabel(processingBlockLabel_);
+    styleCombo(processingBlockCombo_);
+    processingBlockCombo_.addItem("Device (buffer size)", 1);
+    for (int i = 0; i < static_cast<int>(std::size(kProcessingBlockSizes)); ++i)
+        processingBlockCombo_.addItem(juce::String(kProcessingBlockSizes[i]) + " samples", i + 2);
+    processingBlockCombo_.onChange = [this] { onProcessingBlockChanged(); };
+    syncProcessingBlockCombo();
+
     // ── Channel mode (radio group) ──
     styleLabel(channelModeLabel_);
 
@@ -240,6 +251,12 @@ void AudioSettings::resized()
                                bounds.getWidth() - labelW - gap, rowH);
     y += rowH + gap;
 
+    // Processing Block
+    processingBlockLabel_.setBounds(bounds.getX(), y, labelW, rowH);
+    processingBlockCombo_.setBounds(bounds.getX() + labelW + gap, y,
+                                    bounds.getWidth() - labelW - gap, rowH);
+    y += rowH + gap;
+
     // Channel Mode
     channelModeLabel_.setBounds(bounds.getX(), y, labelW, rowH);
     int radioW = (bounds.getWidth() - labelW - gap) / 2;
@@ -289,6 +306,7 @@ void AudioSettings::refreshFromEngine()
     rebuildDeviceLists();
     rebuildSampleRateList();
     rebuildBufferSizeList();
+    syncProcessingBlockCombo();
 
     // Channel mode
     int ch = engine_.getChannelMode();
@@ -514,6 +532,20 @@ void AudioSettings::onBufferSizeChanged()
     }
 }
 
+void AudioSettings::onProcessingBlockChanged()
+{
+    int id = processingBlockCombo_.getSelectedId();
+    if (id < 1) return;
+
+    if (id - 2 >= static_cast<int>(std::size(kProcessingBlockSizes)))
+        return;  // Custom size entry: already applied
+
+    engine_.setProcessingBlockSize(id == 1 ? 0 : kProcessingBlockSizes[id - 2]);
+    updateLatencyDisplay();
+
+    if (onSettingsChanged) onSettingsChanged();
+}
+
 void AudioSettings::onChannelModeChanged()
 {
     int channels = stereoButton_.getToggleState() ? 2 : 1;
@@ -700,18 +732,40 @@ void AudioSettings::rebuildBufferSizeList()
     }
 }
 
+void AudioSettings::syncProcessingBlockCombo()
+{
+    const int size = engine_.getProcessingBlockSize();
+    int id = 1;
+    for (int i = 0; i < static_cast<int>(std::size(kProcessingBlockSizes)); ++i)
+        if (kProcessingBlockSizes[i] == size)
+            id = i + 2;
+
+    // A size from a hand-edited settings file gets its own entry
+    const int customId = static_cast<int>(std::size(kProcessingBlockSizes)) + 2;
+    if (processingBlockCombo_.indexOfItemId(customId) >= 0)
+        processingBlockCombo_.changeItemText(customId, juce::String(size) + " samples");
+    if (id == 1 && size > 0) {
+        if (processingBlockCombo_.indexOfItemId(customId) < 0)
+            processingBlockCombo_.addItem(juce::String(size) + " samples", customId);
+        id = customId;
+    }
+    processingBlockCombo_.setSelectedId(id, juce::dontSendNotification);
+}
+
 void AudioSettings::updateLatencyDisplay()
 {
     auto& monitor = engine_.getLatencyMonitor();
     double sr = monitor.getSampleRate();
     int bs = monitor.getBufferSize();
+    int adapter = monitor.getBlockAdapterLatencySamples();
 
     if (sr > 0.0) {
-        double latencyMs = (static_cast<double>(bs) / sr) * 1000.0 * 2.0;
-        latencyValueLabel_.setText(
-            juce::String(latencyMs, 2) + " ms  (" + juce::String(bs) + " samples @ "
-                + juce::String(static_cast<int>(sr)) + " Hz)",
-            juce::dontSendNotification);
+        double latencyMs = (static_cast<double>(bs) / sr) * 1000.0 * 2.0 + monitor.getBlockAdapterLatencyMs();
+        juce::String detail = juce::String(bs) + " samples @ " + juce::String(static_cast<int>(sr)) + " Hz";
+        if (adapter > 0)
+            detail += ", +" + juce::String(adapter) + " block";
+        latencyValueLabel_.setText(juce::String(latencyMs, 2) + " ms  (" + detail + ")",
+                                   juce::dontSendNotification);
     } else {
         latencyValueLabel_.setText("-- ms", juce::dontSendNotification);
     }
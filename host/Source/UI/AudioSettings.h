@@ -21,7 +21,7 @@
  * @brief Unified audio I/O configuration panel
  *
  * Combines driver type selection (ASIO/WASAPI), input/output device selection,
- * sample rate, buffer size, channel mode, and latency display
+ * sample rate, buffer size, processing block size, channel mode, and latency display
  * into a single cohesive panel.
  */
 #pragma once
@@ -80,6 +80,7 @@ private:
     void onOutputChannelChanged();
     void onSampleRateChanged();
     void onBufferSizeChanged();
+    void onProcessingBlockChanged();
     void onChannelModeChanged();
     void onOutputVolumeChanged();
 
@@ -88,6 +89,7 @@ private:
     void rebuildChannelLists();
     void rebuildSampleRateList();
     void rebuildBufferSizeList();
+    void syncProcessingBlockCombo();
     void updateLatencyDisplay();
     void updateChannelModeDescription();
 
@@ -123,6 +125,11 @@ private:
     juce::Label bufferSizeLabel_{"", "Buffer Size:"};
     juce::ComboBox bufferSizeCombo_;
 
+    // Processing block size (plugin chain quantum; "Device" = buffer size)
+    juce::Label processingBlockLabel_{"", "Process Block:"};
+    juce::ComboBox processingBlockCombo_;
+    static constexpr int kProcessingBlockSizes[] = { 128, 256, 480 };
+
     // Channel mode
     juce::Label channelModeLabel_{"", "Channel Mode:"};
     juce::ToggleButton monoButton_{"Mono"};
@@ -93,6 +93,18 @@ OutputPanel::OutputPanel(AudioEngine& engine)
     ipcInfoLabel_.setColour(juce::Label::textColourId, juce::Colour(kDimTextColour));
     addAndMakeVisible(ipcInfoLabel_);
 
+    // Extra streams, selectable in the Receiver (tap index = AudioEngine::IpcTap)
+    int tapIndex = 0;
+    for (auto* tapToggle : { &ipcInputTapToggle_, &ipcPostChainTapToggle_ }) {
+        tapToggle->setColour(juce::ToggleButton::textColourId, juce::Colour(kDimTextColour));
+        tapToggle->setColour(juce::ToggleButton::tickColourId, juce::Colour(kAccentColour));
+        tapToggle->onClick = [this, tapToggle, tapIndex] {
+            if (onIpcTapToggle) onIpcTapToggle(tapIndex, tapToggle->getToggleState());
+        };
+        addAndMakeVisible(*tapToggle);
+        ++tapIndex;
+    }
+
     // ── Recording section ──
     recordingTitleLabel_.setFont(juce::Font(16.0f, juce::Font::bold));
     recordingTitleLabel_.setColour(juce::Label::textColourId, juce::Colour(kTextColour));
@@ -245,7 +257,12 @@ void OutputPanel::resized()
     y += rowH + gap;
 
     ipcInfoLabel_.setBounds(x, y, w, 18);
-    y += 24;
+    y += 20;
+
+    ipcInputTapToggle_.setBounds(x, y, w, rowH);
+    y += rowH;
+    ipcPostChainTapToggle_.setBounds(x, y, w, rowH);
+    y += rowH + 4;
 
     separatorY2_ = y - 4;
 
@@ -512,4 +529,10 @@ void OutputPanel::setIpcToggleState(bool enabled)
     ipcToggle_.setToggleState(enabled, juce::dontSendNotification);
 }
 
+void OutputPanel::setIpcTapToggleState(int tap, bool enabled)
+{
+    auto& toggle = tap == 0 ? ipcInputTapToggle_ : ipcPostChainTapToggle_;
+    toggle.setToggleState(enabled, juce::dontSendNotification);
+}
+
 } // namespace directpipe
@@ -44,6 +44,8 @@ public:
     std::function<void()> onSettingsChanged;
     std::function<void()> onRecordToggle;
     std::function<void(bool)> onIpcToggle;
+    /** Extra Receiver stream toggled: tap index (AudioEngine::IpcTap), enabled. */
+    std::function<void(int, bool)> onIpcTapToggle;
 
     /** Called when a monitor operation fails (message suitable for NotificationBar). */
     std::function<void(const juce::String&)> onError;
@@ -51,6 +53,9 @@ public:
     /** Set the IPC toggle state externally (e.g., when loading settings). */
     void setIpcToggleState(bool enabled);
 
+    /** Set an extra Receiver stream toggle externally (tap index as in AudioEngine::IpcTap). */
+    void setIpcTapToggleState(int tap, bool enabled);
+
     /** Update recording state display (called from MainComponent timer). */
     void updateRecordingState(bool isRecording, double seconds);
 
@@ -99,6 +104,8 @@ private:
     juce::Label ipcHeaderLabel_{"", "VST Receiver (DirectPipe Receiver)"};
     juce::ToggleButton ipcToggle_{"Enable VST Receiver Output"};
     juce::Label ipcInfoLabel_{"", "Send processed audio to DirectPipe Receiver VST plugin."};
+    juce::ToggleButton ipcInputTapToggle_{"Also publish raw input stream"};
+    juce::ToggleButton ipcPostChainTapToggle_{"Also publish post-chain stream (pre-limiter)"};
 
     // ── Recording section ──
     juce::Label recordingTitleLabel_{"", "Recording"};
@@ -33,6 +33,7 @@ PluginChainEditor::PluginRowComponent::PluginRowComponent(
     : owner_(owner), rowIndex_(rowIndex)
 {
     addAndMakeVisible(nameLabel_);
+    addAndMakeVisible(cpuLabel_);
     addAndMakeVisible(editButton_);
     addAndMakeVisible(bypassButton_);
     addAndMakeVisible(removeButton_);
@@ -40,6 +41,11 @@ PluginChainEditor::PluginRowComponent::PluginRowComponent(
     nameLabel_.setColour(juce::Label::textColourId, juce::Colours::white);
     nameLabel_.setInterceptsMouseClicks(false, false);
 
+    cpuLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
+    cpuLabel_.setFont(juce::Font(10.0f));
+    cpuLabel_.setJustificationType(juce::Justification::centredRight);
+    cpuLabel_.setInterceptsMouseClicks(false, false);
+
     editButton_.onClick = [this] {
         owner_.vstChain_.openPluginEditor(rowIndex_, &owner_);
     };
@@ -103,6 +109,7 @@ void PluginChainEditor::PluginRowComponent::resized()
     bounds.removeFromRight(gap);
     editButton_.setBounds(bounds.removeFromRight(40));
     bounds.removeFromRight(gap);
+    cpuLabel_.setBounds(bounds.removeFromRight(90));
     nameLabel_.setBounds(bounds);
 }
 
@@ -127,6 +134,13 @@ void PluginChainEditor::PluginRowComponent::update(int newRowIndex)
     }
 }
 
+void PluginChainEditor::PluginRowComponent::setTiming(const juce::String& text, bool overBudget)
+{
+    cpuLabel_.setColour(juce::Label::textColourId,
+                        overBudget ? juce::Colour(0xFFFF6B6B) : juce::Colour(0xFF8888AA));
+    cpuLabel_.setText(text, juce::dontSendNotification);
+}
+
 void PluginChainEditor::PluginRowComponent::mouseDown(const juce::MouseEvent& /*e*/)
 {
     owner_.pluginList_.selectRow(rowIndex_);
@@ -240,6 +254,18 @@ PluginChainEditor::PluginChainEditor(VSTChain& vstChain)
     };
     addAndMakeVisible(safetyHeadroomSlider_);
 
+    // Per-plugin CPU time readout on/off (timing costs one atomic load per plugin when off)
+    cpuTimingButton_.setColour(juce::ToggleButton::textColourId, juce::Colour(0xFFE0E0E0));
+    cpuTimingButton_.setColour(juce::ToggleButton::tickColourId, juce::Colour(0xFF7B6FFF));
+    cpuTimingButton_.setToggleState(vstChain_.isPluginTimingEnabled(), juce::dontSendNotification);
+    cpuTimingButton_.setTooltip("Measure each plugin's processing time (mean / p99 per block)");
+    cpuTimingButton_.onClick = [this] {
+        vstChain_.setPluginTimingEnabled(cpuTimingButton_.getToggleState());
+        timingTicks_ = 0;
+        updatePluginTimings();
+    };
+    addAndMakeVisible(cpuTimingButton_);
+
     addAndMakeVisible(addButton_);
     addAndMakeVisible(scanButton_);
     addAndMakeVisible(removeButton_);
@@ -313,6 +339,32 @@ void PluginChainEditor::setLimiterGR(float dB)
         limiterGRLabel_.setText("", juce::dontSendNotification);
 }
 
+void PluginChainEditor::updatePluginTimings()
+{
+    const bool enabled = vstChain_.isPluginTimingEnabled();
+    if (cpuTimingButton_.getToggleState() != enabled)
+        cpuTimingButton_.setToggleState(enabled, juce::dontSendNotification);
+
+    // ~2 Hz at the 30 Hz UI timer
+    if (timingTicks_++ % 15 != 0)
+        return;
+
+    const auto timings = enabled ? vstChain_.getPluginTimings() : std::vector<PluginTimingInfo>{};
+    for (int i = 0; i < getNumRows(); ++i) {
+        auto* row = dynamic_cast<PluginRowComponent*>(pluginList_.getComponentForRowNumber(i));
+        if (row == nullptr)
+            continue;
+        if (static_cast<size_t>(i) >= timings.size() || timings[static_cast<size_t>(i)].blocks == 0) {
+            row->setTiming({}, false);
+            continue;
+        }
+        const auto& t = timings[static_cast<size_t>(i)];
+        // Mean share of the block period, then p99 in microseconds
+        row->setTiming(juce::String(t.budgetPercent, 1) + "% / " + juce::String(juce::roundToInt(t.p99Us)) + "us",
+                       t.budgetPercent >= 50.0f);
+    }
+}
+
 void PluginChainEditor::hideLoadingState()
 {
     loading_ = false;
@@ -345,6 +397,8 @@ void PluginChainEditor::resized()
     safetyVolumeButton_.setBounds(headroomBar.getX(), headroomBar.getY(), toggleW, headroomBar.getHeight());
     safetyHeadroomSlider_.setBounds(headroomBar.getX() + toggleW, headroomBar.getY(),
                                     headroomSliderW, headroomBar.getHeight());
+    cpuTimingButton_.setBounds(headroomBar.getX() + toggleW + headroomSliderW, headroomBar.getY(),
+                               grLabelW, headroomBar.getHeight());
 
     int gap = 4;
     int btnW = (buttonBar.getWidth() - gap * 2) / 3;
@@ -92,6 +92,13 @@ public:
     /** @brief Update limiter gain reduction display (called from timer). */
     void setLimiterGR(float dB);
 
+    /**
+     * @brief Refresh each row's CPU time readout and the CPU toggle (called from timer).
+     *
+     * Rows are only rewritten every few calls so the numbers stay readable.
+     */
+    void updatePluginTimings();
+
 private:
     bool loading_ = false;
     friend class PluginRowComponent;
@@ -110,6 +117,8 @@ private:
     juce::Label limiterGRLabel_;
     juce::ToggleButton safetyVolumeButton_{"Safety Volume"};
     juce::Slider safetyHeadroomSlider_;
+    juce::ToggleButton cpuTimingButton_{"CPU"};
+    int timingTicks_ = 0;
     juce::TextButton addButton_{"+ Add Plugin"};
     juce::TextButton scanButton_{"Scan..."};
     juce::TextButton removeButton_{"Remove"};
@@ -125,6 +134,9 @@ private:
         void paint(juce::Graphics& g) override;
         void update(int newRowIndex);
 
+        /** @brief Show this plugin's processing time (empty text hides it). */
+        void setTiming(const juce::String& text, bool overBudget);
+
         // Mouse handling for row selection and drag initiation
         void mouseDown(const juce::MouseEvent& e) override;
         void mouseDrag(const juce::MouseEvent& e) override;
@@ -141,6 +153,7 @@ private:
         bool dragOver_ = false;
 
         juce::Label nameLabel_;
+        juce::Label cpuLabel_;
         juce::TextButton editButton_{"Edit"};
         juce::ToggleButton bypassButton_{"Bypass"};
         juce::TextButton removeButton_{"X"};
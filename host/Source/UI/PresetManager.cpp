@@ -135,6 +135,7 @@ juce::String PresetManager::exportToJSON()
     // Audio settings (use desired values to survive driver fallback)
     root->setProperty("sampleRate", engine_.getDesiredSampleRate());
     root->setProperty("bufferSize", engine_.getDesiredBufferSize());
+    root->setProperty("processingBlockSize", engine_.getProcessingBlockSize());
     root->setProperty("inputGain", static_cast<double>(engine_.getInputGain()));
     root->setProperty("muted", engine_.isMuted());
 
@@ -209,6 +210,8 @@ juce::String PresetManager::exportToJSON()
 
     // IPC output
     root->setProperty("ipcEnabled", engine_.isIpcEnabled());
+    root->setProperty("ipcInputStream", engine_.isIpcTapEnabled(AudioEngine::IpcTap::Input));
+    root->setProperty("ipcPostChainStream", engine_.isIpcTapEnabled(AudioEngine::IpcTap::PostChain));
 
     // Output mute state (don't persist auto-mute from device loss)
     root->setProperty("outputMuted", engine_.isOutputAutoMuted() ? false : engine_.isOutputMuted());
@@ -258,6 +261,11 @@ bool PresetManager::importFromJSON(const juce::String& json)
             engine_.presetAudioParams(sr, bs);
     }
 
+    // Fixed processing block size (missing key = follow the device). Before the
+    // device type switch, so the chain is prepared with it from the start.
+    engine_.setProcessingBlockSize(root->hasProperty("processingBlockSize")
+                                       ? static_cast<int>(root->getProperty("processingBlockSize")) : 0);
+
     // Restore device type first (affects which devices are available).
     // For ASIO, provide saved device name to avoid opening the wrong device.
     // Skip if the saved device type doesn't exist on this platform (cross-platform safety).
@@ -438,7 +446,11 @@ bool PresetManager::importFromJSON(const juce::String& json)
     if (root->hasProperty("channelMode"))
         engine_.setChannelMode(static_cast<int>(root->getProperty("channelMode")));
 
-    // IPC output
+    // IPC output (extra streams first, so enabling IPC starts them too)
+    if (root->hasProperty("ipcInputStream"))
+        engine_.setIpcTapEnabled(AudioEngine::IpcTap::Input, static_cast<bool>(root->getProperty("ipcInputStream")));
+    if (root->hasProperty("ipcPostChainStream"))
+        engine_.setIpcTapEnabled(AudioEngine::IpcTap::PostChain, static_cast<bool>(root->getProperty("ipcPostChainStream")));
     if (root->hasProperty("ipcEnabled"))
         engine_.setIpcEnabled(static_cast<bool>(root->getProperty("ipcEnabled")));
 
@@ -560,7 +572,7 @@ bool PresetManager::isSameChain(const std::vector<TargetPlugin>& targets, VSTCha
 
 void PresetManager::applyFastPath(const std::vector<TargetPlugin>& targets, VSTChain& chain)
 {
-    // Suspend graph processing to prevent audio thread from calling processBlock
+    // Suspend chain processing to prevent audio thread from calling processBlock
     // while we modify plugin state via setStateInformation (not thread-safe)
     chain.suspendProcessing(true);
 
@@ -262,6 +262,47 @@ void StatusUpdater::tick(PresetManager* pm, int numPresetSlots)
         s.ipcEnabled = engine_.isIpcEnabled();
         s.xrunCount = engine_.getRecentXRunCount();
 
+        directpipe::ConsumerStatsSnapshot ipcStats[directpipe::MAX_CONSUMERS];
+        const uint32_t ipcConsumers = engine_.getIpcConsumerStats(ipcStats, directpipe::MAX_CONSUMERS);
+        s.ipcConsumers.clear();
+        for (uint32_t i = 0; i < ipcConsumers; ++i) {
+            const auto& in = ipcStats[i];
+            AppState::IpcConsumerState c;
+            c.slot = static_cast<int>(in.slot);
+            c.blocks = in.blocks;
+            c.underruns = in.underruns;
+            c.framesPadded = in.frames_padded;
+            c.framesSkipped = in.frames_skipped;
+            c.framesConcealed = in.frames_concealed;
+            c.fillFrames = static_cast<int>(in.fill_frames);
+            c.resampleRatio = in.resample_ratio_micros / 1e6;
+            c.processUs = static_cast<float>(in.process_ns) / 1000.0f;
+            c.processPeakUs = static_cast<float>(in.process_peak_ns) / 1000.0f;
+            c.latencyMs = static_cast<float>(in.latency_us) / 1000.0f;
+            std::copy(std::begin(in.fill_histogram), std::end(in.fill_histogram), c.fillHistogram.begin());
+            s.ipcConsumers.push_back(c);
+        }
+        s.ipcDroppedFrames = engine_.getIpcDroppedFrames();
+        s.ipcOverwrittenFrames = engine_.getIpcOverwrittenFrames();
+
+        // Callback stage histograms: the RT thread only counts, the
+        // percentiles are worked out here
+        std::array<directpipe::StageTimingSnapshot, directpipe::kNumCallbackStages> stages;
+        monitor.getStageTimings(stages);
+        s.callbackStages.clear();
+        for (int i = 0; i < directpipe::kNumCallbackStages; ++i) {
+            const auto& in = stages[static_cast<size_t>(i)];
+            AppState::CallbackStageState st;
+            st.name = directpipe::callbackStageName(static_cast<directpipe::CallbackStage>(i));
+            st.count = in.count;
+            st.meanUs = static_cast<float>(in.meanUs());
+            st.p50Us = static_cast<float>(in.percentileUs(0.50));
+            st.p99Us = static_cast<float>(in.percentileUs(0.99));
+            st.maxUs = static_cast<float>(in.maxNs) / 1000.0f;
+            st.histogram = in.histogram;
+            s.callbackStages.push_back(std::move(st));
+        }
+
         auto& limiter = engine_.getSafetyLimiter();
         s.limiterEnabled = limiter.isEnabled();
         s.limiterCeilingdB = limiter.getCeilingdB();
@@ -275,6 +316,7 @@ void StatusUpdater::tick(PresetManager* pm, int numPresetSlots)
 
         s.plugins.clear();
         auto latencies = chain.getPluginLatencies();
+        auto timings = chain.getPluginTimings();
         for (int i = 0; i < chain.getPluginCount(); ++i) {
             auto* slot = chain.getPluginSlot(i);
             if (slot) {
@@ -284,6 +326,13 @@ void StatusUpdater::tick(PresetManager* pm, int numPresetSlots)
                 ps.loaded = (slot->getProcessor() != nullptr);
                 ps.latencySamples = (static_cast<size_t>(i) < latencies.size())
                     ? latencies[static_cast<size_t>(i)].latencySamples : 0;
+                if (static_cast<size_t>(i) < timings.size()) {
+                    const auto& t = timings[static_cast<size_t>(i)];
+                    ps.cpuMeanUs = t.meanUs;
+                    ps.cpuP99Us = t.p99Us;
+                    ps.cpuMaxUs = t.maxUs;
+                    ps.cpuPercent = t.budgetPercent;
+                }
                 // Map slot type to string
                 switch (slot->type) {
                     case PluginSlot::Type::BuiltinFilter: ps.type = "builtin_filter"; break;
@@ -2,11 +2,13 @@
 // Copyright (C) 2025 LiveTrack
 
 #include "PluginEditor.h"
+#include <cmath>
 
 DirectPipeReceiverEditor::DirectPipeReceiverEditor(DirectPipeReceiverProcessor& p)
     : AudioProcessorEditor(p)
     , processor_(p)
     , muteAttachment_(*p.getAPVTS().getParameter("mute"), muteButton_, nullptr)
+    , concealAttachment_(*p.getAPVTS().getParameter("conceal"), concealButton_, nullptr)
 {
     setSize(kWidth, kHeight);
 
@@ -23,6 +25,7 @@ DirectPipeReceiverEditor::DirectPipeReceiverEditor(DirectPipeReceiverProcessor&
     bufferCombo_.addItem("Medium (1024)", 3);
     bufferCombo_.addItem("High (2048)", 4);
     bufferCombo_.addItem("Safe (4096)", 5);
+    bufferCombo_.addItem("Auto", 6);
     bufferCombo_.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF2A2A40));
     bufferCombo_.setColour(juce::ComboBox::textColourId, juce::Colours::white);
     bufferCombo_.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xFF3A3A5A));
@@ -32,6 +35,53 @@ DirectPipeReceiverEditor::DirectPipeReceiverEditor(DirectPipeReceiverProcessor&
     bufferAttachment_ = std::make_unique<juce::ComboBoxParameterAttachment>(
         *p.getAPVTS().getParameter("buffer"), bufferCombo_, nullptr);
 
+    // Auto buffer underrun budget — same order as the "autoBudget" choices
+    autoBudgetCombo_.addItem("Strict (0.001%)", 1);
+    autoBudgetCombo_.addItem("Normal (0.01%)", 2);
+    autoBudgetCombo_.addItem("Relaxed (0.1%)", 3);
+    autoBudgetCombo_.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF2A2A40));
+    autoBudgetCombo_.setColour(juce::ComboBox::textColourId, juce::Colours::white);
+    autoBudgetCombo_.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xFF3A3A5A));
+    addAndMakeVisible(autoBudgetCombo_);
+    autoBudgetAttachment_ = std::make_unique<juce::ComboBoxParameterAttachment>(
+        *p.getAPVTS().getParameter("autoBudget"), autoBudgetCombo_, nullptr);
+
+    autoBudgetLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
+    autoBudgetLabel_.setFont(juce::Font(12.0f));
+    addAndMakeVisible(autoBudgetLabel_);
+
+    // Resampling quality combo — same order as directpipe::ResamplerQuality
+    qualityCombo_.addItem("Low CPU (cubic)", 1);
+    qualityCombo_.addItem("Medium (16-tap)", 2);
+    qualityCombo_.addItem("High (32-tap)", 3);
+    qualityCombo_.addItem("Best (64-tap)", 4);
+    qualityCombo_.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF2A2A40));
+    qualityCombo_.setColour(juce::ComboBox::textColourId, juce::Colours::white);
+    qualityCombo_.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xFF3A3A5A));
+    addAndMakeVisible(qualityCombo_);
+    qualityAttachment_ = std::make_unique<juce::ComboBoxParameterAttachment>(
+        *p.getAPVTS().getParameter("quality"), qualityCombo_, nullptr);
+
+    qualityLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
+    qualityLabel_.setFont(juce::Font(12.0f));
+    addAndMakeVisible(qualityLabel_);
+
+    // Dropout concealment toggle — off falls back to a short fade to silence
+    concealButton_.setClickingTogglesState(true);
+    concealButton_.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFF4CAF50));
+    concealButton_.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF2A2A40));
+    concealButton_.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+    concealButton_.setColour(juce::TextButton::textColourOffId, juce::Colours::white);
+    addAndMakeVisible(concealButton_);
+
+    concealLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
+    concealLabel_.setFont(juce::Font(12.0f));
+    addAndMakeVisible(concealLabel_);
+
+    concealedLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
+    concealedLabel_.setFont(juce::Font(10.0f));
+    addAndMakeVisible(concealedLabel_);
+
     bufferLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
     bufferLabel_.setFont(juce::Font(12.0f));
     addAndMakeVisible(bufferLabel_);
@@ -44,9 +94,29 @@ DirectPipeReceiverEditor::DirectPipeReceiverEditor(DirectPipeReceiverProcessor&
     srWarningLabel_.setFont(juce::Font(10.0f));
     addAndMakeVisible(srWarningLabel_);
 
-    multiConsumerLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFFFF4444));
-    multiConsumerLabel_.setFont(juce::Font(10.0f, juce::Font::bold));
-    addAndMakeVisible(multiConsumerLabel_);
+    driftLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
+    driftLabel_.setFont(juce::Font(10.0f));
+    addAndMakeVisible(driftLabel_);
+
+    slotsFullLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFFFF4444));
+    slotsFullLabel_.setFont(juce::Font(10.0f, juce::Font::bold));
+    addAndMakeVisible(slotsFullLabel_);
+
+    // Stream selector — one entry per stream in the host's stream directory
+    streamCombo_.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF2A2A40));
+    streamCombo_.setColour(juce::ComboBox::textColourId, juce::Colours::white);
+    streamCombo_.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xFF3A3A5A));
+    streamCombo_.onChange = [this] {
+        const int idx = streamCombo_.getSelectedItemIndex();
+        if (idx >= 0 && idx < streamIds_.size() && streamIds_[idx] != processor_.getStreamId())
+            processor_.setStreamId(streamIds_[idx]);
+    };
+    addAndMakeVisible(streamCombo_);
+
+    streamLabel_.setColour(juce::Label::textColourId, juce::Colour(0xFF8888AA));
+    streamLabel_.setFont(juce::Font(12.0f));
+    addAndMakeVisible(streamLabel_);
+    refreshStreamList();
 
     startTimerHz(10);
 }
@@ -109,20 +179,83 @@ void DirectPipeReceiverEditor::resized()
     muteButton_.setBounds(bounds.getX(), y, bounds.getWidth(), 32);
     y += 40;
 
-    // Buffer selector row
+    // Stream selector row
     int labelW = 50;
+    streamLabel_.setBounds(bounds.getX(), y, labelW, 24);
+    streamCombo_.setBounds(bounds.getX() + labelW + 4, y, bounds.getWidth() - labelW - 4, 24);
+    y += 28;
+
+    // Buffer selector row
     bufferLabel_.setBounds(bounds.getX(), y, labelW, 24);
     bufferCombo_.setBounds(bounds.getX() + labelW + 4, y, bounds.getWidth() - labelW - 4, 24);
     y += 26;
     bufferLatencyLabel_.setBounds(bounds.getX() + labelW + 4, y, bounds.getWidth() - labelW - 4, 14);
     y += 16;
+    driftLabel_.setBounds(bounds.getX() + labelW + 4, y, bounds.getWidth() - labelW - 4, 14);
+    y += 16;
+
+    // Auto buffer budget row
+    autoBudgetLabel_.setBounds(bounds.getX(), y, labelW, 24);
+    autoBudgetCombo_.setBounds(bounds.getX() + labelW + 4, y, bounds.getWidth() - labelW - 4, 24);
+    y += 28;
+
+    // Resampling quality row
+    qualityLabel_.setBounds(bounds.getX(), y, labelW, 24);
+    qualityCombo_.setBounds(bounds.getX() + labelW + 4, y, bounds.getWidth() - labelW - 4, 24);
+    y += 28;
+
+    // Dropout concealment row: toggle + concealed-time readout
+    concealLabel_.setBounds(bounds.getX(), y, labelW, 24);
+    concealButton_.setBounds(bounds.getX() + labelW + 4, y, 72, 24);
+    concealedLabel_.setBounds(bounds.getX() + labelW + 80, y, bounds.getWidth() - labelW - 80, 24);
+    y += 28;
     srWarningLabel_.setBounds(bounds.getX(), y, bounds.getWidth(), 14);
     y += 16;
-    multiConsumerLabel_.setBounds(bounds.getX(), y, bounds.getWidth(), 14);
+    slotsFullLabel_.setBounds(bounds.getX(), y, bounds.getWidth(), 14);
+}
+
+void DirectPipeReceiverEditor::refreshStreamList()
+{
+    directpipe::StreamInfo streams[directpipe::MAX_STREAMS];
+    const uint32_t count = processor_.listStreams(streams, directpipe::MAX_STREAMS);
+
+    // The main stream is always selectable (fixed name, no directory needed)
+    juce::StringArray ids{ directpipe::MAIN_STREAM_ID };
+    juce::StringArray labels{ "Main output" };
+    for (uint32_t i = 0; i < count; ++i) {
+        const juce::String id(streams[i].id);
+        if (id == directpipe::MAIN_STREAM_ID)
+            continue;
+        ids.add(id);
+        labels.add(juce::String(streams[i].description).isNotEmpty()
+                       ? juce::String(streams[i].description) : id);
+    }
+
+    // Keep a saved selection visible while its host is not running
+    const juce::String selected = processor_.getStreamId();
+    if (!ids.contains(selected)) {
+        ids.add(selected);
+        labels.add(selected + " (offline)");
+    }
+
+    if (ids == streamIds_ && streamCombo_.getNumItems() == labels.size())
+        return;
+
+    streamIds_ = ids;
+    streamCombo_.clear(juce::dontSendNotification);
+    for (int i = 0; i < labels.size(); ++i)
+        streamCombo_.addItem(labels[i], i + 1);
+    streamCombo_.setSelectedItemIndex(streamIds_.indexOf(selected), juce::dontSendNotification);
 }
 
 void DirectPipeReceiverEditor::timerCallback()
 {
+    // Stream directory changes rarely — poll it once a second
+    if (++streamRefreshCounter_ >= 10) {
+        streamRefreshCounter_ = 0;
+        refreshStreamList();
+    }
+
     bool connected = processor_.isConnected();
     uint32_t sr = processor_.getSourceSampleRate();
     uint32_t ch = processor_.getSourceChannels();
@@ -135,46 +268,85 @@ void DirectPipeReceiverEditor::timerCallback()
         repaint();
     }
 
-    // Update buffer latency display based on host sample rate
-    // (host SR is always known; source SR may be 0 when disconnected)
+    // Update buffer latency display. The buffer holds source-rate frames, so
+    // use the source SR when connected, else the host (DAW) SR as an estimate.
+    // In Auto the target moves on its own — show the value it has settled on.
     int bufIdx = bufferCombo_.getSelectedItemIndex();
     uint32_t hostSr = static_cast<uint32_t>(processor_.getSampleRate());
-    if (bufIdx != lastBufferIdx_ || srChanged || hostSr != lastHostSr_) {
+    const bool autoBuffer = processor_.isAutoBuffer();
+    const uint32_t samples = processor_.getTargetFillFrames();
+    const uint32_t autoUnderruns = processor_.getAutoUnderruns();
+    if (bufIdx != lastBufferIdx_ || srChanged || hostSr != lastHostSr_
+        || samples != lastTargetFrames_ || autoUnderruns != lastAutoUnderruns_) {
         lastBufferIdx_ = bufIdx;
         lastHostSr_ = hostSr;
-        uint32_t samples = processor_.getTargetFillFrames();
-        if (hostSr > 0 && samples > 0) {
-            double ms = (static_cast<double>(samples) / static_cast<double>(hostSr)) * 1000.0;
-            bufferLatencyLabel_.setText(
-                juce::String(ms, 2) + " ms  (" + juce::String(samples) + " samples @ "
-                    + juce::String(hostSr) + " Hz)",
-                juce::dontSendNotification);
+        lastTargetFrames_ = samples;
+        lastAutoUnderruns_ = autoUnderruns;
+        autoBudgetCombo_.setEnabled(autoBuffer);
+        uint32_t bufferSr = sr > 0 ? sr : hostSr;
+        if (bufferSr > 0 && samples > 0) {
+            double ms = (static_cast<double>(samples) / static_cast<double>(bufferSr)) * 1000.0;
+            juce::String text = juce::String(ms, 2) + " ms  (" + juce::String(samples) + " samples";
+            if (autoBuffer)
+                text = "Auto: " + text + ", " + juce::String(autoUnderruns) + " underruns)";
+            else
+                text += " @ " + juce::String(bufferSr) + " Hz)";
+            bufferLatencyLabel_.setText(text, juce::dontSendNotification);
         } else {
             bufferLatencyLabel_.setText("", juce::dontSendNotification);
         }
     }
 
-    // Multi-consumer warning (SPSC violation — another Receiver is already reading)
-    bool multiConsumer = processor_.hasMultiConsumerWarning();
-    if (multiConsumer != lastMultiConsumer_) {
-        lastMultiConsumer_ = multiConsumer;
-        if (multiConsumer)
-            multiConsumerLabel_.setText(
-                "WARNING: Another Receiver is active — audio may be corrupted",
+    // Drift compensation: resample ratio as a ppm offset (whole ppm is plenty)
+    const int driftPpm = static_cast<int>(std::lround((processor_.getResampleRatio() - 1.0) * 1.0e6));
+    if (connected != lastDriftShown_ || driftPpm != lastDriftPpm_) {
+        lastDriftShown_ = connected;
+        lastDriftPpm_ = driftPpm;
+        if (connected)
+            driftLabel_.setText(
+                "Drift comp: " + juce::String(driftPpm > 0 ? "+" : "") + juce::String(driftPpm) + " ppm",
+                juce::dontSendNotification);
+        else
+            driftLabel_.setText("", juce::dontSendNotification);
+    }
+
+    // Dropout concealment: total audio filled in so far (DAW-rate frames)
+    const uint64_t concealedFrames = processor_.getConcealedFrames();
+    if (concealedFrames != lastConcealedFrames_) {
+        lastConcealedFrames_ = concealedFrames;
+        if (hostSr > 0)
+            concealedLabel_.setText(
+                "Concealed: " + juce::String(static_cast<double>(concealedFrames) * 1000.0 / hostSr, 1) + " ms",
                 juce::dontSendNotification);
         else
-            multiConsumerLabel_.setText("", juce::dontSendNotification);
+            concealedLabel_.setText("", juce::dontSendNotification);
     }
 
-    // SR mismatch warning (source vs host)
-    bool mismatch = connected && sr > 0 && hostSr > 0 && sr != hostSr;
-    if (mismatch != lastSrMismatch_) {
-        lastSrMismatch_ = mismatch;
-        if (mismatch)
-            srWarningLabel_.setText(
-                "SR mismatch: " + juce::String(sr) + " vs " + juce::String(hostSr),
+    // Consumer table full (too many Receivers attached to the same DirectPipe)
+    bool slotsFull = processor_.hasSlotsFullWarning();
+    if (slotsFull != lastSlotsFull_) {
+        lastSlotsFull_ = slotsFull;
+        if (slotsFull)
+            slotsFullLabel_.setText(
+                "WARNING: All " + juce::String(directpipe::MAX_CONSUMERS)
+                    + " Receiver slots in use — not connected",
                 juce::dontSendNotification);
         else
-            srWarningLabel_.setText("", juce::dontSendNotification);
+            slotsFullLabel_.setText("", juce::dontSendNotification);
+    }
+
+    // Source vs DAW rate: converted by the resampler; only absurd pairs are flagged
+    juce::String srText;
+    bool srUnsupported = false;
+    if (connected && sr > 0 && hostSr > 0 && sr != hostSr) {
+        srUnsupported = static_cast<double>(sr) / static_cast<double>(hostSr)
+                        > DirectPipeReceiverProcessor::kMaxRateRatio;
+        srText = (srUnsupported ? "Unsupported SR pair: " : "Resampling ")
+                 + juce::String(sr) + " -> " + juce::String(hostSr) + " Hz";
+    }
+    if (srText != srWarningLabel_.getText()) {
+        srWarningLabel_.setColour(juce::Label::textColourId,
+                                  srUnsupported ? juce::Colour(0xFFCC8844) : juce::Colour(0xFF8888AA));
+        srWarningLabel_.setText(srText, juce::dontSendNotification);
     }
 }
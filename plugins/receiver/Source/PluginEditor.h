@@ -16,6 +16,13 @@ public:
 
 private:
     void timerCallback() override;
+    void refreshStreamList();
+
+    /// Stream ids in combo order (item id = index + 1)
+    juce::StringArray streamIds_;
+    int streamRefreshCounter_ = 0;
+    juce::ComboBox streamCombo_;
+    juce::Label streamLabel_{"", "Stream:"};
 
     DirectPipeReceiverProcessor& processor_;
 
@@ -26,19 +33,36 @@ private:
     std::unique_ptr<juce::ComboBoxParameterAttachment> bufferAttachment_;
     juce::Label bufferLabel_{"", "Buffer:"};
     juce::Label bufferLatencyLabel_;
-    juce::Label srWarningLabel_;
-    juce::Label multiConsumerLabel_;  // SPSC violation warning
+
+    juce::ComboBox autoBudgetCombo_;   // Auto buffer underrun budget (enabled with "Auto")
+    std::unique_ptr<juce::ComboBoxParameterAttachment> autoBudgetAttachment_;
+    juce::Label autoBudgetLabel_{"", "Budget:"};
+
+    juce::ComboBox qualityCombo_;
+    std::unique_ptr<juce::ComboBoxParameterAttachment> qualityAttachment_;
+    juce::Label qualityLabel_{"", "SRC:"};
+    juce::TextButton concealButton_{"Conceal"};   // Dropout concealment vs fade to silence
+    juce::ButtonParameterAttachment concealAttachment_;
+    juce::Label concealLabel_{"", "Gaps:"};
+    juce::Label concealedLabel_;  // Audio concealed so far
+    juce::Label srWarningLabel_;  // Resampling info / unsupported rate pair
+    juce::Label slotsFullLabel_;  // All Receiver slots in use
+    juce::Label driftLabel_;      // Drift-compensation resample ratio
 
     bool lastConnected_ = false;
-    bool lastMultiConsumer_ = false;
+    bool lastSlotsFull_ = false;
     uint32_t lastSampleRate_ = 0;
     uint32_t lastChannels_ = 0;
     int lastBufferIdx_ = -1;
+    uint32_t lastTargetFrames_ = 0;
+    uint32_t lastAutoUnderruns_ = 0;
     uint32_t lastHostSr_ = 0;
-    bool lastSrMismatch_ = false;
+    int lastDriftPpm_ = 0;
+    bool lastDriftShown_ = false;
+    uint64_t lastConcealedFrames_ = ~0ULL;
 
     static constexpr int kWidth = 240;
-    static constexpr int kHeight = 216;
+    static constexpr int kHeight = 344;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DirectPipeReceiverEditor)
 };
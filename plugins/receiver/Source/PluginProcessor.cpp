@@ -4,18 +4,21 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <limits>
 
 DirectPipeReceiverProcessor::DirectPipeReceiverProcessor()
     : AudioProcessor(BusesProperties()
           .withOutput("Output", juce::AudioChannelSet::stereo(), true))
     , apvts_(*this, nullptr, "Parameters", createParameterLayout())
+    , connector_(apvts_.getRawParameterValue("quality"))
 {
 }
 
 DirectPipeReceiverProcessor::~DirectPipeReceiverProcessor()
 {
-    disconnect();
+    releaseConnection();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -26,18 +29,25 @@ DirectPipeReceiverProcessor::createParameterLayout()
         juce::ParameterID{"mute", 1}, "Mute", false));
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         juce::ParameterID{"buffer", 1}, "Buffer",
-        juce::StringArray{"Ultra Low (256)", "Low (512)", "Medium (1024)", "High (2048)", "Safe (4096)"},
-        1));  // default: Low (~10ms)
+        juce::StringArray{"Ultra Low (256)", "Low (512)", "Medium (1024)", "High (2048)", "Safe (4096)", "Auto"},
+        1));  // default: Low (~10ms). "Auto" is appended so saved indices keep their meaning
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"autoBudget", 1}, "Auto Buffer Underrun Budget",
+        juce::StringArray{"Strict (0.001%)", "Normal (0.01%)", "Relaxed (0.1%)"},
+        1));  // fraction of blocks Auto may let underrun — index matches kAutoBudgets
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{"quality", 1}, "Resampling Quality",
+        juce::StringArray{"Low CPU (cubic)", "Medium (16-tap)", "High (32-tap)", "Best (64-tap)"},
+        2));  // default: High — index matches directpipe::ResamplerQuality
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{"conceal", 1}, "Conceal Dropouts", true));  // off: fade to silence (pre-PLC behaviour)
     return { params.begin(), params.end() };
 }
 
-void DirectPipeReceiverProcessor::prepareToPlay(double /*sampleRate*/, int samplesPerBlock)
+void DirectPipeReceiverProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     const size_t maxCh = directpipe::DEFAULT_CHANNELS;
 
-    // Pre-allocate interleaved buffer (max block size * max channels)
-    interleavedBuffer_.resize(static_cast<size_t>(samplesPerBlock) * maxCh, 0.0f);
-
     // Pre-allocate fade-out buffer (planar: channels * blockSize)
     // Ensure at least 64 * maxCh for the fade-out tail (saveLastOutput uses min(numSamples, 64))
     size_t fadeMin = 64u * maxCh;
@@ -49,23 +59,89 @@ void DirectPipeReceiverProcessor::prepareToPlay(double /*sampleRate*/, int sampl
     fadeGain_ = 0.0f;
     blocksSinceConnect_ = 0;
 
-    reconnectCounter_ = 0;
-    tryConnect();
+    // Concealment runs on the DAW side of the resampler (output frames)
+    concealer_.prepare(sampleRate, static_cast<uint32_t>(maxCh));
+    fillController_.prepare(sampleRate);
+    rebuffering_ = false;
+
+    // Re-activated with the same rate and block size — VST3 hosts do this on
+    // every latency change: keep the connection and what Auto has learned,
+    // and pick the stream up again at its live edge
+    if (preparedBlockSize_ == samplesPerBlock && dawSampleRate_ == sampleRate) {
+        if (conn_ != nullptr)
+            resumeAtLiveEdge();
+        setLatencySamples(getReportedLatency());
+        return;
+    }
+    preparedBlockSize_ = samplesPerBlock;
+    concealedFrames_.store(0, std::memory_order_relaxed);
+
+    // Tear down the old connection first: the connector builds new ones for
+    // this rate and block size
+    releaseConnection();
+
+    // Resampler (SRC + drift): each connection's is sized for the widest
+    // supported rate ratio; larger DAW blocks are rendered in chunks.
+    // Report what the first connection will bring — the last host rate seen
+    // and the selected kernel — so adopting it does not change the latency
+    // (hosts re-activate the plugin on a latency change)
+    ReceiverConnector::Config connectorConfig;
+    connectorConfig.dawSampleRate = sampleRate;
+    connectorConfig.channels = static_cast<uint32_t>(maxCh);
+    connectorConfig.maxOutputFrames = static_cast<uint32_t>((std::max)(samplesPerBlock, 64));
+    connectorConfig.maxRatio = kMaxRateRatio * (1.0 + directpipe::FillLevelController::kMaxCorrectionPpm * 1e-6);
+    connectorConfig.maxNominalRatio = kMaxRateRatio;
+
+    dawSampleRate_ = sampleRate;
+    const uint32_t sourceRate = lastSourceRate_.load(std::memory_order_relaxed);
+    nominalRatio_ = (sourceRate > 0 && sampleRate > 0.0)
+        ? (std::min)(static_cast<double>(sourceRate) / sampleRate, kMaxRateRatio) : 1.0;
+    resamplerLatency_ = directpipe::AdaptiveResampler::latencyFramesFor(
+        static_cast<directpipe::ResamplerQuality>(getQualityIndex()), nominalRatio_, connectorConfig.maxRatio);
+    resampleRatio_.store(1.0, std::memory_order_relaxed);
+
+    // Auto buffer: learn from scratch at the Low preset, bounded by the presets
+    directpipe::JitterBufferSizer::Config sizerConfig;
+    sizerConfig.minTarget = 128;
+    sizerConfig.maxTarget = kBufferPresets[kNumBufferPresets - 1][0];
+    sizerConfig.initialTarget = kBufferPresets[1][0];
+    bufferSizer_.reset(sizerConfig);
+    appliedAutoBudget_ = -1;
+    applyAutoBudget();
+    autoTargetFrames_.store(bufferSizer_.target(), std::memory_order_relaxed);
+    autoReportedFrames_ = bufferSizer_.target();
+    autoUnderruns_.store(0, std::memory_order_relaxed);
+    stats_ = {};
+
+    // Open, map and validate the ring on the connector thread; the first
+    // blocks output silence until it is ready
+    connector_.start(connectorConfig);
+    connector_.setWanted(true);
 
     // Report buffering latency to the host DAW
-    setLatencySamples(static_cast<int>(getTargetFillFrames()));
+    setLatencySamples(getReportedLatency());
 }
 
 void DirectPipeReceiverProcessor::releaseResources()
 {
-    disconnect();
+    // The connection stays open: hosts release and re-prepare on a latency
+    // change, and prepareToPlay with the same settings carries on with it.
+    // A prepare with new settings or the destructor tears it down
     lastOutputSamples_ = 0;
 }
 
 void DirectPipeReceiverProcessor::processBlock(juce::AudioBuffer<float>& buffer,
                                                 juce::MidiBuffer& /*midiMessages*/)
 {
-    if (interleavedBuffer_.empty()) {
+    const uint64_t startNs = directpipe::steadyClockNs();
+    renderBlock(buffer);
+    if (conn_ != nullptr)
+        publishStats(startNs);
+}
+
+void DirectPipeReceiverProcessor::renderBlock(juce::AudioBuffer<float>& buffer)
+{
+    if (lastOutputBuffer_.empty()) {  // prepareToPlay not called yet
         buffer.clear();
         return;
     }
@@ -74,123 +150,144 @@ void DirectPipeReceiverProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
 
+    applyStreamSelection();
+    applyConcealChange();
+
     // Check mute parameter
     auto* muteParam = apvts_.getRawParameterValue("mute");
     if (muteParam && muteParam->load() >= 0.5f) {
         buffer.clear();
         hadAudioLastBlock_ = false;
+        concealer_.reset();   // Don't extrapolate from pre-mute audio
         return;
     }
 
-    // Try reconnect periodically if not connected
-    if (!connected_.load(std::memory_order_acquire)) {
-        ++reconnectCounter_;
-        if (reconnectCounter_ >= kReconnectInterval) {
-            reconnectCounter_ = 0;
-            tryConnect();
-        }
-        if (hadAudioLastBlock_) {
-            applyFadeOut(buffer, numSamples, numChannels);
-        } else {
-            buffer.clear();
-        }
+    // Not connected: adopt a connection if the connector has one ready
+    if (conn_ == nullptr && !adoptConnection()) {
+        fillGap(buffer, 0);
         return;
     }
 
     // Check if producer is still active
-    auto* shmData = sharedMemory_.getData();
-    if (shmData) {
-        auto* header = static_cast<directpipe::DirectPipeHeader*>(shmData);
-        if (!header->producer_active.load(std::memory_order_acquire)) {
-            disconnect();
-            if (hadAudioLastBlock_) {
-                applyFadeOut(buffer, numSamples, numChannels);
-            } else {
-                buffer.clear();
-            }
-            return;
-        }
+    auto* header = static_cast<directpipe::DirectPipeHeader*>(conn_->memory.getData());
+    if (!header->producer_active.load(std::memory_order_acquire)) {
+        disconnect();
+        fillGap(buffer, 0);
+        return;
     }
 
     ++blocksSinceConnect_;
+    updateClockRatio(numSamples);
 
-    uint32_t available = ringBuffer_.availableRead();
-    uint32_t channels = ringBuffer_.getChannels();
-
-    // ── Clock drift compensation: skip excess when buffer is too full ──
+    uint32_t available = conn_->ring.availableRead();
+    uint32_t channels = conn_->ring.getChannels();
     uint32_t targetFill = getTargetFillFrames();
+    stats_.fill_frames = available;
+    ++stats_.fill_histogram[directpipe::fillHistogramBin(available)];
 
     // Update latency reporting when buffer preset changes (setLatencySamples is lock-free)
-    if (static_cast<int>(targetFill) != getLatencySamples())
-        setLatencySamples(static_cast<int>(targetFill));
-    uint32_t highThreshold = getHighFillThreshold();
-
-    if (blocksSinceConnect_ > kDriftCheckWarmup && available > highThreshold) {
-        uint32_t excess = available - targetFill;
-        uint32_t chunkFrames = static_cast<uint32_t>(interleavedBuffer_.size()) / (std::max)(channels, 1u);
-        while (excess > 0) {
-            uint32_t chunk = (std::min)(excess, chunkFrames);
-            uint32_t actualRead = ringBuffer_.read(interleavedBuffer_.data(), chunk);
-            if (actualRead == 0) break;  // Defensive: avoid infinite loop
-            excess -= (std::min)(actualRead, excess);
-        }
-        available = ringBuffer_.availableRead();
+    if (getReportedLatency() != getLatencySamples())
+        setLatencySamples(getReportedLatency());
+
+    // ── Stall recovery: the DAW stopped pulling and the ring piled up far past
+    // target. ±1000 ppm would take minutes to drain that, so jump back (drift
+    // alone never gets here — the resampler below absorbs it)
+    if (blocksSinceConnect_ > kDriftCheckWarmup && available > getHighFillThreshold()) {
+        skipFrames(available - targetFill);
+        stats_.frames_skipped += available - targetFill;
+        available = conn_->ring.availableRead();
+        fillController_.reset();
     }
 
-    // ── Clock drift compensation: throttle reads when buffer is running low ──
-    // Dead-band: between lowThreshold/2 and lowThreshold, normal reading occurs
-    // without throttling — prevents oscillation between throttle and normal mode.
-    uint32_t lowThreshold = getLowFillThreshold();
-    if (blocksSinceConnect_ > kDriftCheckWarmup && available > 0 && available < lowThreshold / 2) {
-        // Buffer running low — host clock is slightly slower than DAW clock.
-        // Reduce read amount to leave a buffer cushion, preventing hard underrun.
-        // The unread portion of the output buffer gets zero-padded (existing behavior),
-        // creating micro-gaps instead of hard clicks.
-        uint32_t cushionRead = (std::min)(available, static_cast<uint32_t>(numSamples) / 2);
-        available = cushionRead;
-    }
-
-    // ── Read whatever is available (partial read OK — pad rest with silence) ──
-    uint32_t toRead = (std::min)(available, static_cast<uint32_t>(numSamples));
+    // Quality selector changed — rebuild the kernel (restarts the filter history)
+    applyQualityChange();
 
-    if (toRead == 0) {
-        // Complete underrun — no data at all
-        if (hadAudioLastBlock_) {
-            applyFadeOut(buffer, numSamples, numChannels);
-        } else {
-            buffer.clear();
+    // ── Auto buffer rebuffer: after an underrun grew the target, stay silent
+    // until the ring holds the new target, then restart the drift loop there
+    const bool autoBuffer = isAutoBuffer();
+    if (autoBuffer && rebuffering_) {
+        if (available < targetFill) {
+            countShortRead(numSamples, false);   // The underrun itself was counted already
+            fillGap(buffer, 0);
+            return;
         }
-        return;
+        rebuffering_ = false;
+        fillController_.reset();
+    } else if (!autoBuffer) {
+        rebuffering_ = false;
     }
 
-    // Clamp read to pre-allocated interleaved buffer capacity (no heap alloc in RT callback)
-    uint32_t maxFrames = static_cast<uint32_t>(interleavedBuffer_.size()) / (std::max)(channels, 1u);
-    if (toRead > maxFrames)
-        toRead = maxFrames;
+    // ── Clock drift compensation: steer the read ratio from the fill level ──
+    // Host faster than DAW → fill rises → read slightly faster (correction > 1),
+    // and vice versa; no frames are ever dropped or padded for drift.
+    // The loop runs in DAW frames (its gains assume the DAW rate), so ring
+    // frames are scaled by the nominal rate ratio
+    double correction = 1.0;
+    if (blocksSinceConnect_ > kDriftCheckWarmup)
+        correction = fillController_.update(estimateFill(available) / nominalRatio_,
+                                            static_cast<double>(targetFill) / nominalRatio_,
+                                            static_cast<uint32_t>(numSamples));
+    resampleRatio_.store(correction, std::memory_order_relaxed);
+    const double ratio = nominalRatio_ * correction;   // ring frames per output frame
+    stats_.resample_ratio_micros = static_cast<uint32_t>(std::lround(ratio * 1e6));
+
+    // ── Auto buffer: this block's deficit (how far the ring sits below its
+    // average, plus what we are about to read) feeds the jitter histogram;
+    // a short read is an underrun and may grow the target
+    if (autoBuffer && blocksSinceConnect_ > kDriftCheckWarmup) {
+        applyAutoBudget();
+        const uint32_t need = conn_->resampler.inputFramesFor(static_cast<uint32_t>(numSamples), ratio);
+        const double averageFill = fillController_.smoothedFill() * nominalRatio_;
+        bufferSizer_.observe(averageFill - static_cast<double>(available) + static_cast<double>(need),
+                             static_cast<double>(numSamples) / dawSampleRate_);
+        if (available < need) {
+            rebuffering_ = bufferSizer_.onUnderrun();
+            autoUnderruns_.store(bufferSizer_.underruns(), std::memory_order_relaxed);
+        }
+        autoTargetFrames_.store(bufferSizer_.target(), std::memory_order_relaxed);
+        autoReportedFrames_ = (std::max)(autoReportedFrames_, bufferSizer_.target());
+    }
 
-    uint32_t readCount = ringBuffer_.read(interleavedBuffer_.data(), toRead);
-    if (readCount == 0) {
-        buffer.clear();
+    if (available == 0) {
+        // Complete underrun — no data at all
+        countShortRead(numSamples, true);
+        fillGap(buffer, 0);
         return;
     }
 
-    // De-interleave: [L0 R0 L1 R1 ...] → JUCE planar [L0 L1 ...][R0 R1 ...]
-    int actualRead = static_cast<int>(readCount);
-    for (int ch = 0; ch < numChannels && ch < static_cast<int>(channels); ++ch) {
-        float* dest = buffer.getWritePointer(ch);
-        for (int i = 0; i < actualRead; ++i)
-            dest[i] = interleavedBuffer_[static_cast<size_t>(i) * channels + static_cast<size_t>(ch)];
+    // ── Read + resample in prepared-size chunks (partial OK — pad rest with silence) ──
+    int actualRead = 0;
+    while (actualRead < numSamples) {
+        const uint32_t chunk = (std::min)(static_cast<uint32_t>(numSamples - actualRead),
+                                          conn_->resampler.maxOutputFrames());
+        const int rendered = renderResampled(buffer, actualRead, chunk, ratio, channels);
+        if (rendered < 0) {
+            // Host overwrote these frames while we copied them (we were lapped) —
+            // discard the torn block; the next block resumes at the newest audio
+            countShortRead(numSamples, false);
+            fillGap(buffer, 0);
+            return;
+        }
+        actualRead += rendered;
+        if (static_cast<uint32_t>(rendered) < chunk)
+            break;  // Ring ran dry
+    }
+    if (actualRead == 0) {
+        // Not even one output frame's worth of input — treat as underrun
+        countShortRead(numSamples, true);
+        fillGap(buffer, 0);
+        return;
     }
 
     // Clear remaining channels
     for (int ch = static_cast<int>(channels); ch < numChannels; ++ch)
         buffer.clear(ch, 0, numSamples);
 
-    // Pad remaining samples with silence (partial read)
-    if (actualRead < numSamples) {
-        for (int ch = 0; ch < numChannels; ++ch)
-            buffer.clear(ch, actualRead, numSamples - actualRead);
-    }
+    // Conceal (or pad with silence) the rest of a partial read. Complete
+    // blocks go through too, so the concealer has the latest output
+    if (actualRead < numSamples)
+        countShortRead(numSamples - actualRead, true);
+    fillGap(buffer, actualRead);
 
     // Save state for fade-out
     saveLastOutput(buffer, numSamples, numChannels);
@@ -198,55 +295,275 @@ void DirectPipeReceiverProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     fadeGain_ = 1.0f;
 }
 
-void DirectPipeReceiverProcessor::tryConnect()
+void DirectPipeReceiverProcessor::countShortRead(int paddedFrames, bool underrun)
 {
-    if (!sharedMemory_.open(directpipe::SHM_NAME, 0))
+    stats_.frames_padded += static_cast<uint64_t>(paddedFrames);
+    if (underrun)
+        ++stats_.underruns;
+}
+
+void DirectPipeReceiverProcessor::fillGap(juce::AudioBuffer<float>& buffer, int validFrames)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+    if (concealEnabled_) {
+        // Repeats the last pitch period(s) for up to ~20 ms, then silence; on
+        // a complete block only records it and crossfades out of a gap
+        const uint32_t concealed = concealer_.process(buffer.getArrayOfWritePointers(),
+                                                      static_cast<uint32_t>(numChannels),
+                                                      static_cast<uint32_t>(validFrames),
+                                                      static_cast<uint32_t>(numSamples));
+        stats_.frames_concealed += concealed;
+        concealedFrames_.store(concealer_.concealedFrames(), std::memory_order_relaxed);
         return;
+    }
 
-    if (!ringBuffer_.attachAsConsumer(sharedMemory_.getData(), sharedMemory_.getSize())) {
-        sharedMemory_.close();
+    if (validFrames >= numSamples)
         return;
+    if (validFrames > 0) {
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.clear(ch, validFrames, numSamples - validFrames);
+    } else if (hadAudioLastBlock_) {
+        applyFadeOut(buffer, numSamples, numChannels);
+    } else {
+        buffer.clear();
     }
+}
 
-    // Verify producer is active
-    auto* header = static_cast<directpipe::DirectPipeHeader*>(sharedMemory_.getData());
-    if (!header->producer_active.load(std::memory_order_acquire)) {
-        ringBuffer_.detach();   // Clear consumer_active flag before closing
-        sharedMemory_.close();
+void DirectPipeReceiverProcessor::applyConcealChange()
+{
+    // The history is only kept while enabled — start it fresh on a toggle
+    auto* param = apvts_.getRawParameterValue("conceal");
+    const bool enabled = param == nullptr || param->load() >= 0.5f;
+    if (enabled == concealEnabled_)
         return;
+    concealEnabled_ = enabled;
+    concealer_.reset();
+}
+
+void DirectPipeReceiverProcessor::publishStats(uint64_t startNs)
+{
+    // Our own cost per block, including the read and resample. Plain stores
+    // into our ConsumerStats entry — the host reads them for /api/perf
+    const uint64_t elapsed = directpipe::steadyClockNs() - startNs;
+    const auto elapsedNs = static_cast<uint32_t>((std::min)(elapsed, static_cast<uint64_t>(std::numeric_limits<uint32_t>::max())));
+    stats_.process_ns = stats_.process_ns == 0
+        ? elapsedNs
+        : static_cast<uint32_t>(stats_.process_ns + (static_cast<double>(elapsedNs) - stats_.process_ns)
+                                                    * kProcessTimeSmoothing);
+    stats_.process_peak_ns = (std::max)(stats_.process_peak_ns, elapsedNs);
+    ++stats_.blocks;
+    conn_->ring.publishConsumerStats(stats_);
+}
+
+int DirectPipeReceiverProcessor::renderResampled(juce::AudioBuffer<float>& buffer, int offset,
+                                                 uint32_t frames, double ratio, uint32_t channels)
+{
+    const int numChannels = buffer.getNumChannels();
+    uint32_t toRead = conn_->resampler.inputFramesFor(frames, ratio);
+    const uint32_t available = conn_->ring.availableRead();
+    if (available < toRead) {
+        // Render only what the frames on hand cover
+        frames = conn_->resampler.outputFramesFor(available, ratio);
+        toRead = conn_->resampler.inputFramesFor(frames, ratio);
+    }
+
+    if (toRead > 0) {
+        // Zero-copy read: copy each plane (planar rings) or de-interleave, and
+        // unpack int16/int24/fp16 rings, straight out of the shared pages into
+        // the resampler's input [L0 R0 L1 R1 ...] or [L0 L1 ...]..[R0 R1 ...] → planar
+        const auto region = conn_->ring.beginRead(toRead);
+        if (region.frames() < toRead) {
+            // Cursor was repositioned (evicted / lapped) — shrink to what we got
+            frames = conn_->resampler.outputFramesFor(region.frames(), ratio);
+            toRead = conn_->resampler.inputFramesFor(frames, ratio);
+        }
+        if (offset == 0 && toRead > 0)
+            measureIpcLatency(region.position);
+
+        auto unpackFrom = [&](const uint8_t* src, uint32_t count, uint32_t destOffset) {
+            float* dest[2] = { nullptr, nullptr };
+            for (uint32_t ch = 0; ch < channels && ch < directpipe::AdaptiveResampler::kMaxChannels; ++ch)
+                dest[ch] = conn_->resampler.inputBuffer(ch) + destOffset;
+            if (region.layout == directpipe::SampleLayout::Planar)
+                directpipe::unpackPlanes(region.format, src, region.planeStride, channels, count, dest);
+            else
+                directpipe::unpackInterleaved(region.format, src, channels, count, dest);
+        };
+        const uint32_t first = (std::min)(toRead, region.frames1);
+        if (first > 0)
+            unpackFrom(region.bytes1, first, 0);
+        if (toRead > first)
+            unpackFrom(region.bytes2, toRead - first, first);
+        if (!conn_->ring.commitRead(toRead))
+            return -1;
     }
 
-    // SPSC warning: if another consumer was already reading, audio will be corrupted
-    multiConsumerWarning_.store(ringBuffer_.anotherConsumerWasActive(), std::memory_order_relaxed);
+    float* out[2] = { nullptr, nullptr };
+    for (int ch = 0; ch < numChannels && ch < static_cast<int>(channels)
+                     && ch < static_cast<int>(directpipe::AdaptiveResampler::kMaxChannels); ++ch)
+        out[ch] = buffer.getWritePointer(ch) + offset;
+    conn_->resampler.process(toRead, out, frames, ratio);
+    return static_cast<int>(frames);
+}
 
-    // Skip to fresh position — minimal latency on connect
-    skipToFreshPosition();
+bool DirectPipeReceiverProcessor::adoptConnection()
+{
+    // Finish a hand-back the connector had no room for before taking a new
+    // connection (keeps one spare slot for the next disconnect)
+    if (retiring_ != nullptr) {
+        if (!connector_.retire(retiring_))
+            return false;
+        retiring_ = nullptr;
+    }
+
+    // The connector thread already opened, mapped, attached and validated the
+    // ring and built the resampler — taking it over is a pointer swap
+    ReceiverConnection* ready = connector_.takeReady();
+    if (ready == nullptr)
+        return false;
+    auto* header = static_cast<directpipe::DirectPipeHeader*>(ready->memory.getData());
+    if (ready->streamGeneration != connector_.streamGeneration()
+        || !header->producer_active.load(std::memory_order_acquire)) {
+        // Stale: opened for an old stream selection, or the host stopped since
+        conn_ = ready;
+        disconnect();
+        return false;
+    }
 
-    // Cache values for GUI-thread-safe access (avoids ringBuffer_ dangling pointer race)
-    cachedSampleRate_.store(ringBuffer_.getSampleRate(), std::memory_order_relaxed);
-    cachedChannels_.store(ringBuffer_.getChannels(), std::memory_order_relaxed);
+    conn_ = ready;
+    connector_.setWanted(false);
 
-    blocksSinceConnect_ = 0;
+    // Cache values for GUI-thread-safe access (avoids conn_ dangling pointer race)
+    cachedSampleRate_.store(conn_->ring.getSampleRate(), std::memory_order_relaxed);
+    cachedChannels_.store(conn_->ring.getChannels(), std::memory_order_relaxed);
+    lastSourceRate_.store(conn_->ring.getSampleRate(), std::memory_order_relaxed);
+
+    nominalRatio_ = conn_->nominalRatio;
+    resamplerLatency_ = conn_->resampler.latencyFrames();
+
+    resumeAtLiveEdge();
     connected_.store(true, std::memory_order_release);
+    return true;
+}
+
+void DirectPipeReceiverProcessor::resumeAtLiveEdge()
+{
+    // Skip to fresh position — minimal latency on connect — and restart the
+    // drift loop and both clocks from there
+    skipToFreshPosition();
+    blocksSinceConnect_ = 0;
+    fillController_.reset();
+    clockEstimator_.reset();
+    hasLatestMeta_ = false;
+    framesConsumed_ = 0;
+    smoothedLatencyMs_ = 0.0f;
+}
+
+void DirectPipeReceiverProcessor::applyStreamSelection()
+{
+    // Switch rings: drop the old stream now; the connector is already opening
+    // the new one
+    if (conn_ != nullptr && conn_->streamGeneration != connector_.streamGeneration()) {
+        disconnect();
+        hadAudioLastBlock_ = false;
+    }
+}
+
+void DirectPipeReceiverProcessor::setStreamId(const juce::String& id)
+{
+    const juce::String streamId = directpipe::isValidStreamId(id.toRawUTF8())
+        ? id : juce::String(directpipe::MAIN_STREAM_ID);
+    apvts_.state.setProperty("streamId", streamId, nullptr);
+    connector_.setStreamId(streamId.toStdString());
+}
+
+juce::String DirectPipeReceiverProcessor::getStreamId() const
+{
+    return apvts_.state.getProperty("streamId", juce::String(directpipe::MAIN_STREAM_ID)).toString();
+}
+
+uint32_t DirectPipeReceiverProcessor::listStreams(directpipe::StreamInfo* out, uint32_t maxStreams)
+{
+    // Re-open every time: the directory appears when the first host publishes
+    if (!uiRegistry_.openForReading())
+        return 0;
+    return uiRegistry_.list(out, maxStreams);
 }
 
 void DirectPipeReceiverProcessor::skipToFreshPosition()
 {
     // On initial connection, advance read pointer close to write pointer
     // so we start reading the freshest audio with minimal latency.
+    // Overwrite-oldest rings already attach at the live edge (no-op there).
     uint32_t targetFill = getTargetFillFrames();
-    uint32_t available = ringBuffer_.availableRead();
-    if (available > targetFill && !interleavedBuffer_.empty()) {
-        uint32_t skip = available - targetFill;
-        uint32_t channels = ringBuffer_.getChannels();
-        uint32_t chunkFrames = static_cast<uint32_t>(interleavedBuffer_.size()) / (std::max)(channels, 1u);
-        while (skip > 0) {
-            uint32_t chunk = (std::min)(skip, chunkFrames);
-            uint32_t actualRead = ringBuffer_.read(interleavedBuffer_.data(), chunk);
-            if (actualRead == 0) break;  // Defensive: prevent infinite loop on read failure
-            skip -= (std::min)(actualRead, skip);
-        }
+    uint32_t available = conn_->ring.availableRead();
+    if (available > targetFill)
+        skipFrames(available - targetFill);
+}
+
+void DirectPipeReceiverProcessor::skipFrames(uint32_t frames)
+{
+    // Advance our cursor without touching the samples (commit an unread region)
+    while (frames > 0) {
+        const uint32_t skipped = conn_->ring.beginRead(frames).frames();
+        if (skipped == 0) break;  // Defensive: avoid infinite loop
+        conn_->ring.commitRead(skipped);
+        frames -= (std::min)(skipped, frames);
+    }
+}
+
+void DirectPipeReceiverProcessor::updateClockRatio(int numSamples)
+{
+    // Producer: device sample counter vs. host time, from the newest block stamp.
+    // Consumer: frames the DAW pulled from us vs. host time.
+    directpipe::BlockMetaSnapshot meta;
+    if (conn_->ring.latestBlockMeta(meta)) {
+        clockEstimator_.addProducerStamp(meta.host_time_ns, meta.sample_counter);
+        latestMeta_ = meta;
+        hasLatestMeta_ = true;
     }
+
+    framesConsumed_ += static_cast<uint64_t>(numSamples);
+    clockEstimator_.addConsumerStamp(directpipe::steadyClockNs(), framesConsumed_);
+    clockRatio_.store(clockEstimator_.ratio(), std::memory_order_relaxed);
+}
+
+double DirectPipeReceiverProcessor::estimateFill(uint32_t available) const
+{
+    // `available` jumps by a whole host block on every write. Add the frames
+    // the host has rendered since its newest block started (from the block
+    // timestamp) so the PI loop sees a smooth level, not a one-block sawtooth
+    // beating against our own block rate.
+    if (!hasLatestMeta_)
+        return static_cast<double>(available);
+    const uint64_t now = directpipe::steadyClockNs();
+    if (now <= latestMeta_.host_time_ns)
+        return static_cast<double>(available);
+    const double sinceBlock = static_cast<double>(now - latestMeta_.host_time_ns) * 1e-9
+                              * static_cast<double>(conn_->ring.getSampleRate());
+    return static_cast<double>(available)
+           + (std::min)(sinceBlock, static_cast<double>(latestMeta_.frames));
+}
+
+void DirectPipeReceiverProcessor::measureIpcLatency(uint64_t streamPos)
+{
+    directpipe::BlockMetaSnapshot meta;
+    if (!conn_->ring.findBlockMeta(streamPos, meta))
+        return;  // Block recycled from the side channel (or unstamped) — keep last value
+
+    const uint64_t now = directpipe::steadyClockNs();
+    if (now < meta.host_time_ns)
+        return;
+    const float ms = static_cast<float>(now - meta.host_time_ns) / 1.0e6f;
+
+    smoothedLatencyMs_ = smoothedLatencyMs_ <= 0.0f
+        ? ms
+        : smoothedLatencyMs_ + (ms - smoothedLatencyMs_) * kLatencySmoothing;
+    ipcLatencyMs_.store(smoothedLatencyMs_, std::memory_order_relaxed);
+
+    // Report back through our consumer slot so the host can show the OBS path latency
+    conn_->ring.reportLatencyUs(static_cast<uint32_t>(smoothedLatencyMs_ * 1000.0f));
 }
 
 void DirectPipeReceiverProcessor::saveLastOutput(const juce::AudioBuffer<float>& buffer,
@@ -310,10 +627,18 @@ void DirectPipeReceiverProcessor::applyFadeOut(juce::AudioBuffer<float>& buffer,
     }
 }
 
+bool DirectPipeReceiverProcessor::isAutoBuffer() const
+{
+    auto* param = apvts_.getRawParameterValue("buffer");
+    return param && static_cast<int>(param->load()) == kAutoBufferPreset;
+}
+
 uint32_t DirectPipeReceiverProcessor::getTargetFillFrames() const
 {
     auto* param = apvts_.getRawParameterValue("buffer");
     int idx = param ? static_cast<int>(param->load()) : 1;
+    if (idx == kAutoBufferPreset)
+        return autoTargetFrames_.load(std::memory_order_relaxed);
     if (idx < 0 || idx >= kNumBufferPresets) idx = 1;
     return kBufferPresets[idx][0];
 }
@@ -322,37 +647,99 @@ uint32_t DirectPipeReceiverProcessor::getHighFillThreshold() const
 {
     auto* param = apvts_.getRawParameterValue("buffer");
     int idx = param ? static_cast<int>(param->load()) : 1;
+    if (idx == kAutoBufferPreset)
+        return autoTargetFrames_.load(std::memory_order_relaxed) * 3;   // Same 3x margin as the presets
     if (idx < 0 || idx >= kNumBufferPresets) idx = 1;
     return kBufferPresets[idx][1];
 }
 
-uint32_t DirectPipeReceiverProcessor::getLowFillThreshold() const
+void DirectPipeReceiverProcessor::applyAutoBudget()
 {
-    auto* param = apvts_.getRawParameterValue("buffer");
+    auto* param = apvts_.getRawParameterValue("autoBudget");
     int idx = param ? static_cast<int>(param->load()) : 1;
-    if (idx < 0 || idx >= kNumBufferPresets) idx = 1;
-    return kBufferPresets[idx][2];
+    if (idx < 0 || idx > 2) idx = 1;
+    if (idx == appliedAutoBudget_)
+        return;
+    appliedAutoBudget_ = idx;
+    bufferSizer_.setUnderrunBudget(kAutoBudgets[idx]);   // Keeps the measured history
+}
+
+int DirectPipeReceiverProcessor::getReportedLatency() const
+{
+    // Buffered ring frames and the kernel delay are host-rate frames; the DAW
+    // counts its own samples. Auto reports the largest target it has grown
+    // to, not every step: hosts re-activate the plugin on each change
+    const uint32_t fillFrames = isAutoBuffer() ? autoReportedFrames_ : getTargetFillFrames();
+    const double ringFrames = static_cast<double>(fillFrames) + resamplerLatency_;
+    return static_cast<int>(std::lround(ringFrames / nominalRatio_));
+}
+
+int DirectPipeReceiverProcessor::getQualityIndex() const
+{
+    // Same fallback as the connector uses for new connections
+    auto* param = apvts_.getRawParameterValue("quality");
+    int idx = param ? static_cast<int>(param->load()) : 2;
+    if (idx < 0 || idx > static_cast<int>(directpipe::ResamplerQuality::Sinc64)) idx = 2;
+    return idx;
+}
+
+void DirectPipeReceiverProcessor::applyQualityChange()
+{
+    // Rebuilds the kernel table in place — no allocation (the connector sized
+    // it) and no syscall, a few hundred microseconds at most; only when the
+    // user changes the selector. New connections are built at the new quality
+    const int idx = getQualityIndex();
+    if (idx == conn_->quality)
+        return;
+    conn_->quality = idx;
+    conn_->resampler.configure(static_cast<directpipe::ResamplerQuality>(idx), nominalRatio_);
+    resamplerLatency_ = conn_->resampler.latencyFrames();
 }
 
 void DirectPipeReceiverProcessor::disconnect()
 {
     connected_.store(false, std::memory_order_release);
-    multiConsumerWarning_.store(false, std::memory_order_relaxed);
     cachedSampleRate_.store(0, std::memory_order_relaxed);
     cachedChannels_.store(0, std::memory_order_relaxed);
-    ringBuffer_.detach();  // Clears consumer_active flag, then invalidates pointers
-    sharedMemory_.close();
+    ipcLatencyMs_.store(0.0f, std::memory_order_relaxed);
+    clockRatio_.store(0.0, std::memory_order_relaxed);
+    resampleRatio_.store(1.0, std::memory_order_relaxed);
+
+    // Detach + unmap happen on the connector thread. If its slot still holds
+    // the previous connection, keep this one and hand it over on a later block
+    // (adoptConnection() waits for that, so retiring_ is always free here)
+    if (conn_ != nullptr && !connector_.retire(conn_))
+        retiring_ = conn_;
+    conn_ = nullptr;
+    connector_.setWanted(true);
+}
+
+void DirectPipeReceiverProcessor::releaseConnection()
+{
+    // Audio is stopped (prepareToPlay / releaseResources / destructor): join
+    // the connector and tear everything down here
+    connector_.stop();
+    delete conn_;
+    delete retiring_;
+    conn_ = nullptr;
+    retiring_ = nullptr;
+    connected_.store(false, std::memory_order_release);
+    cachedSampleRate_.store(0, std::memory_order_relaxed);
+    cachedChannels_.store(0, std::memory_order_relaxed);
+    ipcLatencyMs_.store(0.0f, std::memory_order_relaxed);
+    clockRatio_.store(0.0, std::memory_order_relaxed);
+    resampleRatio_.store(1.0, std::memory_order_relaxed);
 }
 
 uint32_t DirectPipeReceiverProcessor::getSourceSampleRate() const
 {
-    // Return cached value — safe to call from GUI thread without touching ringBuffer_
+    // Return cached value — safe to call from GUI thread without touching conn_
     return cachedSampleRate_.load(std::memory_order_relaxed);
 }
 
 uint32_t DirectPipeReceiverProcessor::getSourceChannels() const
 {
-    // Return cached value — safe to call from GUI thread without touching ringBuffer_
+    // Return cached value — safe to call from GUI thread without touching conn_
     return cachedChannels_.load(std::memory_order_relaxed);
 }
 
@@ -366,8 +753,10 @@ void DirectPipeReceiverProcessor::getStateInformation(juce::MemoryBlock& destDat
 void DirectPipeReceiverProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
     std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
-    if (xml && xml->hasTagName(apvts_.state.getType()))
+    if (xml && xml->hasTagName(apvts_.state.getType())) {
         apvts_.replaceState(juce::ValueTree::fromXml(*xml));
+        setStreamId(getStreamId());  // Older sessions have no streamId -> main
+    }
 }
 
 juce::AudioProcessorEditor* DirectPipeReceiverProcessor::createEditor()
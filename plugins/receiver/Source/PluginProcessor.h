@@ -3,10 +3,16 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ReceiverConnector.h"
 #include <directpipe/SharedMemory.h>
 #include <directpipe/RingBuffer.h>
 #include <directpipe/Constants.h>
 #include <directpipe/Protocol.h>
+#include <directpipe/ClockSync.h>
+#include <directpipe/Resampler.h>
+#include <directpipe/JitterBuffer.h>
+#include <directpipe/Concealment.h>
+#include <directpipe/StreamRegistry.h>
 #include <atomic>
 #include <vector>
 
@@ -42,23 +48,53 @@ public:
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts_; }
 
+    /// Widest host/DAW sample-rate ratio the resampler is sized for (192 kHz into 44.1 kHz)
+    static constexpr double kMaxRateRatio = 4.5;
+
     bool isConnected() const { return connected_.load(std::memory_order_relaxed); }
-    bool hasMultiConsumerWarning() const { return multiConsumerWarning_.load(std::memory_order_relaxed); }
+    bool hasSlotsFullWarning() const { return connector_.slotsFull(); }
     uint32_t getSourceSampleRate() const;
     uint32_t getSourceChannels() const;
+    /// Smoothed end-to-end latency from the host's block timestamp to our read (0 = unknown)
+    float getIpcLatencyMs() const { return ipcLatencyMs_.load(std::memory_order_relaxed); }
+    /// Host (producer) / DAW (consumer) sample clock ratio from the timestamp side channel (0 = unknown)
+    double getClockRatio() const { return clockRatio_.load(std::memory_order_relaxed); }
+    /// Drift-compensation read ratio (input/output frames, 1 +/- 1000 ppm; 1.0 while disconnected).
+    /// Applied on top of the fixed host/DAW sample-rate ratio.
+    double getResampleRatio() const { return resampleRatio_.load(std::memory_order_relaxed); }
+
+    /// "Auto" buffer preset selected (target fill follows measured jitter)
+    bool isAutoBuffer() const;
+    /// Underruns Auto has seen since prepareToPlay (a re-activation with the same settings keeps counting)
+    uint32_t getAutoUnderruns() const { return autoUnderruns_.load(std::memory_order_relaxed); }
+    /// Output frames filled by dropout concealment since prepareToPlay
+    uint64_t getConcealedFrames() const { return concealedFrames_.load(std::memory_order_relaxed); }
+
+    /// Select the host stream to receive (MAIN_STREAM_ID by default). Saved with
+    /// the plugin state; the connector thread opens it and the audio thread
+    /// switches over on its next block.
+    void setStreamId(const juce::String& id);                                   // [Message thread]
+    juce::String getStreamId() const;                                           // [Message thread]
+    /// Streams currently listed in the host's stream directory
+    uint32_t listStreams(directpipe::StreamInfo* out, uint32_t maxStreams);    // [Message thread]
 
 private:
-    directpipe::SharedMemory sharedMemory_;
-    directpipe::RingBuffer ringBuffer_;
+    // Connections are opened, mapped and torn down on the connector thread;
+    // the audio thread only adopts a ready one and hands it back (no syscalls)
+    juce::AudioProcessorValueTreeState apvts_;
+    ReceiverConnector connector_;
+    ReceiverConnection* conn_ = nullptr;       // [RT thread only] adopted connection, nullptr when disconnected
+    ReceiverConnection* retiring_ = nullptr;   // [RT thread only] waiting for the connector to collect it
 
     std::atomic<bool> connected_{false};                // [RT write, GUI read]
-    std::atomic<bool> multiConsumerWarning_{false};    // [RT write, GUI read] true if another Receiver was already reading
-    std::atomic<uint32_t> cachedSampleRate_{0};        // [RT write, GUI read] GUI-safe cache (avoids ringBuffer_ race)
-    std::atomic<uint32_t> cachedChannels_{0};          // [RT write, GUI read] GUI-safe cache (avoids ringBuffer_ race)
-    int reconnectCounter_ = 0;                         // [RT thread only]
-    static constexpr int kReconnectInterval = 100;
+    std::atomic<uint32_t> cachedSampleRate_{0};        // [RT write, GUI read] GUI-safe cache (avoids conn_ race)
+    std::atomic<uint32_t> cachedChannels_{0};          // [RT write, GUI read] GUI-safe cache (avoids conn_ race)
+    std::atomic<float> ipcLatencyMs_{0.0f};            // [RT write, GUI read]
+    std::atomic<double> clockRatio_{0.0};              // [RT write, GUI read]
+    std::atomic<double> resampleRatio_{1.0};           // [RT write, GUI read]
+    std::atomic<uint32_t> lastSourceRate_{0};          // [RT write, prepareToPlay read] host rate of the last connection, kept across disconnects
 
-    std::vector<float> interleavedBuffer_;
+    directpipe::StreamRegistry uiRegistry_;            // [Message thread only] listStreams()
 
     // Fade-out buffer: stores last block's output for smooth underrun handling
     std::vector<float> lastOutputBuffer_;   // planar, numChannels * blockSize
@@ -68,33 +104,91 @@ private:
     float fadeGain_ = 0.0f;                 // current fade-out level (1.0 → 0.0)
     static constexpr float kFadeStep = 0.05f;   // per-sample, ~20 samples to silence
 
-    // Clock drift compensation
+    // Dropout concealment ("conceal" on): gaps are filled by repeating the
+    // last pitch period(s) instead of the fade above [RT thread only]
+    directpipe::PacketLossConcealer concealer_;
+    bool concealEnabled_ = true;                         // "conceal" value in effect
+    std::atomic<uint64_t> concealedFrames_{0};           // [RT write, GUI read]
+
+    // IPC timing side channel (block timestamps) [RT thread only]
+    directpipe::ClockRatioEstimator clockEstimator_;
+    directpipe::BlockMetaSnapshot latestMeta_;   // newest host block stamp seen
+    bool hasLatestMeta_ = false;
+    uint64_t framesConsumed_ = 0;           // DAW frames rendered since connect (consumer clock)
+    float smoothedLatencyMs_ = 0.0f;
+    static constexpr float kLatencySmoothing = 0.05f;
+
+    // Sample-rate conversion + clock drift compensation: the connection's
+    // resampler sits between the ring and the output, at (host rate / DAW
+    // rate) x the PI loop's fill-level correction [RT thread only]
+    directpipe::FillLevelController fillController_;
+    double dawSampleRate_ = 0.0;                // from prepareToPlay
+    int preparedBlockSize_ = 0;                 // from prepareToPlay; same rate and size keep the connection
+    double nominalRatio_ = 1.0;                 // host rate / DAW rate of the connected stream
+    double resamplerLatency_ = 0.0;             // group delay of the last adopted kernel (frames)
     int blocksSinceConnect_ = 0;
-    static constexpr int kDriftCheckWarmup = 50;  // ignore first N blocks
+    static constexpr int kDriftCheckWarmup = 50;  // ratio held at 1.0 for the first N blocks
 
-    // Buffer presets: { targetFill, highThreshold, lowThreshold }
-    // Index matches "buffer" AudioParameterChoice
+    // Buffer presets: { targetFill, highThreshold }
+    // highThreshold only catches a DAW stall (drift never gets there); index
+    // matches "buffer" AudioParameterChoice. kAutoBufferPreset follows the list.
     static constexpr int kNumBufferPresets = 5;
-    static constexpr uint32_t kBufferPresets[kNumBufferPresets][3] = {
-        {  256,   768,   64 },  // 0: Ultra Low  (256 samples)
-        {  512,  1536,  128 },  // 1: Low        (512 samples)
-        { 1024,  3072,  256 },  // 2: Medium     (1024 samples)
-        { 2048,  6144,  512 },  // 3: High       (2048 samples)
-        { 4096, 12288, 1024 },  // 4: Safe       (4096 samples)
+    static constexpr int kAutoBufferPreset = kNumBufferPresets;
+    static constexpr uint32_t kBufferPresets[kNumBufferPresets][2] = {
+        {  256,   768 },  // 0: Ultra Low  (256 samples)
+        {  512,  1536 },  // 1: Low        (512 samples)
+        { 1024,  3072 },  // 2: Medium     (1024 samples)
+        { 2048,  6144 },  // 3: High       (2048 samples)
+        { 4096, 12288 },  // 4: Safe       (4096 samples)
     };
+
+    // "Auto" buffer: target fill sized from measured arrival jitter. After an
+    // underrun that grows the target, output stays silent until the ring
+    // refills to it (rebuffer) instead of limping along on a short buffer.
+    directpipe::JitterBufferSizer bufferSizer_;          // [RT thread only]
+    std::atomic<uint32_t> autoTargetFrames_{512};         // [RT write, GUI read]
+    uint32_t autoReportedFrames_ = 512;                   // [RT thread only] largest target since prepare, reported as latency
+    std::atomic<uint32_t> autoUnderruns_{0};              // [RT write, GUI read]
+    bool rebuffering_ = false;                            // [RT thread only]
+    int appliedAutoBudget_ = -1;                          // [RT thread only] "autoBudget" choice in effect
+    static constexpr double kAutoBudgets[] = { 1e-5, 1e-4, 1e-3 };  // Strict / Normal / Relaxed
+
+    // Telemetry for the host: running totals since prepareToPlay, published
+    // into our ConsumerStats entry once per connected block [RT thread only]
+    directpipe::ConsumerStatsSnapshot stats_;
+    static constexpr double kProcessTimeSmoothing = 0.05;
+    void countShortRead(int paddedFrames, bool underrun);
+    void publishStats(uint64_t startNs);
 public:
     uint32_t getTargetFillFrames() const;
 private:
     uint32_t getHighFillThreshold() const;
-    uint32_t getLowFillThreshold() const;
-
-    juce::AudioProcessorValueTreeState apvts_;
-
-    void tryConnect();
-    void disconnect();
+    int getReportedLatency() const;   // targetFill + resampler group delay, in DAW samples
+    int getQualityIndex() const;      // "quality" choice, clamped like the connector does
+    void applyQualityChange();        // RT: rebuild the kernel if the "quality" choice changed
+    void applyAutoBudget();           // RT: pick up an "autoBudget" change
+
+    bool adoptConnection();       // RT: take a ready connection from the connector
+    void resumeAtLiveEdge();      // Skip to the live edge, restart the drift loop and clocks
+    void disconnect();            // RT: hand the connection back for teardown
+    void releaseConnection();     // Message thread (audio stopped): tear down synchronously
+    void applyStreamSelection();  // RT: drop the connection if the stream selection changed
     void skipToFreshPosition();
+    void skipFrames(uint32_t frames);  // Drop frames in place (no copy)
+    void updateClockRatio(int numSamples);          // Feed both clocks once per connected block
+    void measureIpcLatency(uint64_t streamPos);     // Timestamp of the block at streamPos -> now
+    double estimateFill(uint32_t available) const;  // available + frames the host rendered since its last write
+    // Read, resample and write `frames` output frames at `offset`. Returns frames
+    // rendered (fewer if the ring ran dry) or -1 if the read was torn.
+    void renderBlock(juce::AudioBuffer<float>& buffer);   // processBlock body (timed)
+    int renderResampled(juce::AudioBuffer<float>& buffer, int offset, uint32_t frames,
+                        double ratio, uint32_t channels);
     void saveLastOutput(const juce::AudioBuffer<float>& buffer, int numSamples, int numChannels);
     void applyFadeOut(juce::AudioBuffer<float>& buffer, int numSamples, int numChannels);
+    // Frames [validFrames, end) had no input: conceal them, or fade / pad with
+    // silence when concealment is off. Called for complete blocks as well
+    void fillGap(juce::AudioBuffer<float>& buffer, int validFrames);
+    void applyConcealChange();        // RT: pick up a "conceal" toggle
 
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
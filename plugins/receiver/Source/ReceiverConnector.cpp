@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+
+#include "ReceiverConnector.h"
+#include <directpipe/Constants.h>
+#include <directpipe/Protocol.h>
+#include <algorithm>
+#include <chrono>
+
+ReceiverConnection::~ReceiverConnection()
+{
+    ring.detach();   // Releases our consumer slot before the mapping goes away
+    memory.close();
+}
+
+ReceiverConnector::ReceiverConnector(std::atomic<float>* qualityParam)
+    : qualityParam_(qualityParam)
+    , streamId_(directpipe::MAIN_STREAM_ID)
+{
+}
+
+ReceiverConnector::~ReceiverConnector()
+{
+    stop();
+}
+
+void ReceiverConnector::start(const Config& config)
+{
+    stop();
+    config_ = config;
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { run(); });
+}
+
+void ReceiverConnector::stop()
+{
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable())
+        thread_.join();
+    // The audio thread is not running here (prepareToPlay / destructor)
+    delete ready_.exchange(nullptr, std::memory_order_acq_rel);
+    collectRetired();
+}
+
+void ReceiverConnector::setStreamId(const std::string& id)
+{
+    {
+        const std::lock_guard<std::mutex> lock(streamIdMutex_);
+        streamId_ = id;
+    }
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool ReceiverConnector::retire(ReceiverConnection* connection)
+{
+    ReceiverConnection* expected = nullptr;
+    return retired_.compare_exchange_strong(expected, connection, std::memory_order_acq_rel);
+}
+
+void ReceiverConnector::collectRetired()
+{
+    delete retired_.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void ReceiverConnector::run()
+{
+    auto nextAttempt = std::chrono::steady_clock::now();
+    while (running_.load(std::memory_order_acquire)) {
+        collectRetired();
+
+        // A ready connection for a stream that is no longer selected is useless
+        ReceiverConnection* ready = ready_.load(std::memory_order_acquire);
+        if (ready != nullptr && ready->streamGeneration != streamGeneration()) {
+            if (ready_.compare_exchange_strong(ready, nullptr, std::memory_order_acq_rel))
+                delete ready;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (wanted_.load(std::memory_order_acquire)
+            && ready_.load(std::memory_order_acquire) == nullptr && now >= nextAttempt) {
+            if (auto connection = connect())
+                ready_.store(connection.release(), std::memory_order_release);
+            else
+                nextAttempt = now + std::chrono::milliseconds(kRetryIntervalMs);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(kPollIntervalMs));
+    }
+}
+
+std::unique_ptr<ReceiverConnection> ReceiverConnector::connect()
+{
+    const uint32_t generation = streamGeneration();
+    std::string id;
+    {
+        const std::lock_guard<std::mutex> lock(streamIdMutex_);
+        id = streamId_;
+    }
+
+    // The main stream has a fixed name; other streams are looked up in the
+    // host's stream directory
+    std::string shmName = directpipe::SHM_NAME;
+    if (id != directpipe::MAIN_STREAM_ID) {
+        if (!registry_.isOpen() && !registry_.openForReading())
+            return nullptr;
+        directpipe::StreamInfo stream;
+        if (!registry_.find(id.c_str(), stream))
+            return nullptr;
+        shmName = stream.shmName;
+    }
+
+    // Pre-fault (read-only) and lock our view so the first reads after
+    // connecting don't take page faults on the audio thread
+    auto connection = std::make_unique<ReceiverConnection>();
+    directpipe::SharedMemoryOptions memoryOptions;
+    memoryOptions.prefault = true;
+    memoryOptions.lock = true;
+    if (!connection->memory.open(shmName, 0, memoryOptions))
+        return nullptr;
+
+    if (!connection->ring.attachAsConsumer(connection->memory.getData(), connection->memory.getSize())) {
+        // Broadcast buffer supports MAX_CONSUMERS Receivers — surface "table full" in the UI
+        slotsFull_.store(connection->ring.consumerSlotsExhausted(), std::memory_order_relaxed);
+        return nullptr;
+    }
+    slotsFull_.store(false, std::memory_order_relaxed);
+
+    auto* header = static_cast<directpipe::DirectPipeHeader*>(connection->memory.getData());
+    if (!header->producer_active.load(std::memory_order_acquire))
+        return nullptr;   // Destructor releases the slot and unmaps
+
+    // Host rate / DAW rate. Buffers are sized for maxNominalRatio; a wider
+    // pair (not a real-world setup) is clamped and plays slow — the editor flags it
+    const double sourceRate = static_cast<double>(connection->ring.getSampleRate());
+    connection->nominalRatio = (sourceRate > 0.0 && config_.dawSampleRate > 0.0)
+        ? (std::min)(sourceRate / config_.dawSampleRate, config_.maxNominalRatio) : 1.0;
+
+    // Allocation and the kernel table happen here, not on the audio thread
+    int quality = qualityParam_ ? static_cast<int>(qualityParam_->load()) : 2;
+    if (quality < 0 || quality > static_cast<int>(directpipe::ResamplerQuality::Sinc64)) quality = 2;
+    connection->quality = quality;
+    connection->resampler.prepare(config_.channels, config_.maxOutputFrames, config_.maxRatio);
+    connection->resampler.configure(static_cast<directpipe::ResamplerQuality>(quality),
+                                    connection->nominalRatio);
+    connection->streamGeneration = generation;
+    return connection;
+}
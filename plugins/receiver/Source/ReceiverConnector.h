@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+#pragma once
+
+#include <directpipe/SharedMemory.h>
+#include <directpipe/RingBuffer.h>
+#include <directpipe/Resampler.h>
+#include <directpipe/StreamRegistry.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief One mapped, attached and validated IPC stream, ready for the audio thread.
+ *
+ * Built entirely on the connector thread (shm_open/mmap, consumer slot claim,
+ * resampler allocation and kernel table), so adopting it on the audio thread
+ * is a pointer swap. Destroyed on the connector thread as well.
+ */
+struct ReceiverConnection {
+    ~ReceiverConnection();
+
+    directpipe::SharedMemory memory;
+    directpipe::RingBuffer ring;
+    directpipe::AdaptiveResampler resampler;   // prepared + configured for this stream
+    double nominalRatio = 1.0;                 // stream rate / DAW rate (clamped)
+    int quality = 2;                           // "quality" choice the kernel was built for
+    uint32_t streamGeneration = 0;             // stream selection this connection was opened for
+};
+
+/**
+ * @brief Background thread that opens IPC connections for the Receiver.
+ *
+ * The audio thread never makes a syscall for the connection: it requests one
+ * with setWanted(true), picks up a finished one with takeReady(), and hands a
+ * finished-with connection back through retire() — the connector thread
+ * detaches and unmaps it. Hand-over in both directions is a single-slot atomic
+ * pointer exchange.
+ */
+class ReceiverConnector {
+public:
+    /// Audio format the connections are prepared for (from prepareToPlay)
+    struct Config {
+        double dawSampleRate = 48000.0;
+        uint32_t channels = 2;
+        uint32_t maxOutputFrames = 512;
+        double maxRatio = 1.0;        // resampler sizing (widest rate ratio x drift bound)
+        double maxNominalRatio = 1.0; // streams beyond this are clamped
+    };
+
+    /// `qualityParam` is the "quality" parameter value (read when building a connection)
+    explicit ReceiverConnector(std::atomic<float>* qualityParam);
+    ~ReceiverConnector();
+
+    ReceiverConnector(const ReceiverConnector&) = delete;
+    ReceiverConnector& operator=(const ReceiverConnector&) = delete;
+
+    /// Start the thread for `config` (stops a running one first)          [Message thread]
+    void start(const Config& config);
+    /// Stop the thread and tear down anything still handed over            [Message thread]
+    void stop();
+
+    /// Select the stream to open; bumps streamGeneration()                 [any non-RT thread]
+    void setStreamId(const std::string& id);
+
+    /// Current stream selection generation                                 [RT]
+    uint32_t streamGeneration() const { return generation_.load(std::memory_order_acquire); }
+    /// Ask for (or stop asking for) a new connection                       [RT]
+    void setWanted(bool wanted) { wanted_.store(wanted, std::memory_order_release); }
+    /// Take the finished connection, if any (caller owns it until retire)  [RT]
+    ReceiverConnection* takeReady() { return ready_.exchange(nullptr, std::memory_order_acq_rel); }
+    /**
+     * @brief Hand a connection back for teardown on the connector thread.  [RT]
+     * @return false if the previous one has not been collected yet — retry next block.
+     */
+    bool retire(ReceiverConnection* connection);
+
+    /// True if the last attempt found every consumer slot taken           [any thread]
+    bool slotsFull() const { return slotsFull_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    std::unique_ptr<ReceiverConnection> connect();
+    void collectRetired();
+
+    std::atomic<float>* qualityParam_;
+    Config config_;                                        // written before the thread starts
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<ReceiverConnection*> ready_{nullptr};      // [connector write, RT take]
+    std::atomic<ReceiverConnection*> retired_{nullptr};    // [RT write, connector take]
+    std::atomic<bool> wanted_{false};                      // [RT write, connector read]
+    std::atomic<bool> slotsFull_{false};                   // [connector write, GUI read]
+    std::atomic<uint32_t> generation_{0};                  // [Message write, RT + connector read]
+
+    std::mutex streamIdMutex_;
+    std::string streamId_;                                 // [guarded by streamIdMutex_]
+    directpipe::StreamRegistry registry_;                  // [connector thread only]
+
+    static constexpr int kPollIntervalMs = 20;             // retire / request latency
+    static constexpr int kRetryIntervalMs = 250;           // between failed connect attempts
+};
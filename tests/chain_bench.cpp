@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+
+/**
+ * @file chain_bench.cpp
+ * @brief Plugin chain dispatch overhead: AudioProcessorGraph vs SerialChainExecutor
+ *
+ * For 1..16 trivial gain stages in series, renders --iterations blocks through
+ *   1. juce::AudioProcessorGraph (audio input node -> stages -> output node,
+ *      the way VSTChain used to wire it), and
+ *   2. SerialChainExecutor with the same processors in one Plan,
+ * and reports ns per block for each plus the per-stage cost of the stages
+ * themselves (measured by calling processBlock directly), so the difference
+ * is the renderer's own overhead.
+ *
+ * Usage: directpipe-chain-bench [--block 256] [--iterations 20000]
+ *
+ * Results go to stdout as one JSON document. Not registered with ctest —
+ * timings depend on the machine and its load.
+ */
+
+#include <JuceHeader.h>
+#include "Audio/SerialChainExecutor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+using namespace directpipe;
+
+namespace {
+
+class GainStage : public juce::AudioProcessor {
+public:
+    GainStage()
+        : AudioProcessor(BusesProperties()
+              .withInput("In", juce::AudioChannelSet::stereo(), true)
+              .withOutput("Out", juce::AudioChannelSet::stereo(), true)) {}
+
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override {
+        buffer.applyGain(0.999f);
+    }
+
+    const juce::String getName() const override { return "Gain"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+};
+
+constexpr double kSampleRate = 48000.0;
+
+template <typename Fn>
+double nsPerBlock(int iterations, juce::AudioBuffer<float>& buffer, Fn&& render)
+{
+    for (int i = 0; i < iterations / 10; ++i) {   // warm-up
+        buffer.clear();
+        render();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        buffer.clear();
+        render();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+double benchGraph(int stages, int blockSize, int iterations)
+{
+    using Graph = juce::AudioProcessorGraph;
+    using IO = Graph::AudioGraphIOProcessor;
+
+    Graph graph;
+    graph.setPlayConfigDetails(2, 2, kSampleRate, blockSize);
+    graph.prepareToPlay(kSampleRate, blockSize);
+
+    auto in = graph.addNode(std::make_unique<IO>(IO::audioInputNode));
+    auto out = graph.addNode(std::make_unique<IO>(IO::audioOutputNode));
+    auto prev = in->nodeID;
+    for (int s = 0; s < stages; ++s) {
+        auto node = graph.addNode(std::make_unique<GainStage>());
+        for (int ch = 0; ch < 2; ++ch)
+            graph.addConnection({ { prev, ch }, { node->nodeID, ch } });
+        prev = node->nodeID;
+    }
+    for (int ch = 0; ch < 2; ++ch)
+        graph.addConnection({ { prev, ch }, { out->nodeID, ch } });
+    graph.rebuild();
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    return nsPerBlock(iterations, buffer, [&] { graph.processBlock(buffer, midi); });
+}
+
+double benchExecutor(int stages, int blockSize, int iterations)
+{
+    SerialChainExecutor executor;
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    for (int s = 0; s < stages; ++s) {
+        auto stage = std::make_shared<GainStage>();
+        stage->setPlayConfigDetails(2, 2, kSampleRate, blockSize);
+        stage->prepareToPlay(kSampleRate, blockSize);
+        plan->addStage(std::move(stage), false);
+    }
+    plan->allocate(2, blockSize);
+    executor.publish(std::move(plan));
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    return nsPerBlock(iterations, buffer, [&] { executor.process(buffer, midi); });
+}
+
+double benchDirect(int stages, int blockSize, int iterations)
+{
+    std::vector<GainStage> processors(static_cast<size_t>(stages));
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    return nsPerBlock(iterations, buffer, [&] {
+        for (auto& p : processors)
+            p.processBlock(buffer, midi);
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int blockSize = 256;
+    int iterations = 20000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--block") == 0)
+            blockSize = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--iterations") == 0)
+            iterations = std::max(10, std::atoi(argv[i + 1]));
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    std::printf("{\n  \"block\": %d,\n  \"iterations\": %d,\n  \"results\": [\n", blockSize, iterations);
+    const int counts[] = { 1, 2, 4, 8, 16 };
+    for (size_t c = 0; c < std::size(counts); ++c) {
+        const int n = counts[c];
+        const double direct = benchDirect(n, blockSize, iterations);
+        const double graph = benchGraph(n, blockSize, iterations);
+        const double serial = benchExecutor(n, blockSize, iterations);
+        std::printf("    { \"stages\": %d, \"direct_ns\": %.0f, \"graph_ns\": %.0f, \"serial_ns\": %.0f,"
+                    " \"graph_overhead_ns\": %.0f, \"serial_overhead_ns\": %.0f }%s\n",
+                    n, direct, graph, serial, graph - direct, serial - direct,
+                    c + 1 < std::size(counts) ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+    return 0;
+}
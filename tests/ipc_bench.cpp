@@ -0,0 +1,365 @@
+/**
+ * @file ipc_bench.cpp
+ * @brief Cross-process IPC latency and throughput benchmark (JSON report)
+ *
+ * Producer half of directpipe-ipc-bench. For every combination of block size,
+ * channel count, ring capacity and ring layout it creates the shared ring and
+ * data event, spawns ipc-test-child in --ipc-bench mode (the consumer) and
+ * runs two phases:
+ *
+ *   1. Latency: --iterations blocks paced like an audio callback, one block
+ *      period at 48 kHz divided by --speed (the child parks in
+ *      NamedEvent::wait() between them). The child measures write -> wakeup
+ *      -> read latency from a stamp in the block (p50/p99/p99.9/max and a
+ *      log2 histogram). A block that does not fit in the ring is dropped
+ *      whole and counted as an overrun, as the host would.
+ *   2. Throughput: blocks written back to back for --duration-ms, signalling
+ *      after each one like SharedMemWriter and waiting whenever the ring is
+ *      full. The child reports the frame rate it sustained.
+ *
+ * Results go to stdout (or --out) as one JSON document, so runs from two
+ * builds can be diffed to catch regressions in the hot IPC path.
+ *
+ * Usage: directpipe-ipc-bench [--blocks 64,128,...] [--channels 1,2]
+ *                             [--capacities 1024,4096,...] [--layouts interleaved,planar]
+ *                             [--iterations N] [--speed N] [--duration-ms N]
+ *                             [--out file.json]
+ *
+ * Not registered with ctest — timings depend on the machine and its load.
+ */
+
+#include "directpipe/SharedMemory.h"
+#include "directpipe/RingBuffer.h"
+#include "directpipe/Constants.h"
+#include "directpipe/Protocol.h"
+#include "directpipe/ClockSync.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+// Must match values in ipc_test_child.cpp
+static constexpr const char* kBenchShmName = "Local\\DirectPipeIpcBench";
+static constexpr const char* kBenchEventName = "Local\\DirectPipeIpcBenchEvent";
+static constexpr uint32_t kBenchPhaseLatency = 1;
+static constexpr uint32_t kBenchPhaseThroughput = 2;
+static constexpr uint32_t kBenchPhaseEnd = 3;
+static constexpr uint32_t kSampleRate = 48000;
+
+struct BenchOptions {
+    std::vector<uint32_t> blocks { 64, 128, 256, 512, 1024 };
+    std::vector<uint32_t> channels { 1, 2 };
+    std::vector<uint32_t> capacities { 1024, 4096, 16384 };
+    std::vector<directpipe::SampleLayout> layouts { directpipe::SampleLayout::Interleaved,
+                                                    directpipe::SampleLayout::Planar };
+    int iterations = 1000;
+    int speed = 8;  // latency phase runs this many times faster than real time
+    int durationMs = 250;
+    std::string outPath;
+};
+
+/// Producer-side counters for the paced phase of one configuration
+struct ProducerStats {
+    uint64_t blocksWritten = 0;
+    uint64_t overrunBlocks = 0;
+    uint64_t overrunFrames = 0;
+};
+
+/// Find ipc-test-child in the same directory as this executable
+static std::string getChildExePath()
+{
+    char buf[4096] = {};
+    ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+    std::string path = len > 0 ? std::string(buf, static_cast<size_t>(len)) : std::string();
+    auto pos = path.find_last_of('/');
+    path = pos != std::string::npos ? path.substr(0, pos + 1) : std::string("./");
+    return path + "ipc-test-child";
+}
+
+static const char* layoutName(directpipe::SampleLayout layout)
+{
+    return layout == directpipe::SampleLayout::Planar ? "planar" : "interleaved";
+}
+
+/// Stamp the block header the child decodes (see runIpcBench in ipc_test_child.cpp)
+static void stampBlock(std::vector<float>& block, uint32_t seq, uint32_t phase)
+{
+    const int64_t stampNs = static_cast<int64_t>(directpipe::steadyClockNs());
+    std::memcpy(&block[0], &stampNs, sizeof(stampNs));
+    std::memcpy(&block[2], &seq, sizeof(seq));
+    std::memcpy(&block[3], &phase, sizeof(phase));
+}
+
+/**
+ * @brief Run one configuration.
+ * @param childJson Receives the child's JSON object (empty on failure).
+ * @return Child exit code (0 = ok), or -1 if setup failed.
+ */
+static int runConfig(const BenchOptions& opts, uint32_t blockFrames, uint32_t channels,
+                     uint32_t capacity, directpipe::SampleLayout layout,
+                     ProducerStats& stats, bool& futexWake, std::string& childJson)
+{
+    using namespace directpipe;
+
+    size_t shmSize = calculateSharedMemorySize(capacity, channels);
+
+    SharedMemory shm;
+    if (!shm.create(kBenchShmName, shmSize)) {
+        fprintf(stderr, "[bench] Failed to create shared memory\n");
+        return -1;
+    }
+
+    RingBuffer producer;
+    producer.initAsProducer(shm.getData(), capacity, channels, kSampleRate,
+                            SampleFormat::Float32, layout);
+    auto* header = static_cast<DirectPipeHeader*>(shm.getData());
+
+    NamedEvent event;
+    if (!event.create(kBenchEventName)) {
+        fprintf(stderr, "[bench] Failed to create named event\n");
+        return -1;
+    }
+    futexWake = event.bindSharedWord(&header->data_seq, &header->consumer_waiting);
+
+    int outPipe[2];
+    if (pipe(outPipe) != 0) {
+        fprintf(stderr, "[bench] pipe() failed\n");
+        return -1;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, outPipe[0]);
+    posix_spawn_file_actions_addclose(&actions, outPipe[1]);
+
+    std::string childPath = getChildExePath();
+    std::string capArg = std::to_string(capacity);
+    std::string chArg = std::to_string(channels);
+    std::string blockArg = std::to_string(blockFrames);
+    char* childArgv[] = {
+        const_cast<char*>(childPath.c_str()),
+        const_cast<char*>("--ipc-bench"),
+        const_cast<char*>(capArg.c_str()),
+        const_cast<char*>(chArg.c_str()),
+        const_cast<char*>(blockArg.c_str()),
+        nullptr
+    };
+
+    pid_t pid = 0;
+    const int spawnRc = posix_spawn(&pid, childPath.c_str(), &actions, nullptr, childArgv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(outPipe[1]);
+    if (spawnRc != 0) {
+        close(outPipe[0]);
+        fprintf(stderr, "[bench] Failed to spawn %s (build ipc-test-child first)\n",
+                childPath.c_str());
+        return -1;
+    }
+
+    // Wait for the child to attach its cursor
+    auto attachDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (producer.getConsumerCount() == 0 && std::chrono::steady_clock::now() < attachDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::vector<float> block(static_cast<size_t>(blockFrames) * channels, 0.0f);
+    uint32_t seq = 0;
+
+    // Phase 1: paced blocks on an absolute schedule (no drift from sleep
+    // overshoot); a full ring drops the whole block
+    const auto period = std::chrono::nanoseconds(
+        static_cast<int64_t>(blockFrames) * 1000000000ll / (static_cast<int64_t>(kSampleRate) * opts.speed));
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < opts.iterations; ++i) {
+        if (waitpid(pid, nullptr, WNOHANG) != 0)
+            break;  // child gave up early
+        next += period;
+        std::this_thread::sleep_until(next);
+        if (producer.availableWrite() >= blockFrames) {
+            stampBlock(block, seq, kBenchPhaseLatency);
+            producer.write(block.data(), blockFrames);
+            event.signal();
+            ++stats.blocksWritten;
+        } else {
+            ++stats.overrunBlocks;
+            stats.overrunFrames += blockFrames;
+        }
+        ++seq;
+    }
+
+    // Phase 2: back-to-back blocks, waiting for space instead of dropping
+    const uint64_t endNs = steadyClockNs() + static_cast<uint64_t>(opts.durationMs) * 1000000ull;
+    while (steadyClockNs() < endNs) {
+        if (producer.availableWrite() < blockFrames) {
+            std::this_thread::yield();
+            continue;
+        }
+        stampBlock(block, seq++, kBenchPhaseThroughput);
+        producer.write(block.data(), blockFrames);
+        event.signal();
+    }
+
+    // End marker: retry until it fits so the child always terminates
+    auto endDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < endDeadline) {
+        if (producer.availableWrite() >= blockFrames) {
+            stampBlock(block, seq, kBenchPhaseEnd);
+            producer.write(block.data(), blockFrames);
+            event.signal();
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    char buf[1024];
+    ssize_t n = 0;
+    while ((n = read(outPipe[0], buf, sizeof(buf))) > 0)
+        childJson.append(buf, static_cast<size_t>(n));
+    close(outPipe[0]);
+    while (!childJson.empty() && (childJson.back() == '\n' || childJson.back() == '\r'))
+        childJson.pop_back();
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    const int exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+
+    producer.detach();
+    event.close();
+    shm.close();
+
+    if (exitCode != 0)
+        childJson.clear();
+    return exitCode;
+}
+
+static bool parseList(const char* arg, std::vector<uint32_t>& out)
+{
+    out.clear();
+    std::string s(arg);
+    size_t pos = 0;
+    while (pos <= s.size()) {
+        size_t comma = s.find(',', pos);
+        if (comma == std::string::npos) comma = s.size();
+        const long v = std::atol(s.substr(pos, comma - pos).c_str());
+        if (v <= 0) return false;
+        out.push_back(static_cast<uint32_t>(v));
+        pos = comma + 1;
+    }
+    return !out.empty();
+}
+
+static bool parseLayouts(const char* arg, std::vector<directpipe::SampleLayout>& out)
+{
+    out.clear();
+    std::string s(arg);
+    size_t pos = 0;
+    while (pos <= s.size()) {
+        size_t comma = s.find(',', pos);
+        if (comma == std::string::npos) comma = s.size();
+        const std::string name = s.substr(pos, comma - pos);
+        if (name == "interleaved") out.push_back(directpipe::SampleLayout::Interleaved);
+        else if (name == "planar") out.push_back(directpipe::SampleLayout::Planar);
+        else return false;
+        pos = comma + 1;
+    }
+    return !out.empty();
+}
+
+static bool parseArgs(int argc, char** argv, BenchOptions& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+        if (arg == "--blocks") { if (!parseList(value, opts.blocks)) return false; }
+        else if (arg == "--channels") { if (!parseList(value, opts.channels)) return false; }
+        else if (arg == "--capacities") { if (!parseList(value, opts.capacities)) return false; }
+        else if (arg == "--layouts") { if (!parseLayouts(value, opts.layouts)) return false; }
+        else if (arg == "--iterations") opts.iterations = std::atoi(value);
+        else if (arg == "--speed") opts.speed = std::atoi(value);
+        else if (arg == "--duration-ms") opts.durationMs = std::atoi(value);
+        else if (arg == "--out") opts.outPath = value;
+        else return false;
+    }
+    for (auto ch : opts.channels)
+        if (ch > 2) return false;  // protocol carries mono or stereo only
+    for (auto cap : opts.capacities)
+        if ((cap & (cap - 1)) != 0) return false;  // ring capacity must be a power of 2
+    return opts.iterations > 0 && opts.speed > 0 && opts.durationMs > 0;
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        fprintf(stderr, "usage: directpipe-ipc-bench [--blocks 64,128,...] [--channels 1,2]\n"
+                        "         [--capacities 1024,4096,...] [--layouts interleaved,planar]\n"
+                        "         [--iterations N] [--speed N] [--duration-ms N] [--out file.json]\n");
+        return 2;
+    }
+
+    FILE* out = stdout;
+    if (!opts.outPath.empty()) {
+        out = std::fopen(opts.outPath.c_str(), "w");
+        if (out == nullptr) {
+            fprintf(stderr, "[bench] Cannot write %s\n", opts.outPath.c_str());
+            return 2;
+        }
+    }
+
+    fprintf(out, "{\n  \"benchmark\": \"directpipe-ipc-bench\",\n  \"protocol_version\": %u,\n"
+                 "  \"sample_rate\": %u,\n  \"iterations\": %d,\n  \"speed\": %d,\n"
+                 "  \"duration_ms\": %d,\n  \"results\": [",
+            directpipe::PROTOCOL_VERSION, kSampleRate, opts.iterations, opts.speed,
+            opts.durationMs);
+
+    int failures = 0;
+    bool first = true;
+    for (auto layout : opts.layouts)
+    for (auto capacity : opts.capacities)
+    for (auto channels : opts.channels)
+    for (auto blockFrames : opts.blocks) {
+        if (blockFrames > capacity || blockFrames * channels < 4)
+            continue;  // does not fit the ring / the block header
+
+        ProducerStats stats;
+        bool futexWake = false;
+        std::string childJson;
+        const int rc = runConfig(opts, blockFrames, channels, capacity, layout,
+                                 stats, futexWake, childJson);
+        if (rc != 0) ++failures;
+
+        fprintf(stderr, "[bench] %-11s cap=%-6u ch=%u block=%-5u %s\n",
+                layoutName(layout), capacity, channels, blockFrames,
+                rc == 0 ? "ok" : "FAILED");
+
+        fprintf(out, "%s\n    {\"layout\": \"%s\", \"capacity_frames\": %u, \"channels\": %u, "
+                     "\"block_frames\": %u, \"wake\": \"%s\", \"status\": %d,\n"
+                     "     \"producer\": {\"blocks_written\": %llu, \"overrun_blocks\": %llu, "
+                     "\"overrun_frames\": %llu},\n"
+                     "     \"consumer\": %s}",
+                first ? "" : ",", layoutName(layout), capacity, channels, blockFrames,
+                futexWake ? "futex" : "semaphore", rc,
+                static_cast<unsigned long long>(stats.blocksWritten),
+                static_cast<unsigned long long>(stats.overrunBlocks),
+                static_cast<unsigned long long>(stats.overrunFrames),
+                childJson.empty() ? "null" : childJson.c_str());
+        first = false;
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+    if (out != stdout)
+        std::fclose(out);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -6,22 +6,38 @@
  * Opens shared memory created by the parent, reads audio data,
  * verifies data integrity, and returns exit code 0 on success.
  *
+ * Also serves as the consumer half of ipc-wake-bench:
+ *   ipc-test-child --wake-bench <sem|futex> <iterations>
+ * waits on the data event, and for every frame received measures the time
+ * since the parent stamped it, then prints p50/p99/max wake-up latency.
+ *
+ * And as the consumer half of directpipe-ipc-bench:
+ *   ipc-test-child --ipc-bench <capacity> <channels> <block_frames>
+ * reads stamped blocks until the end marker and prints one JSON object
+ * (latency histogram, received frames, lost blocks) on stdout.
+ *
  * Exit codes:
- *   0 = success (all blocks verified)
- *   1 = failed to open shared memory
+ *   0 = success (all blocks verified / benchmark complete)
+ *   1 = failed to open shared memory (or named event)
  *   2 = failed to attach ring buffer
  *   3 = producer not active
  *   4 = data verification failed
  *   5 = incomplete read (fewer blocks than expected)
+ *   6 = bad command line
  */
 
 #include "directpipe/SharedMemory.h"
 #include "directpipe/RingBuffer.h"
 #include "directpipe/Constants.h"
 #include "directpipe/Protocol.h"
+#include "directpipe/ClockSync.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <string>
 #include <vector>
 
 #ifdef _WIN32
@@ -38,10 +54,248 @@ static constexpr uint32_t kSampleRate = 48000;
 static constexpr uint32_t kFramesPerBlock = 128;
 static constexpr int kExpectedBlocks = 50;
 
-int main()
+// Must match values in ipc_wake_bench.cpp
+static constexpr const char* kWakeShmName = "Local\\DirectPipeWakeBench";
+static constexpr const char* kWakeEventName = "Local\\DirectPipeWakeBenchEvent";
+static constexpr uint32_t kWakeCapacity = 1024;
+
+// Must match values in ipc_bench.cpp
+static constexpr const char* kBenchShmName = "Local\\DirectPipeIpcBench";
+static constexpr const char* kBenchEventName = "Local\\DirectPipeIpcBenchEvent";
+static constexpr uint32_t kBenchPhaseLatency = 1;
+static constexpr uint32_t kBenchPhaseThroughput = 2;
+static constexpr uint32_t kBenchPhaseEnd = 3;
+static constexpr int kBenchHistogramBuckets = 18;  // <=1us, <=2us ... <=65536us, overflow
+
+/// Consumer side of ipc-wake-bench. Each frame carries the parent's
+/// steady_clock timestamp (ns) bit-copied into its two float samples.
+static int runWakeBench(bool useFutex, int iterations)
+{
+    using namespace directpipe;
+
+    size_t shmSize = calculateSharedMemorySize(kWakeCapacity, kChannels);
+
+    SharedMemory shm;
+    if (!shm.open(kWakeShmName, shmSize)) {
+        fprintf(stderr, "[child] Failed to open shared memory '%s'\n", kWakeShmName);
+        return 1;
+    }
+
+    NamedEvent event;
+    if (!event.open(kWakeEventName)) {
+        fprintf(stderr, "[child] Failed to open event '%s'\n", kWakeEventName);
+        return 1;
+    }
+
+    auto* header = static_cast<DirectPipeHeader*>(shm.getData());
+    if (useFutex && !event.bindSharedWord(&header->data_seq, &header->consumer_waiting)) {
+        fprintf(stderr, "[child] Futex wake word not available on this platform\n");
+        return 1;
+    }
+
+    RingBuffer consumer;
+    if (!consumer.attachAsConsumer(shm.getData())) {
+        fprintf(stderr, "[child] Failed to attach ring buffer\n");
+        return 2;
+    }
+
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(static_cast<size_t>(iterations));
+    float frame[kChannels] = {};
+
+    while (static_cast<int>(latenciesUs.size()) < iterations) {
+        if (!event.wait(2000))
+            break;
+        const auto wokeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        while (consumer.read(frame, 1) == 1) {
+            int64_t stampNs = 0;
+            std::memcpy(&stampNs, frame, sizeof(stampNs));
+            latenciesUs.push_back(static_cast<double>(wokeNs - stampNs) / 1000.0);
+        }
+    }
+
+    consumer.detach();
+    event.close();
+    shm.close();
+
+    if (static_cast<int>(latenciesUs.size()) < iterations) {
+        fprintf(stderr, "[child] Only received %zu of %d wakeups\n", latenciesUs.size(), iterations);
+        return 5;
+    }
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto percentile = [&](double p) {
+        size_t idx = static_cast<size_t>(p * static_cast<double>(latenciesUs.size() - 1) + 0.5);
+        return latenciesUs[idx];
+    };
+
+    fprintf(stdout, "[child] wake-bench %-5s n=%d  p50=%8.2f us  p99=%8.2f us  max=%8.2f us\n",
+            useFutex ? "futex" : "sem", iterations,
+            percentile(0.50), percentile(0.99), latenciesUs.back());
+    return 0;
+}
+
+/// Consumer side of directpipe-ipc-bench. Every block starts with a header
+/// bit-copied into its first four float samples: steadyClockNs() stamp taken
+/// just before write() (int64), block sequence number and phase (uint32 each).
+/// Latency is measured after read() returns, i.e. write -> wakeup -> read.
+static int runIpcBench(uint32_t capacity, uint32_t channels, uint32_t blockFrames)
+{
+    using namespace directpipe;
+
+    size_t shmSize = calculateSharedMemorySize(capacity, channels);
+
+    SharedMemory shm;
+    if (!shm.open(kBenchShmName, shmSize)) {
+        fprintf(stderr, "[child] Failed to open shared memory '%s'\n", kBenchShmName);
+        return 1;
+    }
+
+    NamedEvent event;
+    if (!event.open(kBenchEventName)) {
+        fprintf(stderr, "[child] Failed to open event '%s'\n", kBenchEventName);
+        return 1;
+    }
+
+    // Same wake path as SharedMemWriter: futex word where available, else semaphore
+    auto* header = static_cast<DirectPipeHeader*>(shm.getData());
+    event.bindSharedWord(&header->data_seq, &header->consumer_waiting);
+
+    RingBuffer consumer;
+    if (!consumer.attachAsConsumer(shm.getData())) {
+        fprintf(stderr, "[child] Failed to attach ring buffer\n");
+        return 2;
+    }
+
+    std::vector<float> block(static_cast<size_t>(blockFrames) * channels);
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(4096);
+    uint64_t histogram[kBenchHistogramBuckets] = {};
+
+    uint32_t expectedSeq = 0;
+    uint64_t lostBlocks = 0;
+    uint64_t partialBlocks = 0;
+    uint64_t throughputFrames = 0;
+    uint64_t throughputFirstNs = 0;
+    uint64_t throughputLastNs = 0;
+    bool done = false;
+
+    while (!done) {
+        if (!event.wait(2000))
+            break;
+        uint32_t got = 0;
+        while (!done && (got = consumer.read(block.data(), blockFrames)) > 0) {
+            const uint64_t nowNs = steadyClockNs();
+            if (got != blockFrames) {
+                ++partialBlocks;  // producer only writes whole blocks
+                continue;
+            }
+
+            int64_t stampNs = 0;
+            uint32_t seq = 0, phase = 0;
+            std::memcpy(&stampNs, &block[0], sizeof(stampNs));
+            std::memcpy(&seq, &block[2], sizeof(seq));
+            std::memcpy(&phase, &block[3], sizeof(phase));
+
+            if (phase == kBenchPhaseEnd) {
+                done = true;
+                break;
+            }
+            if (seq != expectedSeq)
+                lostBlocks += static_cast<uint32_t>(seq - expectedSeq);
+            expectedSeq = seq + 1;
+
+            if (phase == kBenchPhaseLatency) {
+                const double us = static_cast<double>(static_cast<int64_t>(nowNs) - stampNs) / 1000.0;
+                latenciesUs.push_back(us);
+                int bucket = 0;
+                while (bucket < kBenchHistogramBuckets - 1 && us > static_cast<double>(1u << bucket))
+                    ++bucket;
+                ++histogram[bucket];
+            } else if (phase == kBenchPhaseThroughput) {
+                if (throughputFrames == 0)
+                    throughputFirstNs = nowNs;
+                throughputLastNs = nowNs;
+                throughputFrames += got;
+            }
+        }
+    }
+
+    const uint32_t sampleRate = header->sample_rate;
+    consumer.detach();
+    event.close();
+    shm.close();
+
+    if (!done) {
+        fprintf(stderr, "[child] Timed out before the end marker (%zu latency samples)\n",
+                latenciesUs.size());
+        return 5;
+    }
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto percentile = [&](double p) {
+        if (latenciesUs.empty()) return 0.0;
+        size_t idx = static_cast<size_t>(p * static_cast<double>(latenciesUs.size() - 1) + 0.5);
+        return latenciesUs[idx];
+    };
+
+    const double elapsedSec = static_cast<double>(throughputLastNs - throughputFirstNs) / 1e9;
+    const double framesPerSec = elapsedSec > 0.0 ? static_cast<double>(throughputFrames) / elapsedSec : 0.0;
+
+    fprintf(stdout, "{\"latency_us\":{\"samples\":%zu,\"p50\":%.2f,\"p99\":%.2f,\"p999\":%.2f,\"max\":%.2f,"
+                    "\"histogram\":[",
+            latenciesUs.size(), percentile(0.50), percentile(0.99), percentile(0.999),
+            latenciesUs.empty() ? 0.0 : latenciesUs.back());
+    for (int b = 0; b < kBenchHistogramBuckets; ++b) {
+        if (b < kBenchHistogramBuckets - 1)
+            fprintf(stdout, "%s{\"le_us\":%u,\"count\":%llu}", b ? "," : "", 1u << b,
+                    static_cast<unsigned long long>(histogram[b]));
+        else
+            fprintf(stdout, ",{\"le_us\":null,\"count\":%llu}",
+                    static_cast<unsigned long long>(histogram[b]));
+    }
+    fprintf(stdout, "]},\"received_frames\":%llu,\"frames_per_sec\":%.0f,\"realtime_factor\":%.1f,"
+                    "\"lost_blocks\":%llu,\"partial_blocks\":%llu}\n",
+            static_cast<unsigned long long>(throughputFrames), framesPerSec,
+            sampleRate > 0 ? framesPerSec / sampleRate : 0.0,
+            static_cast<unsigned long long>(lostBlocks),
+            static_cast<unsigned long long>(partialBlocks));
+    return 0;
+}
+
+int main(int argc, char** argv)
 {
     using namespace directpipe;
 
+    if (argc > 1 && std::strcmp(argv[1], "--ipc-bench") == 0) {
+        const long capacity = argc == 5 ? std::atol(argv[2]) : 0;
+        const long channels = argc == 5 ? std::atol(argv[3]) : 0;
+        const long blockFrames = argc == 5 ? std::atol(argv[4]) : 0;
+        if (capacity <= 0 || channels <= 0 || channels > 2
+            || blockFrames <= 0 || blockFrames > capacity || blockFrames * channels < 4) {
+            fprintf(stderr, "[child] Bad ipc-bench arguments\n");
+            return 6;
+        }
+        return runIpcBench(static_cast<uint32_t>(capacity), static_cast<uint32_t>(channels),
+                           static_cast<uint32_t>(blockFrames));
+    }
+
+    if (argc > 1) {
+        if (argc != 4 || std::strcmp(argv[1], "--wake-bench") != 0) {
+            fprintf(stderr, "usage: ipc-test-child [--wake-bench <sem|futex> <iterations>]\n"
+                            "       ipc-test-child [--ipc-bench <capacity> <channels> <block_frames>]\n");
+            return 6;
+        }
+        const std::string mode = argv[2];
+        const int iterations = std::atoi(argv[3]);
+        if ((mode != "sem" && mode != "futex") || iterations <= 0) {
+            fprintf(stderr, "[child] Bad wake-bench arguments\n");
+            return 6;
+        }
+        return runWakeBench(mode == "futex", iterations);
+    }
+
     size_t shmSize = calculateSharedMemorySize(kCapacity, kChannels);
 
     SharedMemory shm;
@@ -0,0 +1,159 @@
+/**
+ * @file ipc_wake_bench.cpp
+ * @brief Cross-process wake-up latency benchmark: named semaphore vs futex
+ *
+ * Producer half of the benchmark. Spawns ipc-test-child in --wake-bench mode
+ * (the consumer), then for each iteration waits long enough for the child to
+ * park in NamedEvent::wait(), stamps one frame with steady_clock time, writes
+ * it to the ring and signals. The child reports p50/p99/max latency from the
+ * stamp to its wakeup.
+ *
+ * Runs the semaphore path (sem_post / sem_timedwait) first, then the futex
+ * wake word in DirectPipeHeader (data_seq / consumer_waiting).
+ *
+ * Usage: ipc-wake-bench [iterations]   (default 2000)
+ *
+ * Not registered with ctest — timings depend on the machine and its load.
+ */
+
+#include "directpipe/SharedMemory.h"
+#include "directpipe/RingBuffer.h"
+#include "directpipe/Constants.h"
+#include "directpipe/Protocol.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+// Must match values in ipc_test_child.cpp
+static constexpr const char* kWakeShmName = "Local\\DirectPipeWakeBench";
+static constexpr const char* kWakeEventName = "Local\\DirectPipeWakeBenchEvent";
+static constexpr uint32_t kWakeCapacity = 1024;
+static constexpr uint32_t kChannels = 2;
+static constexpr uint32_t kSampleRate = 48000;
+
+/// Time between signals — long enough that the child is parked in the
+/// kernel, so every sample measures a real wakeup rather than a spin
+static constexpr auto kSignalInterval = std::chrono::microseconds(1000);
+
+/// Find ipc-test-child in the same directory as this executable
+static std::string getChildExePath()
+{
+    char buf[4096] = {};
+    ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+    std::string path = len > 0 ? std::string(buf, static_cast<size_t>(len)) : std::string();
+    auto pos = path.find_last_of('/');
+    path = pos != std::string::npos ? path.substr(0, pos + 1) : std::string("./");
+    return path + "ipc-test-child";
+}
+
+static int runMode(const char* mode, int iterations)
+{
+    using namespace directpipe;
+
+    const bool useFutex = std::strcmp(mode, "futex") == 0;
+    size_t shmSize = calculateSharedMemorySize(kWakeCapacity, kChannels);
+
+    SharedMemory shm;
+    if (!shm.create(kWakeShmName, shmSize)) {
+        fprintf(stderr, "[bench] Failed to create shared memory\n");
+        return 1;
+    }
+
+    RingBuffer producer;
+    producer.initAsProducer(shm.getData(), kWakeCapacity, kChannels, kSampleRate);
+    auto* header = static_cast<DirectPipeHeader*>(shm.getData());
+
+    NamedEvent event;
+    if (!event.create(kWakeEventName)) {
+        fprintf(stderr, "[bench] Failed to create named event\n");
+        return 1;
+    }
+    if (useFutex && !event.bindSharedWord(&header->data_seq, &header->consumer_waiting)) {
+        fprintf(stderr, "[bench] Futex wake word not available on this platform\n");
+        return 1;
+    }
+
+    std::string childPath = getChildExePath();
+    std::string iterArg = std::to_string(iterations);
+    char* childArgv[] = {
+        const_cast<char*>(childPath.c_str()),
+        const_cast<char*>("--wake-bench"),
+        const_cast<char*>(mode),
+        const_cast<char*>(iterArg.c_str()),
+        nullptr
+    };
+
+    pid_t pid = 0;
+    if (posix_spawn(&pid, childPath.c_str(), nullptr, nullptr, childArgv, environ) != 0) {
+        fprintf(stderr, "[bench] Failed to spawn %s (build ipc-test-child first)\n",
+                childPath.c_str());
+        return 1;
+    }
+
+    // Wait for the child to attach its cursor
+    auto attachDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (producer.getConsumerCount() == 0 && std::chrono::steady_clock::now() < attachDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    uint32_t parkedSignals = 0;
+    int sent = 0;
+    for (; sent < iterations; ++sent) {
+        if (waitpid(pid, nullptr, WNOHANG) != 0)
+            break;  // child gave up early
+
+        std::this_thread::sleep_for(kSignalInterval);
+
+        if (header->consumer_waiting.load(std::memory_order_relaxed) != 0)
+            ++parkedSignals;
+
+        const int64_t stampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        float frame[kChannels] = {};
+        std::memcpy(frame, &stampNs, sizeof(stampNs));
+        producer.write(frame, 1);
+        event.signal();
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    const int exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+
+    if (useFutex) {
+        fprintf(stdout, "[bench] futex: %u of %d signals found a parked reader (FUTEX_WAKE issued)\n",
+                parkedSignals, sent);
+    }
+
+    producer.detach();
+    event.close();
+    shm.close();
+
+    if (exitCode != 0)
+        fprintf(stderr, "[bench] %s child exited with code %d\n", mode, exitCode);
+    return exitCode;
+}
+
+int main(int argc, char** argv)
+{
+    static_assert(sizeof(int64_t) == kChannels * sizeof(float),
+                  "One stereo frame must carry a 64-bit timestamp");
+
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+    if (iterations <= 0) {
+        fprintf(stderr, "usage: ipc-wake-bench [iterations]\n");
+        return 2;
+    }
+
+    int rc = runMode("sem", iterations);
+    rc |= runMode("futex", iterations);
+    return rc == 0 ? 0 : 1;
+}
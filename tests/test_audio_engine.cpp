@@ -6,8 +6,48 @@
 #include "Audio/AudioEngine.h"
 #include "Audio/DeviceState.h"
 
+#include <array>
+#include <cmath>
+#include <thread>
+#include <vector>
+
 using namespace directpipe;
 
+namespace {
+
+/// Stereo device that advertises 256-sample buffers; the test drives the
+/// callback itself with whatever block sizes it likes
+class FakeAudioIODevice : public juce::AudioIODevice {
+public:
+    FakeAudioIODevice() : juce::AudioIODevice("Fake", "Fake") {}
+
+    juce::StringArray getOutputChannelNames() override { return { "L", "R" }; }
+    juce::StringArray getInputChannelNames() override { return { "L", "R" }; }
+    juce::Array<double> getAvailableSampleRates() override { return { 48000.0 }; }
+    juce::Array<int> getAvailableBufferSizes() override { return { kBufferSize }; }
+    int getDefaultBufferSize() override { return kBufferSize; }
+
+    juce::String open(const juce::BigInteger&, const juce::BigInteger&, double, int) override { return {}; }
+    void close() override {}
+    bool isOpen() override { return true; }
+    void start(juce::AudioIODeviceCallback*) override {}
+    void stop() override {}
+    bool isPlaying() override { return true; }
+    juce::String getLastError() override { return {}; }
+
+    int getCurrentBufferSizeSamples() override { return kBufferSize; }
+    double getCurrentSampleRate() override { return 48000.0; }
+    int getCurrentBitDepth() override { return 32; }
+    juce::BigInteger getActiveOutputChannels() const override { return juce::BigInteger(3); }
+    juce::BigInteger getActiveInputChannels() const override { return juce::BigInteger(3); }
+    int getOutputLatencyInSamples() override { return 0; }
+    int getInputLatencyInSamples() override { return 0; }
+
+    static constexpr int kBufferSize = 256;
+};
+
+} // namespace
+
 class AudioEngineTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -101,6 +141,134 @@ TEST_F(AudioEngineTest, SampleRatePropagation) {
     EXPECT_GE(rates.size(), 0);
 }
 
+TEST_F(AudioEngineTest, OversizedCallbacksProcessEverySample) {
+    juce::MessageManager::getInstance();
+    FakeAudioIODevice device;
+    juce::AudioIODeviceCallback& callback = *engine_;
+    callback.audioDeviceAboutToStart(&device);
+    engine_->setSafetyHeadroomEnabled(false);
+
+    // Driver hands over more than the advertised 256 samples now and then
+    const std::vector<int> sizes = { 256, 512, 100, 1000, 256 };
+    bool allPassed = true;
+    std::thread audioThread([&] {
+        int64_t frame = 0;
+        for (int size : sizes) {
+            std::vector<float> inL(static_cast<size_t>(size)), inR, outL(inL.size(), 9.0f), outR(outL);
+            for (int i = 0; i < size; ++i)
+                inL[static_cast<size_t>(i)] = 0.25f * std::sin(0.05f * static_cast<float>(frame + i));
+            inR = inL;
+            frame += size;
+            const float* in[2] = { inL.data(), inR.data() };
+            float* out[2] = { outL.data(), outR.data() };
+            callback.audioDeviceIOCallbackWithContext(in, 2, out, 2, size, {});
+            for (size_t i = 0; i < inL.size(); ++i)
+                if (std::abs(outL[i] - inL[i]) > 1.0e-3f || std::abs(outR[i] - inR[i]) > 1.0e-3f)
+                    allPassed = false;
+        }
+    });
+    audioThread.join();
+
+    // Every sample, including the tail past 256, went through the pipeline
+    EXPECT_TRUE(allPassed);
+    EXPECT_EQ(engine_->getOversizedCallbackCount(), 2u);
+
+    callback.audioDeviceStopped();
+}
+
+TEST_F(AudioEngineTest, EveryCallbackStageIsTimedPerSubBlock) {
+    juce::MessageManager::getInstance();
+    FakeAudioIODevice device;
+    juce::AudioIODeviceCallback& callback = *engine_;
+    callback.audioDeviceAboutToStart(&device);
+
+    // 10 callbacks, one of them split in two: 11 sub-blocks
+    std::thread audioThread([&] {
+        std::vector<float> inL(512, 0.1f), inR(inL), outL(inL.size()), outR(inL.size());
+        const float* in[2] = { inL.data(), inR.data() };
+        float* out[2] = { outL.data(), outR.data() };
+        for (int i = 0; i < 10; ++i)
+            callback.audioDeviceIOCallbackWithContext(in, 2, out, 2, i == 4 ? 512 : 256, {});
+    });
+    audioThread.join();
+
+    std::array<StageTimingSnapshot, kNumCallbackStages> stages;
+    engine_->getLatencyMonitor().getStageTimings(stages);
+    for (int i = 0; i < kNumCallbackStages; ++i) {
+        const auto& st = stages[static_cast<size_t>(i)];
+        EXPECT_EQ(st.count, 11u) << callbackStageName(static_cast<CallbackStage>(i));
+        EXPECT_LE(st.percentileUs(0.5), st.percentileUs(0.99));
+        EXPECT_LE(st.percentileUs(0.99), static_cast<double>(st.maxNs) / 1000.0);
+    }
+
+    // Restarting the device starts the histograms over
+    callback.audioDeviceStopped();
+    callback.audioDeviceAboutToStart(&device);
+    engine_->getLatencyMonitor().getStageTimings(stages);
+    EXPECT_EQ(stages[static_cast<size_t>(CallbackStage::Chain)].count, 0u);
+    callback.audioDeviceStopped();
+}
+
+TEST(LatencyMonitorTest, StageTimingBinsDoublePerMicrosecond) {
+    EXPECT_EQ(stageTimingBin(0), 0);
+    EXPECT_EQ(stageTimingBin(999), 0);
+    EXPECT_EQ(stageTimingBin(1000), 1);
+    EXPECT_EQ(stageTimingBin(3999), 2);
+    EXPECT_EQ(stageTimingBin(4000), 3);
+    EXPECT_EQ(stageTimingBin(100000000), kStageTimingBins - 1);
+
+    // 90 samples at ~3 us, 10 at ~40 us: the median is in [2, 4) us, p99 in [32, 64) us
+    StageTimingSnapshot st;
+    st.histogram[static_cast<size_t>(stageTimingBin(3000))] = 90;
+    st.histogram[static_cast<size_t>(stageTimingBin(40000))] = 10;
+    st.count = 100;
+    st.maxNs = 41000;
+    EXPECT_DOUBLE_EQ(st.percentileUs(0.5), 4.0);
+    EXPECT_DOUBLE_EQ(st.percentileUs(0.99), 41.0);   // Capped at the observed max
+    EXPECT_DOUBLE_EQ(StageTimingSnapshot{}.percentileUs(0.99), 0.0);
+}
+
+TEST_F(AudioEngineTest, FixedProcessingBlockDelaysByReportedLatency) {
+    juce::MessageManager::getInstance();
+    engine_->setProcessingBlockSize(480);
+    EXPECT_EQ(engine_->getProcessingBlockSize(), 480);
+
+    FakeAudioIODevice device;
+    juce::AudioIODeviceCallback& callback = *engine_;
+    callback.audioDeviceAboutToStart(&device);
+    engine_->setSafetyHeadroomEnabled(false);
+
+    // 256-sample device blocks into a 480-sample chain: 480 - gcd(256, 480)
+    const int latency = engine_->getLatencyMonitor().getBlockAdapterLatencySamples();
+    EXPECT_EQ(latency, 448);
+
+    std::vector<float> input, output;
+    std::thread audioThread([&] {
+        for (int block = 0; block < 40; ++block) {
+            std::vector<float> in(FakeAudioIODevice::kBufferSize), outL(in.size()), outR(in.size());
+            for (size_t i = 0; i < in.size(); ++i)
+                in[i] = 0.25f * std::sin(0.05f * static_cast<float>(input.size() + i));
+            const float* ins[2] = { in.data(), in.data() };
+            float* outs[2] = { outL.data(), outR.data() };
+            callback.audioDeviceIOCallbackWithContext(ins, 2, outs, 2, FakeAudioIODevice::kBufferSize, {});
+            input.insert(input.end(), in.begin(), in.end());
+            output.insert(output.end(), outL.begin(), outL.end());
+        }
+    });
+    audioThread.join();
+
+    // The adapter delay is exact and stays put for a steady device block size
+    EXPECT_EQ(engine_->getLatencyMonitor().getBlockAdapterLatencySamples(), latency);
+    for (size_t i = 0; i < output.size(); ++i) {
+        const float expected = i < static_cast<size_t>(latency) ? 0.0f : input[i - static_cast<size_t>(latency)];
+        ASSERT_NEAR(output[i], expected, 1.0e-3f) << "frame " << i;
+    }
+
+    callback.audioDeviceStopped();
+    engine_->setProcessingBlockSize(0);
+    EXPECT_EQ(engine_->getProcessingBlockSize(), 0);
+}
+
 // ─── DeviceState state machine tests (pure function, no device needed) ───
 
 TEST_F(AudioEngineTest, SafetyHeadroomDefaultAndClamp) {
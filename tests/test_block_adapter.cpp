@@ -0,0 +1,122 @@
+/**
+ * @file test_block_adapter.cpp
+ * @brief Unit tests for the fixed processing quantum adapter
+ */
+
+#include <gtest/gtest.h>
+#include "directpipe/BlockAdapter.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace directpipe;
+
+namespace {
+
+/// Run `sizes` (cycled until `totalFrames`) through the adapter with a ramp on
+/// both channels. The quantum callback adds 1.0 so processed audio is told
+/// apart from the primed silence. Returns the left output.
+std::vector<float> runStream(FixedBlockAdapter& adapter, const std::vector<uint32_t>& sizes,
+                             uint32_t totalFrames, std::vector<uint32_t>* quanta = nullptr)
+{
+    std::vector<float> result;
+    uint32_t frame = 0;
+    for (size_t i = 0; frame < totalFrames; ++i) {
+        const uint32_t n = sizes[i % sizes.size()];
+        std::vector<float> left(n), right(n);
+        for (uint32_t j = 0; j < n; ++j)
+            left[j] = right[j] = static_cast<float>(frame + j);
+        float* io[2] = { left.data(), right.data() };
+        adapter.process(io, 2, n, [&](float* const* data, uint32_t channels, uint32_t frames) {
+            if (quanta)
+                quanta->push_back(frames);
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                for (uint32_t j = 0; j < frames; ++j)
+                    data[ch][j] += 1.0f;
+        });
+        for (uint32_t j = 0; j < n; ++j)
+            EXPECT_EQ(left[j], right[j]);
+        result.insert(result.end(), left.begin(), left.end());
+        frame += n;
+    }
+    return result;
+}
+
+/// Output frame i should be input frame i - latency (processed), or silence before it
+void expectDelayed(const std::vector<float>& out, uint32_t latency, size_t from = 0)
+{
+    for (size_t i = from; i < out.size(); ++i) {
+        const float expected = i < latency ? 0.0f : static_cast<float>(i - latency) + 1.0f;
+        ASSERT_EQ(out[i], expected) << "frame " << i << " latency " << latency;
+    }
+}
+
+} // namespace
+
+TEST(FixedBlockAdapterTest, MinimumLatencyForSteadyBlocks) {
+    EXPECT_EQ(FixedBlockAdapter::minimumLatency(480, 480), 0u);
+    EXPECT_EQ(FixedBlockAdapter::minimumLatency(128, 512), 0u);
+    EXPECT_EQ(FixedBlockAdapter::minimumLatency(480, 512), 448u);
+    EXPECT_EQ(FixedBlockAdapter::minimumLatency(480, 128), 448u);
+    EXPECT_EQ(FixedBlockAdapter::minimumLatency(256, 441), 255u);
+    EXPECT_EQ(FixedBlockAdapter::minimumLatency(480, 0), 479u);
+    EXPECT_EQ(FixedBlockAdapter::minimumLatency(0, 512), 0u);
+}
+
+TEST(FixedBlockAdapterTest, SteadyBlocksAreDelayedByExactlyTheReportedLatency) {
+    const uint32_t quanta[] = { 128, 256, 480 };
+    const uint32_t blocks[] = { 64, 128, 256, 441, 480, 512, 1024 };
+    for (uint32_t q : quanta) {
+        for (uint32_t b : blocks) {
+            FixedBlockAdapter adapter;
+            adapter.prepare(2, q, b, b);
+            std::vector<uint32_t> seen;
+            const auto out = runStream(adapter, { b }, 20 * 480, &seen);
+            EXPECT_EQ(adapter.latencyFrames(), FixedBlockAdapter::minimumLatency(q, b)) << q << "/" << b;
+            EXPECT_EQ(adapter.underruns(), 0u) << q << "/" << b;
+            expectDelayed(out, adapter.latencyFrames());
+            ASSERT_FALSE(seen.empty());
+            for (uint32_t frames : seen)
+                ASSERT_EQ(frames, q);
+        }
+    }
+}
+
+TEST(FixedBlockAdapterTest, IrregularBlocksGrowTheDelayButNeverPastAQuantum) {
+    FixedBlockAdapter adapter;
+    adapter.prepare(2, 480, 480, 1024);
+    EXPECT_EQ(adapter.latencyFrames(), 0u);
+
+    // A driver that mostly delivers 480 but sometimes splits a period
+    const auto out = runStream(adapter, { 480, 480, 200, 280, 480, 100, 1000, 340 }, 50 * 480);
+    EXPECT_GT(adapter.underruns(), 0u);
+    EXPECT_LE(adapter.latencyFrames(), 479u);
+
+    // Once the delay has settled the output is the input, delayed exactly
+    const uint32_t settled = adapter.latencyFrames();
+    std::vector<float> tail(out.end() - 4 * 480, out.end());
+    const size_t tailStart = out.size() - tail.size();
+    for (size_t i = 0; i < tail.size(); ++i)
+        ASSERT_EQ(tail[i], static_cast<float>(tailStart + i - settled) + 1.0f) << "frame " << i;
+}
+
+TEST(FixedBlockAdapterTest, ResetReturnsToTheInitialDelay) {
+    FixedBlockAdapter adapter;
+    adapter.prepare(2, 256, 512, 512);
+    runStream(adapter, { 512, 100, 412 }, 10 * 512);
+    adapter.reset();
+    EXPECT_EQ(adapter.latencyFrames(), 0u);
+    expectDelayed(runStream(adapter, { 512 }, 8 * 512), 0);
+}
+
+TEST(FixedBlockAdapterTest, ZeroQuantumProcessesInPlace) {
+    FixedBlockAdapter adapter;
+    adapter.prepare(2, 0, 256, 256);
+    std::vector<uint32_t> seen;
+    const auto out = runStream(adapter, { 256, 100 }, 1000, &seen);
+    EXPECT_EQ(adapter.latencyFrames(), 0u);
+    expectDelayed(out, 0);
+    ASSERT_GE(seen.size(), 2u);
+    EXPECT_EQ(seen[0], 256u);
+    EXPECT_EQ(seen[1], 100u);
+}
@@ -0,0 +1,207 @@
+/**
+ * @file test_concealment.cpp
+ * @brief Unit tests for the Receiver's packet-loss concealment (waveform repeat)
+ */
+
+#include <gtest/gtest.h>
+#include "directpipe/Concealment.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace directpipe;
+
+namespace {
+
+constexpr double kRate = 48000.0;
+constexpr uint32_t kBlock = 256;
+constexpr double kPi = 3.14159265358979323846;
+
+uint32_t msFrames(double ms) { return static_cast<uint32_t>(std::lround(ms * kRate / 1000.0)); }
+
+/// Stereo sine source with a running phase; `gapFrames` skips the source
+/// forward like a producer whose blocks were lost
+struct Sine {
+    double hz = 220.0;
+    float amplitude = 0.5f;
+    uint64_t frame = 0;
+    float at(uint64_t n) const
+    {
+        return amplitude * static_cast<float>(std::sin(2.0 * kPi * hz * static_cast<double>(n) / kRate));
+    }
+};
+
+/// Run one block: the first `valid` frames from `sine` (advancing it by the
+/// whole block), the rest left to the concealer. Output appended to `out` (left channel).
+uint32_t runBlock(PacketLossConcealer& plc, Sine& sine, uint32_t valid, std::vector<float>& out,
+                  uint32_t frames = kBlock)
+{
+    std::vector<float> left(frames, 99.0f), right(frames, 99.0f);
+    for (uint32_t i = 0; i < valid; ++i)
+        left[i] = right[i] = sine.at(sine.frame + i);
+    sine.frame += frames;
+    float* io[2] = { left.data(), right.data() };
+    const uint32_t concealed = plc.process(io, 2, valid, frames);
+    out.insert(out.end(), left.begin(), left.end());
+    return concealed;
+}
+
+float maxStep(const std::vector<float>& x, size_t from, size_t to)
+{
+    float step = 0.0f;
+    for (size_t i = (std::max)(from, size_t{1}); i < to && i < x.size(); ++i)
+        step = (std::max)(step, std::fabs(x[i] - x[i - 1]));
+    return step;
+}
+
+} // namespace
+
+TEST(PacketLossConcealerTest, RepeatsPeriodicAudioAcrossAShortGap) {
+    PacketLossConcealer plc;
+    plc.prepare(kRate, 2);
+    Sine sine;
+    std::vector<float> out;
+    for (int i = 0; i < 20; ++i)
+        runBlock(plc, sine, kBlock, out);
+
+    // One whole block lost: the first 10 ms of concealment should track the
+    // sine the producer would have sent
+    const uint64_t gapStart = sine.frame;
+    const size_t outStart = out.size();
+    const uint32_t gap = msFrames(PacketLossConcealer::kFullGainMs);
+    EXPECT_EQ(runBlock(plc, sine, 0, out, gap), gap);
+    EXPECT_TRUE(plc.concealing());
+    EXPECT_GT(plc.pitchPeriod(), 0u);
+
+    double signal = 0.0, error = 0.0;
+    for (uint32_t i = 0; i < gap; ++i) {
+        const double expected = sine.at(gapStart + i);
+        signal += expected * expected;
+        error += (out[outStart + i] - expected) * (out[outStart + i] - expected);
+    }
+    EXPECT_GT(10.0 * std::log10(signal / error), 25.0);
+    EXPECT_EQ(plc.concealedFrames(), gap);
+}
+
+TEST(PacketLossConcealerTest, FadesOutAndStopsCountingAfterTheLimit) {
+    PacketLossConcealer plc;
+    plc.prepare(kRate, 2);
+    Sine sine;
+    std::vector<float> out;
+    for (int i = 0; i < 20; ++i)
+        runBlock(plc, sine, kBlock, out);
+
+    const size_t outStart = out.size();
+    uint32_t concealed = 0;
+    for (int i = 0; i < 8; ++i)   // ~43 ms of nothing
+        concealed += runBlock(plc, sine, 0, out);
+    EXPECT_EQ(concealed, msFrames(PacketLossConcealer::kMaxConcealMs));
+    EXPECT_EQ(plc.concealedFrames(), concealed);
+
+    // Full level up to kFullGainMs, ramping down after, silence past the limit
+    float early = 0.0f, late = 0.0f;
+    for (uint32_t i = 0; i < msFrames(5.0); ++i)
+        early = (std::max)(early, std::fabs(out[outStart + i]));
+    for (uint32_t i = msFrames(17.0); i < msFrames(20.0); ++i)
+        late = (std::max)(late, std::fabs(out[outStart + i]));
+    EXPECT_GT(early, 0.45f);
+    EXPECT_LT(late, 0.2f);
+    for (size_t i = outStart + msFrames(PacketLossConcealer::kMaxConcealMs); i < out.size(); ++i)
+        ASSERT_EQ(out[i], 0.0f) << "frame " << i - outStart;
+
+    // No click anywhere: loop wraps and the gain ramp stay smooth
+    const float sineStep = sine.amplitude * static_cast<float>(2.0 * kPi * sine.hz / kRate);
+    EXPECT_LT(maxStep(out, outStart - 1, out.size()), 2.0f * sineStep);
+}
+
+TEST(PacketLossConcealerTest, PartialBlockSplicesAndRecoversSmoothly) {
+    PacketLossConcealer plc;
+    plc.prepare(kRate, 2);
+    Sine sine;
+    std::vector<float> out;
+    for (int i = 0; i < 20; ++i)
+        runBlock(plc, sine, kBlock, out);
+
+    // Short read (half a block), one lost block, then the stream is back
+    const size_t outStart = out.size();
+    EXPECT_EQ(runBlock(plc, sine, kBlock / 2, out), kBlock / 2);
+    EXPECT_EQ(runBlock(plc, sine, 0, out), kBlock);
+    EXPECT_EQ(runBlock(plc, sine, kBlock, out), 0u);
+    EXPECT_FALSE(plc.concealing());
+    runBlock(plc, sine, kBlock, out);
+    EXPECT_EQ(plc.concealedFrames(), kBlock + kBlock / 2);
+
+    const float sineStep = sine.amplitude * static_cast<float>(2.0 * kPi * sine.hz / kRate);
+    EXPECT_LT(maxStep(out, outStart - 1, out.size()), 2.0f * sineStep);
+
+    // Once the recovery crossfade is over the output is the input again
+    for (size_t i = out.size() - kBlock; i < out.size(); ++i)
+        ASSERT_EQ(out[i], sine.at(i));
+}
+
+TEST(PacketLossConcealerTest, FadesInFromSilenceAfterALongGap) {
+    PacketLossConcealer plc;
+    plc.prepare(kRate, 2);
+    Sine sine;
+    sine.hz = 1000.0;
+    std::vector<float> out;
+    for (int i = 0; i < 20; ++i)
+        runBlock(plc, sine, kBlock, out);
+    for (int i = 0; i < 10; ++i)
+        runBlock(plc, sine, 0, out);
+
+    // The stream returns at an arbitrary phase; no step out of silence
+    const size_t outStart = out.size();
+    runBlock(plc, sine, kBlock, out);
+    EXPECT_LT(std::fabs(out[outStart]), 0.1f * sine.amplitude);
+    EXPECT_LT(maxStep(out, outStart - 1, outStart + msFrames(PacketLossConcealer::kRecoveryMs)),
+              0.25f * sine.amplitude);
+}
+
+TEST(PacketLossConcealerTest, OutputsSilenceWithoutHistory) {
+    PacketLossConcealer plc;
+    plc.prepare(kRate, 2);
+    Sine sine;
+    std::vector<float> out;
+
+    // Gap before enough audio arrived to find a period in
+    runBlock(plc, sine, kBlock, out);
+    EXPECT_EQ(runBlock(plc, sine, 0, out), 0u);
+    for (uint32_t i = kBlock; i < out.size(); ++i)
+        ASSERT_EQ(out[i], 0.0f);
+    EXPECT_EQ(plc.concealedFrames(), 0u);
+
+    // Silent history: nothing to repeat, nothing counted
+    Sine quiet;
+    quiet.amplitude = 0.0f;
+    plc.reset();
+    for (int i = 0; i < 20; ++i)
+        runBlock(plc, quiet, kBlock, out);
+    EXPECT_EQ(runBlock(plc, quiet, 0, out), 0u);
+    EXPECT_EQ(out.back(), 0.0f);
+    EXPECT_EQ(plc.concealedFrames(), 0u);
+}
+
+TEST(PacketLossConcealerTest, NoiseLoopsTheLongestPeriodWithoutBlowingUp) {
+    PacketLossConcealer plc;
+    plc.prepare(kRate, 1);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    std::vector<float> block(kBlock);
+    float* io[1] = { block.data() };
+    for (int b = 0; b < 20; ++b) {
+        for (auto& s : block) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            s = static_cast<float>(static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0)) - 0.5f;
+        }
+        plc.process(io, 1, kBlock, kBlock);
+    }
+
+    EXPECT_EQ(plc.process(io, 1, 0, kBlock), kBlock);
+    EXPECT_EQ(plc.pitchPeriod(), msFrames(PacketLossConcealer::kMaxPeriodMs));
+    float peak = 0.0f;
+    for (float s : block)
+        peak = (std::max)(peak, std::fabs(s));
+    EXPECT_GT(peak, 0.1f);
+    EXPECT_LT(peak, 1.0f);
+}
@@ -156,3 +156,75 @@ TEST(CrossProcessIPC, ChildSeesHeaderFields) {
     shm.close();
 #endif
 }
+
+TEST(CrossProcessIPC, TwoChildConsumersEachReadAllBlocks) {
+#ifndef _WIN32
+    GTEST_SKIP() << "Cross-process IPC test currently Windows-only";
+#else
+    // Broadcast mode: two Receiver processes attached to the same buffer must
+    // each see every block, instead of starving each other on one read_pos.
+    size_t shmSize = calculateSharedMemorySize(kCapacity, kChannels);
+
+    SharedMemory shm;
+    ASSERT_TRUE(shm.create(kShmName, shmSize));
+
+    RingBuffer producer;
+    producer.initAsProducer(shm.getData(), kCapacity, kChannels, kSampleRate);
+
+    std::vector<float> writeBuf(kFramesPerBlock * kChannels);
+    for (int i = 0; i < kBlocks; ++i) {
+        std::fill(writeBuf.begin(), writeBuf.end(), static_cast<float>(i + 1));
+        ASSERT_EQ(producer.write(writeBuf.data(), kFramesPerBlock), kFramesPerBlock);
+    }
+
+    std::string childPath = getChildExePath();
+    PROCESS_INFORMATION children[2] = {};
+
+    for (auto& pi : children) {
+        STARTUPINFOA si = {};
+        si.cb = sizeof(si);
+
+        std::string cmdLine = "\"" + childPath + "\"";
+        std::vector<char> cmdBuf(cmdLine.begin(), cmdLine.end());
+        cmdBuf.push_back('\0');
+
+        if (!CreateProcessA(nullptr, cmdBuf.data(), nullptr, nullptr, FALSE,
+                            0, nullptr, nullptr, &si, &pi)) {
+            DWORD err = GetLastError();
+            for (auto& started : children) {
+                if (started.hProcess) {
+                    WaitForSingleObject(started.hProcess, 10000);
+                    CloseHandle(started.hProcess);
+                    CloseHandle(started.hThread);
+                }
+            }
+            if (err == ERROR_FILE_NOT_FOUND || err == ERROR_PATH_NOT_FOUND) {
+                shm.close();
+                GTEST_SKIP() << "ipc-test-child.exe not found at: " << childPath
+                             << " (build it first)";
+            }
+            FAIL() << "CreateProcess failed with error " << err;
+        }
+    }
+
+    for (auto& pi : children) {
+        DWORD result = WaitForSingleObject(pi.hProcess, 10000);
+        EXPECT_EQ(result, WAIT_OBJECT_0) << "Child process timed out";
+
+        DWORD exitCode = 1;
+        GetExitCodeProcess(pi.hProcess, &exitCode);
+        CloseHandle(pi.hProcess);
+        CloseHandle(pi.hThread);
+
+        EXPECT_EQ(exitCode, 0u) << "Child exit code " << exitCode
+            << ": 1=SHM open fail, 2=attach fail, 3=inactive, 4=data mismatch, 5=incomplete read";
+    }
+
+    // Both children released their cursor slots on exit
+    EXPECT_EQ(producer.getConsumerCount(), 0u);
+    EXPECT_EQ(producer.getEvictedConsumerCount(), 0u);
+
+    producer.detach();
+    shm.close();
+#endif
+}
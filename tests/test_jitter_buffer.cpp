@@ -0,0 +1,142 @@
+/**
+ * @file test_jitter_buffer.cpp
+ * @brief Unit tests for the Receiver's jitter-adaptive target fill (Auto buffer)
+ */
+
+#include <gtest/gtest.h>
+#include "directpipe/JitterBuffer.h"
+
+#include <cstdint>
+
+using namespace directpipe;
+
+namespace {
+
+constexpr double kBlockSec = 256.0 / 48000.0;
+
+/// Deterministic uniform [0, 1) (same sequence on every platform)
+struct Lcg {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    double next()
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+/// Feed `seconds` of blocks whose deficit is base + uniform jitter, with a
+/// spike of `spike` frames on one block in `spikeEvery`
+void feed(JitterBufferSizer& sizer, Lcg& rng, double seconds, double base, double jitter,
+          double spike = 0.0, int spikeEvery = 0)
+{
+    const int blocks = static_cast<int>(seconds / kBlockSec);
+    for (int i = 0; i < blocks; ++i) {
+        double deficit = base + jitter * rng.next();
+        if (spikeEvery > 0 && i % spikeEvery == spikeEvery - 1)
+            deficit += spike;
+        sizer.observe(deficit, kBlockSec);
+    }
+}
+
+} // namespace
+
+TEST(JitterBufferSizerTest, SettlesJustAboveTheJitterItMeasures) {
+    // Reads need 256 frames and arrive up to 200 frames late: anything at or
+    // above 456 never underruns, and Auto should not ask for much more
+    JitterBufferSizer sizer;
+    sizer.reset(JitterBufferSizer::Config{});
+    EXPECT_EQ(sizer.target(), 512u);
+
+    Lcg rng;
+    feed(sizer, rng, 120.0, 256.0, 200.0);
+    EXPECT_GE(sizer.target(), 456u);
+    EXPECT_LE(sizer.target(), 456u + 2 * JitterBufferSizer::kQuantum);
+    EXPECT_EQ(sizer.target() % JitterBufferSizer::kQuantum, 0u);
+    EXPECT_EQ(sizer.underruns(), 0u);
+
+    // Quiet machine: shrinks to the floor the measurement allows, no lower
+    feed(sizer, rng, 300.0, 64.0, 32.0);
+    EXPECT_EQ(sizer.target(), 128u);
+}
+
+TEST(JitterBufferSizerTest, BudgetDecidesWhetherRareSpikesAreCovered) {
+    // A 900-frame spike every 500 blocks (0.2 %): a 1 % budget rides over it,
+    // a 0.01 % budget sizes the buffer for it
+    Lcg rng;
+    JitterBufferSizer::Config relaxed;
+    relaxed.underrunBudget = 1e-2;
+    JitterBufferSizer loose;
+    loose.reset(relaxed);
+    feed(loose, rng, 120.0, 256.0, 64.0, 900.0, 500);
+    EXPECT_LE(loose.target(), 416u);
+
+    JitterBufferSizer::Config strict;
+    strict.underrunBudget = 1e-4;
+    JitterBufferSizer tight;
+    tight.reset(strict);
+    feed(tight, rng, 120.0, 256.0, 64.0, 900.0, 500);
+    EXPECT_GE(tight.target(), 256u + 64u + 900u);
+
+    // Budget change keeps the history: tightening the loose one follows at once
+    loose.setUnderrunBudget(1e-4);
+    feed(loose, rng, 1.0, 256.0, 64.0);
+    EXPECT_GE(loose.target(), 256u + 64u + 900u);
+}
+
+TEST(JitterBufferSizerTest, GrowsAtOnceOnUnderrunAndShrinksSlowly) {
+    JitterBufferSizer sizer;
+    sizer.reset(JitterBufferSizer::Config{});
+    Lcg rng;
+    feed(sizer, rng, 60.0, 128.0, 32.0);
+    const uint32_t settled = sizer.target();
+    EXPECT_LE(settled, 256u);
+
+    // Underrun: at least x1.5 immediately, before any new measurement
+    EXPECT_TRUE(sizer.onUnderrun());
+    const uint32_t grown = sizer.target();
+    EXPECT_GE(static_cast<double>(grown), settled * JitterBufferSizer::kGrowFactor);
+    EXPECT_EQ(sizer.underruns(), 1u);
+
+    // Nothing shrinks during the hold time
+    feed(sizer, rng, JitterBufferSizer::kShrinkHoldSec - 1.0, 128.0, 32.0);
+    EXPECT_EQ(sizer.target(), grown);
+
+    // Then at most one quantum per interval
+    const double shrinkWindow = 10.0;
+    feed(sizer, rng, 1.0 + shrinkWindow, 128.0, 32.0);
+    const double maxSteps = shrinkWindow / JitterBufferSizer::kShrinkIntervalSec + 1.0;
+    EXPECT_LT(sizer.target(), grown);
+    EXPECT_GE(static_cast<double>(sizer.target()),
+              grown - maxSteps * JitterBufferSizer::kQuantum);
+
+    // ... and eventually back to where it was
+    feed(sizer, rng, 120.0, 128.0, 32.0);
+    EXPECT_EQ(sizer.target(), settled);
+}
+
+TEST(JitterBufferSizerTest, TargetStaysWithinConfiguredBounds) {
+    JitterBufferSizer::Config config;
+    config.minTarget = 192;
+    config.maxTarget = 2048;
+    config.initialTarget = 4096;
+    JitterBufferSizer sizer;
+    sizer.reset(config);
+    EXPECT_EQ(sizer.target(), 2048u);
+
+    for (int i = 0; i < 10; ++i)
+        sizer.onUnderrun();
+    EXPECT_EQ(sizer.target(), 2048u);
+    EXPECT_FALSE(sizer.onUnderrun());   // Already at the ceiling: no rebuffer
+
+    Lcg rng;
+    feed(sizer, rng, 600.0, 0.0, 16.0);
+    EXPECT_EQ(sizer.target(), 192u);
+
+    feed(sizer, rng, 5.0, 100000.0, 0.0);   // Beyond the histogram range
+    EXPECT_EQ(sizer.target(), 2048u);
+
+    sizer.reset();
+    EXPECT_EQ(sizer.target(), 2048u);
+    EXPECT_EQ(sizer.measuredTarget(), 0u);
+    EXPECT_EQ(sizer.underruns(), 0u);
+}
@@ -11,6 +11,8 @@
 #include "directpipe/SharedMemory.h"
 #include "directpipe/Constants.h"
 #include "directpipe/Protocol.h"
+#include "directpipe/ClockSync.h"
+#include "directpipe/SampleConvert.h"
 
 #include <vector>
 #include <thread>
@@ -223,3 +225,152 @@ TEST_F(LatencyTest, ThroughputBenchmark) {
     EXPECT_GT(durationInAudioSec / (totalMs / 1000.0), 10.0)
         << "Throughput is less than 10x realtime";
 }
+
+TEST_F(LatencyTest, BlockTimestampMeasuresEndToEndLatency) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    // Producer: stamp the block at "callback start", then write it
+    constexpr uint32_t kFrames = 128;
+    std::vector<float> block(kFrames * kChannels, 0.5f);
+    const uint64_t stampNs = steadyClockNs();
+    auto w = producer.beginWrite(kFrames);
+    ASSERT_EQ(w.frames(), kFrames);
+    producer.publishBlockMeta(w.position, kFrames, stampNs, 0);
+    producer.commitWrite(kFrames);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    // Consumer: look up the stamp of the first frame it reads
+    auto r = consumer.beginRead(kFrames);
+    ASSERT_EQ(r.frames(), kFrames);
+    BlockMetaSnapshot meta;
+    ASSERT_TRUE(consumer.findBlockMeta(r.position, meta));
+    const double latencyMs = static_cast<double>(steadyClockNs() - meta.host_time_ns) / 1e6;
+    consumer.commitRead(kFrames);
+
+    EXPECT_EQ(meta.host_time_ns, stampNs);
+    EXPECT_GE(latencyMs, 2.0);
+    EXPECT_LT(latencyMs, 1000.0);
+}
+
+TEST_F(LatencyTest, PlanarVsInterleavedLayoutBenchmark) {
+    // Host and Receiver both hold planar (JUCE AudioBuffer) channels, so the
+    // interleaved ring pays a transpose on each side; the planar ring copies
+    // each channel with one memcpy.
+    constexpr int kIterations = 20000;
+    const uint32_t blockSizes[] = { 64, 128, 480, 1024 };
+
+    auto runLayout = [&](SampleLayout layout, uint32_t frames) {
+        RingBuffer producer;
+        producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate,
+                                SampleFormat::Float32, layout);
+        RingBuffer consumer;
+        consumer.attachAsConsumer(alignedMem_);
+
+        std::vector<float> inL(frames, 0.25f), inR(frames, -0.25f);
+        std::vector<float> outL(frames), outR(frames);
+        const float* src[kChannels] = { inL.data(), inR.data() };
+        float* dst[kChannels] = { outL.data(), outR.data() };
+        DitherState dither;
+
+        auto start = Clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            auto w = producer.beginWrite(frames);
+            if (w.layout == SampleLayout::Planar) {
+                packPlanes(w.format, src, kChannels, w.frames1, w.bytes1, w.planeStride,
+                           DitherMode::None, dither);
+                if (w.frames2 > 0) {
+                    const float* tail[kChannels] = { src[0] + w.frames1, src[1] + w.frames1 };
+                    packPlanes(w.format, tail, kChannels, w.frames2, w.bytes2, w.planeStride,
+                               DitherMode::None, dither);
+                }
+            } else {
+                packInterleaved(w.format, src, kChannels, w.frames1, w.bytes1, DitherMode::None, dither);
+                if (w.frames2 > 0) {
+                    const float* tail[kChannels] = { src[0] + w.frames1, src[1] + w.frames1 };
+                    packInterleaved(w.format, tail, kChannels, w.frames2, w.bytes2,
+                                    DitherMode::None, dither);
+                }
+            }
+            producer.commitWrite(w.frames());
+
+            auto r = consumer.beginRead(frames);
+            if (r.layout == SampleLayout::Planar) {
+                unpackPlanes(r.format, r.bytes1, r.planeStride, kChannels, r.frames1, dst);
+                if (r.frames2 > 0) {
+                    float* tail[kChannels] = { dst[0] + r.frames1, dst[1] + r.frames1 };
+                    unpackPlanes(r.format, r.bytes2, r.planeStride, kChannels, r.frames2, tail);
+                }
+            } else {
+                unpackInterleaved(r.format, r.bytes1, kChannels, r.frames1, dst);
+                if (r.frames2 > 0) {
+                    float* tail[kChannels] = { dst[0] + r.frames1, dst[1] + r.frames1 };
+                    unpackInterleaved(r.format, r.bytes2, kChannels, r.frames2, tail);
+                }
+            }
+            consumer.commitRead(r.frames());
+        }
+        auto end = Clock::now();
+
+        EXPECT_EQ(outL, inL);
+        EXPECT_EQ(outR, inR);
+        return std::chrono::duration<double, std::nano>(end - start).count() / kIterations;
+    };
+
+    std::cout << "\n=== Planar vs Interleaved Layout (write+read, stereo float) ===" << std::endl;
+    for (uint32_t frames : blockSizes) {
+        const double interleavedNs = runLayout(SampleLayout::Interleaved, frames);
+        const double planarNs = runLayout(SampleLayout::Planar, frames);
+        std::cout << "  " << frames << " frames: interleaved " << interleavedNs
+                  << " ns, planar " << planarNs << " ns (x"
+                  << (interleavedNs / planarNs) << ")" << std::endl;
+
+        // Timing is machine dependent; only guard against a gross regression
+        EXPECT_LT(planarNs, interleavedNs * 4.0 + 1000.0) << "at " << frames << " frames";
+    }
+    std::cout << "================================================================\n" << std::endl;
+}
+
+TEST(ClockRatioTest, DetectsPpmOffsetDespiteTimestampJitter) {
+    // Producer device runs 500 ppm fast against a 48 kHz consumer, both stamped
+    // every 10 ms of host time with up to +/-100 us of scheduling jitter.
+    constexpr double kPpm = 500.0;
+    constexpr double kProducerRate = 48000.0 * (1.0 + kPpm * 1e-6);
+    constexpr uint64_t kStepNs = 10'000'000;
+    const int64_t jitterNs[] = { 0, 73'000, -41'000, 100'000, -100'000, 12'000, -88'000 };
+
+    ClockRatioEstimator est;
+    EXPECT_EQ(est.ratio(), 0.0);
+
+    for (uint64_t i = 0; i <= 900; ++i) {  // 9 s
+        const uint64_t t = 1'000'000'000ULL + i * kStepNs;
+        const uint64_t jittered = static_cast<uint64_t>(static_cast<int64_t>(t) + jitterNs[i % 7]);
+        const double sec = static_cast<double>(i * kStepNs) / 1e9;
+        est.addProducerStamp(jittered, static_cast<uint64_t>(sec * kProducerRate));
+        est.addConsumerStamp(t, static_cast<uint64_t>(sec * 48000.0));
+    }
+
+    EXPECT_NEAR(est.consumerRateHz(), 48000.0, 0.1);
+    EXPECT_NEAR((est.ratio() - 1.0) * 1e6, kPpm, 50.0);
+}
+
+TEST(ClockRatioTest, ReanchorsWhenProducerRestarts) {
+    ClockRatioEstimator est;
+    for (uint64_t i = 0; i <= 200; ++i) {  // 2 s at 48 kHz
+        const uint64_t t = i * 10'000'000ULL;
+        est.addProducerStamp(t, i * 480);
+        est.addConsumerStamp(t, i * 480);
+    }
+    EXPECT_NEAR(est.ratio(), 1.0, 1e-9);
+
+    // Device restarted at 44.1 kHz: counter goes back to 0. The old rate is
+    // kept until the new window is long enough, then the new rate takes over.
+    const uint64_t base = 201 * 10'000'000ULL;
+    for (uint64_t i = 0; i <= 200; ++i)
+        est.addProducerStamp(base + i * 10'000'000ULL, i * 441);
+    EXPECT_NEAR(est.producerRateHz(), 44100.0, 1.0);
+}
@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+#include "Audio/ParameterQueue.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace directpipe;
+
+namespace {
+
+/// Records every value the audio side writes
+class RecordingParameter : public juce::AudioProcessorParameter {
+public:
+    explicit RecordingParameter(bool discrete = false) : discrete_(discrete) {}
+
+    float getValue() const override { return value_.load(); }
+    void setValue(float v) override {
+        value_.store(v);
+        history.push_back(v);
+    }
+    float getDefaultValue() const override { return 0.0f; }
+    juce::String getName(int) const override { return "Param"; }
+    juce::String getLabel() const override { return {}; }
+    float getValueForText(const juce::String&) const override { return 0.0f; }
+    bool isDiscrete() const override { return discrete_; }
+
+    std::vector<float> history;
+
+private:
+    std::atomic<float> value_{0.0f};
+    bool discrete_;
+};
+
+/// Pass-through stage that remembers the parameter value it saw in processBlock
+class ParamStage : public juce::AudioProcessor {
+public:
+    ParamStage()
+        : AudioProcessor(BusesProperties()
+              .withInput("In", juce::AudioChannelSet::stereo(), true)
+              .withOutput("Out", juce::AudioChannelSet::stereo(), true)) {}
+
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {
+        seen.push_back(param.getValue());
+    }
+
+    const juce::String getName() const override { return "ParamStage"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+    RecordingParameter param;
+    std::vector<float> seen;
+};
+
+std::unique_ptr<SerialChainExecutor::Plan> planWith(std::shared_ptr<juce::AudioProcessor> stage)
+{
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    if (stage != nullptr)
+        plan->addStage(std::move(stage), false);
+    plan->allocate(2, 64);
+    return plan;
+}
+
+} // namespace
+
+TEST(ParameterQueueTest, CoalescesToLatestValue) {
+    auto stage = std::make_shared<ParamStage>();
+    auto plan = planWith(stage);
+    ParameterQueue queue;
+
+    for (int i = 1; i <= 100; ++i)
+        ASSERT_TRUE(queue.push(stage, &stage->param, i / 100.0f, false));
+    EXPECT_EQ(queue.pendingCount(), 1);
+
+    queue.applyBlock(*plan, 64);
+    ASSERT_EQ(stage->param.history.size(), 1u);
+    EXPECT_FLOAT_EQ(stage->param.history[0], 1.0f);
+    EXPECT_EQ(queue.pendingCount(), 0);
+
+    queue.applyBlock(*plan, 64);
+    EXPECT_EQ(stage->param.history.size(), 1u);
+}
+
+TEST(ParameterQueueTest, SmoothedChangeGlidesAcrossBlocks) {
+    auto stage = std::make_shared<ParamStage>();
+    auto plan = planWith(stage);
+    ParameterQueue queue;
+    queue.setSmoothing(48000.0, 4.0);   // 192 samples = 3 blocks of 64
+
+    queue.push(stage, &stage->param, 0.9f, true);
+    for (int b = 0; b < 5; ++b)
+        queue.applyBlock(*plan, 64);
+
+    ASSERT_EQ(stage->param.history.size(), 3u);
+    EXPECT_NEAR(stage->param.history[0], 0.3f, 1e-5f);
+    EXPECT_NEAR(stage->param.history[1], 0.6f, 1e-5f);
+    EXPECT_FLOAT_EQ(stage->param.history[2], 0.9f);
+}
+
+TEST(ParameterQueueTest, NewTargetRestartsGlideFromCurrentValue) {
+    auto stage = std::make_shared<ParamStage>();
+    auto plan = planWith(stage);
+    ParameterQueue queue;
+    queue.setSmoothing(48000.0, 4.0);
+
+    queue.push(stage, &stage->param, 0.9f, true);
+    queue.applyBlock(*plan, 64);                 // 0.3
+    queue.push(stage, &stage->param, 0.0f, true);
+    for (int b = 0; b < 5; ++b)
+        queue.applyBlock(*plan, 64);
+
+    ASSERT_EQ(stage->param.history.size(), 4u);
+    EXPECT_NEAR(stage->param.history[1], 0.2f, 1e-5f);
+    EXPECT_NEAR(stage->param.history[2], 0.1f, 1e-5f);
+    EXPECT_FLOAT_EQ(stage->param.history[3], 0.0f);
+}
+
+TEST(ParameterQueueTest, DiscreteParameterJumps) {
+    auto stage = std::make_shared<ParamStage>();
+    auto plan = planWith(stage);
+    RecordingParameter toggle(true);
+    ParameterQueue queue;
+    queue.setSmoothing(48000.0, 20.0);
+
+    queue.push(stage, &toggle, 1.0f, true);
+    queue.applyBlock(*plan, 64);
+    queue.applyBlock(*plan, 64);
+
+    ASSERT_EQ(toggle.history.size(), 1u);
+    EXPECT_FLOAT_EQ(toggle.history[0], 1.0f);
+}
+
+TEST(ParameterQueueTest, DropsChangesForStagesNotInPlan) {
+    auto stage = std::make_shared<ParamStage>();
+    auto empty = planWith(nullptr);
+    ParameterQueue queue;
+
+    queue.push(stage, &stage->param, 0.5f, false);
+    queue.applyBlock(*empty, 64);
+
+    EXPECT_TRUE(stage->param.history.empty());
+    EXPECT_EQ(queue.pendingCount(), 0);
+}
+
+TEST(ParameterQueueTest, ReleasesRemovedStages) {
+    auto stage = std::make_shared<ParamStage>();
+    std::weak_ptr<ParamStage> watch = stage;
+    auto plan = planWith(stage);
+    ParameterQueue queue;
+
+    queue.push(stage, &stage->param, 0.5f, false);
+    queue.applyBlock(*plan, 64);
+    plan.reset();
+    stage.reset();
+    EXPECT_FALSE(watch.expired());   // the slot still holds its stage
+
+    queue.releaseStagesNotIn(*planWith(nullptr));
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(ParameterQueueTest, ExecutorAppliesQueueBeforeTheChainRuns) {
+    auto stage = std::make_shared<ParamStage>();
+    ParameterQueue queue;
+    SerialChainExecutor executor;
+    executor.setParameterQueue(&queue);
+    executor.publish(planWith(stage));
+
+    juce::AudioBuffer<float> buffer(2, 64);
+    juce::MidiBuffer midi;
+    queue.push(stage, &stage->param, 0.75f, false);
+    executor.process(buffer, midi);
+
+    ASSERT_EQ(stage->seen.size(), 1u);
+    EXPECT_FLOAT_EQ(stage->seen[0], 0.75f);
+}
+
+TEST(ParameterQueueTest, ConcurrentSweepEndsOnLatestValue) {
+    auto stage = std::make_shared<ParamStage>();
+    auto plan = planWith(stage);
+    ParameterQueue queue;
+    constexpr int kPushes = 20000;
+
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (int i = 1; i <= kPushes; ++i)
+            queue.push(stage, &stage->param, static_cast<float>(i) / kPushes, false);
+        done.store(true);
+    });
+    while (!done.load())
+        queue.applyBlock(*plan, 64);
+    producer.join();
+    queue.applyBlock(*plan, 64);
+
+    ASSERT_FALSE(stage->param.history.empty());
+    EXPECT_FLOAT_EQ(stage->param.getValue(), 1.0f);
+    for (size_t i = 1; i < stage->param.history.size(); ++i)
+        EXPECT_GE(stage->param.history[i], stage->param.history[i - 1]);
+}
@@ -12,11 +12,15 @@
 #include "directpipe/SharedMemory.h"
 #include "directpipe/Constants.h"
 #include "directpipe/Protocol.h"
+#include "directpipe/Resampler.h"
+#include "directpipe/JitterBuffer.h"
 
 #include <vector>
+#include <cmath>
 #include <cstring>
 #include <algorithm>
 #include <memory>
+#include <iostream>
 
 using namespace directpipe;
 
@@ -38,14 +42,21 @@ protected:
         producer_.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
     }
 
-    /// Write interleaved stereo audio (simulates SharedMemWriter)
+    /// Write interleaved stereo audio (simulates SharedMemWriter: interleave/pack in place)
     void writeInterleaved(float leftVal, float rightVal, int frames) {
-        std::vector<float> interleaved(static_cast<size_t>(frames) * kChannels);
-        for (int i = 0; i < frames; ++i) {
-            interleaved[static_cast<size_t>(i) * kChannels + 0] = leftVal;
-            interleaved[static_cast<size_t>(i) * kChannels + 1] = rightVal;
-        }
-        producer_.write(interleaved.data(), static_cast<uint32_t>(frames));
+        std::vector<float> left(static_cast<size_t>(frames), leftVal);
+        std::vector<float> right(static_cast<size_t>(frames), rightVal);
+        DitherState dither;
+
+        auto region = producer_.beginWrite(static_cast<uint32_t>(frames));
+        auto fill = [&](uint8_t* dest, uint32_t n, uint32_t offset) {
+            const float* src[2] = { left.data() + offset, right.data() + offset };
+            packInterleaved(region.format, src, kChannels, n, dest, DitherMode::None, dither);
+        };
+        fill(region.bytes1, region.frames1, 0);
+        if (region.frames2 > 0)
+            fill(region.bytes2, region.frames2, region.frames1);
+        producer_.commitWrite(region.frames());
     }
 
     /// Simulate Receiver's de-interleave read (same logic as processBlock)
@@ -65,17 +76,22 @@ protected:
 
         if (toRead == 0) return out;  // underrun — silence
 
-        std::vector<float> interleaved(static_cast<size_t>(toRead) * kChannels);
-        uint32_t readCount = consumer.read(interleaved.data(), toRead);
+        // Zero-copy: de-interleave straight out of the shared pages
+        auto region = consumer.beginRead(toRead);
+        uint32_t readCount = region.frames();
         if (readCount == 0) return out;
 
         out.samplesRead = static_cast<int>(readCount);
 
         // De-interleave: [L0 R0 L1 R1 ...] → [L0 L1 ...], [R0 R1 ...]
-        for (int i = 0; i < out.samplesRead; ++i) {
-            out.left[i] = interleaved[static_cast<size_t>(i) * kChannels + 0];
-            out.right[i] = interleaved[static_cast<size_t>(i) * kChannels + 1];
-        }
+        auto deinterleave = [&](const uint8_t* src, uint32_t n, uint32_t offset) {
+            float* dest[2] = { out.left.data() + offset, out.right.data() + offset };
+            unpackInterleaved(region.format, src, kChannels, n, dest);
+        };
+        deinterleave(region.bytes1, region.frames1, 0);
+        if (region.frames2 > 0)
+            deinterleave(region.bytes2, region.frames2, region.frames1);
+        consumer.commitRead(readCount);
 
         return out;
     }
@@ -130,6 +146,54 @@ TEST_F(ReceiverSimulationTest, MonoSourceDeinterleave) {
     }
 }
 
+TEST_F(ReceiverSimulationTest, ZeroCopyDeinterleaveAcrossWrap) {
+    RingBuffer consumer;
+    consumer.attachAsConsumer(alignedMem_);
+
+    // Advance both sides to 50 frames before the physical end of the ring
+    const int lead = static_cast<int>(kCapacity) - 50;
+    writeInterleaved(0.0f, 0.0f, lead);
+    auto skipped = consumer.beginRead(static_cast<uint32_t>(lead));
+    consumer.commitRead(skipped.frames());
+    ASSERT_EQ(consumer.availableRead(), 0u);
+
+    // This block straddles the wrap point — both spans must be de-interleaved
+    writeInterleaved(0.25f, -0.25f, kBlockSize);
+    auto out = readAndDeinterleave(consumer, kBlockSize);
+    EXPECT_EQ(out.samplesRead, kBlockSize);
+    for (int i = 0; i < kBlockSize; ++i) {
+        EXPECT_FLOAT_EQ(out.left[i], 0.25f) << "L[" << i << "]";
+        EXPECT_FLOAT_EQ(out.right[i], -0.25f) << "R[" << i << "]";
+    }
+}
+
+TEST_F(ReceiverSimulationTest, CompactFormatDeinterleaveAcrossWrap) {
+    // Same wrap-straddling block through each compact ring format: the
+    // Receiver unpacks straight out of shared memory
+    const SampleFormat formats[] = { SampleFormat::Int16, SampleFormat::Int24, SampleFormat::Float16 };
+    for (auto format : formats) {
+        producer_.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate, format);
+
+        RingBuffer consumer;
+        ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+        ASSERT_EQ(consumer.getSampleFormat(), format);
+
+        const int lead = static_cast<int>(kCapacity) - 50;
+        writeInterleaved(0.0f, 0.0f, lead);
+        auto skipped = consumer.beginRead(static_cast<uint32_t>(lead));
+        consumer.commitRead(skipped.frames());
+
+        writeInterleaved(0.25f, -0.25f, kBlockSize);
+        auto out = readAndDeinterleave(consumer, kBlockSize);
+        EXPECT_EQ(out.samplesRead, kBlockSize);
+        for (int i = 0; i < kBlockSize; ++i) {
+            EXPECT_NEAR(out.left[i], 0.25f, 1e-4f) << "format " << static_cast<int>(format) << " L[" << i << "]";
+            EXPECT_NEAR(out.right[i], -0.25f, 1e-4f) << "format " << static_cast<int>(format) << " R[" << i << "]";
+        }
+        consumer.detach();
+    }
+}
+
 // ─── Underrun (no data available) ───────────────────────────────
 
 TEST_F(ReceiverSimulationTest, UnderrunSilence) {
@@ -203,6 +267,302 @@ TEST_F(ReceiverSimulationTest, ClockDriftSkip) {
     EXPECT_GE(available, 1u);  // At least some data remains
 }
 
+TEST_F(ReceiverSimulationTest, AdaptiveResamplingHoldsTargetFillUnderDrift) {
+    // Same loop as processBlock: PI ratio from the fill level, read exactly
+    // inputFramesFor() frames into the resampler, render a full DAW block.
+    // Three simulated minutes per clock offset, no skips and no short reads.
+    constexpr uint32_t kTargetFill = 512;       // "Low" preset
+    constexpr uint32_t kHighThreshold = 1536;
+    constexpr uint32_t kDawBlock = 256;
+    const double drifts[] = { 400e-6, -400e-6 };
+
+    for (double drift : drifts) {
+        producer_.reset();
+        RingBuffer consumer;
+        ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+        FillLevelController pi;
+        pi.prepare(kSampleRate);
+        AdaptiveResampler rs;
+        rs.prepare(kChannels, kDawBlock, 1.0 + FillLevelController::kMaxCorrectionPpm * 1e-6);
+        std::vector<float> left(kDawBlock), right(kDawBlock);
+        float* out[2] = { left.data(), right.data() };
+
+        for (uint32_t i = 0; i < kTargetFill / kBlockSize; ++i)
+            writeInterleaved(0.1f, -0.1f, kBlockSize);
+
+        double producerOwed = 0.0;
+        int shortReads = 0;
+        uint32_t maxFill = 0;
+        const int blocks = static_cast<int>(kSampleRate) * 180 / static_cast<int>(kDawBlock);
+        for (int b = 0; b < blocks; ++b) {
+            // Host callbacks that happened during this DAW block (host clock offset by drift)
+            producerOwed += kDawBlock * (1.0 + drift);
+            while (producerOwed >= kBlockSize) {
+                writeInterleaved(0.1f, -0.1f, kBlockSize);
+                producerOwed -= kBlockSize;
+            }
+
+            const uint32_t available = consumer.availableRead();
+            maxFill = (std::max)(maxFill, available);
+            // processBlock adds the frames the host has rendered since its last
+            // write (from the block timestamp), hiding the one-block sawtooth
+            const double ratio = pi.update(available + producerOwed, kTargetFill, kDawBlock);
+            const uint32_t need = rs.inputFramesFor(kDawBlock, ratio);
+            if (available < need) {
+                ++shortReads;
+                continue;
+            }
+
+            auto region = consumer.beginRead(need);
+            ASSERT_EQ(region.frames(), need);
+            float* dest1[2] = { rs.inputBuffer(0), rs.inputBuffer(1) };
+            unpackInterleaved(region.format, region.bytes1, kChannels, region.frames1, dest1);
+            if (region.frames2 > 0) {
+                float* dest2[2] = { rs.inputBuffer(0) + region.frames1,
+                                    rs.inputBuffer(1) + region.frames1 };
+                unpackInterleaved(region.format, region.bytes2, kChannels, region.frames2, dest2);
+            }
+            ASSERT_TRUE(consumer.commitRead(need));
+            rs.process(need, out, kDawBlock, ratio);
+        }
+
+        EXPECT_EQ(shortReads, 0) << "drift " << drift;
+        EXPECT_LT(maxFill, kHighThreshold) << "drift " << drift;   // drift-skip never needed
+        EXPECT_NEAR(pi.correctionPpm(), drift * 1e6, 5.0) << "drift " << drift;
+        EXPECT_NEAR(pi.smoothedFill(), kTargetFill, 4.0) << "drift " << drift;
+        EXPECT_FLOAT_EQ(left[kDawBlock - 1], 0.1f);
+        EXPECT_FLOAT_EQ(right[kDawBlock - 1], -0.1f);
+        consumer.detach();
+    }
+}
+
+TEST_F(ReceiverSimulationTest, SampleRateConversionBetweenHostAndDawRates) {
+    // Host at 44.1/48/96 kHz into a DAW at another of those rates: the
+    // Receiver reads at hostRate/dawRate x drift correction. The host's 1 kHz
+    // tone must come out clean and at full level, tracking the read position
+    // the ratio implies, with no short reads and the fill level held.
+    constexpr uint32_t kTargetFill = 1024;
+    constexpr uint32_t kDawBlock = 256;
+    constexpr double kPi = 3.14159265358979323846;
+    const uint32_t rates[] = { 44100, 48000, 96000 };
+
+    for (uint32_t hostRate : rates) {
+        for (uint32_t dawRate : rates) {
+            if (hostRate == dawRate) continue;
+            const double nominal = static_cast<double>(hostRate) / dawRate;
+            const std::string pair = std::to_string(hostRate) + " -> " + std::to_string(dawRate);
+
+            size_t memSize = calculateSharedMemorySize(kCapacity, kChannels);
+            std::vector<uint8_t> mem(memSize + 64, 0);
+            void* raw = mem.data();
+            size_t space = mem.size();
+            void* aligned = std::align(64, memSize, raw, space);
+            ASSERT_NE(aligned, nullptr);
+            RingBuffer host;
+            host.initAsProducer(aligned, kCapacity, kChannels, hostRate);
+            RingBuffer consumer;
+            ASSERT_TRUE(consumer.attachAsConsumer(aligned));
+
+            FillLevelController pi;
+            pi.prepare(dawRate);
+            AdaptiveResampler rs;
+            rs.prepare(kChannels, kDawBlock, 4.5 * 1.001);
+            rs.configure(ResamplerQuality::Sinc32, nominal);
+
+            uint64_t hostFrames = 0;
+            std::vector<float> block(static_cast<size_t>(kBlockSize) * kChannels);
+            auto hostWrite = [&] {
+                for (int i = 0; i < kBlockSize; ++i) {
+                    const float v = static_cast<float>(
+                        0.5 * std::sin(2.0 * kPi * 1000.0 * static_cast<double>(hostFrames + i) / hostRate));
+                    block[i * 2] = v;
+                    block[i * 2 + 1] = -v;
+                }
+                host.write(block.data(), kBlockSize);
+                hostFrames += kBlockSize;
+            };
+            // Prime so the fill seen before the first read is about the target
+            while (hostFrames + kDawBlock * nominal < kTargetFill)
+                hostWrite();
+
+            // Expected tone phase at each output frame: the read position
+            // advances by `ratio` input frames per output frame
+            std::vector<float> left, right(kDawBlock), chunk(kDawBlock);
+            std::vector<double> phase;
+            float* out[2] = { chunk.data(), right.data() };
+            const double inputOmega = 2.0 * kPi * 1000.0 / hostRate;
+            double readPhase = 0.0;
+            double owed = 0.0;
+            int shortReads = 0;
+            double worstFillError = 0.0;
+            const int blocks = static_cast<int>(dawRate) * 4 / static_cast<int>(kDawBlock);  // 4 s
+            for (int b = 0; b < blocks; ++b) {
+                owed += kDawBlock * nominal;
+                while (owed >= kBlockSize) {
+                    hostWrite();
+                    owed -= kBlockSize;
+                }
+
+                const double fill = consumer.availableRead() + owed;
+                // The loop runs in DAW frames, as in processBlock
+                const double ratio = nominal * pi.update(fill / nominal, kTargetFill / nominal, kDawBlock);
+                if (b > blocks / 2)
+                    worstFillError = (std::max)(worstFillError,
+                                                std::fabs(pi.smoothedFill() * nominal - kTargetFill));
+                const uint32_t need = rs.inputFramesFor(kDawBlock, ratio);
+                auto region = consumer.beginRead(need);
+                if (region.frames() < need) {
+                    ++shortReads;
+                    continue;
+                }
+                float* dest1[2] = { rs.inputBuffer(0), rs.inputBuffer(1) };
+                unpackInterleaved(region.format, region.bytes1, kChannels, region.frames1, dest1);
+                if (region.frames2 > 0) {
+                    float* dest2[2] = { rs.inputBuffer(0) + region.frames1,
+                                        rs.inputBuffer(1) + region.frames1 };
+                    unpackInterleaved(region.format, region.bytes2, kChannels, region.frames2, dest2);
+                }
+                ASSERT_TRUE(consumer.commitRead(need));
+                rs.process(need, out, kDawBlock, ratio);
+
+                for (uint32_t i = 0; i < kDawBlock; ++i) {
+                    ASSERT_FLOAT_EQ(right[i], -chunk[i]) << pair;
+                    phase.push_back(readPhase);
+                    readPhase += inputOmega * ratio;
+                }
+                left.insert(left.end(), chunk.begin(), chunk.end());
+            }
+
+            EXPECT_EQ(shortReads, 0) << pair;
+            EXPECT_LT(worstFillError, 64.0) << pair;
+
+            // Fit the tone over 20 ms windows of the last 2 s (the fixed
+            // resampler delay is a constant phase the fit absorbs)
+            const size_t window = dawRate / 50;
+            double worstResidualDb = -300.0;
+            for (size_t start = left.size() - 100 * window; start + window <= left.size(); start += window) {
+                double sc = 0.0, cc = 0.0;
+                for (size_t i = start; i < start + window; ++i) {
+                    sc += left[i] * std::sin(phase[i]);
+                    cc += left[i] * std::cos(phase[i]);
+                }
+                const double a = 2.0 * sc / window, c = 2.0 * cc / window;
+                EXPECT_NEAR(std::sqrt(a * a + c * c), 0.5, 0.005) << pair << " at " << start;
+                double res = 0.0;
+                for (size_t i = start; i < start + window; ++i) {
+                    const double e = left[i] - (a * std::sin(phase[i]) + c * std::cos(phase[i]));
+                    res += e * e;
+                }
+                worstResidualDb = (std::max)(worstResidualDb,
+                                             20.0 * std::log10(std::sqrt(res / window) / 0.5));
+            }
+            EXPECT_LT(worstResidualDb, -60.0) << pair;
+            consumer.detach();
+        }
+    }
+}
+
+TEST_F(ReceiverSimulationTest, AutoBufferFindsSmallestTargetWithoutUnderruns) {
+    // processBlock's "Auto" preset against a host whose callbacks arrive up to
+    // 2 ms late, with a 12 ms hiccup every ~2.7 s (0.2 % of our blocks, far
+    // above the default budget). Auto starts at Low (512), may underrun while it
+    // learns, then must run clean at the smallest target covering the hiccups.
+    constexpr uint32_t kDawBlock = 256;
+    constexpr double kRate = kSampleRate;
+    const double blockSec = kDawBlock / kRate;
+
+    producer_.reset();
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    FillLevelController pi;
+    pi.prepare(kRate);
+    AdaptiveResampler rs;
+    rs.prepare(kChannels, kDawBlock, 1.0 + FillLevelController::kMaxCorrectionPpm * 1e-6);
+    JitterBufferSizer sizer;
+    sizer.reset(JitterBufferSizer::Config{});
+    std::vector<float> left(kDawBlock), right(kDawBlock);
+    float* out[2] = { left.data(), right.data() };
+
+    // Host block k is due at k * 128 / rate and delivered late (in order)
+    uint64_t hostBlock = 0;
+    uint64_t lateSeed = 12345;
+    double lastDelivery = 0.0;
+    auto deliveryTime = [&](uint64_t k) {
+        lateSeed = lateSeed * 6364136223846793005ULL + 1442695040888963407ULL;
+        double late = 0.002 * static_cast<double>(lateSeed >> 11) / 9007199254740992.0;
+        if (k % 1000 == 999)
+            late += 0.012;
+        return k * kBlockSize / kRate + late;
+    };
+    double nextDelivery = deliveryTime(0);
+
+    bool rebuffering = true;
+    int underruns = 0, lateUnderruns = 0;
+    uint32_t peakLateTarget = 0;
+    double worstLateDeficit = 0.0;
+    const int blocks = static_cast<int>(120.0 / blockSec);   // 2 min
+    for (int b = 0; b < blocks; ++b) {
+        const double now = b * blockSec;
+        while (nextDelivery <= now) {
+            writeInterleaved(0.1f, -0.1f, kBlockSize);
+            lastDelivery = (std::max)(lastDelivery, nextDelivery);
+            nextDelivery = (std::max)(deliveryTime(++hostBlock), lastDelivery);
+        }
+
+        const uint32_t target = sizer.target();
+        const uint32_t available = consumer.availableRead();
+        if (rebuffering) {
+            if (available < target)
+                continue;   // Silence until the new target is buffered
+            rebuffering = false;
+            pi.reset();
+        }
+
+        // estimateFill(): frames the host rendered since its newest block's callback
+        const double fill = available + (std::min)((now - lastDelivery) * kRate, double(kBlockSize));
+        const double ratio = pi.update(fill, target, kDawBlock);
+        const uint32_t need = rs.inputFramesFor(kDawBlock, ratio);
+        const double deficit = pi.smoothedFill() - available + need;
+        sizer.observe(deficit, blockSec);
+        if (b > blocks / 2) {
+            peakLateTarget = (std::max)(peakLateTarget, sizer.target());
+            worstLateDeficit = (std::max)(worstLateDeficit, deficit);
+        }
+        if (available < need) {
+            ++underruns;
+            if (b > blocks / 2)
+                ++lateUnderruns;
+            rebuffering = sizer.onUnderrun();
+            continue;
+        }
+
+        auto region = consumer.beginRead(need);
+        ASSERT_EQ(region.frames(), need);
+        float* dest1[2] = { rs.inputBuffer(0), rs.inputBuffer(1) };
+        unpackInterleaved(region.format, region.bytes1, kChannels, region.frames1, dest1);
+        if (region.frames2 > 0) {
+            float* dest2[2] = { rs.inputBuffer(0) + region.frames1,
+                                rs.inputBuffer(1) + region.frames1 };
+            unpackInterleaved(region.format, region.bytes2, kChannels, region.frames2, dest2);
+        }
+        ASSERT_TRUE(consumer.commitRead(need));
+        rs.process(need, out, kDawBlock, ratio);
+    }
+
+    std::cout << "[ AUTO     ] target " << sizer.target() << " (peak " << peakLateTarget
+              << "), worst deficit " << worstLateDeficit << ", underruns " << underruns << std::endl;
+    EXPECT_LE(underruns, 3);
+    EXPECT_EQ(lateUnderruns, 0);
+    EXPECT_EQ(static_cast<uint32_t>(underruns), sizer.underruns());
+    EXPECT_GT(static_cast<double>(sizer.target()), worstLateDeficit);
+    EXPECT_LE(static_cast<double>(sizer.target()), worstLateDeficit + 3 * JitterBufferSizer::kQuantum);
+    EXPECT_LE(peakLateTarget, 1024u);
+    EXPECT_FLOAT_EQ(left[kDawBlock - 1], 0.1f);
+    consumer.detach();
+}
+
 // ─── Producer Death Detection ───────────────────────────────────
 
 TEST_F(ReceiverSimulationTest, ProducerDeathDetection) {
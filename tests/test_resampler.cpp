@@ -0,0 +1,244 @@
+/**
+ * @file test_resampler.cpp
+ * @brief Unit tests for the Receiver's resampler (SRC + drift) and PI loop
+ */
+
+#include <gtest/gtest.h>
+#include "directpipe/Resampler.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace directpipe;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// Run a block stream through `rs`: input[n] = signal(n), returns all output
+template <typename Signal>
+std::vector<float> resampleStream(AdaptiveResampler& rs, Signal signal, uint32_t blocks,
+                                  uint32_t blockFrames, double ratio, uint64_t& consumed)
+{
+    std::vector<float> output;
+    std::vector<float> block(blockFrames);
+    consumed = 0;
+    for (uint32_t b = 0; b < blocks; ++b) {
+        const uint32_t need = rs.inputFramesFor(blockFrames, ratio);
+        float* in = rs.inputBuffer(0);
+        for (uint32_t i = 0; i < need; ++i)
+            in[i] = signal(consumed + i);
+        float* out[1] = { block.data() };
+        rs.process(need, out, blockFrames, ratio);
+        consumed += need;
+        output.insert(output.end(), block.begin(), block.end());
+    }
+    return output;
+}
+
+/// Amplitude of the `hz` component of `x` (sampled at `rate`) and the RMS of
+/// what remains after removing it, from `start` on
+struct ToneFit { double amplitude; double residualRms; };
+ToneFit fitTone(const std::vector<float>& x, size_t start, double hz, double rate)
+{
+    const double w = 2.0 * kPi * hz / rate;
+    double sc = 0.0, cc = 0.0;
+    const size_t n = x.size() - start;
+    for (size_t i = start; i < x.size(); ++i) {
+        sc += x[i] * std::sin(w * i);
+        cc += x[i] * std::cos(w * i);
+    }
+    const double a = 2.0 * sc / n, b = 2.0 * cc / n;
+    double res = 0.0;
+    for (size_t i = start; i < x.size(); ++i) {
+        const double e = x[i] - (a * std::sin(w * i) + b * std::cos(w * i));
+        res += e * e;
+    }
+    return { std::sqrt(a * a + b * b), std::sqrt(res / n) };
+}
+
+} // namespace
+
+TEST(ResamplerTest, UnityRatioIsAPureDelay) {
+    AdaptiveResampler rs;
+    rs.prepare(1, 64, 1.0);
+
+    uint64_t consumed = 0;
+    auto out = resampleStream(rs, [](uint64_t n) { return static_cast<float>(n) * 0.001f; },
+                              8, 64, 1.0, consumed);
+
+    EXPECT_EQ(consumed, 8u * 64u);
+    const auto delay = static_cast<size_t>(rs.latencyFrames());
+    for (size_t i = delay; i < out.size(); ++i)
+        ASSERT_FLOAT_EQ(out[i], static_cast<float>(i - delay) * 0.001f) << "at " << i;
+}
+
+TEST(ResamplerTest, DriftRatioConsumesProportionallyAndTracksSine) {
+    // 1 kHz at 48 kHz, read 800 ppm fast across odd-sized blocks
+    constexpr double kRatio = 1.0008;
+    constexpr double kOmega = 2.0 * kPi * 1000.0 / 48000.0;
+    AdaptiveResampler rs;
+    rs.prepare(1, 137, FillLevelController::kMaxCorrectionPpm * 1e-6 + 1.0);
+
+    uint64_t consumed = 0;
+    auto out = resampleStream(rs, [&](uint64_t n) { return static_cast<float>(std::sin(kOmega * n)); },
+                              400, 137, kRatio, consumed);
+
+    // Input consumed matches the ratio to within one frame
+    EXPECT_NEAR(static_cast<double>(consumed), out.size() * kRatio, 1.0);
+
+    // Output k sits at input position k * ratio - latency
+    double maxError = 0.0;
+    for (size_t k = 16; k < out.size(); ++k) {
+        const double pos = static_cast<double>(k) * kRatio - rs.latencyFrames();
+        maxError = (std::max)(maxError, std::fabs(out[k] - std::sin(kOmega * pos)));
+    }
+    EXPECT_LT(maxError, 1e-3);
+}
+
+TEST(ResamplerTest, OutputFramesForIsTheInverseOfInputFramesFor) {
+    AdaptiveResampler rs;
+    rs.prepare(2, 512, 1.001);
+
+    const double ratios[] = { 0.999, 0.9995, 1.0, 1.0003, 1.001 };
+    std::vector<float> l(512), r(512);
+    float* out[2] = { l.data(), r.data() };
+    for (double ratio : ratios) {
+        for (uint32_t step = 0; step < 20; ++step) {
+            // Advance the phase by a few odd-sized blocks
+            const uint32_t n = rs.inputFramesFor(97 + step, ratio);
+            rs.process(n, out, 97 + step, ratio);
+
+            for (uint32_t in = 0; in < 520; in += 37) {
+                const uint32_t o = rs.outputFramesFor(in, ratio);
+                EXPECT_LE(rs.inputFramesFor(o, ratio), in);
+                if (o < rs.maxOutputFrames()) {
+                    EXPECT_GT(rs.inputFramesFor(o + 1, ratio), in);
+                }
+            }
+        }
+    }
+}
+
+TEST(FillLevelControllerTest, ConvergesOnClockOffsetAndHoldsTarget) {
+    // Fluid model: the producer adds blockFrames * (1 + drift) per block,
+    // the consumer removes blockFrames * ratio
+    constexpr double kTarget = 512.0;
+    constexpr uint32_t kBlock = 256;
+    const double drifts[] = { 300e-6, -300e-6, 50e-6 };
+
+    for (double drift : drifts) {
+        FillLevelController pi;
+        pi.prepare(48000.0);
+        double fill = kTarget;
+        double peakError = 0.0;
+        for (int b = 0; b < 48000 * 120 / static_cast<int>(kBlock); ++b) {  // 120 s
+            fill += kBlock * (1.0 + drift);
+            const double ratio = pi.update(fill, kTarget + kBlock, kBlock);
+            fill -= kBlock * ratio;
+            peakError = (std::max)(peakError, std::fabs(fill - kTarget));
+        }
+        EXPECT_NEAR(pi.correctionPpm(), drift * 1e6, 2.0) << "drift " << drift;
+        EXPECT_NEAR(fill, kTarget, 2.0) << "drift " << drift;
+        EXPECT_LT(peakError, 64.0) << "drift " << drift;
+    }
+}
+
+TEST(FillLevelControllerTest, CorrectionIsBounded) {
+    FillLevelController pi;
+    pi.prepare(48000.0);
+    for (int b = 0; b < 10000; ++b)
+        pi.update(4096.0, 512.0, 128);
+    EXPECT_NEAR(pi.correctionPpm(), FillLevelController::kMaxCorrectionPpm, 1e-6);
+
+    // Integrator was clamped: a starved ring swings straight to the other bound
+    for (int b = 0; b < 2000; ++b)
+        pi.update(0.0, 512.0, 128);
+    EXPECT_NEAR(pi.correctionPpm(), -FillLevelController::kMaxCorrectionPpm, 1e-6);
+
+    pi.reset();
+    EXPECT_DOUBLE_EQ(pi.ratio(), 1.0);
+}
+
+TEST(ResamplerTest, SincQualitiesConvertCommonRatesCleanly) {
+    // 1 kHz tone through every sinc quality and rate pair: correct pitch,
+    // unity gain, residual (aliasing + interpolation error) far below the tone
+    const double rates[] = { 44100.0, 48000.0, 96000.0 };
+    const ResamplerQuality qualities[] = { ResamplerQuality::Sinc16, ResamplerQuality::Sinc32,
+                                           ResamplerQuality::Sinc64 };
+    const double floorDb[] = { -55.0, -70.0, -75.0 };
+
+    for (size_t q = 0; q < 3; ++q) {
+        for (double inRate : rates) {
+            for (double outRate : rates) {
+                const double ratio = inRate / outRate;
+                AdaptiveResampler rs;
+                rs.prepare(1, 256, 2.2);
+                rs.configure(qualities[q], ratio);
+
+                uint64_t consumed = 0;
+                auto out = resampleStream(
+                    rs, [&](uint64_t n) { return static_cast<float>(0.5 * std::sin(2.0 * kPi * 1000.0 * n / inRate)); },
+                    static_cast<uint32_t>(outRate / 256.0), 256, ratio, consumed);
+
+                const auto fit = fitTone(out, 512, 1000.0, outRate);
+                EXPECT_NEAR(fit.amplitude, 0.5, 0.5 * 0.005)
+                    << inRate << " -> " << outRate << " q" << q;
+                EXPECT_LT(20.0 * std::log10(fit.residualRms / 0.5), floorDb[q])
+                    << inRate << " -> " << outRate << " q" << q;
+            }
+        }
+    }
+}
+
+TEST(ResamplerTest, DownsamplingRejectsContentAboveOutputNyquist) {
+    // 96 -> 48 kHz: a 30 kHz tone has no place in the output and must not
+    // alias down to 18 kHz; the cubic kernel (no anti-aliasing) lets it through
+    AdaptiveResampler rs;
+    rs.prepare(1, 256, 2.2);
+
+    auto aliasLevel = [&](ResamplerQuality quality) {
+        rs.configure(quality, 2.0);
+        EXPECT_GE(rs.taps(), quality == ResamplerQuality::Cubic ? 4u : 64u);
+        uint64_t consumed = 0;
+        auto out = resampleStream(
+            rs, [](uint64_t n) { return static_cast<float>(std::sin(2.0 * kPi * 30000.0 * n / 96000.0)); },
+            100, 256, 2.0, consumed);
+        return 20.0 * std::log10(fitTone(out, 512, 18000.0, 48000.0).amplitude + 1e-12);
+    };
+
+    EXPECT_GT(aliasLevel(ResamplerQuality::Cubic), -20.0);
+    EXPECT_LT(aliasLevel(ResamplerQuality::Sinc32), -70.0);
+    EXPECT_LT(aliasLevel(ResamplerQuality::Sinc64), -90.0);
+}
+
+TEST(ResamplerTest, SincLatencyMatchesReportedGroupDelay) {
+    // A slow ramp through a symmetric kernel comes out shifted by exactly latencyFrames()
+    AdaptiveResampler rs;
+    rs.prepare(1, 64, 1.0);
+    rs.configure(ResamplerQuality::Sinc32, 1.0);
+    EXPECT_EQ(rs.taps(), 32u);
+    EXPECT_DOUBLE_EQ(rs.latencyFrames(), 17.0);
+
+    uint64_t consumed = 0;
+    auto out = resampleStream(rs, [](uint64_t n) { return static_cast<float>(n) * 1e-4f; },
+                              8, 64, 1.0, consumed);
+    const auto delay = static_cast<size_t>(rs.latencyFrames());
+    for (size_t i = 64; i < out.size(); ++i)
+        ASSERT_NEAR(out[i], static_cast<float>(i - delay) * 1e-4f, 1e-5f) << "at " << i;
+}
+
+TEST(ResamplerTest, LatencyFramesForMatchesConfiguredKernel) {
+    // The Receiver reports this before it has a connection; it must not change once one is built
+    constexpr double kMaxRatio = 4.5 * 1.001;
+    AdaptiveResampler rs;
+    rs.prepare(2, 256, kMaxRatio);
+    for (auto quality : { ResamplerQuality::Cubic, ResamplerQuality::Sinc16,
+                          ResamplerQuality::Sinc32, ResamplerQuality::Sinc64 }) {
+        for (double ratio : { 0.25, 0.9187, 1.0, 1.0884, 2.0, 4.0 }) {
+            rs.configure(quality, ratio);
+            EXPECT_DOUBLE_EQ(AdaptiveResampler::latencyFramesFor(quality, ratio, kMaxRatio), rs.latencyFrames())
+                << "quality " << static_cast<int>(quality) << " ratio " << ratio;
+        }
+    }
+}
@@ -1,6 +1,6 @@
 /**
  * @file test_ring_buffer.cpp
- * @brief Unit tests for SPSC lock-free ring buffer
+ * @brief Unit tests for the lock-free broadcast ring buffer
  */
 
 #include <gtest/gtest.h>
@@ -8,6 +8,7 @@
 #include "directpipe/Constants.h"
 #include "directpipe/Protocol.h"
 
+#include <memory>
 #include <vector>
 #include <thread>
 #include <atomic>
@@ -374,3 +375,753 @@ TEST_F(RingBufferTest, AvailableReadWriteConsistency) {
     EXPECT_EQ(consumer.availableRead(), 312u);
     EXPECT_EQ(producer.availableWrite(), kCapacity - 312);
 }
+
+// ─── Multi-consumer broadcast tests ─────────────────────────────
+
+TEST_F(RingBufferTest, TwoConsumersEachReceiveEveryFrame) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    RingBuffer consumerA;
+    RingBuffer consumerB;
+    ASSERT_TRUE(consumerA.attachAsConsumer(alignedMem_));
+    ASSERT_TRUE(consumerB.attachAsConsumer(alignedMem_));
+    EXPECT_EQ(producer.getConsumerCount(), 2u);
+
+    const uint32_t frames = 256;
+    std::vector<float> writeData(frames * kChannels);
+    for (size_t i = 0; i < writeData.size(); ++i)
+        writeData[i] = static_cast<float>(i);
+    ASSERT_EQ(producer.write(writeData.data(), frames), frames);
+
+    // Both consumers see the same frames independently
+    std::vector<float> readA(frames * kChannels, 0.0f);
+    std::vector<float> readB(frames * kChannels, 0.0f);
+    EXPECT_EQ(consumerA.read(readA.data(), frames), frames);
+    EXPECT_EQ(consumerB.availableRead(), frames);
+    EXPECT_EQ(consumerB.read(readB.data(), frames), frames);
+
+    for (size_t i = 0; i < writeData.size(); ++i) {
+        EXPECT_FLOAT_EQ(readA[i], writeData[i]) << "Consumer A mismatch at index " << i;
+        EXPECT_FLOAT_EQ(readB[i], writeData[i]) << "Consumer B mismatch at index " << i;
+    }
+}
+
+TEST_F(RingBufferTest, SlowestConsumerBoundsFreeSpace) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    RingBuffer fast;
+    RingBuffer slow;
+    ASSERT_TRUE(fast.attachAsConsumer(alignedMem_));
+    ASSERT_TRUE(slow.attachAsConsumer(alignedMem_));
+
+    std::vector<float> data(512 * kChannels, 1.0f);
+    producer.write(data.data(), 512);
+
+    fast.read(data.data(), 512);
+    slow.read(data.data(), 100);
+
+    // Slow consumer still holds 412 frames — free space follows it, not the fast one
+    EXPECT_EQ(producer.availableWrite(), kCapacity - 412);
+    EXPECT_EQ(fast.availableRead(), 0u);
+    EXPECT_EQ(slow.availableRead(), 412u);
+}
+
+TEST_F(RingBufferTest, StalledConsumerIsEvicted) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    producer.setStallTimeoutMs(0);
+
+    RingBuffer live;
+    RingBuffer stalled;
+    ASSERT_TRUE(live.attachAsConsumer(alignedMem_));
+    ASSERT_TRUE(stalled.attachAsConsumer(alignedMem_));
+
+    // Fill the buffer; the live consumer drains it, the stalled one never reads
+    std::vector<float> fill(kCapacity * kChannels, 1.0f);
+    ASSERT_EQ(producer.write(fill.data(), kCapacity), kCapacity);
+    ASSERT_EQ(live.read(fill.data(), kCapacity), kCapacity);
+
+    std::vector<float> block(128 * kChannels, 2.0f);
+    // First blocked write arms the stall tracker; nothing fits yet
+    EXPECT_EQ(producer.write(block.data(), 128), 0u);
+    // Stalled consumer still hasn't read — evicted, write goes through
+    EXPECT_EQ(producer.write(block.data(), 128), 128u);
+    EXPECT_EQ(producer.getEvictedConsumerCount(), 1u);
+    EXPECT_EQ(producer.getConsumerCount(), 1u);
+
+    // The live consumer was never blocked
+    EXPECT_EQ(live.read(block.data(), 128), 128u);
+    EXPECT_FLOAT_EQ(block[0], 2.0f);
+}
+
+TEST_F(RingBufferTest, EvictedConsumerRejoinsAtLiveEdge) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    producer.setStallTimeoutMs(0);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    std::vector<float> fill(kCapacity * kChannels, 1.0f);
+    ASSERT_EQ(producer.write(fill.data(), kCapacity), kCapacity);
+    EXPECT_EQ(producer.write(fill.data(), 64), 0u);   // arms
+    EXPECT_EQ(producer.write(fill.data(), 64), 64u);  // evicts, then writes
+    EXPECT_EQ(producer.getConsumerCount(), 0u);
+
+    // Next read notices the eviction and re-claims at the write position
+    EXPECT_EQ(consumer.read(fill.data(), 64), 0u);
+    EXPECT_EQ(consumer.getEvictionCount(), 1u);
+    EXPECT_EQ(producer.getConsumerCount(), 1u);
+    EXPECT_EQ(consumer.availableRead(), 0u);
+
+    std::vector<float> block(32 * kChannels, 3.0f);
+    ASSERT_EQ(producer.write(block.data(), 32), 32u);
+    std::vector<float> readData(32 * kChannels, 0.0f);
+    EXPECT_EQ(consumer.read(readData.data(), 32), 32u);
+    EXPECT_FLOAT_EQ(readData[0], 3.0f);
+}
+
+TEST_F(RingBufferTest, ActiveConsumerIsNotEvicted) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    producer.setStallTimeoutMs(0);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    std::vector<float> fill(kCapacity * kChannels, 1.0f);
+    ASSERT_EQ(producer.write(fill.data(), kCapacity), kCapacity);
+
+    // The consumer keeps reading (heartbeat advances) between blocked writes
+    std::vector<float> block(64 * kChannels, 1.0f);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(producer.write(block.data(), 64), 0u);
+        consumer.read(block.data(), 0);  // heartbeat without consuming
+        EXPECT_EQ(consumer.read(block.data(), 16), 16u);
+        EXPECT_EQ(producer.write(block.data(), 16), 16u);
+    }
+    EXPECT_EQ(producer.getEvictedConsumerCount(), 0u);
+    EXPECT_EQ(consumer.getEvictionCount(), 0u);
+}
+
+TEST_F(RingBufferTest, AttachFailsWhenAllSlotsTaken) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    std::vector<std::unique_ptr<RingBuffer>> consumers;
+    for (uint32_t i = 0; i < MAX_CONSUMERS; ++i) {
+        consumers.push_back(std::make_unique<RingBuffer>());
+        ASSERT_TRUE(consumers.back()->attachAsConsumer(alignedMem_)) << "slot " << i;
+    }
+    EXPECT_EQ(producer.getConsumerCount(), MAX_CONSUMERS);
+
+    RingBuffer extra;
+    EXPECT_FALSE(extra.attachAsConsumer(alignedMem_));
+    EXPECT_TRUE(extra.consumerSlotsExhausted());
+    EXPECT_FALSE(extra.isValid());
+
+    // Releasing one slot lets the next consumer in
+    consumers.front()->detach();
+    EXPECT_TRUE(extra.attachAsConsumer(alignedMem_));
+    EXPECT_FALSE(extra.consumerSlotsExhausted());
+    EXPECT_EQ(producer.getConsumerCount(), MAX_CONSUMERS);
+}
+
+TEST_F(RingBufferTest, ConcurrentProducerTwoConsumers) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    RingBuffer consumers[2];
+    ASSERT_TRUE(consumers[0].attachAsConsumer(alignedMem_));
+    ASSERT_TRUE(consumers[1].attachAsConsumer(alignedMem_));
+
+    constexpr uint32_t kFramesPerBlock = 128;
+    constexpr uint32_t kTotalBlocks = 1000;
+    constexpr uint64_t kTotalFrames = static_cast<uint64_t>(kFramesPerBlock) * kTotalBlocks;
+
+    std::atomic<bool> producerDone{false};
+    std::atomic<bool> sequenceOk[2] = {{true}, {true}};
+    uint64_t totalRead[2] = {0, 0};
+
+    std::thread producerThread([&]() {
+        std::vector<float> data(kFramesPerBlock * kChannels);
+        uint64_t frameIndex = 0;
+        while (frameIndex < kTotalFrames) {
+            for (uint32_t f = 0; f < kFramesPerBlock; ++f)
+                for (uint32_t c = 0; c < kChannels; ++c)
+                    data[f * kChannels + c] = static_cast<float>((frameIndex + f) % 65536);
+
+            if (producer.write(data.data(), kFramesPerBlock) == kFramesPerBlock)
+                frameIndex += kFramesPerBlock;
+            else
+                std::this_thread::yield();
+        }
+        producerDone.store(true, std::memory_order_release);
+    });
+
+    auto consume = [&](int idx) {
+        std::vector<float> data(kFramesPerBlock * kChannels);
+        while (!producerDone.load(std::memory_order_acquire) ||
+               consumers[idx].availableRead() > 0) {
+            uint32_t n = consumers[idx].read(data.data(), kFramesPerBlock);
+            if (n == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (uint32_t f = 0; f < n; ++f) {
+                if (data[f * kChannels] != static_cast<float>((totalRead[idx] + f) % 65536))
+                    sequenceOk[idx].store(false, std::memory_order_relaxed);
+            }
+            totalRead[idx] += n;
+        }
+    };
+
+    std::thread consumerThreadA(consume, 0);
+    std::thread consumerThreadB(consume, 1);
+
+    producerThread.join();
+    consumerThreadA.join();
+    consumerThreadB.join();
+
+    EXPECT_EQ(totalRead[0], kTotalFrames);
+    EXPECT_EQ(totalRead[1], kTotalFrames);
+    EXPECT_TRUE(sequenceOk[0].load());
+    EXPECT_TRUE(sequenceOk[1].load());
+    EXPECT_EQ(producer.getEvictedConsumerCount(), 0u);
+}
+
+// ─── Zero-copy reserve/commit tests ─────────────────────────────
+
+TEST_F(RingBufferTest, BeginWriteSplitsAtWrapPoint) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    // Move both cursors to 100 frames before the end of the ring
+    std::vector<float> fill((kCapacity - 100) * kChannels, 0.0f);
+    producer.write(fill.data(), kCapacity - 100);
+    consumer.read(fill.data(), kCapacity - 100);
+
+    auto region = producer.beginWrite(160);
+    ASSERT_EQ(region.frames(), 160u);
+    EXPECT_EQ(region.frames1, 100u);
+    EXPECT_EQ(region.frames2, 60u);
+    ASSERT_NE(region.span2, nullptr);
+
+    // Interleave a ramp straight into shared memory
+    for (uint32_t f = 0; f < region.frames1; ++f)
+        for (uint32_t c = 0; c < kChannels; ++c)
+            region.span1[f * kChannels + c] = static_cast<float>(f * 10 + c);
+    for (uint32_t f = 0; f < region.frames2; ++f)
+        for (uint32_t c = 0; c < kChannels; ++c)
+            region.span2[f * kChannels + c] = static_cast<float>((region.frames1 + f) * 10 + c);
+
+    // Not visible until committed
+    EXPECT_EQ(consumer.availableRead(), 0u);
+    producer.commitWrite(region.frames());
+    EXPECT_EQ(consumer.availableRead(), 160u);
+
+    std::vector<float> readData(160 * kChannels, 0.0f);
+    ASSERT_EQ(consumer.read(readData.data(), 160), 160u);
+    for (uint32_t f = 0; f < 160; ++f)
+        for (uint32_t c = 0; c < kChannels; ++c)
+            EXPECT_FLOAT_EQ(readData[f * kChannels + c], static_cast<float>(f * 10 + c));
+}
+
+TEST_F(RingBufferTest, BeginWriteClampsToFreeSpace) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    std::vector<float> fill((kCapacity - 32) * kChannels, 0.0f);
+    producer.write(fill.data(), kCapacity - 32);
+
+    auto region = producer.beginWrite(128);
+    EXPECT_EQ(region.frames(), 32u);
+
+    // Partial commit publishes only what was filled; abandoning costs nothing
+    producer.commitWrite(16);
+    EXPECT_EQ(producer.availableWrite(), 16u);
+    producer.beginWrite(16);
+    producer.commitWrite(0);
+    EXPECT_EQ(producer.availableWrite(), 16u);
+}
+
+TEST_F(RingBufferTest, BeginReadExposesSharedMemoryInPlace) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    std::vector<float> data(64 * kChannels);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<float>(i);
+    producer.write(data.data(), 64);
+
+    auto region = consumer.beginRead(48);
+    ASSERT_EQ(region.frames(), 48u);
+    EXPECT_EQ(region.frames2, 0u);
+    for (size_t i = 0; i < 48 * kChannels; ++i)
+        EXPECT_FLOAT_EQ(region.span1[i], data[i]);
+
+    // Commit only part of the region — the rest is read again next time
+    consumer.commitRead(32);
+    EXPECT_EQ(consumer.availableRead(), 32u);
+
+    region = consumer.beginRead(64);
+    ASSERT_EQ(region.frames(), 32u);
+    EXPECT_FLOAT_EQ(region.span1[0], data[32 * kChannels]);
+    consumer.commitRead(region.frames());
+    EXPECT_EQ(consumer.availableRead(), 0u);
+    EXPECT_EQ(producer.availableWrite(), kCapacity);
+}
+
+TEST_F(RingBufferTest, ReserveCommitAfterDetachIsNoOp) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    std::vector<float> data(64 * kChannels, 1.0f);
+    producer.write(data.data(), 64);
+
+    auto readRegion = consumer.beginRead(64);
+    EXPECT_EQ(readRegion.frames(), 64u);
+    consumer.detach();
+    consumer.commitRead(64);  // Must not touch shared memory
+    EXPECT_EQ(producer.availableRead(), 64u);
+
+    auto writeRegion = producer.beginWrite(64);
+    EXPECT_EQ(writeRegion.frames(), 64u);
+    producer.detach();
+    producer.commitWrite(64);
+    EXPECT_EQ(producer.beginWrite(64).frames(), 0u);
+}
+
+TEST_F(RingBufferTest, Int16RingRoundTripsAndHalvesFootprint) {
+    EXPECT_EQ(calculateSharedMemorySize(kCapacity, kChannels, SampleFormat::Int16) - sizeof(DirectPipeHeader),
+              (calculateSharedMemorySize(kCapacity, kChannels) - sizeof(DirectPipeHeader)) / 2);
+
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate, SampleFormat::Int16);
+    EXPECT_EQ(producer.getSampleFormat(), SampleFormat::Int16);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_,
+        calculateSharedMemorySize(kCapacity, kChannels, SampleFormat::Int16)));
+    EXPECT_EQ(consumer.getSampleFormat(), SampleFormat::Int16);
+
+    // Wrap the ring so both write and read split
+    std::vector<float> pad((kCapacity - 100) * kChannels, 0.0f);
+    std::vector<float> sink(pad.size());
+    ASSERT_EQ(producer.write(pad.data(), kCapacity - 100), kCapacity - 100);
+    ASSERT_EQ(consumer.read(sink.data(), kCapacity - 100), kCapacity - 100);
+
+    std::vector<float> data(256 * kChannels);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = std::sin(static_cast<float>(i) * 0.05f) * 0.9f;
+    ASSERT_EQ(producer.write(data.data(), 256), 256u);
+
+    // Raw region exposes the packed bytes; the float view is only for Float32 rings
+    auto region = consumer.beginRead(256);
+    EXPECT_EQ(region.format, SampleFormat::Int16);
+    EXPECT_EQ(region.frames1, 100u);
+    EXPECT_EQ(region.span1, nullptr);
+    ASSERT_NE(region.bytes1, nullptr);
+    ASSERT_NE(region.bytes2, nullptr);
+    consumer.commitRead(0);
+
+    std::vector<float> out(data.size());
+    ASSERT_EQ(consumer.read(out.data(), 256), 256u);
+    for (size_t i = 0; i < data.size(); ++i)
+        EXPECT_NEAR(out[i], data[i], 1.0f / 32767.0f) << "at " << i;
+}
+
+TEST_F(RingBufferTest, AttachNegotiatesSampleFormat) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate, SampleFormat::Int16);
+    EXPECT_EQ(producer.getConsumerFormatMask(), ALL_SAMPLE_FORMATS);
+
+    // A float-only consumer cannot decode this ring
+    RingBuffer floatOnly;
+    EXPECT_FALSE(floatOnly.attachAsConsumer(alignedMem_, 0, sampleFormatBit(SampleFormat::Float32)));
+    EXPECT_TRUE(floatOnly.formatRejected());
+    EXPECT_FALSE(floatOnly.consumerSlotsExhausted());
+    EXPECT_EQ(producer.getConsumerCount(), 0u);
+
+    // Consumers publish what they accept; the producer sees the intersection
+    RingBuffer encoder;
+    ASSERT_TRUE(encoder.attachAsConsumer(alignedMem_, 0,
+        sampleFormatBit(SampleFormat::Int16) | sampleFormatBit(SampleFormat::Float32)));
+    EXPECT_FALSE(encoder.formatRejected());
+
+    RingBuffer receiver;
+    ASSERT_TRUE(receiver.attachAsConsumer(alignedMem_));
+
+    EXPECT_EQ(producer.getConsumerFormatMask(),
+              sampleFormatBit(SampleFormat::Int16) | sampleFormatBit(SampleFormat::Float32));
+
+    encoder.detach();
+    EXPECT_EQ(producer.getConsumerFormatMask(), ALL_SAMPLE_FORMATS);
+}
+
+TEST_F(RingBufferTest, PlanarLayoutRoundTripsAcrossWrap) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate,
+                            SampleFormat::Float32, SampleLayout::Planar);
+    EXPECT_EQ(producer.getSampleLayout(), SampleLayout::Planar);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+    EXPECT_EQ(consumer.getSampleLayout(), SampleLayout::Planar);
+
+    // Wrap the ring so both write and read split
+    std::vector<float> pad((kCapacity - 100) * kChannels, 0.0f);
+    std::vector<float> sink(pad.size());
+    ASSERT_EQ(producer.write(pad.data(), kCapacity - 100), kCapacity - 100);
+    ASSERT_EQ(consumer.read(sink.data(), kCapacity - 100), kCapacity - 100);
+
+    // Interleaved API on a planar ring: L = +i, R = -i
+    std::vector<float> data(256 * kChannels);
+    for (size_t i = 0; i < 256; ++i) {
+        data[i * 2] = static_cast<float>(i);
+        data[i * 2 + 1] = -static_cast<float>(i);
+    }
+    ASSERT_EQ(producer.write(data.data(), 256), 256u);
+
+    // Each channel is its own contiguous plane of kCapacity samples
+    auto region = consumer.beginRead(256);
+    EXPECT_EQ(region.layout, SampleLayout::Planar);
+    EXPECT_EQ(region.planeStride, kCapacity * sizeof(float));
+    ASSERT_EQ(region.frames1, 100u);
+    ASSERT_NE(region.span2, nullptr);
+    EXPECT_FLOAT_EQ(region.span1[0], 0.0f);
+    EXPECT_FLOAT_EQ(region.span1[99], 99.0f);
+    EXPECT_FLOAT_EQ(region.span1[kCapacity], 0.0f);
+    EXPECT_FLOAT_EQ(region.span1[kCapacity + 99], -99.0f);
+    EXPECT_FLOAT_EQ(region.span2[0], 100.0f);
+    EXPECT_FLOAT_EQ(region.span2[kCapacity], -100.0f);
+    consumer.commitRead(0);
+
+    std::vector<float> out(data.size());
+    ASSERT_EQ(consumer.read(out.data(), 256), 256u);
+    EXPECT_EQ(out, data);
+}
+
+TEST_F(RingBufferTest, AttachRejectsUnknownSampleLayout) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    static_cast<DirectPipeHeader*>(alignedMem_)->sample_layout = 7;
+
+    RingBuffer consumer;
+    EXPECT_FALSE(consumer.attachAsConsumer(alignedMem_));
+}
+
+TEST_F(RingBufferTest, RegionsCarryStreamPosition) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    std::vector<float> data(300 * kChannels, 0.0f);
+    ASSERT_EQ(producer.write(data.data(), 300), 300u);
+
+    auto w = producer.beginWrite(10);
+    EXPECT_EQ(w.position, 300u);
+    producer.commitWrite(10);
+
+    auto r = consumer.beginRead(100);
+    EXPECT_EQ(r.position, 0u);
+    consumer.commitRead(100);
+    EXPECT_EQ(consumer.beginRead(1).position, 100u);
+    consumer.commitRead(0);
+}
+
+TEST_F(RingBufferTest, BlockMetaPublishFindAndRecycle) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    BlockMetaSnapshot meta;
+    EXPECT_FALSE(consumer.latestBlockMeta(meta));
+    EXPECT_FALSE(consumer.findBlockMeta(0, meta));
+
+    // 100 blocks of 32 frames: more than BLOCK_META_CAPACITY, so the oldest are recycled
+    constexpr uint32_t kBlock = 32;
+    constexpr uint64_t kBlocks = 100;
+    for (uint64_t n = 0; n < kBlocks; ++n)
+        producer.publishBlockMeta(n * kBlock, kBlock, 1000000 + n * 666667, 5000 + n * kBlock);
+
+    ASSERT_TRUE(consumer.latestBlockMeta(meta));
+    EXPECT_EQ(meta.stream_pos, (kBlocks - 1) * kBlock);
+    EXPECT_EQ(meta.frames, kBlock);
+
+    // A frame in the middle of a recent block maps to that block
+    const uint64_t n = kBlocks - 10;
+    ASSERT_TRUE(consumer.findBlockMeta(n * kBlock + 17, meta));
+    EXPECT_EQ(meta.stream_pos, n * kBlock);
+    EXPECT_EQ(meta.host_time_ns, 1000000 + n * 666667);
+    EXPECT_EQ(meta.sample_counter, 5000 + n * kBlock);
+
+    // Oldest surviving entry, recycled entry, and a position not written yet
+    EXPECT_TRUE(consumer.findBlockMeta((kBlocks - BLOCK_META_CAPACITY) * kBlock, meta));
+    EXPECT_FALSE(consumer.findBlockMeta((kBlocks - BLOCK_META_CAPACITY - 1) * kBlock, meta));
+    EXPECT_FALSE(consumer.findBlockMeta(kBlocks * kBlock, meta));
+
+    // reset() rewinds stream positions, so old stamps must not match anymore
+    producer.reset();
+    EXPECT_FALSE(consumer.latestBlockMeta(meta));
+}
+
+TEST_F(RingBufferTest, BlockMetaSeqlockNeverTearsUnderConcurrency) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    // Every field is derived from the block index, so a torn copy is detectable
+    constexpr uint64_t kBlocks = 200000;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t n = 1; n <= kBlocks; ++n)
+            producer.publishBlockMeta(n * 64, static_cast<uint32_t>(n & 0xFFFF), n * 3, n * 7);
+        done.store(true, std::memory_order_release);
+    });
+
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        BlockMetaSnapshot meta;
+        if (!consumer.latestBlockMeta(meta)) continue;
+        const uint64_t n = meta.stream_pos / 64;
+        if (meta.frames != (n & 0xFFFF) || meta.host_time_ns != n * 3 || meta.sample_counter != n * 7)
+            ++torn;
+        ++reads;
+    }
+    writer.join();
+
+    EXPECT_EQ(torn, 0u) << "out of " << reads << " reads";
+}
+
+TEST_F(RingBufferTest, ConsumerLatencyReportedToProducer) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    RingBuffer c1, c2;
+    ASSERT_TRUE(c1.attachAsConsumer(alignedMem_));
+    ASSERT_TRUE(c2.attachAsConsumer(alignedMem_));
+    EXPECT_EQ(producer.getMaxConsumerLatencyUs(), 0u);
+
+    c1.reportLatencyUs(1500);
+    c2.reportLatencyUs(4200);
+    EXPECT_EQ(producer.getMaxConsumerLatencyUs(), 4200u);
+
+    // A departed consumer's report no longer counts
+    c2.detach();
+    EXPECT_EQ(producer.getMaxConsumerLatencyUs(), 1500u);
+}
+
+TEST_F(RingBufferTest, ConsumerStatsPublishedPerSlot) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    RingBuffer c1, c2;
+    ASSERT_TRUE(c1.attachAsConsumer(alignedMem_));
+    ASSERT_TRUE(c2.attachAsConsumer(alignedMem_));
+
+    ConsumerStatsSnapshot stats;
+    stats.blocks = 1000;
+    stats.frames_padded = 96;
+    stats.frames_skipped = 2048;
+    stats.frames_concealed = 64;
+    stats.underruns = 3;
+    stats.fill_frames = 700;
+    stats.resample_ratio_micros = 1000120;
+    stats.process_ns = 12000;
+    stats.process_peak_ns = 80000;
+    stats.fill_histogram[fillHistogramBin(700)] = 997;
+    stats.fill_histogram[fillHistogramBin(10)] = 3;
+    c2.publishConsumerStats(stats);
+    c2.reportLatencyUs(4200);
+
+    ConsumerStatsSnapshot out[MAX_CONSUMERS];
+    ASSERT_EQ(producer.readConsumerStats(out, MAX_CONSUMERS), 2u);
+    EXPECT_EQ(out[0].blocks, 0u);   // c1 has not published anything
+    EXPECT_NE(out[0].slot, out[1].slot);
+    EXPECT_EQ(out[1].latency_us, 4200u);
+    EXPECT_EQ(out[1].blocks, 1000u);
+    EXPECT_EQ(out[1].frames_padded, 96u);
+    EXPECT_EQ(out[1].frames_skipped, 2048u);
+    EXPECT_EQ(out[1].frames_concealed, 64u);
+    EXPECT_EQ(out[1].underruns, 3u);
+    EXPECT_EQ(out[1].fill_frames, 700u);
+    EXPECT_EQ(out[1].resample_ratio_micros, 1000120u);
+    EXPECT_EQ(out[1].process_ns, 12000u);
+    EXPECT_EQ(out[1].process_peak_ns, 80000u);
+    EXPECT_EQ(out[1].fill_histogram[4], 997u);   // [512, 1024)
+    EXPECT_EQ(out[1].fill_histogram[0], 3u);
+    EXPECT_EQ(producer.readConsumerStats(out, 1), 1u);
+
+    // Histogram bins double from 64 frames up; the last one is open-ended
+    EXPECT_EQ(fillHistogramBin(63), 0u);
+    EXPECT_EQ(fillHistogramBin(64), 1u);
+    EXPECT_EQ(fillHistogramBin(1023), 4u);
+    EXPECT_EQ(fillHistogramBin(1024), 5u);
+    EXPECT_EQ(fillHistogramBin(0xFFFFFFFFu), FILL_HISTOGRAM_BINS - 1);
+    EXPECT_EQ(fillHistogramBinFloor(5), 1024u);
+    EXPECT_EQ(fillHistogramBin(fillHistogramBinFloor(9)), 9u);
+
+    // A new owner of the slot starts from zero
+    c2.detach();
+    RingBuffer c3;
+    ASSERT_TRUE(c3.attachAsConsumer(alignedMem_));
+    ASSERT_EQ(producer.readConsumerStats(out, MAX_CONSUMERS), 2u);
+    EXPECT_EQ(out[0].blocks + out[1].blocks, 0u);
+    EXPECT_EQ(out[0].fill_histogram[4] + out[1].fill_histogram[4], 0u);
+}
+
+TEST_F(RingBufferTest, OverwriteOldestNeverDropsAndRetiresOldFrames) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    producer.setOverrunPolicy(OverrunPolicy::OverwriteOldest);
+
+    RingBuffer idle;  // attached, never reads
+    ASSERT_TRUE(idle.attachAsConsumer(alignedMem_));
+    EXPECT_EQ(idle.getOverrunPolicy(), OverrunPolicy::OverwriteOldest);
+
+    std::vector<float> block(256 * kChannels, 1.0f);
+    for (int i = 0; i < 12; ++i)
+        EXPECT_EQ(producer.write(block.data(), 256), 256u) << "block " << i;
+
+    auto* header = static_cast<DirectPipeHeader*>(alignedMem_);
+    EXPECT_EQ(header->write_pos.load(), 12u * 256u);
+    EXPECT_EQ(header->oldest_pos.load(), 12u * 256u - kCapacity);
+    EXPECT_EQ(header->last_block_pos.load(), 11u * 256u);
+    EXPECT_EQ(producer.getOverwrittenFrames(), 12u * 256u - kCapacity);
+
+    // A block larger than the ring keeps its first getCapacity() frames
+    std::vector<float> huge((kCapacity + 100) * kChannels, 2.0f);
+    EXPECT_EQ(producer.write(huge.data(), kCapacity + 100), kCapacity);
+}
+
+TEST_F(RingBufferTest, LappedConsumerResumesAtNewestBlock) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    producer.setOverrunPolicy(OverrunPolicy::OverwriteOldest);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    // Consumer stalls while the producer laps it several times; block i holds value i
+    constexpr uint32_t kBlock = 128;
+    std::vector<float> block(kBlock * kChannels);
+    for (int i = 1; i <= 40; ++i) {
+        std::fill(block.begin(), block.end(), static_cast<float>(i));
+        ASSERT_EQ(producer.write(block.data(), kBlock), kBlock);
+    }
+
+    // No stale replay: the first read is the newest block, then live audio follows
+    std::vector<float> out(kCapacity * kChannels, 0.0f);
+    EXPECT_EQ(consumer.read(out.data(), kCapacity), kBlock);
+    EXPECT_FLOAT_EQ(out[0], 40.0f);
+    EXPECT_FLOAT_EQ(out[kBlock * kChannels - 1], 40.0f);
+    EXPECT_EQ(consumer.getLapCount(), 1u);
+
+    std::fill(block.begin(), block.end(), 41.0f);
+    ASSERT_EQ(producer.write(block.data(), kBlock), kBlock);
+    EXPECT_EQ(consumer.read(out.data(), kCapacity), kBlock);
+    EXPECT_FLOAT_EQ(out[0], 41.0f);
+    EXPECT_EQ(consumer.getLapCount(), 1u);
+    EXPECT_EQ(consumer.getEvictionCount(), 0u);
+}
+
+TEST_F(RingBufferTest, OverwriteDuringZeroCopyReadIsReportedAsTorn) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    producer.setOverrunPolicy(OverrunPolicy::OverwriteOldest);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    std::vector<float> block(256 * kChannels, 1.0f);
+    for (int i = 0; i < 4; ++i)
+        ASSERT_EQ(producer.write(block.data(), 256), 256u);
+
+    // Region [0, 256) is exposed, then the producer recycles it mid-read
+    auto region = consumer.beginRead(256);
+    ASSERT_EQ(region.frames(), 256u);
+    EXPECT_EQ(region.position, 0u);
+    ASSERT_EQ(producer.write(block.data(), 64), 64u);
+    EXPECT_FALSE(consumer.commitRead(256));
+
+    // The cursor stayed put; the next read counts the lap and starts at the newest block
+    region = consumer.beginRead(kCapacity);
+    EXPECT_EQ(region.position, 1024u);
+    EXPECT_EQ(region.frames(), 64u);
+    EXPECT_TRUE(consumer.commitRead(region.frames()));
+    EXPECT_EQ(consumer.getLapCount(), 1u);
+}
+
+TEST_F(RingBufferTest, OverwriteOldestAttachStartsAtLiveEdge) {
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+
+    std::vector<float> block(512 * kChannels, 1.0f);
+    ASSERT_EQ(producer.write(block.data(), 512), 512u);
+
+    // DropNewest keeps retained frames for a new consumer
+    RingBuffer retained;
+    ASSERT_TRUE(retained.attachAsConsumer(alignedMem_));
+    EXPECT_EQ(retained.availableRead(), 512u);
+    retained.detach();
+
+    // Latest wins: a new consumer only gets audio written after it attached
+    producer.setOverrunPolicy(OverrunPolicy::OverwriteOldest);
+    RingBuffer live;
+    ASSERT_TRUE(live.attachAsConsumer(alignedMem_));
+    EXPECT_EQ(live.availableRead(), 0u);
+    ASSERT_EQ(producer.write(block.data(), 64), 64u);
+    EXPECT_EQ(live.availableRead(), 64u);
+}
+
+TEST_F(RingBufferTest, OverwriteOldestConcurrentReadsNeverTear) {
+    // A slow consumer against a producer that never waits: every block it
+    // accepts must be internally consistent (all samples = block index).
+    RingBuffer producer;
+    producer.initAsProducer(alignedMem_, kCapacity, kChannels, kSampleRate);
+    producer.setOverrunPolicy(OverrunPolicy::OverwriteOldest);
+
+    RingBuffer consumer;
+    ASSERT_TRUE(consumer.attachAsConsumer(alignedMem_));
+
+    constexpr uint32_t kBlock = 64;
+    constexpr int kBlocks = 20000;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        std::vector<float> block(kBlock * kChannels);
+        for (int i = 1; i <= kBlocks; ++i) {
+            std::fill(block.begin(), block.end(), static_cast<float>(i));
+            producer.write(block.data(), kBlock);
+        }
+        done.store(true);
+    });
+
+    std::vector<float> out(kBlock * kChannels);
+    int torn = 0;
+    float last = 0.0f;
+    while (!done.load() || consumer.availableRead() > 0) {
+        if (consumer.read(out.data(), kBlock) != kBlock)
+            continue;
+        for (float v : out)
+            torn += (v != out[0]) ? 1 : 0;
+        EXPECT_GE(out[0], last);  // never goes back in time
+        last = out[0];
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0);
+}
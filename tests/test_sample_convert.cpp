@@ -0,0 +1,211 @@
+/**
+ * @file test_sample_convert.cpp
+ * @brief Unit tests for the float <-> compact sample format kernels
+ */
+
+#include <gtest/gtest.h>
+#include "directpipe/SampleConvert.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace directpipe;
+
+namespace {
+
+/// Deterministic test signal covering [-1, 1] (odd length exercises SIMD tails)
+std::vector<float> makeRamp(size_t n)
+{
+    std::vector<float> v(n);
+    for (size_t i = 0; i < n; ++i)
+        v[i] = -1.0f + 2.0f * static_cast<float>(i) / static_cast<float>(n - 1);
+    return v;
+}
+
+} // namespace
+
+TEST(SampleConvertTest, Int16RoundTripWithinHalfLsb) {
+    auto src = makeRamp(1037);
+    std::vector<uint8_t> packed(src.size() * 2);
+    std::vector<float> out(src.size());
+    DitherState state;
+
+    packSamples(SampleFormat::Int16, src.data(), src.size(), packed.data(), DitherMode::None, state);
+    unpackSamples(SampleFormat::Int16, packed.data(), src.size(), out.data());
+
+    for (size_t i = 0; i < src.size(); ++i)
+        EXPECT_NEAR(out[i], src[i], 0.5f / 32767.0f + 1e-7f) << "at " << i;
+    EXPECT_FLOAT_EQ(out.front(), -1.0f);
+    EXPECT_FLOAT_EQ(out.back(), 1.0f);
+}
+
+TEST(SampleConvertTest, Int24RoundTripWithinHalfLsb) {
+    auto src = makeRamp(1001);
+    std::vector<uint8_t> packed(src.size() * 3);
+    std::vector<float> out(src.size());
+    DitherState state;
+
+    packSamples(SampleFormat::Int24, src.data(), src.size(), packed.data(), DitherMode::None, state);
+    unpackSamples(SampleFormat::Int24, packed.data(), src.size(), out.data());
+
+    for (size_t i = 0; i < src.size(); ++i)
+        EXPECT_NEAR(out[i], src[i], 0.5f / 8388607.0f + 1e-7f) << "at " << i;
+
+    // Packed little-endian, 3 bytes: -1.0 -> 0x800001
+    EXPECT_EQ(packed[0], 0x01);
+    EXPECT_EQ(packed[1], 0x00);
+    EXPECT_EQ(packed[2], 0x80);
+}
+
+TEST(SampleConvertTest, Float16RoundTripAndSpecialValues) {
+    auto src = makeRamp(999);
+    std::vector<uint8_t> packed(src.size() * 2);
+    std::vector<float> out(src.size());
+    DitherState state;
+
+    packSamples(SampleFormat::Float16, src.data(), src.size(), packed.data(), DitherMode::None, state);
+    unpackSamples(SampleFormat::Float16, packed.data(), src.size(), out.data());
+
+    // 10-bit mantissa: relative error <= 2^-11 for normals
+    for (size_t i = 0; i < src.size(); ++i)
+        EXPECT_NEAR(out[i], src[i], std::fabs(src[i]) * (1.0f / 2048.0f) + 6e-8f) << "at " << i;
+
+    const float specials[] = { 0.0f, 65504.0f, 70000.0f, 5.9604645e-8f,
+                               std::numeric_limits<float>::infinity() };
+    uint16_t h[5];
+    float back[5];
+    packSamples(SampleFormat::Float16, specials, 5, h, DitherMode::None, state);
+    unpackSamples(SampleFormat::Float16, h, 5, back);
+    EXPECT_EQ(h[0], 0x0000);
+    EXPECT_EQ(h[1], 0x7BFF);         // max finite half
+    EXPECT_EQ(h[2], 0x7C00);         // overflow -> +Inf
+    EXPECT_EQ(h[3], 0x0001);         // smallest subnormal
+    EXPECT_EQ(h[4], 0x7C00);
+    EXPECT_FLOAT_EQ(back[1], 65504.0f);
+    EXPECT_FLOAT_EQ(back[3], 5.9604645e-8f);
+}
+
+TEST(SampleConvertTest, IntegerFormatsClampOutOfRangeAndNaN) {
+    const float src[] = { 2.0f, -3.0f, std::numeric_limits<float>::quiet_NaN(), 0.0f,
+                          1.5f, -1.5f, 0.25f, -0.25f, 10.0f };  // 9: SIMD block + tail
+    int16_t packed[9];
+    DitherState state;
+    packSamples(SampleFormat::Int16, src, 9, packed, DitherMode::None, state);
+
+    EXPECT_EQ(packed[0], 32767);
+    EXPECT_EQ(packed[1], -32767);
+    EXPECT_EQ(packed[2], -32767);   // NaN maps to -1.0
+    EXPECT_EQ(packed[3], 0);
+    EXPECT_EQ(packed[4], 32767);
+    EXPECT_EQ(packed[5], -32767);
+    EXPECT_EQ(packed[8], 32767);
+}
+
+TEST(SampleConvertTest, TpdfDitherIsBoundedAndZeroMean) {
+    // A constant a quarter LSB above zero: undithered always rounds to 0,
+    // dithered output averages back to the true value.
+    constexpr size_t kN = 20000;
+    const float lsb = 1.0f / 32767.0f;
+    std::vector<float> src(kN, 0.25f * lsb);
+    std::vector<int16_t> packed(kN);
+    DitherState state;
+
+    packSamples(SampleFormat::Int16, src.data(), kN, packed.data(), DitherMode::Tpdf, state);
+
+    double sum = 0.0;
+    for (auto q : packed) {
+        EXPECT_GE(q, -1);
+        EXPECT_LE(q, 1);
+        sum += q;
+    }
+    EXPECT_NEAR(sum / kN, 0.25, 0.03);
+
+    packSamples(SampleFormat::Int16, src.data(), kN, packed.data(), DitherMode::None, state);
+    for (auto q : packed)
+        EXPECT_EQ(q, 0);
+}
+
+TEST(SampleConvertTest, StereoInterleaveMatchesSampleOrder) {
+    constexpr uint32_t kFrames = 67;
+    auto left = makeRamp(kFrames);
+    std::vector<float> right(kFrames);
+    for (uint32_t i = 0; i < kFrames; ++i)
+        right[i] = -left[i] * 0.5f;
+
+    std::vector<float> interleaved(kFrames * 2);
+    for (uint32_t i = 0; i < kFrames; ++i) {
+        interleaved[i * 2] = left[i];
+        interleaved[i * 2 + 1] = right[i];
+    }
+
+    const SampleFormat formats[] = { SampleFormat::Float32, SampleFormat::Int16,
+                                     SampleFormat::Int24, SampleFormat::Float16 };
+    for (auto format : formats) {
+        const size_t bytes = kFrames * 2 * bytesPerSample(format);
+        std::vector<uint8_t> planarPacked(bytes), flatPacked(bytes);
+        DitherState s1, s2;
+
+        const float* src[2] = { left.data(), right.data() };
+        packInterleaved(format, src, 2, kFrames, planarPacked.data(), DitherMode::None, s1);
+        packSamples(format, interleaved.data(), kFrames * 2, flatPacked.data(), DitherMode::None, s2);
+        EXPECT_EQ(planarPacked, flatPacked) << "format " << static_cast<int>(format);
+
+        // De-interleave, skipping the left channel
+        std::vector<float> outRight(kFrames);
+        float* dest[2] = { nullptr, outRight.data() };
+        unpackInterleaved(format, planarPacked.data(), 2, kFrames, dest);
+        for (uint32_t i = 0; i < kFrames; ++i)
+            EXPECT_NEAR(outRight[i], right[i], 1e-3f) << "format " << static_cast<int>(format);
+    }
+}
+
+TEST(SampleConvertTest, PlanesMatchPerChannelPack) {
+    constexpr uint32_t kFrames = 67;
+    constexpr uint32_t kChannels = 3;
+    constexpr size_t kPlaneFrames = 80;   // plane stride larger than the block
+    auto ramp = makeRamp(kFrames);
+
+    std::vector<std::vector<float>> planes(kChannels, std::vector<float>(kFrames));
+    std::vector<float> interleaved(kFrames * kChannels);
+    for (uint32_t c = 0; c < kChannels; ++c)
+        for (uint32_t i = 0; i < kFrames; ++i) {
+            planes[c][i] = ramp[i] * (1.0f - 0.25f * static_cast<float>(c));
+            interleaved[i * kChannels + c] = planes[c][i];
+        }
+
+    const SampleFormat formats[] = { SampleFormat::Float32, SampleFormat::Int16,
+                                     SampleFormat::Int24, SampleFormat::Float16 };
+    for (auto format : formats) {
+        const size_t stride = kPlaneFrames * bytesPerSample(format);
+        std::vector<uint8_t> fromPlanar(stride * kChannels), fromInterleaved(stride * kChannels);
+        DitherState s1, s2, s3;
+
+        const float* src[kChannels] = { planes[0].data(), planes[1].data(), planes[2].data() };
+        packPlanes(format, src, kChannels, kFrames, fromPlanar.data(), stride, DitherMode::None, s1);
+        packInterleavedToPlanes(format, interleaved.data(), kChannels, kFrames,
+                                fromInterleaved.data(), stride, DitherMode::None, s2);
+        EXPECT_EQ(fromPlanar, fromInterleaved) << "format " << static_cast<int>(format);
+
+        // Each plane is exactly packSamples of that channel
+        std::vector<uint8_t> expected(kFrames * bytesPerSample(format));
+        packSamples(format, planes[1].data(), kFrames, expected.data(), DitherMode::None, s3);
+        EXPECT_EQ(std::memcmp(fromPlanar.data() + stride, expected.data(), expected.size()), 0)
+            << "format " << static_cast<int>(format);
+
+        // Back to planar (skipping channel 0) and to interleaved
+        std::vector<float> out1(kFrames), out2(kFrames);
+        float* dest[kChannels] = { nullptr, out1.data(), out2.data() };
+        unpackPlanes(format, fromPlanar.data(), stride, kChannels, kFrames, dest);
+        std::vector<float> outInterleaved(kFrames * kChannels);
+        unpackPlanesToInterleaved(format, fromPlanar.data(), stride, kChannels, kFrames,
+                                  outInterleaved.data());
+        for (uint32_t i = 0; i < kFrames; ++i) {
+            EXPECT_NEAR(out1[i], planes[1][i], 1e-3f) << "format " << static_cast<int>(format);
+            EXPECT_NEAR(out2[i], planes[2][i], 1e-3f) << "format " << static_cast<int>(format);
+            for (uint32_t c = 0; c < kChannels; ++c)
+                EXPECT_NEAR(outInterleaved[i * kChannels + c], planes[c][i], 1e-3f);
+        }
+    }
+}
@@ -0,0 +1,607 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2025 LiveTrack
+
+#include <JuceHeader.h>
+#include <gtest/gtest.h>
+#include "Audio/SerialChainExecutor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace directpipe;
+
+namespace {
+
+/// y = x * gain + offset on every channel it owns; bus layout set per test
+class AffineProcessor : public juce::AudioProcessor {
+public:
+    AffineProcessor(float gain, float offset, int ins = 2, int outs = 2)
+        : AudioProcessor(makeBuses(ins, outs)), gain_(gain), offset_(offset) {}
+    ~AffineProcessor() override { alive_ = 0; }
+
+    static BusesProperties makeBuses(int ins, int outs) {
+        BusesProperties props;
+        if (ins > 0)
+            props = props.withInput("In", juce::AudioChannelSet::canonicalChannelSet(ins), true);
+        if (outs > 0)
+            props = props.withOutput("Out", juce::AudioChannelSet::canonicalChannelSet(outs), true);
+        return props;
+    }
+
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override {
+        if (alive_ != kAlive)
+            useAfterFree.fetch_add(1, std::memory_order_relaxed);
+        lastChannels = buffer.getNumChannels();
+        ++calls;
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            auto* d = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                d[i] = d[i] * gain_ + offset_;
+        }
+    }
+
+    const juce::String getName() const override { return "Affine"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+    static inline std::atomic<int> useAfterFree{0};
+    int lastChannels = 0;
+    int calls = 0;
+
+private:
+    static constexpr uint32_t kAlive = 0xA11CE5u;
+    volatile uint32_t alive_ = kAlive;
+    float gain_, offset_;
+};
+
+/// Stereo pure delay of `latency` samples that reports it as its latency
+class DelayProcessor : public AffineProcessor {
+public:
+    explicit DelayProcessor(int latency) : AffineProcessor(1.0f, 0.0f), line_(2, latency + 1) {
+        setLatencySamples(latency);
+        line_.clear();
+    }
+
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override {
+        ++calls;
+        const int size = line_.getNumSamples();
+        for (int i = 0; i < buffer.getNumSamples(); ++i) {
+            for (int ch = 0; ch < 2; ++ch) {
+                line_.setSample(ch, pos_, buffer.getSample(ch, i));
+                buffer.setSample(ch, i, line_.getSample(ch, (pos_ + 1) % size));
+            }
+            pos_ = (pos_ + 1) % size;
+        }
+    }
+
+private:
+    juce::AudioBuffer<float> line_;
+    int pos_ = 0;
+};
+
+std::unique_ptr<SerialChainExecutor::Plan> makePlan(
+    std::initializer_list<std::pair<std::shared_ptr<juce::AudioProcessor>, bool>> stages,
+    int maxBlockSize = 64)
+{
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    for (const auto& [processor, bypassed] : stages)
+        plan->addStage(processor, bypassed);
+    plan->allocate(2, maxBlockSize);
+    return plan;
+}
+
+using Fade = SerialChainExecutor::Fade;
+
+std::unique_ptr<SerialChainExecutor::Plan> makeFadePlan(
+    std::initializer_list<std::pair<std::shared_ptr<juce::AudioProcessor>, Fade>> stages,
+    int fadeSamples, int maxBlockSize = 64)
+{
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    for (const auto& [processor, fade] : stages)
+        plan->addStage(processor, false, fade);
+    plan->allocate(2, maxBlockSize, fadeSamples);
+    return plan;
+}
+
+/// Largest sample-to-sample step on channel 0
+float maxStep(const juce::AudioBuffer<float>& buffer, float previous) {
+    float step = 0.0f;
+    for (int i = 0; i < buffer.getNumSamples(); ++i) {
+        step = std::max(step, std::abs(buffer.getSample(0, i) - previous));
+        previous = buffer.getSample(0, i);
+    }
+    return step;
+}
+
+void fill(juce::AudioBuffer<float>& buffer, float value) {
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), value, buffer.getNumSamples());
+}
+
+} // namespace
+
+class SerialChainExecutorTest : public ::testing::Test {
+protected:
+    SerialChainExecutor executor_;
+    juce::AudioBuffer<float> buffer_{2, 64};
+    juce::MidiBuffer midi_;
+};
+
+// Without a Plan the executor is a pass-through
+TEST_F(SerialChainExecutorTest, EmptyIsPassThrough) {
+    fill(buffer_, 0.5f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 10), 0.5f);
+    EXPECT_FLOAT_EQ(buffer_.getSample(1, 10), 0.5f);
+}
+
+// Stages run in Plan order: (x * 2) + 1, then x + 3
+TEST_F(SerialChainExecutorTest, StagesRunInOrder) {
+    auto a = std::make_shared<AffineProcessor>(2.0f, 1.0f);
+    auto b = std::make_shared<AffineProcessor>(1.0f, 3.0f);
+    executor_.publish(makePlan({ { a, false }, { b, false } }));
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 6.0f);
+    EXPECT_FLOAT_EQ(buffer_.getSample(1, 63), 6.0f);
+
+    // Reordered Plan: (x + 3) * 2 + 1
+    executor_.publish(makePlan({ { b, false }, { a, false } }));
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 9.0f);
+}
+
+// A bypassed stage is skipped entirely
+TEST_F(SerialChainExecutorTest, BypassedStageIsSkipped) {
+    auto a = std::make_shared<AffineProcessor>(2.0f, 0.0f);
+    auto b = std::make_shared<AffineProcessor>(10.0f, 0.0f);
+    executor_.publish(makePlan({ { a, false }, { b, true } }));
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 2.0f);
+    EXPECT_EQ(b->lastChannels, 0);
+}
+
+// A mono-output stage feeds both channels downstream
+TEST_F(SerialChainExecutorTest, MonoOutputIsCopiedToRight) {
+    auto mono = std::make_shared<AffineProcessor>(1.0f, 4.0f, 1, 1);
+    executor_.publish(makePlan({ { mono, false } }));
+
+    fill(buffer_, 0.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_EQ(mono->lastChannels, 1);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 5), 4.0f);
+    EXPECT_FLOAT_EQ(buffer_.getSample(1, 5), 4.0f);
+}
+
+// A stage wider than the buffer (e.g. sidechain input) gets silent scratch channels
+TEST_F(SerialChainExecutorTest, WideStageGetsScratchChannels) {
+    auto wide = std::make_shared<AffineProcessor>(1.0f, 1.0f, 4, 2);
+    executor_.publish(makePlan({ { wide, false } }));
+
+    fill(buffer_, 0.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_EQ(wide->lastChannels, 4);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 1.0f);
+    EXPECT_FLOAT_EQ(buffer_.getSample(1, 0), 1.0f);
+}
+
+// Blocks larger than the Plan was sized for pass through untouched
+TEST_F(SerialChainExecutorTest, OversizedBlockPassesThrough) {
+    auto a = std::make_shared<AffineProcessor>(2.0f, 0.0f);
+    executor_.publish(makePlan({ { a, false } }, 32));
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 1.0f);
+}
+
+// Suspended = silence; resuming restores processing
+TEST_F(SerialChainExecutorTest, SuspendClearsBuffer) {
+    auto a = std::make_shared<AffineProcessor>(2.0f, 0.0f);
+    executor_.publish(makePlan({ { a, false } }));
+
+    executor_.setSuspended(true);
+    EXPECT_TRUE(executor_.isSuspended());
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 0.0f);
+
+    executor_.setSuspended(false);
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 2.0f);
+}
+
+// A processor only a replaced Plan still held is destroyed on publish
+TEST_F(SerialChainExecutorTest, ReplacedPlanReleasesProcessor) {
+    std::weak_ptr<juce::AudioProcessor> watch;
+    {
+        auto a = std::make_shared<AffineProcessor>(2.0f, 0.0f);
+        watch = a;
+        executor_.publish(makePlan({ { a, false } }));
+    }
+    EXPECT_FALSE(watch.expired());   // the live Plan keeps it
+
+    executor_.publish(nullptr);
+    EXPECT_TRUE(watch.expired());
+    EXPECT_EQ(executor_.pendingReclaimCount(), 0u);
+}
+
+// A fading-in stage starts from dry and ends fully processed, with no step
+TEST_F(SerialChainExecutorTest, FadeInRampsFromDryToProcessed) {
+    auto mute = std::make_shared<AffineProcessor>(0.0f, 0.0f);
+    executor_.publish(makeFadePlan({ { mute, Fade::In } }, 128));
+    EXPECT_TRUE(executor_.isTransitionActive());
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_NEAR(buffer_.getSample(0, 0), 1.0f, 1.0e-3f);
+    EXPECT_LT(maxStep(buffer_, 1.0f), 0.05f);
+    const float mid = buffer_.getSample(0, 63);
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_LT(maxStep(buffer_, mid), 0.05f);
+    EXPECT_NEAR(buffer_.getSample(0, 63), 0.0f, 1.0e-6f);
+    EXPECT_NEAR(buffer_.getSample(1, 63), 0.0f, 1.0e-6f);
+    EXPECT_FALSE(executor_.isTransitionActive());
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 0.0f);
+}
+
+// A fading-out stage ends fully dry and is skipped from then on
+TEST_F(SerialChainExecutorTest, FadeOutRampsToDryThenSkips) {
+    auto mute = std::make_shared<AffineProcessor>(0.0f, 0.0f);
+    executor_.publish(makeFadePlan({ { mute, Fade::Out } }, 64));
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_LT(buffer_.getSample(0, 0), 0.05f);
+    EXPECT_LT(maxStep(buffer_, 0.0f), 0.05f);
+    EXPECT_NEAR(buffer_.getSample(0, 63), 1.0f, 1.0e-6f);
+    EXPECT_EQ(mute->calls, 1);
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 1.0f);
+    EXPECT_EQ(mute->calls, 1);
+}
+
+// A moved processor (out at the old position, in at the new one) never runs
+// twice in one block, and the fade-in waits for the fade-out to finish
+TEST_F(SerialChainExecutorTest, MoveFadesOutThenIn) {
+    auto moved = std::make_shared<AffineProcessor>(2.0f, 0.0f);
+    auto other = std::make_shared<AffineProcessor>(1.0f, 1.0f);
+    executor_.publish(makeFadePlan({ { moved, Fade::Out }, { other, Fade::None }, { moved, Fade::In } }, 64));
+
+    for (int block = 1; block <= 3; ++block) {
+        fill(buffer_, 1.0f);
+        executor_.process(buffer_, midi_);
+        EXPECT_EQ(moved->calls, block);
+    }
+    EXPECT_FALSE(executor_.isTransitionActive());
+    // New order: (x + 1) * 2
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 4.0f);
+}
+
+// A Plan published mid-fade carries the stage's fade state over: the fade
+// continues from the current gain instead of jumping to its end or start
+TEST_F(SerialChainExecutorTest, RepublishMidFadeContinuesFromCurrentGain) {
+    auto mute = std::make_shared<AffineProcessor>(0.0f, 0.0f);
+    auto plan = makeFadePlan({ { mute, Fade::In } }, 128);
+    auto state = plan->fadeStates[0];
+    executor_.publish(std::move(plan));
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    const float mid = buffer_.getSample(0, 63);
+    EXPECT_NEAR(mid, 0.5f, 0.05f);
+
+    // Steady Plan for the same stage: the rest of the fade-in, not a cut to processed
+    plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->addStage(mute, false, Fade::None, nullptr, state);
+    plan->allocate(2, 64, 128);
+    executor_.publish(std::move(plan));
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_LT(maxStep(buffer_, mid), 0.05f);
+    EXPECT_NEAR(buffer_.getSample(0, 63), 0.0f, 1.0e-6f);
+    EXPECT_FALSE(executor_.isTransitionActive());
+}
+
+// Removing a stage that is still fading in fades it back out from where it got to
+TEST_F(SerialChainExecutorTest, FadeReversesFromCurrentGain) {
+    auto mute = std::make_shared<AffineProcessor>(0.0f, 0.0f);
+    auto plan = makeFadePlan({ { mute, Fade::In } }, 128);
+    auto state = plan->fadeStates[0];
+    executor_.publish(std::move(plan));
+
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    const float mid = buffer_.getSample(0, 63);
+
+    plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->addStage(mute, false, Fade::Out, nullptr, state);
+    plan->allocate(2, 64, 128);
+    executor_.publish(std::move(plan));
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_LT(maxStep(buffer_, mid), 0.05f);
+    EXPECT_NEAR(buffer_.getSample(0, 63), 1.0f, 1.0e-6f);   // back to dry in half a fade
+    EXPECT_FALSE(executor_.isTransitionActive());
+
+    const int calls = mute->calls;
+    fill(buffer_, 1.0f);
+    executor_.process(buffer_, midi_);
+    EXPECT_EQ(mute->calls, calls);
+}
+
+// The dry delay returns its input `latency` samples later, across blocks
+TEST_F(SerialChainExecutorTest, DryDelayDelaysByLatency) {
+    SerialChainExecutor::DryDelay delay;
+    delay.prepare(2, 5, 8);
+    juce::AudioBuffer<float> block(2, 8);
+    float next = 1.0f;
+    for (int b = 0; b < 4; ++b) {
+        const float first = next;
+        for (int i = 0; i < 8; ++i, next += 1.0f)
+            for (int ch = 0; ch < 2; ++ch)
+                block.setSample(ch, i, next);
+        delay.write(block, 2, 8);
+        delay.read(block, 2, 8);
+        for (int i = 0; i < 8; ++i) {
+            const float expected = first + static_cast<float>(i) - 5.0f;
+            EXPECT_FLOAT_EQ(block.getSample(1, i), expected < 1.0f ? 0.0f : expected);
+        }
+    }
+}
+
+// A bypassed stage with latency delays the signal instead of dropping out of it
+TEST_F(SerialChainExecutorTest, BypassedStageKeepsLatencyAsDryDelay) {
+    auto plugin = std::make_shared<DelayProcessor>(3);
+    SerialChainExecutor::DryDelay delay;
+    delay.prepare(2, plugin->getLatencySamples(), 64);
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->addStage(plugin, true, Fade::None, &delay);
+    plan->allocate(2, 64);
+    executor_.publish(std::move(plan));
+
+    for (int i = 0; i < 64; ++i)
+        buffer_.setSample(0, i, static_cast<float>(i + 1));
+    executor_.process(buffer_, midi_);
+    EXPECT_EQ(plugin->calls, 0);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 2), 0.0f);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 3), 1.0f);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 63), 61.0f);
+}
+
+// Bypassing a plugin with latency and back crossfades against a delayed dry
+// path: for a plugin that only delays, the output does not change, and the
+// plugin stops being processed once its fade-out is over. Coming back, the
+// fade-in waits out the plugin's latency, so its stale output from before the
+// bypass is never heard.
+TEST_F(SerialChainExecutorTest, BypassFadeIsLatencyAligned) {
+    auto plugin = std::make_shared<DelayProcessor>(5);
+    SerialChainExecutor::DryDelay delay;
+    delay.prepare(2, plugin->getLatencySamples(), 64);
+    auto publish = [&](bool bypassed, Fade fade) {
+        auto plan = std::make_unique<SerialChainExecutor::Plan>();
+        plan->addStage(plugin, bypassed, fade, &delay);
+        plan->allocate(2, 64, 124);
+        executor_.publish(std::move(plan));
+    };
+
+    float next = 1.0f;
+    auto runBlock = [&] {
+        const float first = next;
+        for (int i = 0; i < 64; ++i, next += 1.0f)
+            for (int ch = 0; ch < 2; ++ch)
+                buffer_.setSample(ch, i, next);
+        executor_.process(buffer_, midi_);
+        for (int i = 0; i < 64; ++i) {
+            const float expected = std::max(0.0f, first + static_cast<float>(i) - 5.0f);
+            ASSERT_NEAR(buffer_.getSample(0, i), expected, 1.0e-3f) << "sample " << i;
+            ASSERT_NEAR(buffer_.getSample(1, i), expected, 1.0e-3f) << "sample " << i;
+        }
+    };
+
+    publish(false, Fade::None);
+    runBlock();
+    publish(false, Fade::ToBypass);
+    runBlock();
+    runBlock();   // 124-sample fade-out ends in this block
+    EXPECT_FALSE(executor_.isTransitionActive());
+    const int callsWhenBypassed = plugin->calls;
+    runBlock();
+    EXPECT_EQ(plugin->calls, callsWhenBypassed);
+
+    publish(false, Fade::FromBypass);
+    runBlock();
+    runBlock();   // fade-in lasts 5 + 124 samples: still fading
+    EXPECT_TRUE(executor_.isTransitionActive());
+    runBlock();
+    EXPECT_FALSE(executor_.isTransitionActive());
+    EXPECT_EQ(plugin->calls, callsWhenBypassed + 3);
+}
+
+// Removing a bypassed plugin with latency crossfades its delayed dry path
+// into the undelayed input instead of splicing it out of the signal
+TEST_F(SerialChainExecutorTest, RemovedBypassedStageFadesOutItsLatency) {
+    auto plugin = std::make_shared<DelayProcessor>(5);
+    SerialChainExecutor::DryDelay delay;
+    delay.prepare(2, plugin->getLatencySamples(), 64);
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->addStage(plugin, true, Fade::None, &delay);
+    plan->allocate(2, 64, 128);
+    auto state = plan->fadeStates[0];
+    executor_.publish(std::move(plan));
+
+    float next = 1.0f;
+    auto ramp = [&] {
+        for (int i = 0; i < 64; ++i, next += 1.0f)
+            for (int ch = 0; ch < 2; ++ch)
+                buffer_.setSample(ch, i, next);
+    };
+    ramp();
+    executor_.process(buffer_, midi_);
+    float previous = buffer_.getSample(0, 63);
+    EXPECT_FLOAT_EQ(previous, 59.0f);
+
+    plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->addStage(plugin, true, Fade::Out, &delay, state);
+    plan->allocate(2, 64, 128);
+    executor_.publish(std::move(plan));
+    for (int block = 0; block < 2; ++block) {
+        ramp();
+        executor_.process(buffer_, midi_);
+        EXPECT_LT(maxStep(buffer_, previous), 1.1f);
+        previous = buffer_.getSample(0, 63);
+    }
+    EXPECT_FALSE(executor_.isTransitionActive());
+    EXPECT_FLOAT_EQ(previous, 192.0f);   // undelayed
+    ramp();
+    executor_.process(buffer_, midi_);
+    EXPECT_FLOAT_EQ(buffer_.getSample(0, 0), 193.0f);
+    EXPECT_EQ(plugin->calls, 0);
+}
+
+// A plugin with latency moved past a gain stage shares its dry delay between
+// the old and the new position: audio from the old position is never heard
+// at the new one, and the chain's timing changes without a splice
+TEST_F(SerialChainExecutorTest, MovedLatencyStageDoesNotReplayOldPosition) {
+    auto plugin = std::make_shared<DelayProcessor>(5);
+    auto gain = std::make_shared<AffineProcessor>(2.0f, 0.0f);
+    SerialChainExecutor::DryDelay delay;
+    delay.prepare(2, plugin->getLatencySamples(), 64);
+    auto plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->addStage(plugin, false, Fade::None, &delay);
+    plan->addStage(gain, false);
+    plan->allocate(2, 64, 64);
+    auto state = plan->fadeStates[0];
+    executor_.publish(std::move(plan));
+
+    float next = 1000.0f;
+    auto ramp = [&] {
+        for (int i = 0; i < 64; ++i, next += 1.0f)
+            for (int ch = 0; ch < 2; ++ch)
+                buffer_.setSample(ch, i, next);
+    };
+    ramp();
+    executor_.process(buffer_, midi_);
+    ramp();
+    executor_.process(buffer_, midi_);
+    float previous = buffer_.getSample(0, 63);
+
+    // Out at the old position with its current state, in after the gain with a new one
+    plan = std::make_unique<SerialChainExecutor::Plan>();
+    plan->addStage(plugin, false, Fade::Out, &delay, state);
+    plan->addStage(gain, false);
+    plan->addStage(plugin, false, Fade::In, &delay);
+    plan->allocate(2, 64, 64);
+    executor_.publish(std::move(plan));
+    for (int block = 0; block < 6; ++block) {
+        const float first = next;
+        ramp();
+        executor_.process(buffer_, midi_);
+        for (int i = 0; i < 64; ++i) {
+            const float x = first + static_cast<float>(i);
+            ASSERT_GE(buffer_.getSample(0, i), 2.0f * (x - 5.0f) - 1.0e-2f) << "block " << block << " sample " << i;
+            ASSERT_LE(buffer_.getSample(0, i), 2.0f * x + 1.0e-2f) << "block " << block << " sample " << i;
+        }
+        EXPECT_LT(maxStep(buffer_, previous), 2.5f);
+        previous = buffer_.getSample(0, 63);
+    }
+    EXPECT_FALSE(executor_.isTransitionActive());
+    EXPECT_FLOAT_EQ(previous, 2.0f * (next - 1.0f - 5.0f));
+}
+
+// Publishing and reclaiming while the audio thread renders never frees a
+// processor that is still in use
+TEST_F(SerialChainExecutorTest, ConcurrentPublishIsSafe) {
+    AffineProcessor::useAfterFree.store(0);
+    std::atomic<bool> running{true};
+    std::atomic<int> blocks{0};
+
+    std::thread rt([&] {
+        juce::AudioBuffer<float> buffer(2, 64);
+        juce::MidiBuffer midi;
+        while (running.load(std::memory_order_relaxed)) {
+            fill(buffer, 1.0f);
+            executor_.process(buffer, midi);
+            blocks.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    for (int i = 0; i < 2000; ++i) {
+        auto a = std::make_shared<AffineProcessor>(1.0f, 0.0f);
+        auto b = std::make_shared<AffineProcessor>(1.0f, 0.0f);
+        executor_.publish(makePlan({ { a, false }, { b, (i & 1) != 0 } }));
+    }
+
+    running.store(false);
+    rt.join();
+    executor_.publish(nullptr);
+
+    EXPECT_GT(blocks.load(), 0);
+    EXPECT_EQ(AffineProcessor::useAfterFree.load(), 0);
+    EXPECT_EQ(executor_.pendingReclaimCount(), 0u);
+}
+
+/// Stays inside processBlock until released, like a plugin stuck in a long block
+class StallingProcessor : public AffineProcessor {
+public:
+    StallingProcessor() : AffineProcessor(1.0f, 0.0f) {}
+
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {
+        entered.store(true);
+        while (!release.load())
+            std::this_thread::yield();
+    }
+
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+};
+
+// While one audio block is stuck, only the first publish waits for it; the
+// Plans retired meanwhile are freed once the block is over
+TEST_F(SerialChainExecutorTest, StuckBlockStallsOnlyOnePublish) {
+    auto stalling = std::make_shared<StallingProcessor>();
+    executor_.publish(makePlan({ { stalling, false } }));
+    std::thread rt([&] { executor_.process(buffer_, midi_); });
+    while (!stalling->entered.load())
+        std::this_thread::yield();
+
+    executor_.publish(makePlan({}));   // waits out kMaxWaitMs, then defers
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; ++i)
+        executor_.publish(makePlan({}));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+    EXPECT_EQ(executor_.pendingReclaimCount(), 6u);
+
+    stalling->release.store(true);
+    rt.join();
+    executor_.publish(nullptr);
+    EXPECT_EQ(executor_.pendingReclaimCount(), 0u);
+}
@@ -9,8 +9,10 @@
 #include "directpipe/Constants.h"
 #include "directpipe/Protocol.h"
 
+#include <atomic>
 #include <thread>
 #include <chrono>
+#include <cstring>
 #include <vector>
 
 using namespace directpipe;
@@ -94,6 +96,80 @@ TEST_F(SharedMemoryTest, OpenWithoutExplicitSizeUsesMappedSize) {
     consumerShm.close();
 }
 
+TEST_F(SharedMemoryTest, ResidencyOptionsAreReported) {
+    size_t size = calculateSharedMemorySize(kCapacity, kChannels);
+
+    SharedMemory plain;
+    ASSERT_TRUE(plain.create(kTestShmName, size));
+    EXPECT_FALSE(plain.getAppliedOptions().prefault);
+    EXPECT_FALSE(plain.getAppliedOptions().lock);
+    EXPECT_FALSE(plain.getAppliedOptions().hugePages);
+    plain.close();
+
+    SharedMemoryOptions options;
+    options.prefault = true;
+    options.lock = true;
+    options.hugePages = true;
+
+    SharedMemory producerShm;
+    ASSERT_TRUE(producerShm.create(kTestShmName, size, options));
+    // Pre-faulting always works; lock depends on RLIMIT_MEMLOCK / working-set
+    // quota, so it is only reported. A region smaller than one huge page
+    // never gets huge pages on Linux/macOS.
+    EXPECT_TRUE(producerShm.getAppliedOptions().prefault);
+#ifndef _WIN32
+    EXPECT_FALSE(producerShm.getAppliedOptions().hugePages);
+#endif
+
+    // The producer's pre-fault must leave the (zeroed) region intact
+    auto* bytes = static_cast<uint8_t*>(producerShm.getData());
+    for (size_t i = 0; i < size; i += 997)
+        ASSERT_EQ(bytes[i], 0u) << "at " << i;
+    std::memset(bytes, 0x5A, size);
+
+    // A consumer pre-faults read-only: producer data is untouched
+    SharedMemory consumerShm;
+    ASSERT_TRUE(consumerShm.open(kTestShmName, size, options));
+    EXPECT_TRUE(consumerShm.getAppliedOptions().prefault);
+    auto* seen = static_cast<const uint8_t*>(consumerShm.getData());
+    for (size_t i = 0; i < size; i += 997)
+        ASSERT_EQ(seen[i], 0x5Au) << "at " << i;
+
+    // Reports are cleared on close
+    consumerShm.close();
+    EXPECT_FALSE(consumerShm.getAppliedOptions().prefault);
+    producerShm.close();
+}
+
+TEST_F(SharedMemoryTest, OpenOrCreateSharesAndNeverUnlinks) {
+    const std::string name = "Local\\DirectPipeTestShared";
+    constexpr size_t kSize = 4096;
+
+    SharedMemory first;
+    ASSERT_TRUE(first.openOrCreate(name, kSize));
+    auto* bytes = static_cast<uint8_t*>(first.getData());
+    EXPECT_EQ(bytes[0], 0u);  // fresh region is zero-filled
+    bytes[0] = 0x5A;
+
+    // A second opener sees the same memory instead of a fresh region
+    SharedMemory second;
+    ASSERT_TRUE(second.openOrCreate(name, kSize));
+    EXPECT_EQ(static_cast<uint8_t*>(second.getData())[0], 0x5A);
+
+    // Closing an opener does not remove the region for the others
+    first.close();
+    SharedMemory third;
+    ASSERT_TRUE(third.open(name, kSize));
+    EXPECT_EQ(static_cast<uint8_t*>(third.getData())[0], 0x5A);
+    third.close();
+    second.close();
+
+    // Remove it: create() takes ownership, close() unlinks (POSIX)
+    SharedMemory cleanup;
+    ASSERT_TRUE(cleanup.create(name, kSize));
+    cleanup.close();
+}
+
 TEST_F(SharedMemoryTest, MoveSemantics) {
     SharedMemory shm1;
     size_t size = calculateSharedMemorySize(kCapacity, kChannels);
@@ -173,6 +249,84 @@ TEST_F(SharedMemoryTest, NamedEventMoveSemantics) {
     ev3.close();
 }
 
+TEST_F(SharedMemoryTest, SharedWordWakeAcrossMappings) {
+#ifndef __linux__
+    GTEST_SKIP() << "Futex wake word is Linux-only";
+#else
+    // Producer and consumer bind the header wake word through two separate
+    // mappings, as the host and Receiver do in different processes
+    size_t size = calculateSharedMemorySize(kCapacity, kChannels);
+
+    SharedMemory producerShm;
+    ASSERT_TRUE(producerShm.create(kTestShmName, size));
+    RingBuffer producer;
+    producer.initAsProducer(producerShm.getData(), kCapacity, kChannels, kSampleRate);
+    auto* ph = static_cast<DirectPipeHeader*>(producerShm.getData());
+
+    SharedMemory consumerShm;
+    ASSERT_TRUE(consumerShm.open(kTestShmName, size));
+    auto* ch = static_cast<DirectPipeHeader*>(consumerShm.getData());
+
+    NamedEvent producerEvent;
+    ASSERT_TRUE(producerEvent.create(kTestEventName));
+    ASSERT_TRUE(producerEvent.bindSharedWord(&ph->data_seq, &ph->consumer_waiting));
+
+    NamedEvent consumerEvent;
+    ASSERT_TRUE(consumerEvent.open(kTestEventName));
+    ASSERT_TRUE(consumerEvent.bindSharedWord(&ch->data_seq, &ch->consumer_waiting));
+    EXPECT_TRUE(consumerEvent.isSharedWordBound());
+
+    std::atomic<bool> woke{false};
+    std::thread consumer([&]() {
+        woke.store(consumerEvent.wait(2000), std::memory_order_release);
+    });
+
+    // Let the consumer park, then signal — the waiter count must be visible
+    auto parkDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (ph->consumer_waiting.load() == 0 && std::chrono::steady_clock::now() < parkDeadline)
+        std::this_thread::yield();
+    EXPECT_EQ(ph->consumer_waiting.load(), 1u);
+
+    producerEvent.signal();
+    consumer.join();
+
+    EXPECT_TRUE(woke.load(std::memory_order_acquire));
+    EXPECT_EQ(ph->consumer_waiting.load(), 0u);
+
+    consumerEvent.close();
+    EXPECT_FALSE(consumerEvent.isSharedWordBound());
+    producerEvent.close();
+    consumerShm.close();
+    producerShm.close();
+#endif
+}
+
+TEST_F(SharedMemoryTest, SharedWordSignalsCoalesce) {
+#ifndef __linux__
+    GTEST_SKIP() << "Futex wake word is Linux-only";
+#else
+    // Unlike the semaphore, a burst of signals with nobody parked leaves one
+    // pending wakeup, not a count that causes a burst of spurious wakeups
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> waiters{0};
+
+    NamedEvent event;
+    ASSERT_TRUE(event.create(kTestEventName));
+    ASSERT_TRUE(event.bindSharedWord(&seq, &waiters));
+
+    event.signal();
+    event.signal();
+    event.signal();
+    EXPECT_EQ(seq.load(), 3u);
+    EXPECT_EQ(waiters.load(), 0u);
+
+    EXPECT_TRUE(event.wait(100));
+    EXPECT_FALSE(event.wait(50));
+
+    event.close();
+#endif
+}
+
 TEST_F(SharedMemoryTest, FullIPCPipeline) {
     // Simulate the full IPC pipeline: producer writes to shared memory,
     // signals event, consumer reads from shared memory.
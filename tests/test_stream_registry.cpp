@@ -0,0 +1,151 @@
+/**
+ * @file test_stream_registry.cpp
+ * @brief Unit tests for the multi-stream directory
+ */
+
+#include <gtest/gtest.h>
+#include "directpipe/StreamRegistry.h"
+#include "directpipe/SharedMemory.h"
+#include "directpipe/Constants.h"
+#include "directpipe/Protocol.h"
+
+#include <cstring>
+#include <string>
+
+using namespace directpipe;
+
+class StreamRegistryTest : public ::testing::Test {
+protected:
+    // Private directory name so a running host's registry is never touched
+    const std::string kTestRegistryName = "Local\\DirectPipeTestRegistry";
+
+    void TearDown() override {
+        // The directory is never unlinked by its users; remove the test copy
+        SharedMemory cleanup;
+        if (cleanup.create(kTestRegistryName, sizeof(StreamDirectory)))
+            cleanup.close();
+    }
+
+    static StreamInfo makeInfo(const char* id, const char* description, uint32_t sampleRate = 48000) {
+        StreamInfo info;
+        EXPECT_TRUE(makeStreamInfo(id, description, info));
+        info.channels = 2;
+        info.sampleRate = sampleRate;
+        return info;
+    }
+};
+
+TEST_F(StreamRegistryTest, StreamIdValidationAndNames) {
+    EXPECT_TRUE(isValidStreamId("main"));
+    EXPECT_TRUE(isValidStreamId("post-chain_2"));
+    EXPECT_FALSE(isValidStreamId(""));
+    EXPECT_FALSE(isValidStreamId(nullptr));
+    EXPECT_FALSE(isValidStreamId("has space"));
+    EXPECT_FALSE(isValidStreamId("back\\slash"));
+    EXPECT_FALSE(isValidStreamId(std::string(STREAM_ID_LEN, 'a').c_str()));
+    EXPECT_TRUE(isValidStreamId(std::string(STREAM_ID_LEN - 1, 'a').c_str()));
+
+    // The main stream keeps the legacy fixed names
+    StreamInfo info;
+    ASSERT_TRUE(makeStreamInfo(MAIN_STREAM_ID, "Main", info));
+    EXPECT_STREQ(info.shmName, SHM_NAME);
+    EXPECT_STREQ(info.eventName, EVENT_NAME);
+
+    ASSERT_TRUE(makeStreamInfo("input", "Raw input", info));
+    EXPECT_EQ(std::string(info.shmName), std::string(SHM_NAME) + "_input");
+    EXPECT_EQ(std::string(info.eventName), std::string(EVENT_NAME) + "_input");
+    EXPECT_STREQ(info.description, "Raw input");
+
+    // Longest id still fits the name fields
+    const std::string longId(STREAM_ID_LEN - 1, 'z');
+    ASSERT_TRUE(makeStreamInfo(longId.c_str(), "", info));
+    EXPECT_EQ(std::string(info.shmName), std::string(SHM_NAME) + "_" + longId);
+}
+
+TEST_F(StreamRegistryTest, ReaderFailsUntilAProducerCreatesTheDirectory) {
+    StreamRegistry reader;
+    EXPECT_FALSE(reader.openForReading(kTestRegistryName));
+
+    StreamRegistry producer;
+    ASSERT_TRUE(producer.openForPublishing(kTestRegistryName));
+    ASSERT_TRUE(reader.openForReading(kTestRegistryName));
+
+    StreamInfo out[MAX_STREAMS];
+    EXPECT_EQ(reader.list(out, MAX_STREAMS), 0u);
+}
+
+TEST_F(StreamRegistryTest, PublishListFindWithdraw) {
+    StreamRegistry hostA, hostB, reader;
+    ASSERT_TRUE(hostA.openForPublishing(kTestRegistryName));
+    ASSERT_TRUE(hostB.openForPublishing(kTestRegistryName));  // second producer shares it
+    ASSERT_TRUE(reader.openForReading(kTestRegistryName));
+
+    EXPECT_TRUE(hostA.publish(makeInfo(MAIN_STREAM_ID, "Main output")));
+    EXPECT_TRUE(hostA.publish(makeInfo("input", "Raw input")));
+    EXPECT_TRUE(hostB.publish(makeInfo("inst2", "Second instance", 44100)));
+
+    StreamInfo out[MAX_STREAMS];
+    ASSERT_EQ(reader.list(out, MAX_STREAMS), 3u);
+    EXPECT_STREQ(out[0].id, MAIN_STREAM_ID);
+    EXPECT_STREQ(out[1].id, "input");
+    EXPECT_STREQ(out[2].id, "inst2");
+
+    StreamInfo found;
+    ASSERT_TRUE(reader.find("inst2", found));
+    EXPECT_EQ(found.sampleRate, 44100u);
+    EXPECT_EQ(found.channels, 2u);
+    EXPECT_STREQ(found.description, "Second instance");
+    EXPECT_EQ(std::string(found.shmName), std::string(SHM_NAME) + "_inst2");
+    EXPECT_FALSE(reader.find("missing", found));
+
+    EXPECT_TRUE(hostA.withdraw("input"));
+    EXPECT_FALSE(hostA.withdraw("input"));
+    EXPECT_FALSE(reader.find("input", found));
+    EXPECT_EQ(reader.list(out, MAX_STREAMS), 2u);
+
+    // maxStreams bounds the copy
+    EXPECT_EQ(reader.list(out, 1), 1u);
+}
+
+TEST_F(StreamRegistryTest, RepublishUpdatesInPlace) {
+    StreamRegistry producer, reader;
+    ASSERT_TRUE(producer.openForPublishing(kTestRegistryName));
+    ASSERT_TRUE(reader.openForReading(kTestRegistryName));
+
+    ASSERT_TRUE(producer.publish(makeInfo("post-chain", "Post-chain", 48000)));
+    // Sample rate change / producer restart after a crash: same entry, no duplicate
+    ASSERT_TRUE(producer.publish(makeInfo("post-chain", "Post-chain", 96000)));
+
+    StreamInfo out[MAX_STREAMS];
+    ASSERT_EQ(reader.list(out, MAX_STREAMS), 1u);
+    EXPECT_EQ(out[0].sampleRate, 96000u);
+}
+
+TEST_F(StreamRegistryTest, FullDirectoryRejectsNewStreams) {
+    StreamRegistry producer;
+    ASSERT_TRUE(producer.openForPublishing(kTestRegistryName));
+
+    for (uint32_t i = 0; i < MAX_STREAMS; ++i) {
+        const std::string id = "s" + std::to_string(i);
+        EXPECT_TRUE(producer.publish(makeInfo(id.c_str(), "")));
+    }
+    EXPECT_FALSE(producer.publish(makeInfo("overflow", "")));
+
+    // An existing id can still be updated, and a withdrawn entry is reused
+    EXPECT_TRUE(producer.publish(makeInfo("s3", "", 44100)));
+    EXPECT_TRUE(producer.withdraw("s5"));
+    EXPECT_TRUE(producer.publish(makeInfo("overflow", "")));
+}
+
+TEST_F(StreamRegistryTest, IncompatibleDirectoryVersionIsRejected) {
+    StreamRegistry producer;
+    ASSERT_TRUE(producer.openForPublishing(kTestRegistryName));
+
+    SharedMemory raw;
+    ASSERT_TRUE(raw.open(kTestRegistryName, sizeof(StreamDirectory)));
+    static_cast<StreamDirectory*>(raw.getData())->version.store(REGISTRY_VERSION + 1);
+
+    StreamRegistry reader;
+    EXPECT_FALSE(reader.openForReading(kTestRegistryName));
+    EXPECT_FALSE(reader.isOpen());
+}
@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 #include "Audio/VSTChain.h"
 
+#include <thread>
+
 using namespace directpipe;
 
 class VSTChainTest : public ::testing::Test {
@@ -175,3 +177,103 @@ TEST_F(VSTChainTest, RemoveOutOfRange) {
     EXPECT_TRUE(chain_->removePlugin(0));
     EXPECT_EQ(chain_->getPluginCount(), 0);
 }
+
+// Test 10: each plugin's processBlock is timed, and nothing is counted while timing is off
+TEST_F(VSTChainTest, PluginTimingCountsBlocksPerPlugin) {
+    addBuiltin(PluginSlot::Type::BuiltinFilter);
+    addBuiltin(PluginSlot::Type::BuiltinAutoGain);
+    ASSERT_NE(chain_->getPluginSlot(0)->node, nullptr);
+    EXPECT_EQ(chain_->getPluginSlot(0)->node->getInner(), chain_->getPluginSlot(0)->getProcessor());
+
+    // processBlock asserts it is not on the message thread
+    auto runBlocks = [this](int blocks) {
+        std::thread rt([this, blocks] {
+            juce::AudioBuffer<float> buffer(2, 512);
+            for (int i = 0; i < blocks; ++i) {
+                buffer.clear();
+                chain_->processBlock(buffer, 512);
+            }
+        });
+        rt.join();
+    };
+
+    runBlocks(10);
+    auto timings = chain_->getPluginTimings();
+    ASSERT_EQ(timings.size(), 2u);
+    for (const auto& t : timings) {
+        EXPECT_EQ(t.blocks, 10u);
+        EXPECT_GT(t.maxUs, 0.0f);
+        EXPECT_LE(t.meanUs, t.maxUs);
+        EXPECT_GE(t.budgetPercent, 0.0f);
+    }
+
+    chain_->setPluginTimingEnabled(false);
+    runBlocks(5);
+    for (const auto& t : chain_->getPluginTimings())
+        EXPECT_EQ(t.blocks, 10u);
+}
+
+// Test 11: master bypass flips every plugin at once, and a bypassed plugin
+// keeps its latency in the chain (as its dry delay), so PDC does not change
+TEST_F(VSTChainTest, BypassKeepsChainLatency) {
+    addBuiltin(PluginSlot::Type::BuiltinFilter);
+    addBuiltin(PluginSlot::Type::BuiltinAutoGain);
+    const int pdc = chain_->getTotalChainPDC();
+    EXPECT_GT(pdc, 0);
+
+    chain_->setAllPluginsBypassed(true);
+    EXPECT_TRUE(chain_->isPluginBypassed(0));
+    EXPECT_TRUE(chain_->isPluginBypassed(1));
+    EXPECT_EQ(chain_->getTotalChainPDC(), pdc);
+
+    chain_->setPluginBypassed(0, false);
+    chain_->setAllPluginsBypassed(false);
+    EXPECT_FALSE(chain_->isPluginBypassed(0));
+    EXPECT_FALSE(chain_->isPluginBypassed(1));
+    EXPECT_EQ(chain_->getTotalChainPDC(), pdc);
+}
+
+// Test 12: a plugin that changes its latency gets a new dry delay of that
+// length, and bypass toggles afterwards keep the new latency in the chain
+TEST_F(VSTChainTest, LatencyChangeResizesDryDelay) {
+    addBuiltin(PluginSlot::Type::BuiltinAutoGain);
+    auto* slot = chain_->getPluginSlot(0);
+    ASSERT_NE(slot->node, nullptr);
+    const int base = slot->node->getLatencySamples();
+    const auto original = slot->node->getDryDelay();
+
+    auto runBlocks = [this](int blocks) {
+        std::thread rt([this, blocks] {
+            juce::AudioBuffer<float> buffer(2, 512);
+            for (int i = 0; i < blocks; ++i) {
+                buffer.clear();
+                chain_->processBlock(buffer, 512);
+            }
+        });
+        rt.join();
+    };
+    runBlocks(4);
+
+    // The async update would run on the message loop; run it directly
+    slot->getProcessor()->setLatencySamples(base + 100);
+    EXPECT_EQ(slot->node->getLatencySamples(), base + 100);
+    chain_->updateDryDelays();
+    ASSERT_NE(slot->node->getDryDelay(), original);   // a new delay, not resized in place
+    EXPECT_EQ(slot->node->getDryDelay()->getLatency(), base + 100);
+    EXPECT_EQ(chain_->getTotalChainPDC(), base + 100);
+
+    chain_->setPluginBypassed(0, true);
+    runBlocks(20);
+    EXPECT_EQ(chain_->getTotalChainPDC(), base + 100);
+
+    // Changing it again while bypassed crossfades from the old delay to the new one
+    slot->getProcessor()->setLatencySamples(base + 200);
+    chain_->updateDryDelays();
+    runBlocks(20);
+    EXPECT_EQ(chain_->getTotalChainPDC(), base + 200);
+
+    chain_->setPluginBypassed(0, false);
+    runBlocks(20);
+    EXPECT_FALSE(chain_->isPluginBypassed(0));
+    EXPECT_EQ(chain_->getTotalChainPDC(), base + 200);
+}
@@ -419,6 +419,31 @@ TEST_F(StateSerializationTest, EmptyPluginArraySerializesCorrectly) {
     EXPECT_EQ(plugins.size(), 0);
 }
 
+TEST_F(StateSerializationTest, PluginEntriesIncludeCpuTiming) {
+    broadcaster->updateState([](AppState& state) {
+        AppState::PluginState ps;
+        ps.name = "ReaComp";
+        ps.loaded = true;
+        ps.cpuMeanUs = 42.5f;
+        ps.cpuP99Us = 128.0f;
+        ps.cpuMaxUs = 310.0f;
+        ps.cpuPercent = 0.4f;
+        state.plugins = { ps };
+    });
+
+    auto parsed = juce::JSON::parse(juce::String(broadcaster->toJSON()));
+    auto* data = parsed.getDynamicObject()->getProperty("data").getDynamicObject();
+    ASSERT_NE(data, nullptr);
+    auto plugins = *data->getProperty("plugins").getArray();
+    ASSERT_EQ(plugins.size(), 1);
+
+    auto* p0 = plugins[0].getDynamicObject();
+    EXPECT_NEAR(static_cast<double>(p0->getProperty("cpu_mean_us")), 42.5, 1e-3);
+    EXPECT_NEAR(static_cast<double>(p0->getProperty("cpu_p99_us")), 128.0, 1e-3);
+    EXPECT_NEAR(static_cast<double>(p0->getProperty("cpu_max_us")), 310.0, 1e-3);
+    EXPECT_NEAR(static_cast<double>(p0->getProperty("cpu_percent")), 0.4, 1e-3);
+}
+
 TEST_F(StateSerializationTest, StateJsonIsReproducible) {
     broadcaster->updateState([](AppState& state) {
         state.masterBypassed = true;
@@ -581,3 +606,82 @@ TEST_F(StateSerializationTest, StateJsonIncludesIpcEnabled) {
     EXPECT_TRUE(data->hasProperty("ipc_enabled"));
     EXPECT_EQ(static_cast<bool>(data->getProperty("ipc_enabled")), false);
 }
+
+TEST_F(StateSerializationTest, StateJsonIncludesIpcConsumerTelemetry) {
+    broadcaster->updateState([](AppState& state) {
+        state.ipcDroppedFrames = 12;
+        AppState::IpcConsumerState c;
+        c.slot = 3;
+        c.blocks = 5000000000ULL;   // Past 32 bits
+        c.underruns = 2;
+        c.framesPadded = 300;
+        c.framesSkipped = 4096;
+        c.framesConcealed = 240;
+        c.fillFrames = 520;
+        c.resampleRatio = 1.000125;
+        c.processUs = 14.5f;
+        c.fillHistogram[4] = 4999;
+        state.ipcConsumers.push_back(c);
+    });
+
+    auto parsed = juce::JSON::parse(juce::String(broadcaster->toJSON()));
+    auto* data = parsed.getDynamicObject()->getProperty("data").getDynamicObject();
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(static_cast<juce::int64>(data->getProperty("ipc_dropped_frames")), 12);
+    EXPECT_EQ(static_cast<juce::int64>(data->getProperty("ipc_overwritten_frames")), 0);
+
+    auto* consumers = data->getProperty("ipc_consumers").getArray();
+    ASSERT_NE(consumers, nullptr);
+    ASSERT_EQ(consumers->size(), 1);
+    auto* c = (*consumers)[0].getDynamicObject();
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(static_cast<int>(c->getProperty("slot")), 3);
+    EXPECT_EQ(static_cast<juce::int64>(c->getProperty("blocks")), 5000000000LL);
+    EXPECT_EQ(static_cast<int>(c->getProperty("underruns")), 2);
+    EXPECT_EQ(static_cast<int>(c->getProperty("frames_padded")), 300);
+    EXPECT_EQ(static_cast<int>(c->getProperty("frames_skipped")), 4096);
+    EXPECT_EQ(static_cast<int>(c->getProperty("frames_concealed")), 240);
+    EXPECT_EQ(static_cast<int>(c->getProperty("fill_frames")), 520);
+    EXPECT_NEAR(static_cast<double>(c->getProperty("resample_ratio")), 1.000125, 1e-9);
+    EXPECT_NEAR(static_cast<double>(c->getProperty("process_us")), 14.5, 0.01);
+
+    auto* histogram = c->getProperty("fill_histogram").getArray();
+    ASSERT_NE(histogram, nullptr);
+    EXPECT_EQ(histogram->size(), static_cast<int>(FILL_HISTOGRAM_BINS));
+    EXPECT_EQ(static_cast<int>((*histogram)[4]), 4999);
+}
+
+TEST_F(StateSerializationTest, StateJsonIncludesCallbackStageTiming) {
+    broadcaster->updateState([](AppState& state) {
+        AppState::CallbackStageState st;
+        st.name = "chain";
+        st.count = 6000000000ULL;   // Past 32 bits
+        st.meanUs = 85.5f;
+        st.p50Us = 128.0f;
+        st.p99Us = 512.0f;
+        st.maxUs = 2210.0f;
+        st.histogram[8] = 4000;
+        state.callbackStages.push_back(st);
+    });
+
+    auto parsed = juce::JSON::parse(juce::String(broadcaster->toJSON()));
+    auto* data = parsed.getDynamicObject()->getProperty("data").getDynamicObject();
+    ASSERT_NE(data, nullptr);
+
+    auto* stages = data->getProperty("callback_stages").getArray();
+    ASSERT_NE(stages, nullptr);
+    ASSERT_EQ(stages->size(), 1);
+    auto* st = (*stages)[0].getDynamicObject();
+    ASSERT_NE(st, nullptr);
+    EXPECT_EQ(st->getProperty("name").toString(), juce::String("chain"));
+    EXPECT_EQ(static_cast<juce::int64>(st->getProperty("count")), 6000000000LL);
+    EXPECT_NEAR(static_cast<double>(st->getProperty("mean_us")), 85.5, 0.01);
+    EXPECT_NEAR(static_cast<double>(st->getProperty("p50_us")), 128.0, 0.01);
+    EXPECT_NEAR(static_cast<double>(st->getProperty("p99_us")), 512.0, 0.01);
+    EXPECT_NEAR(static_cast<double>(st->getProperty("max_us")), 2210.0, 0.01);
+
+    auto* histogram = st->getProperty("histogram").getArray();
+    ASSERT_NE(histogram, nullptr);
+    EXPECT_EQ(histogram->size(), kStageTimingBins);
+    EXPECT_EQ(static_cast<int>((*histogram)[8]), 4000);
+}